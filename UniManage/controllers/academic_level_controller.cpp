@@ -1,6 +1,8 @@
 #include "academic_level_controller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -17,11 +19,13 @@ AcademicLevelController::AcademicLevelController() {}
  */
 bool AcademicLevelController::addAcademicLevel(const AcademicLevel& level)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_ACADEMIC_LEVEL);
     query.addBindValue(level.name());
     query.addBindValue(level.levelNumber());
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("academic_levels", query.lastInsertId().toInt(), ChangeEvent::Inserted);
+    return true;
 }
 
 /**
@@ -31,12 +35,14 @@ bool AcademicLevelController::addAcademicLevel(const AcademicLevel& level)
  */
 bool AcademicLevelController::updateAcademicLevel(const AcademicLevel& level)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_ACADEMIC_LEVEL);
     query.addBindValue(level.name());
     query.addBindValue(level.levelNumber());
     query.addBindValue(level.id());
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("academic_levels", level.id(), ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -46,10 +52,12 @@ bool AcademicLevelController::updateAcademicLevel(const AcademicLevel& level)
  */
 bool AcademicLevelController::deleteAcademicLevel(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_ACADEMIC_LEVEL);
     query.addBindValue(id);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("academic_levels", id, ChangeEvent::Deleted);
+    return true;
 }
 
 /**
@@ -59,7 +67,7 @@ bool AcademicLevelController::deleteAcademicLevel(int id)
 QList<AcademicLevel> AcademicLevelController::getAllAcademicLevels()
 {
     QList<AcademicLevel> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (query.exec(Queries::SELECT_ALL_ACADEMIC_LEVELS)) {
         while (query.next()) {
             list.append(AcademicLevel(query.value("id").toInt(),
@@ -78,7 +86,7 @@ QList<AcademicLevel> AcademicLevelController::getAllAcademicLevels()
 AcademicLevel AcademicLevelController::getAcademicLevelById(int id)
 {
     AcademicLevel level;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_ACADEMIC_LEVEL_BY_ID);
     query.addBindValue(id);
     
@@ -0,0 +1,56 @@
+#ifndef AUTHSERVICE_H
+#define AUTHSERVICE_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+#include <QObject>
+#include <QString>
+#include "../models/domain_types.h"
+#include <QThreadPool>
+#include <functional>
+
+/**
+ * Resolves login credentials (code + national ID) in one prepared round trip
+ * Lookups run on a small dedicated thread pool with per-thread database
+ * connections, and failed attempts are remembered for a short time so
+ * repeated retries during a login storm never reach the database
+ */
+class AuthService
+{
+public:
+    struct Result {
+        bool success = false;
+        int userId = 0;
+        UserRole role = UserRole::Unknown;
+    };
+
+    typedef std::function<void(const Result&)> Callback;
+
+    static AuthService& instance();
+
+    Result authenticate(const QString& code, const QString& natId);
+    void authenticateAsync(const QString& code, const QString& natId, QObject* context, Callback callback);
+
+    void clearNegativeCache();
+    void setNegativeCacheTtl(int msecs);
+
+    static bool verify(const QString& code, const QString& natId, UserRole role,
+                       const QString& storedHash, const QString& storedNatId);
+
+private:
+    AuthService();
+    AuthService(const AuthService&) = delete;
+    AuthService& operator=(const AuthService&) = delete;
+
+    static QByteArray cacheKey(const QString& code, const QString& natId);
+    bool isCachedFailure(const QByteArray& key);
+    void rememberFailure(const QByteArray& key);
+
+    QThreadPool m_pool;
+    QMutex m_cacheMutex;
+    QHash<QByteArray, qint64> m_failures; // cache key -> expiry (ms since epoch)
+    int m_negativeTtlMs;
+};
+
+#endif // AUTHSERVICE_H
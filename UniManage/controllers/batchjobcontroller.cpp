@@ -0,0 +1,141 @@
+#include "batchjobcontroller.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+/**
+ * Constructor for the BatchJobController class
+ */
+BatchJobController::BatchJobController() {}
+
+/**
+ * Retrieves a job by its type and scope
+ * @param jobType - The job type (e.g. "term_billing")
+ * @param scope - The scope of the run (e.g. "semester:3")
+ * @return The BatchJob (ID 0 if none exists)
+ */
+BatchJob BatchJobController::getJob(const QString& jobType, const QString& scope)
+{
+    BatchJob job;
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_BATCH_JOB);
+    query.addBindValue(jobType);
+    query.addBindValue(scope);
+
+    if (!query.exec()) {
+        qDebug() << "getJob failed:" << query.lastError().text();
+        return job;
+    }
+
+    if (query.next()) {
+        job.setId(query.value("id").toInt());
+        job.setJobType(query.value("job_type").toString());
+        job.setScope(query.value("scope").toString());
+        job.setStatus(query.value("status").toString());
+        job.setCheckpoint(query.value("checkpoint").toInt());
+        job.setProcessed(query.value("processed").toInt());
+        job.setTotal(query.value("total").toInt());
+        job.setStartedAt(query.value("started_at").toDateTime());
+        job.setUpdatedAt(query.value("updated_at").toDateTime());
+    }
+    return job;
+}
+
+/**
+ * Returns the existing job for (type, scope), or creates a new running one
+ * Paused or failed jobs are switched back to Running and keep their checkpoint
+ * @param jobType - The job type
+ * @param scope - The scope of the run
+ * @param total - Expected number of records for a new job
+ * @return The BatchJob (ID 0 on failure)
+ */
+BatchJob BatchJobController::startOrResume(const QString& jobType, const QString& scope, int total)
+{
+    BatchJob job = getJob(jobType, scope);
+    if (job.id() > 0) {
+        if (job.status() != "Completed" && job.status() != "Running") {
+            if (!setStatus(job.id(), "Running")) return BatchJob();
+            job.setStatus("Running");
+        }
+        return job;
+    }
+
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::INSERT_BATCH_JOB);
+    query.addBindValue(jobType);
+    query.addBindValue(scope);
+    query.addBindValue(total);
+
+    if (!query.exec()) {
+        qDebug() << "startOrResume failed:" << query.lastError().text();
+        return BatchJob();
+    }
+    return getJob(jobType, scope);
+}
+
+/**
+ * Rewinds a job to the beginning so it can run again
+ * @param jobId - The ID of the job
+ * @param total - The new expected number of records
+ * @return True if successful, otherwise false
+ */
+bool BatchJobController::resetJob(int jobId, int total)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::RESET_BATCH_JOB);
+    query.addBindValue(total);
+    query.addBindValue(jobId);
+
+    if (!query.exec()) {
+        qDebug() << "resetJob failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Updates the status of a job
+ * @param jobId - The ID of the job
+ * @param status - Running, Paused, Completed or Failed
+ * @return True if successful, otherwise false
+ */
+bool BatchJobController::setStatus(int jobId, const QString& status)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_BATCH_JOB_STATUS);
+    query.addBindValue(status);
+    query.addBindValue(jobId);
+
+    if (!query.exec()) {
+        qDebug() << "setStatus failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Advances a job's checkpoint
+ * Must run in the same transaction as the chunk it records
+ * @param db - The connection holding the caller's transaction
+ * @param jobId - The ID of the job
+ * @param checkpoint - The last key fully processed
+ * @param processedDelta - Number of records processed in this chunk
+ * @return True if successful, otherwise false
+ */
+bool BatchJobController::recordProgress(QSqlDatabase& db, int jobId, int checkpoint, int processedDelta)
+{
+    DBQuery query(db);
+    query.prepare(Queries::UPDATE_BATCH_JOB_PROGRESS);
+    query.addBindValue(checkpoint);
+    query.addBindValue(processedDelta);
+    query.addBindValue(jobId);
+
+    if (!query.exec()) {
+        qDebug() << "recordProgress failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
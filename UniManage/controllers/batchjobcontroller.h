@@ -0,0 +1,27 @@
+#ifndef BATCHJOBCONTROLLER_H
+#define BATCHJOBCONTROLLER_H
+
+#include "../models/batch_job.h"
+#include <QString>
+
+class QSqlDatabase;
+
+/**
+ * Persists progress of restartable batch jobs in the batch_jobs table
+ * A job is identified by (job_type, scope); checkpoints are written inside
+ * the same transaction as the chunk they describe
+ */
+class BatchJobController
+{
+public:
+    BatchJobController();
+
+    BatchJob getJob(const QString& jobType, const QString& scope);
+    BatchJob startOrResume(const QString& jobType, const QString& scope, int total);
+    bool resetJob(int jobId, int total);
+    bool setStatus(int jobId, const QString& status);
+
+    static bool recordProgress(QSqlDatabase& db, int jobId, int checkpoint, int processedDelta);
+};
+
+#endif // BATCHJOBCONTROLLER_H
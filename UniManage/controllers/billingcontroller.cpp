@@ -0,0 +1,185 @@
+#include "billingcontroller.h"
+#include "batchjobcontroller.h"
+#include "ledgercontroller.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/tableversions.h"
+#include "../database/changebus.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+const QString BillingController::TermBillingJob = "term_billing";
+
+/**
+ * Constructor for the BillingController class
+ */
+BillingController::BillingController() {}
+
+/**
+ * Adds a fee rule, or changes the amount of the rule with the same scope
+ * @param rule - The FeeRule (zero college/level IDs are wildcards)
+ * @return True if successful, otherwise false
+ */
+bool BillingController::addFeeRule(const FeeRule& rule)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPSERT_FEE_RULE);
+    query.addBindValue(qMax(0, rule.collegeId()));
+    query.addBindValue(qMax(0, rule.academicLevelId()));
+    query.addBindValue(rule.amount().toString());
+
+    if (!query.exec()) {
+        qDebug() << "addFeeRule failed:" << query.lastError().text();
+        return false;
+    }
+    ChangeBus::instance().publish("fee_rules", 0, ChangeEvent::Updated);
+    return true;
+}
+
+/**
+ * Deletes a fee rule
+ * @param id - The ID of the rule
+ * @return True if successful, otherwise false
+ */
+bool BillingController::deleteFeeRule(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::DELETE_FEE_RULE);
+    query.addBindValue(id);
+
+    if (!query.exec()) {
+        qDebug() << "deleteFeeRule failed:" << query.lastError().text();
+        return false;
+    }
+    ChangeBus::instance().publish("fee_rules", id, ChangeEvent::Deleted);
+    return true;
+}
+
+/**
+ * Retrieves all fee rules
+ * @return A list of FeeRule objects
+ */
+QList<FeeRule> BillingController::getAllFeeRules()
+{
+    QList<FeeRule> list;
+    DBQuery query(DBConnection::instance().database());
+
+    if (!query.exec(Queries::SELECT_ALL_FEE_RULES)) {
+        qDebug() << "getAllFeeRules failed:" << query.lastError().text();
+        return list;
+    }
+
+    while (query.next()) {
+        list.append(FeeRule(query.value("id").toInt(),
+                            query.value("college_id").toInt(),
+                            query.value("academic_level_id").toInt(),
+                            Money::fromVariant(query.value("amount"))));
+    }
+    return list;
+}
+
+/**
+ * Retrieves the billing job of a semester
+ * @param semesterId - The ID of the semester
+ * @return The BatchJob (ID 0 if the semester was never billed)
+ */
+BatchJob BillingController::getTermBillingJob(int semesterId)
+{
+    return BatchJobController().getJob(TermBillingJob, QString("semester:%1").arg(semesterId));
+}
+
+/**
+ * Bills every active student for a semester
+ * Amount precedence: college+level rule, college rule, level rule, college
+ * tuition fees, student tuition fees. Existing charges are never duplicated
+ * (UNIQUE student_id, semester_id), so re-running a completed job only bills
+ * students added since
+ * @param semesterId - The ID of the semester to bill
+ * @param chunkSize - Number of students per transaction
+ * @param progress - Optional callback invoked after every chunk
+ * @param restartCompleted - Re-run a job that already completed
+ * @return True if the run completed, false if it failed or was paused
+ */
+bool BillingController::runTermBilling(int semesterId, int chunkSize, const ProgressCallback& progress, bool restartCompleted)
+{
+    QSqlDatabase& db = DBConnection::instance().database();
+    BatchJobController jobs;
+    const QString scope = QString("semester:%1").arg(semesterId);
+
+    DBQuery countQuery(db);
+    if (!countQuery.exec(Queries::COUNT_BILLABLE_STUDENTS) || !countQuery.next()) {
+        qDebug() << "runTermBilling failed to count students:" << countQuery.lastError().text();
+        return false;
+    }
+    const int total = countQuery.value(0).toInt();
+
+    BatchJob job = jobs.startOrResume(TermBillingJob, scope, total);
+    if (job.id() == 0) return false;
+    if (job.status() == "Completed") {
+        if (!restartCompleted) return true;
+        if (!jobs.resetJob(job.id(), total)) return false;
+        job.setCheckpoint(0);
+        job.setProcessed(0);
+    }
+
+    int checkpoint = job.checkpoint();
+    int processed = job.processed();
+    if (progress && !progress(processed, total)) {
+        jobs.setStatus(job.id(), "Paused");
+        return false;
+    }
+
+    DBQuery bound(db);
+    bound.prepare(Queries::SELECT_BILLING_CHUNK_BOUND);
+    DBQuery charges(db);
+    charges.prepare(Queries::INSERT_TUITION_CHARGES_CHUNK);
+
+    while (true) {
+        bound.addBindValue(checkpoint);
+        bound.addBindValue(chunkSize);
+        if (!bound.exec() || !bound.next()) {
+            qDebug() << "runTermBilling failed to read chunk:" << bound.lastError().text();
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+        if (bound.value(0).isNull()) break;
+        const int upper = bound.value(0).toInt();
+        const int count = bound.value(1).toInt();
+        bound.finish();
+
+        if (!DBConnection::instance().beginTransaction(db)) {
+            qDebug() << "runTermBilling failed to start transaction:" << db.lastError().text();
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+
+        charges.addBindValue(semesterId);
+        charges.addBindValue(job.id());
+        charges.addBindValue(checkpoint);
+        charges.addBindValue(upper);
+        bool ok = charges.exec();
+        if (!ok) qDebug() << "runTermBilling failed to insert charges:" << charges.lastError().text();
+
+        ok = ok && LedgerController::rebuildBalanceRange(db, checkpoint, upper)
+                && BatchJobController::recordProgress(db, job.id(), upper, count)
+                && TableVersions::bump(db, "tuition_charges")
+                && DBConnection::instance().commit(db);
+        if (!ok) {
+            DBConnection::instance().rollback(db);
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+        ChangeBus::instance().deliver("tuition_charges", 0, ChangeEvent::Inserted);
+
+        checkpoint = upper;
+        processed += count;
+        if (progress && !progress(processed, total)) {
+            jobs.setStatus(job.id(), "Paused");
+            return false;
+        }
+    }
+
+    return jobs.setStatus(job.id(), "Completed");
+}
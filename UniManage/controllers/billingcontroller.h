@@ -0,0 +1,37 @@
+#ifndef BILLINGCONTROLLER_H
+#define BILLINGCONTROLLER_H
+
+#include "../models/fee_rule.h"
+#include "../models/batch_job.h"
+#include <QList>
+#include <QString>
+#include <functional>
+
+/**
+ * Term tuition billing
+ * Generates one tuition_charges row per billable student for a semester using
+ * set-based INSERT ... SELECT statements over chunks of students_data.id.
+ * Every chunk commits its charges, ledger rows and job checkpoint together,
+ * so an interrupted run resumes where it stopped without double billing
+ */
+class BillingController
+{
+public:
+    // Receives (processed, total); returning false pauses the run
+    typedef std::function<bool(int, int)> ProgressCallback;
+
+    static const QString TermBillingJob;
+
+    BillingController();
+
+    bool addFeeRule(const FeeRule& rule);
+    bool deleteFeeRule(int id);
+    QList<FeeRule> getAllFeeRules();
+
+    BatchJob getTermBillingJob(int semesterId);
+    bool runTermBilling(int semesterId, int chunkSize = 2000,
+                        const ProgressCallback& progress = ProgressCallback(),
+                        bool restartCompleted = false);
+};
+
+#endif // BILLINGCONTROLLER_H
@@ -1,6 +1,9 @@
 #include "calendarcontroller.h"
+#include "calendarindex.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -17,18 +20,22 @@ CalendarController::CalendarController() {}
  */
 bool CalendarController::addEvent(const CalendarEvent& event)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_CALENDAR_EVENT);
     query.addBindValue(event.title());
     query.addBindValue(event.description());
     query.addBindValue(event.startDate());
     query.addBindValue(event.endDate());
     query.addBindValue(event.eventType());
+    query.addBindValue(event.recurrenceName());
+    query.addBindValue(event.isRecurring() && event.recurrenceUntil().isValid() ? QVariant(event.recurrenceUntil()) : QVariant());
 
     if (!query.exec()) {
         qDebug() << "addEvent failed:" << query.lastError().text();
         return false;
     }
+    CalendarIndex::instance().invalidate();
+    ChangeBus::instance().publish("calendar_events", query.lastInsertId().toInt(), ChangeEvent::Inserted);
     return true;
 }
 
@@ -39,19 +46,23 @@ bool CalendarController::addEvent(const CalendarEvent& event)
  */
 bool CalendarController::updateEvent(const CalendarEvent& event)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_CALENDAR_EVENT);
     query.addBindValue(event.title());
     query.addBindValue(event.description());
     query.addBindValue(event.startDate());
     query.addBindValue(event.endDate());
     query.addBindValue(event.eventType());
+    query.addBindValue(event.recurrenceName());
+    query.addBindValue(event.isRecurring() && event.recurrenceUntil().isValid() ? QVariant(event.recurrenceUntil()) : QVariant());
     query.addBindValue(event.id());
 
     if (!query.exec()) {
         qDebug() << "updateEvent failed:" << query.lastError().text();
         return false;
     }
+    CalendarIndex::instance().invalidate();
+    ChangeBus::instance().publish("calendar_events", event.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -62,7 +73,7 @@ bool CalendarController::updateEvent(const CalendarEvent& event)
  */
 bool CalendarController::deleteEvent(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_CALENDAR_EVENT);
     query.addBindValue(id);
 
@@ -70,64 +81,41 @@ bool CalendarController::deleteEvent(int id)
         qDebug() << "deleteEvent failed:" << query.lastError().text();
         return false;
     }
+    CalendarIndex::instance().invalidate();
+    ChangeBus::instance().publish("calendar_events", id, ChangeEvent::Deleted);
     return true;
 }
 
 /**
- * Retrieves all calendar events from the database
- * @return A list of CalendarEvent objects
+ * Retrieves all calendar events
+ * Served from CalendarIndex, which only goes back to the database when
+ * the calendar_events table has changed
+ * @return A list of CalendarEvent objects ordered by start date
  */
 QList<CalendarEvent> CalendarController::getAllEvents()
 {
-    QList<CalendarEvent> list;
-    QSqlQuery query(DBConnection::instance().database());
-
-    if (!query.exec(Queries::SELECT_ALL_CALENDAR_EVENTS)) {
-        qDebug() << "getAllEvents failed:" << query.lastError().text();
-        return list;
-    }
+    return CalendarIndex::instance().events();
+}
 
-    while (query.next()) {
-        CalendarEvent e;
-        e.setId(query.value("id").toInt());
-        e.setTitle(query.value("title").toString());
-        e.setDescription(query.value("description").toString());
-        e.setStartDate(query.value("start_date").toDate());
-        e.setEndDate(query.value("end_date").toDate());
-        e.setEventType(query.value("event_type").toString());
-        list.append(e);
-    }
-    return list;
+/**
+ * Retrieves a single calendar event
+ * @param id - The ID of the event
+ * @return The event if found, otherwise an empty object
+ */
+CalendarEvent CalendarController::getEventById(int id)
+{
+    return CalendarIndex::instance().eventById(id);
 }
 
 /**
- * Retrieves calendar events falling within a specific date range
+ * Retrieves the calendar events that overlap a date range
+ * Events partly inside the range are included, and recurring events are
+ * expanded into one entry per occurrence in the range
  * @param start - The start date of the range
- * @param end - The end date of the range
- * @return A list of CalendarEvent objects within the specified range
+ * @param end - The end date of the range (inclusive)
+ * @return A list of CalendarEvent occurrences ordered by start date
  */
 QList<CalendarEvent> CalendarController::getEventsByRange(const QDate& start, const QDate& end)
 {
-    QList<CalendarEvent> list;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_CALENDAR_EVENTS_BY_RANGE);
-    query.addBindValue(start);
-    query.addBindValue(end);
-
-    if (!query.exec()) {
-        qDebug() << "getEventsByRange failed:" << query.lastError().text();
-        return list;
-    }
-
-    while (query.next()) {
-        CalendarEvent e;
-        e.setId(query.value("id").toInt());
-        e.setTitle(query.value("title").toString());
-        e.setDescription(query.value("description").toString());
-        e.setStartDate(query.value("start_date").toDate());
-        e.setEndDate(query.value("end_date").toDate());
-        e.setEventType(query.value("event_type").toString());
-        list.append(e);
-    }
-    return list;
+    return CalendarIndex::instance().occurrences(start, end);
 }
@@ -13,6 +13,7 @@ public:
     bool updateEvent(const CalendarEvent& event);
     bool deleteEvent(int id);
     QList<CalendarEvent> getAllEvents();
+    CalendarEvent getEventById(int id);
     QList<CalendarEvent> getEventsByRange(const QDate& start, const QDate& end);
 };
 
@@ -0,0 +1,283 @@
+#include "calendarindex.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include "../database/tableversions.h"
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <limits>
+
+namespace {
+
+const qint64 Unbounded = std::numeric_limits<qint64>::max();
+
+/**
+ * @param event - A calendar event
+ * @return Days from its start to its end (0 for single-day or open events)
+ */
+qint64 durationDays(const CalendarEvent& event)
+{
+    if (!event.endDate().isValid()) return 0;
+    return qMax<qint64>(0, event.endDate().toJulianDay() - event.startDate().toJulianDay());
+}
+
+/**
+ * Copies an event onto another occurrence date, keeping its length
+ */
+CalendarEvent occurrenceAt(const CalendarEvent& event, qint64 start, qint64 duration)
+{
+    CalendarEvent copy = event;
+    copy.setStartDate(QDate::fromJulianDay(start));
+    copy.setEndDate(QDate::fromJulianDay(start + duration));
+    return copy;
+}
+
+} // namespace
+
+/**
+ * Constructor for the CalendarIndex class
+ * Nothing is loaded until the first lookup
+ */
+CalendarIndex::CalendarIndex()
+    : m_version(0), m_loaded(false)
+{
+}
+
+/**
+ * @return The process wide calendar index
+ */
+CalendarIndex& CalendarIndex::instance()
+{
+    static CalendarIndex index;
+    return index;
+}
+
+/**
+ * @return Every stored event ordered by start date; recurring events appear
+ *         once, with the dates of their first occurrence
+ */
+QList<CalendarEvent> CalendarIndex::events()
+{
+    ensureCurrent();
+    QReadLocker locker(&m_lock);
+    return m_events;
+}
+
+/**
+ * @param id - The ID of the event
+ * @return The stored event, or an empty object if there is none
+ */
+CalendarEvent CalendarIndex::eventById(int id)
+{
+    ensureCurrent();
+    QReadLocker locker(&m_lock);
+    const int index = m_byId.value(id, -1);
+    return index >= 0 ? m_events.at(index) : CalendarEvent();
+}
+
+/**
+ * Finds every event occurrence that overlaps a date range
+ * Recurring events contribute one entry per occurrence in the range, each
+ * carrying the event's ID with the occurrence's own start and end dates
+ * @param from - First day of the range
+ * @param to - Last day of the range (inclusive)
+ * @return The occurrences ordered by start date
+ */
+QList<CalendarEvent> CalendarIndex::occurrences(const QDate& from, const QDate& to)
+{
+    QList<CalendarEvent> out;
+    if (!from.isValid() || !to.isValid() || to < from) return out;
+
+    ensureCurrent();
+    const qint64 first = from.toJulianDay();
+    const qint64 last = to.toJulianDay();
+
+    QReadLocker locker(&m_lock);
+    std::vector<int> hits;
+    collect(0, int(m_spans.size()), first, last, hits);
+    for (int index : hits) {
+        expand(m_events.at(index), first, last, out);
+    }
+    locker.unlock();
+
+    std::stable_sort(out.begin(), out.end(), [](const CalendarEvent& a, const CalendarEvent& b) {
+        return a.startDate() < b.startDate();
+    });
+    return out;
+}
+
+/**
+ * Forces a reload on the next lookup
+ * Called by CalendarController after every successful write
+ */
+void CalendarIndex::invalidate()
+{
+    QWriteLocker locker(&m_lock);
+    m_loaded = false;
+}
+
+/**
+ * Appends the occurrences of one event that overlap a day range
+ * @param event - The event
+ * @param from - Julian day the range starts
+ * @param to - Julian day the range ends (inclusive)
+ * @param out - Receives the occurrences, in date order
+ */
+void CalendarIndex::expand(const CalendarEvent& event, qint64 from, qint64 to, QList<CalendarEvent>& out)
+{
+    if (!event.startDate().isValid()) return;
+    const qint64 start = event.startDate().toJulianDay();
+    const qint64 duration = durationDays(event);
+    const qint64 until = event.recurrenceUntil().isValid() ? event.recurrenceUntil().toJulianDay() : Unbounded;
+
+    switch (event.recurrence()) {
+        case Recurrence::Weekly: {
+            // Skip straight to the first week whose occurrence reaches the range
+            const qint64 behind = from - duration - start;
+            qint64 day = start + (behind > 0 ? (behind + 6) / 7 * 7 : 0);
+            for (; day <= to && day <= until; day += 7) {
+                out.append(occurrenceAt(event, day, duration));
+            }
+            break;
+        }
+        case Recurrence::Yearly: {
+            const int firstYear = event.startDate().year();
+            const int lastYear = QDate::fromJulianDay(to).year();
+            int year = qMax(firstYear, QDate::fromJulianDay(from - duration).year());
+            for (; year <= lastYear; ++year) {
+                // addYears() moves 29 February to the 28th in other years
+                const qint64 day = event.startDate().addYears(year - firstYear).toJulianDay();
+                if (day > to || day > until) break;
+                if (day + duration >= from) out.append(occurrenceAt(event, day, duration));
+            }
+            break;
+        }
+        case Recurrence::None:
+        default:
+            if (start <= to && start + duration >= from) out.append(event);
+            break;
+    }
+}
+
+/**
+ * Reloads the index if it was never loaded, was invalidated, or the
+ * calendar_events counter changed since the last load
+ * The counter is read before the rows, so a write racing with the load is
+ * picked up by the next lookup. Without counters every lookup reloads
+ */
+void CalendarIndex::ensureCurrent()
+{
+    QHash<QString, qint64> versions;
+    const bool tracked = TableVersions::fetch(versions);
+    const qint64 version = versions.value("calendar_events");
+    {
+        QReadLocker locker(&m_lock);
+        if (m_loaded && tracked && version == m_version) return;
+    }
+
+    // Read outside the lock; on failure keep serving the last good copy
+    QList<CalendarEvent> events;
+    if (!load(events)) return;
+
+    QWriteLocker locker(&m_lock);
+    m_events = events;
+    build();
+    m_version = version;
+    m_loaded = tracked;
+}
+
+/**
+ * Reads every calendar event
+ * @param events - Receives the events ordered by start date
+ * @return True if the query succeeded, otherwise false
+ */
+bool CalendarIndex::load(QList<CalendarEvent>& events)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+
+    if (!query.exec(Queries::SELECT_ALL_CALENDAR_EVENTS)) {
+        qDebug() << "getAllEvents failed:" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        CalendarEvent e;
+        e.setId(query.value("id").toInt());
+        e.setTitle(query.value("title").toString());
+        e.setDescription(query.value("description").toString());
+        e.setStartDate(query.value("start_date").toDate());
+        e.setEndDate(query.value("end_date").toDate());
+        e.setEventType(query.value("event_type").toString());
+        e.setRecurrence(query.value("recurrence").toString());
+        e.setRecurrenceUntil(query.value("recurrence_until").toDate());
+        events.append(e);
+    }
+    return true;
+}
+
+/**
+ * Rebuilds the ID map and the span tree from m_events
+ * Called with the write lock held
+ */
+void CalendarIndex::build()
+{
+    m_byId.clear();
+    m_spans.clear();
+    m_spans.reserve(m_events.size());
+
+    for (int i = 0; i < m_events.size(); ++i) {
+        const CalendarEvent& e = m_events.at(i);
+        m_byId.insert(e.id(), i);
+        if (!e.startDate().isValid()) continue;
+
+        Span span;
+        span.low = e.startDate().toJulianDay();
+        span.high = span.low + durationDays(e);
+        span.event = i;
+        if (e.isRecurring()) {
+            span.high = e.recurrenceUntil().isValid()
+                ? qMax(span.high, e.recurrenceUntil().toJulianDay() + durationDays(e))
+                : Unbounded;
+        }
+        m_spans.push_back(span);
+    }
+
+    std::sort(m_spans.begin(), m_spans.end(), [](const Span& a, const Span& b) {
+        return a.low < b.low;
+    });
+    m_maxHigh.assign(m_spans.size(), 0);
+    buildMax(0, int(m_spans.size()));
+}
+
+/**
+ * Fills m_maxHigh for the subtree over [begin, end), rooted at its middle
+ * @return The largest high in the subtree
+ */
+qint64 CalendarIndex::buildMax(int begin, int end)
+{
+    if (begin >= end) return std::numeric_limits<qint64>::min();
+    const int mid = begin + (end - begin) / 2;
+    const qint64 high = qMax(m_spans[mid].high, qMax(buildMax(begin, mid), buildMax(mid + 1, end)));
+    m_maxHigh[mid] = high;
+    return high;
+}
+
+/**
+ * Collects the spans of the subtree over [begin, end) that overlap a range
+ * A subtree is skipped when all its spans end before the range, and the
+ * right half is skipped when the middle span already starts after it
+ * @param hits - Receives indexes into m_events
+ */
+void CalendarIndex::collect(int begin, int end, qint64 from, qint64 to, std::vector<int>& hits) const
+{
+    if (begin >= end) return;
+    const int mid = begin + (end - begin) / 2;
+    if (m_maxHigh[mid] < from) return;
+
+    collect(begin, mid, from, to, hits);
+    if (m_spans[mid].low > to) return;
+    if (m_spans[mid].high >= from) hits.push_back(m_spans[mid].event);
+    collect(mid + 1, end, from, to, hits);
+}
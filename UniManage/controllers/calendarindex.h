@@ -0,0 +1,61 @@
+#ifndef CALENDARINDEX_H
+#define CALENDARINDEX_H
+
+#include "../models/calendar_event.h"
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <vector>
+
+/**
+ * In-memory interval index over calendar_events
+ * Every row is stored once; a recurring row covers the span from its first
+ * occurrence to the end of its last one (unbounded without an end date).
+ * The spans sit in an array sorted by start, read as an implicit balanced
+ * tree whose nodes carry the largest end in their subtree, so an overlap
+ * query visits O(log n + k) nodes. Recurring rows found that way are
+ * expanded into the occurrences that fall inside the query window only.
+ * The index is loaded on first use and reloaded when the calendar_events
+ * change counter (see TableVersions) moves or a controller invalidates it
+ */
+class CalendarIndex
+{
+public:
+    static CalendarIndex& instance();
+
+    QList<CalendarEvent> events();
+    CalendarEvent eventById(int id);
+    QList<CalendarEvent> occurrences(const QDate& from, const QDate& to);
+
+    void invalidate();
+
+    static void expand(const CalendarEvent& event, qint64 from, qint64 to, QList<CalendarEvent>& out);
+
+private:
+    CalendarIndex();
+    CalendarIndex(const CalendarIndex&) = delete;
+    CalendarIndex& operator=(const CalendarIndex&) = delete;
+
+    struct Span {
+        qint64 low;  // Julian day the first occurrence starts
+        qint64 high; // Julian day the last occurrence ends
+        int event;   // index into m_events
+    };
+
+    void ensureCurrent();
+    static bool load(QList<CalendarEvent>& events);
+    void build();
+    qint64 buildMax(int begin, int end);
+    void collect(int begin, int end, qint64 from, qint64 to, std::vector<int>& hits) const;
+
+    mutable QReadWriteLock m_lock;
+    QList<CalendarEvent> m_events; // ordered by start date
+    QHash<int, int> m_byId;        // event ID -> index into m_events
+    std::vector<Span> m_spans;     // ordered by low
+    std::vector<qint64> m_maxHigh; // largest high in the subtree rooted at each span
+    qint64 m_version;
+    bool m_loaded;
+};
+
+#endif // CALENDARINDEX_H
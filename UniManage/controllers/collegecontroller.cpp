@@ -1,10 +1,13 @@
 #include "collegecontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include "../database/persistence.h"
+#include "../database/changebus.h"
+#include "ledgercontroller.h"
 
 /**
  * Constructor for the CollegeController class
@@ -19,13 +22,14 @@ CollegeController::CollegeController() {}
  */
 bool CollegeController::addCollege(const College& college)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare("INSERT INTO colleges (name, code, tuition_fees) VALUES (?, ?, ?)");
     query.addBindValue(college.name());
     query.addBindValue(college.code());
-    query.addBindValue(college.tuitionFees());
+    query.addBindValue(college.tuitionFees().toString());
     if (query.exec()) {
         Persistence::logChange("Faculty", "Create", query.lastInsertId().toInt(), college.name());
+        ChangeBus::instance().publish("colleges", query.lastInsertId().toInt(), ChangeEvent::Inserted);
         return true;
     }
     return false;
@@ -33,20 +37,23 @@ bool CollegeController::addCollege(const College& college)
 
 /**
  * Updates an existing college in the database
- * Logs the update event after successful execution
+ * The ledger rows of its students are rebuilt, since unbilled students are
+ * charged the college's tuition fees. Logs the update event after successful execution
  * @param college - The College object with updated details
  * @return True if successful, otherwise false
  */
 bool CollegeController::updateCollege(const College& college)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare("UPDATE colleges SET name = ?, code = ?, tuition_fees = ? WHERE id = ?");
     query.addBindValue(college.name());
     query.addBindValue(college.code());
-    query.addBindValue(college.tuitionFees());
+    query.addBindValue(college.tuitionFees().toString());
     query.addBindValue(college.id());
     if (query.exec()) {
+        LedgerController().rebuildCollegeBalances(college.id());
         Persistence::logChange("Faculty", "Edit", college.id(), college.name());
+        ChangeBus::instance().publish("colleges", college.id(), ChangeEvent::Updated);
         return true;
     }
     return false;
@@ -60,11 +67,12 @@ bool CollegeController::updateCollege(const College& college)
  */
 bool CollegeController::deleteCollege(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_COLLEGE);
     query.addBindValue(id);
     if (query.exec()) {
         Persistence::logChange("Faculty", "Delete", id, "Removed Faculty");
+        ChangeBus::instance().publish("colleges", id, ChangeEvent::Deleted);
         return true;
     }
     return false;
@@ -77,13 +85,13 @@ bool CollegeController::deleteCollege(int id)
 QList<College> CollegeController::getAllColleges()
 {
     QList<College> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (query.exec(Queries::SELECT_ALL_COLLEGES)) {
         while (query.next()) {
             list.append(College(query.value("id").toInt(),
                               query.value("name").toString(),
                               query.value("code").toString(),
-                              query.value("tuition_fees").toDouble()));
+                              Money::fromVariant(query.value("tuition_fees"))));
         }
     }
     return list;
@@ -96,14 +104,14 @@ QList<College> CollegeController::getAllColleges()
  */
 College CollegeController::getCollegeById(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare("SELECT * FROM colleges WHERE id = ?");
     query.addBindValue(id);
     if (query.exec() && query.next()) {
         return College(query.value("id").toInt(),
                       query.value("name").toString(),
                       query.value("code").toString(),
-                      query.value("tuition_fees").toDouble());
+                      Money::fromVariant(query.value("tuition_fees")));
     }
     return College();
 }
@@ -1,42 +1,32 @@
 #include "coursecontroller.h"
-#include "../database/dbconnection.h"
-#include "../database/queries.h"
-#include <QSqlQuery>
-#include <QSqlError>
+#include "../dao/sql_course_dao.h"
 #include <QDebug>
-#include <QDateTime>
 #include "../database/persistence.h"
+#include "searchindex.h"
+#include "../database/changebus.h"
 
 /**
  * Constructor for the CourseController class
+ * @param dao - Where courses are stored; the configured database if null
  */
-CourseController::CourseController() {}
+CourseController::CourseController(std::shared_ptr<CourseDAO> dao)
+    : m_dao(dao ? dao : std::make_shared<SqlCourseDAO>())
+{
+}
 
 /**
  * Adds a new course to the database
  * Logs the creation event after successful insertion
- * @param course - The Course object containing the details
+ * @param course - The Course object containing the details; receives the new ID
  * @return True if successful, otherwise false
  */
-bool CourseController::addCourse(const Course& course)
+bool CourseController::addCourse(Course& course)
 {
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-    query.prepare(Queries::INSERT_COURSE);
-    query.addBindValue(course.name());
-    query.addBindValue(course.description());
-    query.addBindValue(course.yearLevel());
-    query.addBindValue(course.creditHours());
-    query.addBindValue(course.semesterId());
-    query.addBindValue(course.departmentId());
-    query.addBindValue(course.maxGrade());
-    query.addBindValue(course.courseType());
-
-    if (!query.exec()) {
-        qDebug() << "addCourse failed:" << query.lastError().text();
-        return false;
-    }
-    Persistence::logChange("Course", "Create", query.lastInsertId().toInt(), course.name());
+    if (!m_dao->insert(course)) return false;
+    int newCourseId = course.id();
+    SearchIndex::instance().refreshCourse(newCourseId);
+    Persistence::logChange("Course", "Create", newCourseId, course.name());
+    ChangeBus::instance().publish("courses", newCourseId, ChangeEvent::Inserted);
     return true;
 }
 
@@ -48,24 +38,10 @@ bool CourseController::addCourse(const Course& course)
  */
 bool CourseController::updateCourse(const Course& course)
 {
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-    query.prepare(Queries::UPDATE_COURSE);
-    query.addBindValue(course.name());
-    query.addBindValue(course.description());
-    query.addBindValue(course.yearLevel());
-    query.addBindValue(course.creditHours());
-    query.addBindValue(course.semesterId());
-    query.addBindValue(course.departmentId());
-    query.addBindValue(course.maxGrade());
-    query.addBindValue(course.courseType());
-    query.addBindValue(course.id());
-
-    if (!query.exec()) {
-        qDebug() << "updateCourse failed:" << query.lastError().text();
-        return false;
-    }
+    if (!m_dao->update(course)) return false;
+    SearchIndex::instance().refreshCourse(course.id());
     Persistence::logChange("Course", "Edit", course.id(), course.name());
+    ChangeBus::instance().publish("courses", course.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -78,45 +54,13 @@ bool CourseController::updateCourse(const Course& course)
  */
 bool CourseController::deleteCourse(int id)
 {
-    QSqlDatabase& db = DBConnection::instance().database();
-    
-    // 1. Delete Schedules
-    QSqlQuery delSch(db);
-    delSch.prepare("DELETE FROM schedules WHERE course_id = ?");
-    delSch.addBindValue(id);
-    delSch.exec();
-    
-    // 2. Delete Sections (Groups)
-    QSqlQuery delSec(db);
-    delSec.prepare("DELETE FROM sections WHERE course_id = ?");
-    delSec.addBindValue(id);
-    delSec.exec();
-    
-    // 3. Delete Enrollments (and logs via DB constraint or manual if needed, assuming simple structure for now)
-    // Note: Enrollments might have foreign keys in attendance_logs. 
-    // Ideally we should delete logs too, but let's try deleting enrollments directly.
-    // If constraints fail, we'd need to delete from attendance_logs first.
-    // Let's be safe:
-    QSqlQuery delLogs(db);
-    delLogs.prepare("DELETE FROM attendance_logs WHERE enrollment_id IN (SELECT id FROM enrollments WHERE course_id = ?)");
-    delLogs.addBindValue(id);
-    delLogs.exec();
-    
-    QSqlQuery delEnr(db);
-    delEnr.prepare("DELETE FROM enrollments WHERE course_id = ?");
-    delEnr.addBindValue(id);
-    delEnr.exec();
-
-    // 4. Finally Delete Course
-    QSqlQuery query(db);
-    query.prepare(Queries::DELETE_COURSE);
-    query.addBindValue(id);
-
-    if (!query.exec()) {
-        qDebug() << "deleteCourse failed:" << query.lastError().text();
-        return false;
-    }
+    if (!m_dao->remove(id)) return false;
+    SearchIndex::instance().remove(SearchIndex::Course, id);
     Persistence::logChange("Course", "Delete", id, "ID removed from system");
+    ChangeBus::instance().publish("courses", id, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("schedules", 0, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("sections", 0, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("enrollments", 0, ChangeEvent::Deleted);
     return true;
 }
 
@@ -127,62 +71,22 @@ bool CourseController::deleteCourse(int id)
  */
 QList<Course> CourseController::getAllCourses()
 {
-    QList<Course> list;
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-
-    if (!query.exec(Queries::SELECT_ALL_COURSES)) {
-        qDebug() << "getAllCourses failed:" << query.lastError().text();
-        // Fallback: try simple query
-        if (!query.exec("SELECT * FROM courses ORDER BY name")) {
-            return list;
-        }
-    }
-
-    while (query.next()) {
-        int id = query.value("id").toInt();
-        QString name = query.value("name").toString();
-        QString description = query.value("description").toString();
-        int yearLevel = query.value("year_level").toInt();
-        int creditHours = query.value("credit_hours").toInt();
-        int semesterId = query.value("semester_id").toInt();
-        int maxGrade = query.value("max_grade").toInt();
-        QString type = query.value("course_type").toString();
-
-        Course c(id, name, description, yearLevel, creditHours, semesterId);
-        c.setMaxGrade(maxGrade);
-        c.setCourseType(type);
-
-        QString createdStr = query.value("created_at").toString();
-        if (!createdStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(createdStr, Qt::ISODate);
-            if (dt.isValid()) c.setCreatedAt(dt);
-        }
-
-        QString updatedStr = query.value("updated_at").toString();
-        if (!updatedStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(updatedStr, Qt::ISODate);
-            if (dt.isValid()) c.setUpdatedAt(dt);
-        }
-
-        QString semesterYear = query.value("semester_year").toString();
-        QString semesterNumber = query.value("semester_number").toString();
-        
-        c.setSemesterYear(semesterYear);
-        c.setSemesterNumber(semesterNumber.toInt());
-        
-        if (!semesterYear.isEmpty() || !semesterNumber.isEmpty()) {
-            QString semName = QString("%1 - Sem %2").arg(semesterYear).arg(semesterNumber);
-            c.setSemesterName(semName);
-        }
-
-        c.setAssignedProfessor(query.value("assigned_professors").toString());
-        c.setDepartmentId(query.value("department_id").toInt());
-        c.setDepartmentName(query.value("department_name").toString());
+    return m_dao->getAll();
+}
 
-        list.append(c);
-    }
-    return list;
+/**
+ * Streams every course to a callback one at a time, without
+ * materializing the whole list
+ * @param filter - Courses it rejects are skipped; empty to visit all
+ * @param visit - Called once per course; return false to stop early
+ * @return False if the store could not be read
+ */
+bool CourseController::forEachCourse(const Filter& filter, const CourseDAO::Visitor& visit)
+{
+    if (!filter) return m_dao->forEach(visit);
+    return m_dao->forEach([&](const Course& c) {
+        return !filter(c) || visit(c);
+    });
 }
 
 /**
@@ -192,46 +96,7 @@ QList<Course> CourseController::getAllCourses()
  */
 QList<Course> CourseController::getCoursesBySemester(int semesterId)
 {
-    QList<Course> list;
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-    query.prepare(Queries::SELECT_COURSES_BY_SEMESTER);
-    query.addBindValue(semesterId);
-
-    if (!query.exec()) {
-        qDebug() << "getCoursesBySemester failed:" << query.lastError().text();
-        return list;
-    }
-
-    while (query.next()) {
-        int id = query.value("id").toInt();
-        QString name = query.value("name").toString();
-        QString description = query.value("description").toString();
-        int yearLevel = query.value("year_level").toInt();
-        int creditHours = query.value("credit_hours").toInt();
-        int semId = query.value("semester_id").toInt();
-        int maxGrade = query.value("max_grade").toInt();
-        QString type = query.value("course_type").toString();
-
-        Course c(id, name, description, yearLevel, creditHours, semId);
-        c.setMaxGrade(maxGrade);
-        c.setCourseType(type);
-
-        QString createdStr = query.value("created_at").toString();
-        if (!createdStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(createdStr, Qt::ISODate);
-            if (dt.isValid()) c.setCreatedAt(dt);
-        }
-
-        QString updatedStr = query.value("updated_at").toString();
-        if (!updatedStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(updatedStr, Qt::ISODate);
-            if (dt.isValid()) c.setUpdatedAt(dt);
-        }
-
-        list.append(c);
-    }
-    return list;
+    return m_dao->getBySemester(semesterId);
 }
 
 /**
@@ -241,50 +106,7 @@ QList<Course> CourseController::getCoursesBySemester(int semesterId)
  */
 Course CourseController::getCourseById(int id)
 {
-    Course c;
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-    query.prepare(Queries::SELECT_COURSE_BY_ID);
-    query.addBindValue(id);
-
-    if (!query.exec()) {
-        qDebug() << "getCourseById failed:" << query.lastError().text();
-        return c;
-    }
-
-    if (query.next()) {
-        c.setId(query.value("id").toInt());
-        c.setName(query.value("name").toString());
-        c.setDescription(query.value("description").toString());
-        c.setYearLevel(query.value("year_level").toInt());
-        c.setCreditHours(query.value("credit_hours").toInt());
-        c.setSemesterId(query.value("semester_id").toInt());
-        c.setMaxGrade(query.value("max_grade").toInt());
-        c.setCourseType(query.value("course_type").toString());
-
-        QString createdStr = query.value("created_at").toString();
-        if (!createdStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(createdStr, Qt::ISODate);
-            if (dt.isValid()) c.setCreatedAt(dt);
-        }
-
-        QString updatedStr = query.value("updated_at").toString();
-        if (!updatedStr.isEmpty()) {
-            QDateTime dt = QDateTime::fromString(updatedStr, Qt::ISODate);
-            if (dt.isValid()) c.setUpdatedAt(dt);
-        }
-
-        QString semesterYear = query.value("semester_year").toString();
-        QString semesterNumber = query.value("semester_number").toString();
-        c.setSemesterYear(semesterYear);
-        c.setSemesterNumber(semesterNumber.toInt());
-        
-        if (!semesterYear.isEmpty() || !semesterNumber.isEmpty()) {
-            QString semName = QString("%1 - Sem %2").arg(semesterYear).arg(semesterNumber);
-            c.setSemesterName(semName);
-        }
-    }
-    return c;
+    return m_dao->getById(id);
 }
 
 /**
@@ -294,42 +116,5 @@ Course CourseController::getCourseById(int id)
  */
 QList<Course> CourseController::getCoursesByProfessor(int professorId)
 {
-    QList<Course> list;
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
-    query.prepare(Queries::SELECT_COURSES_BY_PROFESSOR);
-    query.addBindValue(professorId);
-
-    if (!query.exec()) {
-        qDebug() << "getCoursesByProfessor failed:" << query.lastError().text();
-        return list;
-    }
-
-    while (query.next()) {
-        int id = query.value("id").toInt();
-        QString name = query.value("name").toString();
-        QString description = query.value("description").toString();
-        int yearLevel = query.value("year_level").toInt();
-        int creditHours = query.value("credit_hours").toInt();
-        int semId = query.value("semester_id").toInt();
-        int maxGrade = query.value("max_grade").toInt();
-        QString type = query.value("course_type").toString();
-        
-        Course c(id, name, description, yearLevel, creditHours, semId);
-        c.setMaxGrade(maxGrade);
-        c.setCourseType(type);
-
-        QString semesterYear = query.value("semester_year").toString();
-        QString semesterNumber = query.value("semester_number").toString();
-        c.setSemesterYear(semesterYear);
-        c.setSemesterNumber(semesterNumber.toInt());
-        
-        if (!semesterYear.isEmpty() || !semesterNumber.isEmpty()) {
-            QString semName = QString("%1 - Sem %2").arg(semesterYear).arg(semesterNumber);
-            c.setSemesterName(semName);
-        }
-
-        list.append(c);
-    }
-    return list;
+    return m_dao->getByProfessor(professorId);
 }
@@ -2,21 +2,30 @@
 #define COURSECONTROLLER_H
 
 #include "../models/course.h"
+#include "../dao/course_dao.h"
 #include <QList>
+#include <functional>
+#include <memory>
 
 class CourseController
 {
 public:
-    CourseController();
+    typedef std::function<bool(const Course&)> Filter;
 
-    bool addCourse(const Course& course);
+    explicit CourseController(std::shared_ptr<CourseDAO> dao = nullptr);
+
+    bool addCourse(Course& course);
     bool updateCourse(const Course& course);
     bool deleteCourse(int id);
 
     QList<Course> getAllCourses();
+    bool forEachCourse(const Filter& filter, const CourseDAO::Visitor& visit);
     QList<Course> getCoursesBySemester(int semesterId);
     QList<Course> getCoursesByProfessor(int professorId);
     Course getCourseById(int id);
+
+private:
+    std::shared_ptr<CourseDAO> m_dao;
 };
 
 #endif // COURSECONTROLLER_H
@@ -0,0 +1,779 @@
+#include "datagenerator.h"
+#include "gradestatistics.h"
+#include "ledgercontroller.h"
+#include "../dao/sql_user_dao.h"
+#include "../models/domain_types.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/sqldialect.h"
+#include "../database/tableversions.h"
+#include <QDate>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QStringConverter>
+#include <QTextStream>
+#include <QThread>
+#include <QThreadPool>
+#include <QVector>
+#include <QSqlError>
+#include <QDebug>
+
+namespace {
+
+// Placeholders allowed per statement: SQLite's default SQLITE_MAX_VARIABLE_NUMBER
+// and the 16-bit parameter count of MySQL's prepared statement protocol
+const int SqliteMaxVariables = 999;
+const int MysqlMaxPlaceholders = 65535;
+const int StatementsPerTransaction = 20;
+const int AttendancePercent = 85;
+const int DeletedPercent = 2;
+const int PaidPercent = 90;
+const QString GeneratedPassword = "password";
+const QString CsvTimestamp = "2025-09-01T00:00:00";
+
+// Per-table salts so every table draws from its own stream
+enum Salt {
+    CollegeSalt = 1,
+    DepartmentSalt,
+    CourseSalt,
+    SectionSalt,
+    RoomSalt,
+    UserSalt,
+    StudentSalt,
+    ProfessorSalt,
+    ScheduleSalt,
+    EnrollmentSalt,
+    GradeSalt,
+    AttendanceSalt,
+    PaymentSalt
+};
+
+const QStringList Subjects = {
+    "Computer Science", "Information Systems", "Software Engineering", "Mathematics",
+    "Physics", "Chemistry", "Biology", "Civil Engineering", "Mechanical Engineering",
+    "Electrical Engineering", "Architecture", "Accounting", "Finance", "Marketing",
+    "Law", "English", "History", "Medicine", "Pharmacy", "Nursing"
+};
+const QStringList Faculties = {
+    "Engineering", "Computers and Information", "Science", "Commerce",
+    "Law", "Arts", "Medicine", "Pharmacy"
+};
+const QStringList CourseTopics = {
+    "Introduction to", "Principles of", "Applied", "Advanced", "Topics in", "Seminar in"
+};
+const QStringList LevelNames = {
+    "First Year", "Second Year", "Third Year", "Fourth Year", "Fifth Year"
+};
+const QStringList FirstNames = {
+    "Ahmed", "Mohamed", "Omar", "Youssef", "Mariam", "Nour", "Salma", "Hana",
+    "Karim", "Laila", "Mostafa", "Farida", "Ali", "Yasmin", "Khaled", "Aya"
+};
+const QStringList LastNames = {
+    "Hassan", "Ibrahim", "Mahmoud", "Saleh", "Fathy", "Adel", "Nabil", "Samir",
+    "Mansour", "Kamal", "Fouad", "Rashad"
+};
+const QStringList Titles = { "Dr.", "Prof.", "Assoc. Prof.", "Lecturer" };
+const QStringList Days = { "Sunday", "Monday", "Tuesday", "Wednesday", "Thursday" };
+const QStringList PaymentMethods = { "Credit Card", "Bank Transfer", "Cash at Office" };
+
+/**
+ * SplitMix64 stream seeded from (seed, salt, row index)
+ * Each row gets its own stream, so rows can be produced in any order and
+ * on any thread without changing their values
+ */
+class RowRandom
+{
+public:
+    RowRandom(quint32 seed, Salt salt, qint64 index)
+        : m_state(mix(quint64(seed) << 32 | quint64(salt)) ^ mix(quint64(index) + 0x632BE59BD9B4E019ULL)) {}
+
+    quint64 next()
+    {
+        m_state += 0x9E3779B97F4A7C15ULL;
+        return mix(m_state);
+    }
+
+    /**
+     * @param bound - Exclusive upper bound, greater than zero
+     * @return A value in [0, bound)
+     */
+    int bounded(int bound) { return int(next() % quint64(bound)); }
+
+private:
+    static quint64 mix(quint64 z)
+    {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    quint64 m_state;
+};
+
+/**
+ * @param names - The base names
+ * @param i - Row index
+ * @return names[i], suffixed with a round number once the list wraps
+ */
+QString cycledName(const QStringList& names, qint64 i)
+{
+    const QString name = names.at(int(i % names.size()));
+    return i < names.size() ? name : QString("%1 %2").arg(name).arg(i / names.size() + 1);
+}
+
+/**
+ * @param db - The open connection
+ * @param table - A table with an integer id column
+ * @param id - Receives the id after the largest one in use
+ * @return True if the table could be read
+ */
+bool nextId(QSqlDatabase& db, const QString& table, int& id)
+{
+    DBQuery query(db);
+    if (!query.exec("SELECT COALESCE(MAX(id), 0) FROM " + table) || !query.next()) {
+        qDebug() << "DataGenerator could not read" << table << ":" << query.lastError().text();
+        return false;
+    }
+    id = query.value(0).toInt() + 1;
+    return true;
+}
+
+/**
+ * @param values - One generated row
+ * @param columns - Number of leading values to write
+ * @return The values as an unquoted CSV line, the format of the FileDB DAOs
+ */
+QString csvFields(const QVariantList& values, int columns)
+{
+    QStringList fields;
+    for (int i = 0; i < columns; ++i) fields.append(values.at(i).toString());
+    return fields.join(",");
+}
+
+} // namespace
+
+/**
+ * Constructor for the DataGenerator class, with the default Scale
+ */
+DataGenerator::DataGenerator() : DataGenerator(Scale()) {}
+
+/**
+ * Constructor for the DataGenerator class
+ * Generated accounts all use the password "password"
+ * @param scale - Size and seed of the data set
+ */
+DataGenerator::DataGenerator(const Scale& scale)
+    : m_scale(scale),
+      m_passwordHash(SqlUserDAO::hashPassword(GeneratedPassword)),
+      m_failed(false)
+{
+    m_scale.colleges = qMax(1, m_scale.colleges);
+    m_scale.departmentsPerCollege = qMax(1, m_scale.departmentsPerCollege);
+    m_scale.levels = qMax(1, m_scale.levels);
+    m_scale.semesters = qMax(1, m_scale.semesters);
+    m_scale.courses = qMax(1, m_scale.courses);
+    m_scale.sectionsPerCourse = qMax(1, m_scale.sectionsPerCourse);
+    m_scale.rooms = qMax(1, m_scale.rooms);
+    m_scale.students = qMax(0, m_scale.students);
+    m_scale.attendanceDays = qMax(0, m_scale.attendanceDays);
+    m_scale.paymentsPerStudent = qMax(0, m_scale.paymentsPerStudent);
+    m_scale.batchSize = qMax(1, m_scale.batchSize);
+    m_pool.setMaxThreadCount(m_scale.threads > 0 ? m_scale.threads : QThread::idealThreadCount());
+}
+
+/**
+ * Sets the callback invoked after every committed batch
+ * It runs on the worker threads, serialized by the generator
+ * @param progress - The callback
+ */
+void DataGenerator::setProgressCallback(const ProgressCallback& progress)
+{
+    m_progress = progress;
+}
+
+/**
+ * Writes the whole data set into the configured database
+ * Tables are filled parent first; the rows of each table are split across
+ * worker threads, each with its own connection and transactions. SQLite
+ * allows one writer at a time, so it is always filled from one thread.
+ * Student balances are rebuilt from the generated payments at the end
+ * @return True if every row was inserted
+ */
+bool DataGenerator::generateToDatabase()
+{
+    m_failed = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_rowCounts.clear();
+        m_lastError.clear();
+    }
+    if (!readIds()) return false;
+
+    for (const Table& table : tables()) {
+        if (table.rows <= 0) continue;
+        if (!insertTable(table)) return false;
+        // The semester table is tracked under the name SemesterController publishes
+        TableVersions::bump(table.name == "semester" ? QString("semesters") : table.name);
+    }
+
+    if (m_scale.paymentsPerStudent > 0 && m_scale.students > 0 && !LedgerController().rebuildAllBalances()) {
+        fail("Could not rebuild the student balances");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the data set as FileDB CSV files (users, students_data, courses,
+ * professors), replacing any existing ones in the directory
+ * The CSV backend has no other tables, so only those four are produced.
+ * users.csv starts with the CLI's default admin account (admin/admin123)
+ * @param directory - Destination directory, created if missing
+ * @return True if every file was written
+ */
+bool DataGenerator::generateToCsv(const QString& directory)
+{
+    m_failed = false;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_rowCounts.clear();
+        m_lastError.clear();
+    }
+    m_ids = Ids();
+    m_ids.user = 2;
+
+    if (!QDir().mkpath(directory)) {
+        fail("Could not create " + directory);
+        return false;
+    }
+    const QDir dir(directory);
+    const QString timestamps = "," + CsvTimestamp + "," + CsvTimestamp;
+    const int professors = professorCount();
+
+    const QString admin = "1,Admin User,admin," + SqlUserDAO::hashPassword("admin123") + ",admin" + timestamps;
+
+    return writeCsv(dir.filePath("users.csv"), "id,full_name,username,password,role,created_at,updated_at\n" + admin,
+                    qint64(professors) + m_scale.students,
+                    [&](qint64 i) { return csvFields(userRow(i), 5) + timestamps; })
+        && writeCsv(dir.filePath("students_data.csv"),
+                    "id,user_id,student_number,id_number,dob,department,department_id,academic_level_id,"
+                    "section_id,college_id,tuition_fees,seat_number,status,created_at,updated_at",
+                    m_scale.students,
+                    [&](qint64 i) { return csvFields(studentRow(i), 13) + timestamps; })
+        && writeCsv(dir.filePath("courses.csv"),
+                    "id,name,description,year_level,credit_hours,semester_id,department_id,max_grade,"
+                    "course_type,created_at,updated_at",
+                    m_scale.courses,
+                    [&](qint64 i) { return csvFields(courseRow(i), 9) + timestamps; })
+        && writeCsv(dir.filePath("professors.csv"), "id,user_id,specialization,title,personal_info,id_number,full_name",
+                    professors,
+                    [&](qint64 i) { return csvFields(professorRow(i), 6) + "," + userRow(i).at(1).toString(); });
+}
+
+/**
+ * @return Rows written per table by the last run
+ */
+QMap<QString, qint64> DataGenerator::rowCounts() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_rowCounts;
+}
+
+/**
+ * @return The first error of the last run, empty if it succeeded
+ */
+QString DataGenerator::lastError() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_lastError;
+}
+
+/**
+ * Describes every generated table, in insertion (parent first) order
+ * @return The tables with their columns, row counts and row producers
+ */
+QList<DataGenerator::Table> DataGenerator::tables() const
+{
+    const qint64 students = m_scale.students;
+    const qint64 enrollments = students * coursesPerStudent();
+
+    return {
+        { "colleges", { "id", "name", "code", "tuition_fees" },
+          m_scale.colleges, [this](qint64 i) { return collegeRow(i); } },
+        { "departments", { "id", "name", "code", "college_id" },
+          departmentCount(), [this](qint64 i) { return departmentRow(i); } },
+        { "academic_levels", { "id", "name", "level_number" },
+          m_scale.levels, [this](qint64 i) { return levelRow(i); } },
+        { "semester", { "id", "year", "semester" },
+          m_scale.semesters, [this](qint64 i) { return semesterRow(i); } },
+        { "courses", { "id", "name", "description", "year_level", "credit_hours", "semester_id",
+                       "department_id", "max_grade", "course_type", "course_code" },
+          m_scale.courses, [this](qint64 i) { return courseRow(i); } },
+        { "sections", { "id", "name", "course_id", "capacity", "semester_id", "academic_level_id" },
+          qint64(m_scale.courses) * m_scale.sectionsPerCourse, [this](qint64 i) { return sectionRow(i); } },
+        { "rooms", { "id", "name", "code", "type", "capacity" },
+          m_scale.rooms, [this](qint64 i) { return roomRow(i); } },
+        { "users", { "id", "full_name", "username", "password", "role" },
+          professorCount() + students, [this](qint64 i) { return userRow(i); } },
+        { "students_data", { "id", "user_id", "student_number", "id_number", "dob", "department", "department_id",
+                             "academic_level_id", "section_id", "college_id", "tuition_fees", "seat_number", "status" },
+          students, [this](qint64 i) { return studentRow(i); } },
+        { "professors", { "id", "user_id", "specialization", "title", "personal_info", "id_number" },
+          professorCount(), [this](qint64 i) { return professorRow(i); } },
+        { "schedules", { "id", "course_id", "room_id", "professor_id", "day_of_week", "start_time", "end_time" },
+          qint64(m_scale.courses) * 2, [this](qint64 i) { return scheduleRow(i); } },
+        { "enrollments", { "id", "student_id", "course_id", "section_id", "status", "attendance_count",
+                           "absence_count", "assignment_1_grade", "assignment_2_grade", "coursework_grade",
+                           "final_exam_grade", "experience_grade", "total_grade", "letter_grade" },
+          enrollments, [this](qint64 i) { return enrollmentRow(i); } },
+        { "attendance_logs", { "id", "enrollment_id", "date", "status", "notes" },
+          enrollments * m_scale.attendanceDays, [this](qint64 i) { return attendanceRow(i); } },
+        { "payments", { "id", "student_id", "amount", "date", "year", "method", "status", "notes" },
+          students * m_scale.paymentsPerStudent, [this](qint64 i) { return paymentRow(i); } }
+    };
+}
+
+/**
+ * Reads the first free id of every generated table
+ * @return True if every table could be read
+ */
+bool DataGenerator::readIds()
+{
+    QSqlDatabase& db = DBConnection::instance().database();
+    const bool ok = nextId(db, "colleges", m_ids.college)
+                 && nextId(db, "departments", m_ids.department)
+                 && nextId(db, "academic_levels", m_ids.level)
+                 && nextId(db, "semester", m_ids.semester)
+                 && nextId(db, "courses", m_ids.course)
+                 && nextId(db, "sections", m_ids.section)
+                 && nextId(db, "rooms", m_ids.room)
+                 && nextId(db, "users", m_ids.user)
+                 && nextId(db, "students_data", m_ids.student)
+                 && nextId(db, "professors", m_ids.professor)
+                 && nextId(db, "schedules", m_ids.schedule)
+                 && nextId(db, "enrollments", m_ids.enrollment)
+                 && nextId(db, "attendance_logs", m_ids.attendance)
+                 && nextId(db, "payments", m_ids.payment);
+    if (!ok) fail("Could not read the existing ids");
+    return ok;
+}
+
+/**
+ * @param rows - Rows to produce
+ * @return Worker threads worth using: at most one per batch
+ */
+int DataGenerator::workerCount(qint64 rows) const
+{
+    const int threads = m_scale.threads > 0 ? m_scale.threads : QThread::idealThreadCount();
+    const qint64 batches = (rows + m_scale.batchSize - 1) / m_scale.batchSize;
+    return int(qBound<qint64>(1, batches, qMax(1, threads)));
+}
+
+/**
+ * Inserts every row of a table, splitting the rows across worker threads
+ * @param table - The table
+ * @return True if every row was inserted
+ */
+bool DataGenerator::insertTable(const Table& table)
+{
+    const int workers = SqlDialect::instance().isSqlite() ? 1 : workerCount(table.rows);
+    if (workers == 1) return insertRange(table, 0, table.rows);
+
+    const qint64 perWorker = (table.rows + workers - 1) / workers;
+    for (qint64 from = 0; from < table.rows; from += perWorker) {
+        const qint64 to = qMin(table.rows, from + perWorker);
+        m_pool.start([this, &table, from, to]() { insertRange(table, from, to); });
+    }
+    m_pool.waitForDone();
+    return !m_failed;
+}
+
+/**
+ * Inserts rows [from, to) of a table with multi-row INSERT statements,
+ * committing every StatementsPerTransaction statements
+ * Uses the calling thread's connection
+ * @param table - The table
+ * @param from - First row index
+ * @param to - Row index after the last
+ * @return True if every row was inserted
+ */
+bool DataGenerator::insertRange(const Table& table, qint64 from, qint64 to)
+{
+    DBConnection& connection = DBConnection::instance();
+    QSqlDatabase& db = connection.database();
+
+    const int maxPlaceholders = SqlDialect::instance().isSqlite() ? SqliteMaxVariables : MysqlMaxPlaceholders;
+    const int perStatement = qMin(m_scale.batchSize, maxPlaceholders / int(table.columns.size()));
+
+    QStringList placeholders;
+    for (int i = 0; i < table.columns.size(); ++i) placeholders.append("?");
+    const QString tuple = "(" + placeholders.join(", ") + ")";
+    const QString head = "INSERT INTO " + table.name + " (" + table.columns.join(", ") + ") VALUES ";
+
+    qint64 next = from;
+    while (next < to && !m_failed) {
+        if (!connection.beginTransaction(db)) {
+            fail("Could not start a transaction on " + table.name);
+            return false;
+        }
+        const qint64 batchStart = next;
+        for (int s = 0; s < StatementsPerTransaction && next < to; ++s) {
+            const int count = int(qMin<qint64>(perStatement, to - next));
+            QStringList tuples;
+            for (int i = 0; i < count; ++i) tuples.append(tuple);
+
+            DBQuery query(db);
+            query.prepare(head + tuples.join(", "));
+            for (qint64 i = next; i < next + count; ++i) {
+                for (const QVariant& value : table.row(i)) query.addBindValue(value);
+            }
+            if (!query.exec()) {
+                connection.rollback(db);
+                fail(QString("Insert into %1 failed: %2").arg(table.name, query.lastError().text()));
+                return false;
+            }
+            next += count;
+        }
+        if (!connection.commit(db)) {
+            fail("Could not commit rows of " + table.name);
+            return false;
+        }
+        recordRows(table.name, next - batchStart, table.rows);
+    }
+    return !m_failed;
+}
+
+/**
+ * Writes one CSV file; chunks of lines are formatted on worker threads
+ * and written in row order
+ * @param path - Destination file, truncated
+ * @param header - The header line
+ * @param rows - Number of data lines
+ * @param line - Produces the line of a row index
+ * @return True if the file was written
+ */
+bool DataGenerator::writeCsv(const QString& path, const QString& header, qint64 rows,
+                             const std::function<QString(qint64)>& line)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) {
+        fail("Could not write " + path);
+        return false;
+    }
+    QTextStream out(&file);
+    out.setEncoding(QStringConverter::Utf8);
+    out << header << '\n';
+
+    const QString table = QFileInfo(path).baseName();
+    const int workers = workerCount(rows);
+    const qint64 chunkRows = m_scale.batchSize;
+    QVector<QString> chunks(workers);
+
+    for (qint64 blockStart = 0; blockStart < rows; blockStart += chunkRows * workers) {
+        for (int w = 0; w < workers; ++w) {
+            const qint64 from = qMin(rows, blockStart + w * chunkRows);
+            const qint64 to = qMin(rows, from + chunkRows);
+            QString* chunk = &chunks[w];
+            m_pool.start([&line, chunk, from, to]() {
+                chunk->clear();
+                for (qint64 i = from; i < to; ++i) {
+                    chunk->append(line(i));
+                    chunk->append('\n');
+                }
+            });
+        }
+        m_pool.waitForDone();
+        for (const QString& chunk : chunks) out << chunk;
+        recordRows(table, qMin(rows, blockStart + chunkRows * workers) - blockStart, rows);
+    }
+
+    out.flush();
+    if (out.status() != QTextStream::Ok) {
+        fail("Could not write " + path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Adds written rows to the counts and reports progress
+ * @param table - The table
+ * @param rows - Rows just written
+ * @param planned - Rows the table will have in total
+ */
+void DataGenerator::recordRows(const QString& table, qint64 rows, qint64 planned)
+{
+    QMutexLocker locker(&m_mutex);
+    const qint64 written = m_rowCounts.value(table) + rows;
+    m_rowCounts[table] = written;
+    if (m_progress) m_progress(table, written, planned);
+}
+
+/**
+ * Records the first error and stops the other workers
+ * @param error - Description of the failure
+ */
+void DataGenerator::fail(const QString& error)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_failed.exchange(true)) m_lastError = error;
+    qWarning() << "DataGenerator:" << error;
+}
+
+/**
+ * @return The number of professors, one per 40 students unless set
+ */
+int DataGenerator::professorCount() const
+{
+    return m_scale.professors > 0 ? m_scale.professors : m_scale.students / 40 + 1;
+}
+
+/**
+ * @return Enrollments per student, never more than there are courses
+ */
+int DataGenerator::coursesPerStudent() const
+{
+    return qBound(0, m_scale.coursesPerStudent, m_scale.courses);
+}
+
+/**
+ * @return The number of departments across all colleges
+ */
+int DataGenerator::departmentCount() const
+{
+    return m_scale.colleges * m_scale.departmentsPerCollege;
+}
+
+/**
+ * @param departmentIndex - Row index of a department
+ * @return Row index of its college
+ */
+int DataGenerator::collegeOfDepartment(int departmentIndex) const
+{
+    return departmentIndex / m_scale.departmentsPerCollege;
+}
+
+/**
+ * Each student takes a run of consecutive courses from a random start, so
+ * no course appears twice in one student's enrollments
+ * @param enrollmentIndex - Row index of an enrollment
+ * @return Row index of its course
+ */
+int DataGenerator::courseOfEnrollment(qint64 enrollmentIndex) const
+{
+    const int perStudent = coursesPerStudent();
+    RowRandom rng(m_scale.seed, EnrollmentSalt, enrollmentIndex / perStudent);
+    return int((rng.bounded(m_scale.courses) + enrollmentIndex % perStudent) % m_scale.courses);
+}
+
+/**
+ * Shared by attendance_logs and the enrollment counters, which stay consistent
+ * @param attendanceIndex - Row index of an attendance log
+ * @return True if the student attended that day
+ */
+bool DataGenerator::isPresent(qint64 attendanceIndex) const
+{
+    return RowRandom(m_scale.seed, AttendanceSalt, attendanceIndex).bounded(100) < AttendancePercent;
+}
+
+/**
+ * @param collegeIndex - Row index of a college
+ * @return Its yearly tuition fees
+ */
+int DataGenerator::collegeFees(int collegeIndex) const
+{
+    return 8000 + RowRandom(m_scale.seed, CollegeSalt, collegeIndex).bounded(9) * 1000;
+}
+
+/*
+ * Row producers: each returns the values of row i in the column order
+ * listed by tables(), derived only from the seed and i
+ */
+
+QVariantList DataGenerator::collegeRow(qint64 i) const
+{
+    const int id = m_ids.college + int(i);
+    return { id, "Faculty of " + cycledName(Faculties, i), QString("GC%1").arg(id),
+             QString("%1.00").arg(collegeFees(int(i))) };
+}
+
+QVariantList DataGenerator::departmentRow(qint64 i) const
+{
+    const int id = m_ids.department + int(i);
+    return { id, cycledName(Subjects, i), QString("GD%1").arg(id), m_ids.college + collegeOfDepartment(int(i)) };
+}
+
+QVariantList DataGenerator::levelRow(qint64 i) const
+{
+    return { m_ids.level + int(i), cycledName(LevelNames, i), int(i) + 1 };
+}
+
+QVariantList DataGenerator::semesterRow(qint64 i) const
+{
+    const int year = 2025 - int(i / 2);
+    return { m_ids.semester + int(i), QString("%1-09-01").arg(year), int(i % 2) + 1 };
+}
+
+QVariantList DataGenerator::courseRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, CourseSalt, i);
+    const int id = m_ids.course + int(i);
+    const int department = rng.bounded(departmentCount());
+    const bool practical = i % 3 == 0;
+    return { id,
+             QString("%1 %2").arg(CourseTopics.at(rng.bounded(CourseTopics.size())), Subjects.at(department % Subjects.size())),
+             "Generated course",
+             m_ids.level + int(i % m_scale.levels),
+             2 + rng.bounded(3),
+             m_ids.semester + int(i % m_scale.semesters),
+             m_ids.department + department,
+             practical ? 150 : 100,
+             courseTypeName(practical ? CourseType::Practical : CourseType::Theoretical),
+             QString("GC%1").arg(id) };
+}
+
+QVariantList DataGenerator::sectionRow(qint64 i) const
+{
+    const qint64 course = i / m_scale.sectionsPerCourse;
+    return { m_ids.section + int(i),
+             QString("Section %1").arg(i % m_scale.sectionsPerCourse + 1),
+             m_ids.course + int(course),
+             40 + RowRandom(m_scale.seed, SectionSalt, i).bounded(41),
+             m_ids.semester + int(course % m_scale.semesters),
+             m_ids.level + int(course % m_scale.levels) };
+}
+
+QVariantList DataGenerator::roomRow(qint64 i) const
+{
+    const int id = m_ids.room + int(i);
+    const bool lab = i % 3 == 0;
+    return { id, QString("%1 %2").arg(lab ? "Lab" : "Hall").arg(i + 1), QString("GR%1").arg(id),
+             lab ? "Lab" : "Hall", 30 + RowRandom(m_scale.seed, RoomSalt, i).bounded(91) };
+}
+
+/**
+ * Professors' accounts come first, then the students'
+ */
+QVariantList DataGenerator::userRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, UserSalt, i);
+    const QString name = FirstNames.at(rng.bounded(FirstNames.size())) + " " + LastNames.at(rng.bounded(LastNames.size()));
+    const int professors = professorCount();
+    if (i < professors) {
+        return { m_ids.user + int(i), name, QString("GP%1").arg(m_ids.professor + int(i), 7, 10, QChar('0')),
+                 m_passwordHash, roleName(UserRole::Professor) };
+    }
+    return { m_ids.user + int(i), name, QString("G%1").arg(m_ids.student + int(i - professors), 8, 10, QChar('0')),
+             m_passwordHash, roleName(UserRole::Student) };
+}
+
+QVariantList DataGenerator::studentRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, StudentSalt, i);
+    const int id = m_ids.student + int(i);
+    const int department = rng.bounded(departmentCount());
+    const int college = collegeOfDepartment(department);
+    const int sections = m_scale.courses * m_scale.sectionsPerCourse;
+    return { id,
+             m_ids.user + professorCount() + int(i),
+             QString("G%1").arg(id, 8, 10, QChar('0')),
+             QString("3%1").arg(id, 13, 10, QChar('0')),
+             QDate(1998, 1, 1).addDays(rng.bounded(3650)).toString(Qt::ISODate),
+             cycledName(Subjects, department),
+             m_ids.department + department,
+             m_ids.level + rng.bounded(m_scale.levels),
+             m_ids.section + rng.bounded(sections),
+             m_ids.college + college,
+             QString("%1.00").arg(collegeFees(college)),
+             QString::number(i + 1),
+             studentStatusName(rng.bounded(100) < DeletedPercent ? StudentStatus::Deleted : StudentStatus::Active) };
+}
+
+QVariantList DataGenerator::professorRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, ProfessorSalt, i);
+    const int id = m_ids.professor + int(i);
+    return { id, m_ids.user + int(i), Subjects.at(rng.bounded(Subjects.size())),
+             Titles.at(rng.bounded(Titles.size())), "", QString("2%1").arg(id, 13, 10, QChar('0')) };
+}
+
+/**
+ * Two weekly meetings per course
+ */
+QVariantList DataGenerator::scheduleRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, ScheduleSalt, i);
+    const int slot = rng.bounded(5);
+    return { m_ids.schedule + int(i),
+             m_ids.course + int(i / 2),
+             m_ids.room + rng.bounded(m_scale.rooms),
+             m_ids.professor + rng.bounded(professorCount()),
+             Days.at(int((i / 2 + (i % 2) * 2) % Days.size())),
+             QString("%1:00:00").arg(8 + 2 * slot, 2, 10, QChar('0')),
+             QString("%1:30:00").arg(9 + 2 * slot, 2, 10, QChar('0')) };
+}
+
+QVariantList DataGenerator::enrollmentRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, GradeSalt, i);
+    const int course = courseOfEnrollment(i);
+    const bool practical = course % 3 == 0;
+    const int maxGrade = practical ? 150 : 100;
+
+    const int assignment1 = rng.bounded(11);
+    const int assignment2 = rng.bounded(11);
+    const int coursework = rng.bounded(21);
+    const int finalExam = rng.bounded(61);
+    const int experience = practical ? rng.bounded(51) : 0;
+    const int total = assignment1 + assignment2 + coursework + finalExam + experience;
+    const GradeStatistics::LetterGrade letter = GradeStatistics::letterForPercentage(total * 100.0 / maxGrade);
+
+    int attended = 0;
+    for (int day = 0; day < m_scale.attendanceDays; ++day) {
+        if (isPresent(i * m_scale.attendanceDays + day)) ++attended;
+    }
+
+    return { m_ids.enrollment + int(i),
+             m_ids.student + int(i / coursesPerStudent()),
+             m_ids.course + course,
+             m_ids.section + course * m_scale.sectionsPerCourse + rng.bounded(m_scale.sectionsPerCourse),
+             "active",
+             attended,
+             m_scale.attendanceDays - attended,
+             assignment1, assignment2, coursework, finalExam, experience, total,
+             gradeLetterName(GradeStatistics::gradeLetter(letter)) };
+}
+
+/**
+ * One log per enrollment and teaching week
+ */
+QVariantList DataGenerator::attendanceRow(qint64 i) const
+{
+    const qint64 enrollment = i / m_scale.attendanceDays;
+    const int week = int(i % m_scale.attendanceDays);
+    return { m_ids.attendance + int(i),
+             m_ids.enrollment + int(enrollment),
+             QDate(2025, 9, 7).addDays(7 * week + enrollment % 5).toString(Qt::ISODate),
+             attendanceStatusName(isPresent(i) ? AttendanceStatus::Present : AttendanceStatus::Absent),
+             "" };
+}
+
+/**
+ * Instalments of the student's tuition fees; a few are still pending
+ */
+QVariantList DataGenerator::paymentRow(qint64 i) const
+{
+    RowRandom rng(m_scale.seed, PaymentSalt, i);
+    const qint64 student = i / m_scale.paymentsPerStudent;
+    const int department = RowRandom(m_scale.seed, StudentSalt, student).bounded(departmentCount());
+    const double amount = double(collegeFees(collegeOfDepartment(department))) / m_scale.paymentsPerStudent;
+    return { m_ids.payment + int(i),
+             m_ids.student + int(student),
+             QString::number(amount, 'f', 2),
+             QDate(2025, 9, 1).addDays(rng.bounded(120)).toString(Qt::ISODate),
+             "2025",
+             PaymentMethods.at(rng.bounded(PaymentMethods.size())),
+             rng.bounded(100) < PaidPercent ? "Success" : "Pending",
+             "" };
+}
@@ -0,0 +1,136 @@
+#ifndef DATAGENERATOR_H
+#define DATAGENERATOR_H
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+#include <QThreadPool>
+#include <QVariant>
+#include <atomic>
+#include <functional>
+
+/**
+ * Seeded generator for synthetic university data sets
+ * Produces colleges, departments, levels, semesters, courses, sections,
+ * rooms, professors, students, schedules, enrollments, attendance logs and
+ * payments at a configurable scale, either into the configured database
+ * (batched multi-row INSERTs) or into FileDB CSV files.
+ *
+ * Every row is derived from (seed, table, row index) alone, so the same
+ * Scale always produces the same data regardless of the thread count.
+ * Database ids continue after the largest id already in each table, which
+ * lets a data set be generated on top of existing data.
+ */
+class DataGenerator
+{
+public:
+    struct Scale
+    {
+        int colleges = 5;
+        int departmentsPerCollege = 4;
+        int levels = 4;
+        int semesters = 2;
+        int courses = 60;
+        int sectionsPerCourse = 2;
+        int rooms = 30;
+        int professors = 0;          // 0 = one per 40 students
+        int students = 1000;
+        int coursesPerStudent = 5;   // capped at courses
+        int attendanceDays = 10;     // attendance_logs rows per enrollment
+        int paymentsPerStudent = 2;
+        quint32 seed = 42;
+        int threads = 0;             // 0 = QThread::idealThreadCount()
+        int batchSize = 500;         // rows per INSERT statement / CSV chunk
+    };
+
+    // Receives (table, rows written, rows planned); called from worker threads
+    typedef std::function<void(const QString&, qint64, qint64)> ProgressCallback;
+
+    DataGenerator();
+    explicit DataGenerator(const Scale& scale);
+
+    void setProgressCallback(const ProgressCallback& progress);
+
+    bool generateToDatabase();
+    bool generateToCsv(const QString& directory);
+
+    QMap<QString, qint64> rowCounts() const;
+    QString lastError() const;
+
+private:
+    // First id of every generated table
+    struct Ids
+    {
+        int college = 1;
+        int department = 1;
+        int level = 1;
+        int semester = 1;
+        int course = 1;
+        int section = 1;
+        int room = 1;
+        int user = 1;
+        int student = 1;
+        int professor = 1;
+        int schedule = 1;
+        int enrollment = 1;
+        int attendance = 1;
+        int payment = 1;
+    };
+
+    struct Table
+    {
+        QString name;
+        QStringList columns;
+        qint64 rows;
+        std::function<QVariantList(qint64)> row;
+    };
+
+    QList<Table> tables() const;
+    bool readIds();
+    int workerCount(qint64 rows) const;
+
+    bool insertTable(const Table& table);
+    bool insertRange(const Table& table, qint64 from, qint64 to);
+    bool writeCsv(const QString& path, const QString& header, qint64 rows,
+                  const std::function<QString(qint64)>& line);
+    void recordRows(const QString& table, qint64 rows, qint64 planned);
+    void fail(const QString& error);
+
+    int professorCount() const;
+    int coursesPerStudent() const;
+    int departmentCount() const;
+    int collegeOfDepartment(int departmentIndex) const;
+    int courseOfEnrollment(qint64 enrollmentIndex) const;
+    bool isPresent(qint64 attendanceIndex) const;
+    int collegeFees(int collegeIndex) const;
+
+    QVariantList collegeRow(qint64 i) const;
+    QVariantList departmentRow(qint64 i) const;
+    QVariantList levelRow(qint64 i) const;
+    QVariantList semesterRow(qint64 i) const;
+    QVariantList courseRow(qint64 i) const;
+    QVariantList sectionRow(qint64 i) const;
+    QVariantList roomRow(qint64 i) const;
+    QVariantList userRow(qint64 i) const;
+    QVariantList studentRow(qint64 i) const;
+    QVariantList professorRow(qint64 i) const;
+    QVariantList scheduleRow(qint64 i) const;
+    QVariantList enrollmentRow(qint64 i) const;
+    QVariantList attendanceRow(qint64 i) const;
+    QVariantList paymentRow(qint64 i) const;
+
+    Scale m_scale;
+    Ids m_ids;
+    ProgressCallback m_progress;
+    QString m_passwordHash;
+
+    mutable QMutex m_mutex;
+    QMap<QString, qint64> m_rowCounts;
+    QString m_lastError;
+    std::atomic<bool> m_failed;
+    QThreadPool m_pool; // shared by every table, so worker connections are reused
+};
+
+#endif // DATAGENERATOR_H
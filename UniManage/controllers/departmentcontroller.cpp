@@ -1,6 +1,8 @@
 #include "departmentcontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -17,12 +19,14 @@ DepartmentController::DepartmentController() {}
  */
 bool DepartmentController::addDepartment(const Department& dept)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_DEPARTMENT);
     query.addBindValue(dept.name());
     query.addBindValue(dept.collegeId());
     query.addBindValue(dept.code());
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("departments", query.lastInsertId().toInt(), ChangeEvent::Inserted);
+    return true;
 }
 
 /**
@@ -32,13 +36,15 @@ bool DepartmentController::addDepartment(const Department& dept)
  */
 bool DepartmentController::updateDepartment(const Department& dept)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_DEPARTMENT);
     query.addBindValue(dept.name());
     query.addBindValue(dept.collegeId());
     query.addBindValue(dept.code());
     query.addBindValue(dept.id());
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("departments", dept.id(), ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -48,10 +54,12 @@ bool DepartmentController::updateDepartment(const Department& dept)
  */
 bool DepartmentController::deleteDepartment(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_DEPARTMENT);
     query.addBindValue(id);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("departments", id, ChangeEvent::Deleted);
+    return true;
 }
 
 /**
@@ -62,7 +70,7 @@ bool DepartmentController::deleteDepartment(int id)
 QList<Department> DepartmentController::getAllDepartments()
 {
     QList<Department> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (query.exec(Queries::SELECT_ALL_DEPARTMENTS)) {
         while (query.next()) {
             Department d(query.value("id").toInt(),
@@ -83,7 +91,7 @@ QList<Department> DepartmentController::getAllDepartments()
  */
 Department DepartmentController::getDepartmentById(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_DEPARTMENT_BY_ID);
     query.addBindValue(id);
     if (query.exec() && query.next()) {
@@ -103,7 +111,7 @@ Department DepartmentController::getDepartmentById(int id)
 QList<Department> DepartmentController::getDepartmentsByCollege(int collegeId)
 {
     QList<Department> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_DEPARTMENTS_BY_COLLEGE);
     query.addBindValue(collegeId);
     if (query.exec()) {
@@ -1,10 +1,16 @@
 #include "enrollmentcontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "gradestatistics.h"
+#include "sessioncalendar.h"
+#include "../database/changebus.h"
+#include "../database/tableversions.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include <QDateTime>
+#include <QSet>
 
 /**
  * Constructor for the EnrollmentController class
@@ -18,7 +24,7 @@ EnrollmentController::EnrollmentController() {}
  */
 bool EnrollmentController::addEnrollment(const Enrollment& e)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_ENROLLMENT);
     query.addBindValue(e.studentId());
     query.addBindValue(e.courseId());
@@ -31,12 +37,13 @@ bool EnrollmentController::addEnrollment(const Enrollment& e)
     query.addBindValue(e.finalExamGrade());
     query.addBindValue(e.experienceGrade());
     query.addBindValue(e.totalGrade());
-    query.addBindValue(e.letterGrade());
+    query.addBindValue(e.letterGradeName());
 
     if (!query.exec()) {
         qDebug() << "addEnrollment failed:" << query.lastError().text();
         return false;
     }
+    ChangeBus::instance().publish("enrollments", query.lastInsertId().toInt(), ChangeEvent::Inserted);
     return true;
 }
 
@@ -47,30 +54,25 @@ bool EnrollmentController::addEnrollment(const Enrollment& e)
  */
 bool EnrollmentController::updateEnrollment(const Enrollment& e)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare("UPDATE enrollments SET status = :status, "
-                  "attendance_count = :att, absence_count = :abs, "
-                  "assignment_1_grade = :a1, assignment_2_grade = :a2, "
-                  "coursework_grade = :cw, final_exam_grade = :fi, "
-                  "experience_grade = :exp, total_grade = :tot, "
-                  "letter_grade = :lg WHERE id = :id");
-    
-    query.bindValue(":status", e.status().isEmpty() ? "active" : e.status());
-    query.bindValue(":att", e.attendanceCount());
-    query.bindValue(":abs", e.absenceCount());
-    query.bindValue(":a1", e.assignment1Grade());
-    query.bindValue(":a2", e.assignment2Grade());
-    query.bindValue(":cw", e.courseworkGrade());
-    query.bindValue(":fi", e.finalExamGrade());
-    query.bindValue(":exp", e.experienceGrade());
-    query.bindValue(":tot", e.totalGrade());
-    query.bindValue(":lg", e.letterGrade().isEmpty() ? "N/A" : e.letterGrade());
-    query.bindValue(":id", e.id());
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_ENROLLMENT);
+    query.addBindValue(e.status().isEmpty() ? "active" : e.status());
+    query.addBindValue(e.attendanceCount());
+    query.addBindValue(e.absenceCount());
+    query.addBindValue(e.assignment1Grade());
+    query.addBindValue(e.assignment2Grade());
+    query.addBindValue(e.courseworkGrade());
+    query.addBindValue(e.finalExamGrade());
+    query.addBindValue(e.experienceGrade());
+    query.addBindValue(e.totalGrade());
+    query.addBindValue(e.letterGradeName());
+    query.addBindValue(e.id());
 
     if (!query.exec()) {
         qDebug() << "updateEnrollment failed:" << query.lastError().text();
         return false;
     }
+    ChangeBus::instance().publish("enrollments", e.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -81,10 +83,12 @@ bool EnrollmentController::updateEnrollment(const Enrollment& e)
  */
 bool EnrollmentController::deleteEnrollment(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_ENROLLMENT);
     query.addBindValue(id);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("enrollments", id, ChangeEvent::Deleted);
+    return true;
 }
 
 /**
@@ -96,7 +100,7 @@ bool EnrollmentController::deleteEnrollment(int id)
 QList<Enrollment> EnrollmentController::getEnrollmentsByStudent(int studentId)
 {
     QList<Enrollment> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_ENROLLMENTS_BY_STUDENT);
     query.addBindValue(studentId);
 
@@ -135,7 +139,7 @@ QList<Enrollment> EnrollmentController::getEnrollmentsByStudent(int studentId)
 QList<Enrollment> EnrollmentController::getEnrollmentsByCourse(int courseId)
 {
     QList<Enrollment> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_ENROLLMENTS_BY_COURSE);
     query.addBindValue(courseId);
 
@@ -173,9 +177,8 @@ QList<Enrollment> EnrollmentController::getEnrollmentsByCourse(int courseId)
 Enrollment EnrollmentController::getEnrollmentById(int id)
 {
     Enrollment e;
-    QSqlQuery query(DBConnection::instance().database());
-    // Use a simpler query first to ensure we get the enrollment data
-    query.prepare("SELECT * FROM enrollments WHERE id = ?");
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_ENROLLMENT_BY_ID);
     query.addBindValue(id);
     
     if (query.exec() && query.next()) {
@@ -192,16 +195,7 @@ Enrollment EnrollmentController::getEnrollmentById(int id)
         e.setExperienceGrade(query.value("experience_grade").toDouble());
         e.setTotalGrade(query.value("total_grade").toDouble());
         e.setLetterGrade(query.value("letter_grade").toString());
-        
-        // Fetch student name separately for reliability
-        QSqlQuery nameQuery(DBConnection::instance().database());
-        nameQuery.prepare("SELECT u.full_name FROM students_data sd "
-                         "JOIN users u ON sd.user_id = u.id "
-                         "WHERE sd.id = ?");
-        nameQuery.addBindValue(e.studentId());
-        if (nameQuery.exec() && nameQuery.next()) {
-            e.setStudentName(nameQuery.value(0).toString());
-        }
+        e.setStudentName(query.value("full_name").toString());
     } else {
         qDebug() << "getEnrollmentById failed for ID:" << id << "Error:" << query.lastError().text();
     }
@@ -215,7 +209,7 @@ Enrollment EnrollmentController::getEnrollmentById(int id)
  * @param courseType - Type of course (affects grading scale if needed in future)
  * @param maxMarks - Maximum marks for the course (e.g., 100 or 150)
  */
-void EnrollmentController::calculateTotalAndGrade(Enrollment& e, const QString& courseType, int maxMarks)
+void EnrollmentController::calculateTotalAndGrade(Enrollment& e, CourseType courseType, int maxMarks)
 {
     // Total is simply the sum of all components
     // The inputs (Assignment 1, 2, CW, Final) are expected to be raw marks out of their respective component max
@@ -233,85 +227,89 @@ void EnrollmentController::calculateTotalAndGrade(Enrollment& e, const QString&
         percentage = (total / maxMarks) * 100.0;
     }
 
-    QString grade;
-    if (percentage >= 85) grade = "Excellent";
-    else if (percentage >= 75) grade = "Very Good";
-    else if (percentage >= 65) grade = "Good";
-    else if (percentage >= 60) grade = "Pass";
-    else grade = "Fail";
-
-    e.setLetterGrade(grade);
+    e.setLetterGrade(GradeStatistics::gradeLetter(GradeStatistics::letterForPercentage(percentage)));
 }
 
 /**
  * records an attendance log for a specific date
  * Updates existing log if found, otherwise creates a new one
- * Recalculates total attendance counts and updates the main enrollment record
+ * The enrollment's counters are moved by the change in status and the day's
+ * bit is set in the enrollment's attendance bitmap, in one transaction
  * @param log - The AttendanceLog object containing the record
  * @return True if successful, otherwise false
  */
 bool EnrollmentController::addAttendanceLog(const AttendanceLog& log)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    
-    // 1. Check if log exists for this date
-    QSqlQuery checkQuery(db);
-    checkQuery.prepare("SELECT id FROM attendance_logs WHERE enrollment_id = ? AND date = ?");
+    if (!DBConnection::instance().beginTransaction(db)) {
+        qDebug() << "addAttendanceLog failed to start transaction:" << db.lastError().text();
+        return false;
+    }
+
+    // 1. Check if log exists for this date, and what it recorded
+    DBQuery checkQuery(db);
+    checkQuery.prepare(Queries::SELECT_ATTENDANCE_LOG_BY_DATE);
     checkQuery.addBindValue(log.enrollmentId());
     checkQuery.addBindValue(log.date());
-    
-    bool exists = false;
-    int existingId = -1;
-    if (checkQuery.exec() && checkQuery.next()) {
-        exists = true;
-        existingId = checkQuery.value(0).toInt();
+    if (!checkQuery.exec()) {
+        qDebug() << "addAttendanceLog (lookup) failed:" << checkQuery.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
     }
-    
-    // 2. Insert or Update
-    QSqlQuery query(db);
+
+    const bool exists = checkQuery.next();
+    const int existingId = exists ? checkQuery.value(0).toInt() : -1;
+    const AttendanceStatus previous = exists
+        ? attendanceStatusFromName(checkQuery.value(1).toString())
+        : AttendanceStatus::Unmarked;
+
+    // 2. Insert or Update; empty notes are stored as NULL
+    const QVariant notes = log.notes().isEmpty() ? QVariant() : QVariant(log.notes());
+    DBQuery query(db);
     if (exists) {
-        query.prepare("UPDATE attendance_logs SET status = ?, notes = ? WHERE id = ?");
-        query.addBindValue(log.status());
-        query.addBindValue(log.notes());
+        query.prepare(Queries::UPDATE_ATTENDANCE_LOG);
+        query.addBindValue(log.statusName());
+        query.addBindValue(notes);
         query.addBindValue(existingId);
     } else {
         query.prepare(Queries::INSERT_ATTENDANCE_LOG);
         query.addBindValue(log.enrollmentId());
         query.addBindValue(log.date());
-        query.addBindValue(log.status());
-        query.addBindValue(log.notes());
+        query.addBindValue(log.statusName());
+        query.addBindValue(notes);
     }
-    
+
     if (!query.exec()) {
         qDebug() << "addAttendanceLog (insert/update) failed:" << query.lastError().text();
+        DBConnection::instance().rollback(db);
         return false;
     }
-    
-    // 3. Recalculate counts
-    QSqlQuery countQuery(db);
-    int presentCount = 0;
-    int absentCount = 0;
-    
-    countQuery.prepare("SELECT COUNT(*) FROM attendance_logs WHERE enrollment_id = ? AND status = 'Present'");
-    countQuery.addBindValue(log.enrollmentId());
-    if (countQuery.exec() && countQuery.next()) presentCount = countQuery.value(0).toInt();
-    
-    countQuery.prepare("SELECT COUNT(*) FROM attendance_logs WHERE enrollment_id = ? AND status = 'Absent'");
-    countQuery.addBindValue(log.enrollmentId());
-    if (countQuery.exec() && countQuery.next()) absentCount = countQuery.value(0).toInt();
-    
-    // 4. Update Enrollment
-    QSqlQuery updateEnrollment(db);
-    updateEnrollment.prepare("UPDATE enrollments SET attendance_count = ?, absence_count = ? WHERE id = ?");
-    updateEnrollment.addBindValue(presentCount);
-    updateEnrollment.addBindValue(absentCount);
-    updateEnrollment.addBindValue(log.enrollmentId());
-    
-    if (!updateEnrollment.exec()) {
-        qDebug() << "addAttendanceLog (update enrollment counts) failed:" << updateEnrollment.lastError().text();
-        return false; 
+
+    // 3. Move the enrollment counters by what changed instead of recounting
+    const int presentDelta = (log.status() == AttendanceStatus::Present) - (previous == AttendanceStatus::Present);
+    const int absentDelta = (log.status() == AttendanceStatus::Absent) - (previous == AttendanceStatus::Absent);
+    if (presentDelta != 0 || absentDelta != 0) {
+        DBQuery updateEnrollment(db);
+        updateEnrollment.prepare(Queries::ADJUST_ENROLLMENT_ATTENDANCE_COUNTS);
+        updateEnrollment.addBindValue(presentDelta);
+        updateEnrollment.addBindValue(absentDelta);
+        updateEnrollment.addBindValue(log.enrollmentId());
+
+        if (!updateEnrollment.exec()) {
+            qDebug() << "addAttendanceLog (update enrollment counts) failed:" << updateEnrollment.lastError().text();
+            DBConnection::instance().rollback(db);
+            return false;
+        }
     }
-    
+
+    // 4. Set the day in the bitmap
+    if (!updateBitmap(db, log) || !TableVersions::bump(db, "enrollments") || !DBConnection::instance().commit(db)) {
+        qDebug() << "addAttendanceLog (bitmap) failed:" << db.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+
+    ChangeBus::instance().deliver("enrollments", log.enrollmentId(), ChangeEvent::Updated);
     return true;
 }
 
@@ -324,7 +322,7 @@ bool EnrollmentController::addAttendanceLog(const AttendanceLog& log)
 QList<AttendanceLog> EnrollmentController::getAttendanceLogsByCourse(int courseId, const QDate& date)
 {
     QList<AttendanceLog> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_ATTENDANCE_LOGS_BY_COURSE_DATE);
     query.addBindValue(courseId);
     query.addBindValue(date);
@@ -343,3 +341,233 @@ QList<AttendanceLog> EnrollmentController::getAttendanceLogsByCourse(int courseI
     return list;
 }
 
+/**
+ * Share of the sessions held so far that the student attended
+ * The number of sessions held comes from SessionCalendar, so this needs no
+ * query once the course has been expanded
+ * @param e - The enrollment, with its attendance count
+ * @param asOf - Sessions after this date are not counted
+ * @return The percentage (0-100), 0 when no session has been held yet
+ */
+double EnrollmentController::attendancePercentage(const Enrollment& e, const QDate& asOf)
+{
+    const int held = SessionCalendar::instance().sessions(e.courseId())->daysUpTo(asOf);
+    if (held <= 0) return 0.0;
+    return qMin(100.0, 100.0 * e.attendanceCount() / held);
+}
+
+/**
+ * Lists the teaching days of a course on which no attendance was recorded
+ * for any of its students
+ * @param courseId - The ID of the course
+ * @param upTo - Teaching days after this date are not checked
+ * @return The dates, oldest first
+ */
+QList<QDate> EnrollmentController::getUnrecordedSessionDays(int courseId, const QDate& upTo)
+{
+    QList<QDate> missing;
+    SessionCalendar::Handle sessions = SessionCalendar::instance().sessions(courseId);
+    const int held = sessions->daysUpTo(upTo);
+    if (held == 0) return missing;
+
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    query.prepare(Queries::SELECT_ATTENDANCE_DATES_BY_COURSE);
+    query.addBindValue(courseId);
+    if (!query.exec()) {
+        qDebug() << "getUnrecordedSessionDays failed:" << query.lastError().text();
+        return missing;
+    }
+
+    QSet<qint64> recorded;
+    while (query.next()) {
+        recorded.insert(query.value(0).toDate().toJulianDay());
+    }
+    for (int i = 0; i < held; ++i) {
+        const QDate day = sessions->dayAt(i);
+        if (!recorded.contains(day.toJulianDay())) missing.append(day);
+    }
+    return missing;
+}
+
+/**
+ * Summarises the attendance of every student in a course
+ * Each enrollment's bitmap is read in one query and counted against the mask
+ * of sessions held so far, a few word operations per student. Enrollments
+ * without a current bitmap (logged before bitmaps were kept, or whose term
+ * moved) are rebuilt from the course's logs and stored on the way
+ * @param courseId - The ID of the course
+ * @param asOf - Sessions after this date are not counted
+ * @return The sessions held and the counts per enrollment; empty when the
+ *         course has no term
+ */
+EnrollmentController::CourseAttendance EnrollmentController::getCourseAttendance(int courseId, const QDate& asOf)
+{
+    CourseAttendance result;
+    SessionCalendar::Handle sessions = SessionCalendar::instance().sessions(courseId);
+    const int termDays = sessions->termDays();
+    if (termDays == 0) return result;
+
+    const QVector<quint64> mask = sessions->dayMask(asOf);
+    result.sessionsHeld = sessions->daysUpTo(asOf);
+
+    QSqlDatabase& db = DBConnection::instance().database();
+    DBQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(Queries::SELECT_ATTENDANCE_BITMAPS_BY_COURSE);
+    query.addBindValue(courseId);
+    if (!query.exec()) {
+        qDebug() << "getCourseAttendance failed:" << query.lastError().text();
+        return result;
+    }
+
+    QList<AttendanceBitmap> bitmaps;
+    QHash<int, AttendanceBitmap> stale;
+    while (query.next()) {
+        AttendanceBitmap bitmap;
+        if (readBitmap(query, sessions->termStart(), termDays, bitmap)) {
+            bitmaps.append(bitmap);
+        } else {
+            bitmap = AttendanceBitmap(sessions->termStart(), termDays);
+            bitmap.setEnrollmentId(query.value("enrollment_id").toInt());
+            stale.insert(bitmap.enrollmentId(), bitmap);
+        }
+    }
+
+    if (!stale.isEmpty()) {
+        DBQuery logs(db);
+        logs.setForwardOnly(true);
+        logs.prepare(Queries::SELECT_ATTENDANCE_STATUS_BY_COURSE);
+        logs.addBindValue(courseId);
+        if (!logs.exec()) {
+            qDebug() << "getCourseAttendance (rebuild) failed:" << logs.lastError().text();
+            return result;
+        }
+        while (logs.next()) {
+            const int enrollmentId = logs.value(0).toInt();
+            if (!stale.contains(enrollmentId)) continue;
+            AttendanceBitmap& bitmap = stale[enrollmentId];
+            bitmap.setStatus(bitmap.dayOf(logs.value(1).toDate()), attendanceStatusFromName(logs.value(2).toString()));
+        }
+
+        // Storing is best effort; the counts below do not depend on it
+        if (DBConnection::instance().beginTransaction(db)) {
+            bool saved = true;
+            for (const AttendanceBitmap& bitmap : stale) {
+                saved = saved && saveBitmap(db, bitmap);
+            }
+            if (!saved || !DBConnection::instance().commit(db)) {
+                DBConnection::instance().rollback(db);
+            }
+        }
+        bitmaps.append(stale.values());
+    }
+
+    for (const AttendanceBitmap& bitmap : bitmaps) {
+        AttendanceCounts counts;
+        counts.present = bitmap.count(AttendanceStatus::Present, mask);
+        counts.absent = bitmap.count(AttendanceStatus::Absent, mask);
+        counts.late = bitmap.count(AttendanceStatus::Late, mask);
+        counts.excused = bitmap.count(AttendanceStatus::Excused, mask);
+        counts.unmarked = bitmap.unmarked(mask);
+        result.byEnrollment.insert(bitmap.enrollmentId(), counts);
+    }
+    return result;
+}
+
+/**
+ * Loads the bitmap columns of a SELECT_ATTENDANCE_BITMAP* row
+ * @param query - Positioned on the row
+ * @param termStart - The current start of the course's term
+ * @param termDays - The current length of the course's term
+ * @param bitmap - Receives the bitmap
+ * @return False if the row has no bitmap or it was built for another term
+ */
+bool EnrollmentController::readBitmap(const QSqlQuery& query, const QDate& termStart, int termDays, AttendanceBitmap& bitmap)
+{
+    if (query.value("term_start").isNull()
+        || query.value("term_start").toDate() != termStart
+        || query.value("day_count").toInt() != termDays) {
+        return false;
+    }
+
+    bitmap = AttendanceBitmap(termStart, termDays);
+    bitmap.setEnrollmentId(query.value("enrollment_id").toInt());
+    bitmap.setPlaneBytes(AttendanceStatus::Present, query.value("present").toByteArray());
+    bitmap.setPlaneBytes(AttendanceStatus::Absent, query.value("absent").toByteArray());
+    bitmap.setPlaneBytes(AttendanceStatus::Late, query.value("late").toByteArray());
+    bitmap.setPlaneBytes(AttendanceStatus::Excused, query.value("excused").toByteArray());
+    return true;
+}
+
+/**
+ * Inserts or replaces the stored bitmap of an enrollment
+ * @param db - The connection
+ * @param bitmap - The bitmap, with its enrollment ID
+ * @return True if successful, otherwise false
+ */
+bool EnrollmentController::saveBitmap(QSqlDatabase& db, const AttendanceBitmap& bitmap)
+{
+    DBQuery query(db);
+    query.prepare(Queries::UPSERT_ATTENDANCE_BITMAP);
+    query.addBindValue(bitmap.enrollmentId());
+    query.addBindValue(bitmap.termStart());
+    query.addBindValue(bitmap.dayCount());
+    query.addBindValue(bitmap.planeBytes(AttendanceStatus::Present));
+    query.addBindValue(bitmap.planeBytes(AttendanceStatus::Absent));
+    query.addBindValue(bitmap.planeBytes(AttendanceStatus::Late));
+    query.addBindValue(bitmap.planeBytes(AttendanceStatus::Excused));
+
+    if (!query.exec()) {
+        qDebug() << "saveBitmap failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Applies a just written log to the enrollment's bitmap
+ * When there is no bitmap yet, or it was built for another term, it is
+ * rebuilt from all of the enrollment's logs (which include this one)
+ * Days outside the term are only kept in attendance_logs
+ * @param db - The connection, inside the caller's transaction
+ * @param log - The log that was written
+ * @return True if successful, otherwise false
+ */
+bool EnrollmentController::updateBitmap(QSqlDatabase& db, const AttendanceLog& log)
+{
+    DBQuery query(db);
+    query.prepare(Queries::SELECT_ATTENDANCE_BITMAP_BY_ENROLLMENT);
+    query.addBindValue(log.enrollmentId());
+    if (!query.exec()) {
+        qDebug() << "updateBitmap failed:" << query.lastError().text();
+        return false;
+    }
+    if (!query.next()) return true; // no such enrollment; nothing to keep
+
+    SessionCalendar::Handle sessions = SessionCalendar::instance().sessions(query.value("course_id").toInt());
+    const int termDays = sessions->termDays();
+    if (termDays == 0) return true; // course without a term; the logs are all there is
+
+    AttendanceBitmap bitmap;
+    if (readBitmap(query, sessions->termStart(), termDays, bitmap)) {
+        bitmap.setStatus(bitmap.dayOf(log.date()), log.status());
+    } else {
+        bitmap = AttendanceBitmap(sessions->termStart(), termDays);
+        bitmap.setEnrollmentId(log.enrollmentId());
+
+        DBQuery logs(db);
+        logs.setForwardOnly(true);
+        logs.prepare(Queries::SELECT_ATTENDANCE_LOGS_BY_ENROLLMENT);
+        logs.addBindValue(log.enrollmentId());
+        if (!logs.exec()) {
+            qDebug() << "updateBitmap (rebuild) failed:" << logs.lastError().text();
+            return false;
+        }
+        while (logs.next()) {
+            bitmap.setStatus(bitmap.dayOf(logs.value("date").toDate()),
+                             attendanceStatusFromName(logs.value("status").toString()));
+        }
+    }
+    return saveBitmap(db, bitmap);
+}
@@ -3,13 +3,33 @@
 
 #include "../models/enrollment.h"
 #include "../models/attendance_log.h"
+#include "../models/attendance_bitmap.h"
+#include <QHash>
 #include <QList>
 #include <QString>
 #include <QDate> // Required for QDate parameter in new function
 
+class QSqlDatabase;
+class QSqlQuery;
+
 class EnrollmentController
 {
 public:
+    // Sessions of one enrollment by recorded state
+    struct AttendanceCounts {
+        int present = 0;
+        int absent = 0;
+        int late = 0;
+        int excused = 0;
+        int unmarked = 0;
+    };
+
+    // Attendance of a whole course over the sessions held so far
+    struct CourseAttendance {
+        int sessionsHeld = 0;
+        QHash<int, AttendanceCounts> byEnrollment; // enrollment ID -> counts
+    };
+
     EnrollmentController();
 
     bool addEnrollment(const Enrollment& e);
@@ -20,11 +40,19 @@ public:
     QList<Enrollment> getEnrollmentsByCourse(int courseId);
     Enrollment getEnrollmentById(int id);
 
-    void calculateTotalAndGrade(Enrollment& e, const QString& courseType, int maxMarks);
+    void calculateTotalAndGrade(Enrollment& e, CourseType courseType, int maxMarks);
     
     // Attendance Logs
     bool addAttendanceLog(const AttendanceLog& log);
     QList<AttendanceLog> getAttendanceLogsByCourse(int courseId, const QDate& date);
+    double attendancePercentage(const Enrollment& e, const QDate& asOf = QDate::currentDate());
+    QList<QDate> getUnrecordedSessionDays(int courseId, const QDate& upTo = QDate::currentDate());
+    CourseAttendance getCourseAttendance(int courseId, const QDate& asOf = QDate::currentDate());
+
+private:
+    static bool readBitmap(const QSqlQuery& query, const QDate& termStart, int termDays, AttendanceBitmap& bitmap);
+    static bool saveBitmap(QSqlDatabase& db, const AttendanceBitmap& bitmap);
+    static bool updateBitmap(QSqlDatabase& db, const AttendanceLog& log);
 };
 
 #endif // ENROLLMENTCONTROLLER_H
@@ -0,0 +1,314 @@
+#include "gradestatistics.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+/**
+ * Constructor for the GradeStatistics class
+ */
+GradeStatistics::GradeStatistics() {}
+
+/**
+ * Loads the graded enrollments of a single course
+ * @param courseId - The ID of the course
+ * @return True if the rows were loaded, otherwise false
+ */
+bool GradeStatistics::loadForCourse(int courseId)
+{
+    return load(Queries::SELECT_GRADE_ROWS_BY_COURSE, courseId);
+}
+
+/**
+ * Loads the graded enrollments of every course belonging to an academic level
+ * @param levelId - The ID of the academic level (courses.year_level)
+ * @return True if the rows were loaded, otherwise false
+ */
+bool GradeStatistics::loadForLevel(int levelId)
+{
+    return load(Queries::SELECT_GRADE_ROWS_BY_LEVEL, levelId);
+}
+
+/**
+ * Loads every graded enrollment in the university
+ * @return True if the rows were loaded, otherwise false
+ */
+bool GradeStatistics::loadForUniversity()
+{
+    return load(Queries::SELECT_ALL_GRADE_ROWS, 0);
+}
+
+/**
+ * Streams grade rows into the column arrays
+ * Enrollments with no grade entered yet are skipped, matching the student portal
+ * @param sql - One of the SELECT_*GRADE_ROWS* queries
+ * @param bindId - Value bound to the single placeholder (ignored when <= 0)
+ * @return True if the query succeeded, otherwise false
+ */
+bool GradeStatistics::load(const QString& sql, int bindId)
+{
+    clear();
+
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    if (bindId > 0) query.addBindValue(bindId);
+
+    if (!query.exec()) {
+        qDebug() << "GradeStatistics load failed:" << query.lastError().text();
+        return false;
+    }
+
+    if (query.size() > 0) {
+        for (auto& column : m_columns) column.reserve(query.size());
+        m_percentages.reserve(query.size());
+    }
+
+    double grades[ColumnCount];
+    while (query.next()) {
+        bool graded = false;
+        for (int c = 0; c < ColumnCount; ++c) {
+            grades[c] = query.value(c).toDouble();
+            if (c != Total && grades[c] != 0.0) graded = true;
+        }
+        if (!graded) continue;
+        addRow(grades, query.value(ColumnCount).toInt());
+    }
+    return true;
+}
+
+/**
+ * Removes all loaded rows
+ */
+void GradeStatistics::clear()
+{
+    for (auto& column : m_columns) column.clear();
+    m_percentages.clear();
+}
+
+/**
+ * Appends one enrollment row
+ * @param grades - Grade values indexed by Column
+ * @param maxGrade - The course max grade used to derive the percentage
+ */
+void GradeStatistics::addRow(const double grades[ColumnCount], int maxGrade)
+{
+    for (int c = 0; c < ColumnCount; ++c) {
+        m_columns[c].push_back(grades[c]);
+    }
+    m_percentages.push_back(maxGrade > 0 ? (grades[Total] / maxGrade) * 100.0 : 0.0);
+}
+
+/**
+ * @return The number of loaded rows
+ */
+int GradeStatistics::size() const
+{
+    return static_cast<int>(m_percentages.size());
+}
+
+/**
+ * Computes the full report over the loaded rows
+ * @param histogramBuckets - Number of equal-width histogram buckets per column
+ * @return The computed Report
+ */
+GradeStatistics::Report GradeStatistics::compute(int histogramBuckets) const
+{
+    Report report;
+    report.sampleCount = size();
+    for (int c = 0; c < ColumnCount; ++c) {
+        report.columns[c] = summarize(m_columns[c], histogramBuckets, 0.0);
+    }
+    report.percentage = summarize(m_percentages, histogramBuckets, 100.0);
+
+    for (double p : m_percentages) {
+        report.letterCounts[letterForPercentage(p)]++;
+    }
+    return report;
+}
+
+/**
+ * Computes the summary of one column
+ * Percentiles use successive nth_element passes over a shrinking tail, O(n) each
+ * @param values - The column values
+ * @param histogramBuckets - Number of histogram buckets
+ * @param upperBound - Fixed histogram upper bound, or <= 0 to use the column max
+ * @return The ColumnSummary
+ */
+GradeStatistics::ColumnSummary GradeStatistics::summarize(const std::vector<double>& values, int histogramBuckets, double upperBound)
+{
+    ColumnSummary s;
+    const std::size_t n = values.size();
+    if (histogramBuckets < 1) histogramBuckets = 1;
+    s.histogram = QList<int>(histogramBuckets, 0);
+    if (n == 0) return s;
+
+    s.count = static_cast<int>(n);
+    s.mean = sum(values.data(), n) / static_cast<double>(n);
+    s.stddev = std::sqrt(sumSquaredDeviation(values.data(), n, s.mean) / static_cast<double>(n));
+    minMax(values.data(), n, s.min, s.max);
+
+    std::vector<double> work(values);
+    const double ranks[] = {0.25, 0.50, 0.75, 0.90, 0.99};
+    double* targets[] = {&s.p25, &s.p50, &s.p75, &s.p90, &s.p99};
+    auto from = work.begin();
+    for (int i = 0; i < 5; ++i) {
+        auto nth = work.begin() + static_cast<std::ptrdiff_t>(ranks[i] * static_cast<double>(n - 1));
+        std::nth_element(from, nth, work.end());
+        *targets[i] = *nth;
+        from = nth;
+    }
+
+    const double lo = std::min(0.0, s.min);
+    const double hi = upperBound > 0.0 ? upperBound : s.max;
+    s.bucketWidth = (hi - lo) / histogramBuckets;
+    for (double v : values) {
+        int bucket = 0;
+        if (s.bucketWidth > 0.0) {
+            bucket = static_cast<int>((v - lo) / s.bucketWidth);
+            bucket = std::clamp(bucket, 0, histogramBuckets - 1);
+        }
+        s.histogram[bucket]++;
+    }
+    return s;
+}
+
+/**
+ * @param column - The grade column
+ * @return A display name for the column
+ */
+QString GradeStatistics::columnName(Column column)
+{
+    switch (column) {
+        case Assignment1: return "Assignment 1";
+        case Assignment2: return "Assignment 2";
+        case Coursework: return "Coursework";
+        case FinalExam: return "Final Exam";
+        case Experience: return "Experience";
+        case Total: return "Total";
+        default: return QString();
+    }
+}
+
+/**
+ * @param letter - The letter grade bucket
+ * @return The evaluation text stored in enrollments.letter_grade
+ */
+QString GradeStatistics::letterName(LetterGrade letter)
+{
+    switch (letter) {
+        case Excellent: return "Excellent";
+        case VeryGood: return "Very Good";
+        case Good: return "Good";
+        case Pass: return "Pass";
+        default: return "Fail";
+    }
+}
+
+/**
+ * Maps a percentage of the course max grade to its evaluation
+ * @param percentage - Total grade as a percentage of the course max grade
+ * @return The LetterGrade bucket
+ */
+GradeStatistics::LetterGrade GradeStatistics::letterForPercentage(double percentage)
+{
+    if (percentage >= 85) return Excellent;
+    if (percentage >= 75) return VeryGood;
+    if (percentage >= 65) return Good;
+    if (percentage >= 60) return Pass;
+    return Fail;
+}
+
+/**
+ * @param letter - A LetterGrade bucket
+ * @return The evaluation stored on enrollments for that bucket
+ */
+GradeLetter GradeStatistics::gradeLetter(LetterGrade letter)
+{
+    switch (letter) {
+        case Excellent: return GradeLetter::Excellent;
+        case VeryGood: return GradeLetter::VeryGood;
+        case Good: return GradeLetter::Good;
+        case Pass: return GradeLetter::Pass;
+        default: return GradeLetter::Fail;
+    }
+}
+
+/**
+ * Sums a contiguous array
+ * Four independent accumulators break the add dependency chain so the loop
+ * vectorizes without relaxing floating point semantics
+ * @param values - Pointer to the first value
+ * @param count - Number of values
+ * @return The sum
+ */
+double GradeStatistics::sum(const double* values, std::size_t count)
+{
+    double a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        a0 += values[i];
+        a1 += values[i + 1];
+        a2 += values[i + 2];
+        a3 += values[i + 3];
+    }
+    for (; i < count; ++i) a0 += values[i];
+    return (a0 + a1) + (a2 + a3);
+}
+
+/**
+ * Sums the squared deviation from the mean (second pass of the variance)
+ * @param values - Pointer to the first value
+ * @param count - Number of values
+ * @param mean - The precomputed mean
+ * @return The sum of (x - mean)^2
+ */
+double GradeStatistics::sumSquaredDeviation(const double* values, std::size_t count, double mean)
+{
+    double a0 = 0.0, a1 = 0.0, a2 = 0.0, a3 = 0.0;
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const double d0 = values[i] - mean;
+        const double d1 = values[i + 1] - mean;
+        const double d2 = values[i + 2] - mean;
+        const double d3 = values[i + 3] - mean;
+        a0 += d0 * d0;
+        a1 += d1 * d1;
+        a2 += d2 * d2;
+        a3 += d3 * d3;
+    }
+    for (; i < count; ++i) {
+        const double d = values[i] - mean;
+        a0 += d * d;
+    }
+    return (a0 + a1) + (a2 + a3);
+}
+
+/**
+ * Finds the minimum and maximum of a non-empty contiguous array
+ * @param values - Pointer to the first value
+ * @param count - Number of values (must be > 0)
+ * @param min - Receives the minimum
+ * @param max - Receives the maximum
+ */
+void GradeStatistics::minMax(const double* values, std::size_t count, double& min, double& max)
+{
+    double lo0 = values[0], lo1 = values[0], hi0 = values[0], hi1 = values[0];
+    std::size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        lo0 = values[i] < lo0 ? values[i] : lo0;
+        lo1 = values[i + 1] < lo1 ? values[i + 1] : lo1;
+        hi0 = values[i] > hi0 ? values[i] : hi0;
+        hi1 = values[i + 1] > hi1 ? values[i + 1] : hi1;
+    }
+    for (; i < count; ++i) {
+        lo0 = values[i] < lo0 ? values[i] : lo0;
+        hi0 = values[i] > hi0 ? values[i] : hi0;
+    }
+    min = lo0 < lo1 ? lo0 : lo1;
+    max = hi0 > hi1 ? hi0 : hi1;
+}
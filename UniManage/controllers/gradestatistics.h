@@ -0,0 +1,89 @@
+#ifndef GRADESTATISTICS_H
+#define GRADESTATISTICS_H
+
+#include <QList>
+#include <QString>
+#include "../models/domain_types.h"
+#include <cstddef>
+#include <vector>
+
+/**
+ * Aggregate grade statistics over the enrollments table
+ * Rows are kept as one contiguous double array per grade column so that
+ * the reductions below compile to tight (auto-vectorized) loops
+ */
+class GradeStatistics
+{
+public:
+    enum Column {
+        Assignment1 = 0,
+        Assignment2,
+        Coursework,
+        FinalExam,
+        Experience,
+        Total,
+        ColumnCount
+    };
+
+    enum LetterGrade {
+        Excellent = 0,
+        VeryGood,
+        Good,
+        Pass,
+        Fail,
+        LetterCount
+    };
+
+    struct ColumnSummary {
+        int count = 0;
+        double mean = 0.0;
+        double stddev = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double p25 = 0.0;
+        double p50 = 0.0;
+        double p75 = 0.0;
+        double p90 = 0.0;
+        double p99 = 0.0;
+        double bucketWidth = 0.0;
+        QList<int> histogram;
+    };
+
+    struct Report {
+        int sampleCount = 0;
+        ColumnSummary columns[ColumnCount];
+        ColumnSummary percentage; // total_grade relative to the course max grade
+        int letterCounts[LetterCount] = {0, 0, 0, 0, 0};
+    };
+
+    GradeStatistics();
+
+    bool loadForCourse(int courseId);
+    bool loadForLevel(int levelId);
+    bool loadForUniversity();
+
+    void clear();
+    void addRow(const double grades[ColumnCount], int maxGrade);
+    int size() const;
+
+    Report compute(int histogramBuckets = 10) const;
+
+    static QString columnName(Column column);
+    static QString letterName(LetterGrade letter);
+    static LetterGrade letterForPercentage(double percentage);
+    static GradeLetter gradeLetter(LetterGrade letter);
+
+    // Reduction kernels over contiguous arrays
+    static double sum(const double* values, std::size_t count);
+    static double sumSquaredDeviation(const double* values, std::size_t count, double mean);
+    static void minMax(const double* values, std::size_t count, double& min, double& max);
+
+private:
+    bool load(const QString& sql, int bindId);
+    static ColumnSummary summarize(const std::vector<double>& values, int histogramBuckets, double upperBound);
+
+    std::vector<double> m_columns[ColumnCount];
+    std::vector<double> m_percentages;
+};
+
+#endif // GRADESTATISTICS_H
@@ -0,0 +1,199 @@
+#include "ledgercontroller.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+/**
+ * Constructor for the LedgerController class
+ */
+LedgerController::LedgerController() {}
+
+/**
+ * Retrieves the running balance of a student
+ * Students without a ledger row yet are seeded from their tuition and payments
+ * @param studentId - The ID of the student
+ * @return The StudentBalance (empty if the student does not exist)
+ */
+StudentBalance LedgerController::getBalance(int studentId)
+{
+    QSqlDatabase& db = DBConnection::instance().database();
+    for (int attempt = 0; attempt < 2; ++attempt) {
+        DBQuery query(db);
+        query.prepare(Queries::SELECT_BALANCE_BY_STUDENT);
+        query.addBindValue(studentId);
+
+        if (!query.exec()) {
+            qDebug() << "getBalance failed:" << query.lastError().text();
+            return StudentBalance();
+        }
+
+        if (query.next()) {
+            StudentBalance b(query.value("student_id").toInt(),
+                             Money::fromVariant(query.value("total_charged")),
+                             Money::fromVariant(query.value("total_paid")));
+            b.setUpdatedAt(query.value("updated_at").toDateTime());
+            return b;
+        }
+
+        if (attempt == 0 && !rebuildBalance(studentId)) break;
+    }
+    return StudentBalance();
+}
+
+/**
+ * Retrieves every student whose outstanding balance exceeds a threshold
+ * @param minimumBalance - Only balances strictly greater than this are returned
+ * @return A list of StudentBalance objects, largest balance first
+ */
+QList<StudentBalance> LedgerController::getOutstandingBalances(Money minimumBalance)
+{
+    QList<StudentBalance> list;
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    query.prepare(Queries::SELECT_OUTSTANDING_BALANCES);
+    query.addBindValue(minimumBalance.toString());
+
+    if (!query.exec()) {
+        qDebug() << "getOutstandingBalances failed:" << query.lastError().text();
+        return list;
+    }
+
+    while (query.next()) {
+        StudentBalance b(query.value("student_id").toInt(),
+                         Money::fromVariant(query.value("total_charged")),
+                         Money::fromVariant(query.value("total_paid")));
+        b.setUpdatedAt(query.value("updated_at").toDateTime());
+        b.setStudentNumber(query.value("student_number").toString());
+        b.setFullName(query.value("full_name").toString());
+        list.append(b);
+    }
+    return list;
+}
+
+/**
+ * Recomputes a single student's ledger row from tuition fees and payments
+ * @param studentId - The ID of the student
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::rebuildBalance(int studentId)
+{
+    return rebuildBalance(DBConnection::instance().database(), studentId);
+}
+
+/**
+ * Recomputes a single student's ledger row on the given connection
+ * @param db - The connection (may hold the caller's transaction)
+ * @param studentId - The ID of the student
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::rebuildBalance(QSqlDatabase& db, int studentId)
+{
+    DBQuery query(db);
+    query.prepare(Queries::REBUILD_BALANCE_BY_STUDENT);
+    query.addBindValue(studentId);
+
+    if (!query.exec()) {
+        qDebug() << "rebuildBalance failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Recomputes the ledger rows of every student of a college
+ * Called after the college's tuition fees change
+ * @param collegeId - The ID of the college
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::rebuildCollegeBalances(int collegeId)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::REBUILD_BALANCES_BY_COLLEGE);
+    query.addBindValue(collegeId);
+
+    if (!query.exec()) {
+        qDebug() << "rebuildCollegeBalances failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Recomputes the ledger for every student in one set-based statement
+ * Used to seed the table and to repair drift after manual edits
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::rebuildAllBalances()
+{
+    DBQuery query(DBConnection::instance().database());
+    if (!query.exec(Queries::REBUILD_ALL_BALANCES)) {
+        qDebug() << "rebuildAllBalances failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Recomputes the ledger rows of a contiguous student ID range
+ * @param db - The connection (may hold the caller's transaction)
+ * @param fromStudentId - Exclusive lower bound of students_data.id
+ * @param toStudentId - Inclusive upper bound of students_data.id
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::rebuildBalanceRange(QSqlDatabase& db, int fromStudentId, int toStudentId)
+{
+    DBQuery query(db);
+    query.prepare(Queries::REBUILD_BALANCES_BY_RANGE);
+    query.addBindValue(fromStudentId);
+    query.addBindValue(toStudentId);
+
+    if (!query.exec()) {
+        qDebug() << "rebuildBalanceRange failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Checks whether a payment status counts towards the amount paid
+ * @param status - The payment status
+ * @return True for Paid, Success and Completed (case-insensitive, like
+ *         the LOWER(p.status) test of the rebuild queries)
+ */
+bool LedgerController::countsAsPaid(const QString& status)
+{
+    return status.compare("Paid", Qt::CaseInsensitive) == 0 ||
+           status.compare("Success", Qt::CaseInsensitive) == 0 ||
+           status.compare("Completed", Qt::CaseInsensitive) == 0;
+}
+
+/**
+ * Adds a delta to a student's total paid
+ * A student without a ledger row is seeded instead; the rebuild reads the
+ * payments table inside the same transaction, so it already includes the change
+ * @param db - The connection holding the caller's transaction
+ * @param studentId - The ID of the student
+ * @param delta - Signed change of the paid total
+ * @return True if successful, otherwise false
+ */
+bool LedgerController::applyPaidDelta(QSqlDatabase& db, int studentId, Money delta)
+{
+    if (delta.isZero()) return true;
+
+    DBQuery query(db);
+    query.prepare(Queries::UPDATE_BALANCE_PAID);
+    query.addBindValue(delta.toString());
+    query.addBindValue(studentId);
+
+    if (!query.exec()) {
+        qDebug() << "applyPaidDelta failed:" << query.lastError().text();
+        return false;
+    }
+    if (query.numRowsAffected() == 0) {
+        return rebuildBalance(db, studentId);
+    }
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef LEDGERCONTROLLER_H
+#define LEDGERCONTROLLER_H
+
+#include "../models/student_balance.h"
+#include <QList>
+#include <QString>
+
+class QSqlDatabase;
+
+/**
+ * Maintains the student_balances ledger
+ * Payment writes apply their delta to the ledger inside the same transaction,
+ * so balances can be read per student without aggregating the payments table
+ * total_charged is the sum of billed tuition_charges, or the tuition fees for
+ * students that have not been billed yet, so edits to a student's or a
+ * college's tuition_fees must rebuild the affected rows
+ */
+class LedgerController
+{
+public:
+    LedgerController();
+
+    StudentBalance getBalance(int studentId);
+    QList<StudentBalance> getOutstandingBalances(Money minimumBalance = Money());
+
+    bool rebuildBalance(int studentId);
+    bool rebuildCollegeBalances(int collegeId);
+    bool rebuildAllBalances();
+
+    // Used by payment writes and batch jobs inside their own transaction
+    static bool countsAsPaid(const QString& status);
+    static bool applyPaidDelta(QSqlDatabase& db, int studentId, Money delta);
+    static bool rebuildBalance(QSqlDatabase& db, int studentId);
+    static bool rebuildBalanceRange(QSqlDatabase& db, int fromStudentId, int toStudentId);
+};
+
+#endif // LEDGERCONTROLLER_H
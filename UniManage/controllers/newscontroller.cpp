@@ -1,6 +1,8 @@
 #include "newscontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -19,7 +21,7 @@ NewsController::NewsController() {}
 bool NewsController::addNews(const News& news)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::INSERT_NEWS);
     query.addBindValue(news.title());
     query.addBindValue(news.body());
@@ -28,6 +30,7 @@ bool NewsController::addNews(const News& news)
         qDebug() << "addNews failed:" << query.lastError().text();
         return false;
     }
+    ChangeBus::instance().publish("news", query.lastInsertId().toInt(), ChangeEvent::Inserted);
     return true;
 }
 
@@ -39,7 +42,7 @@ bool NewsController::addNews(const News& news)
 bool NewsController::updateNews(const News& news)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::UPDATE_NEWS);
     query.addBindValue(news.title());
     query.addBindValue(news.body());
@@ -49,6 +52,7 @@ bool NewsController::updateNews(const News& news)
         qDebug() << "updateNews failed:" << query.lastError().text();
         return false;
     }
+    ChangeBus::instance().publish("news", news.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -60,7 +64,7 @@ bool NewsController::updateNews(const News& news)
 bool NewsController::deleteNews(int id)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::DELETE_NEWS);
     query.addBindValue(id);
 
@@ -68,6 +72,7 @@ bool NewsController::deleteNews(int id)
         qDebug() << "deleteNews failed:" << query.lastError().text();
         return false;
     }
+    ChangeBus::instance().publish("news", id, ChangeEvent::Deleted);
     return true;
 }
 
@@ -80,7 +85,7 @@ QList<News> NewsController::getAllNews()
 {
     QList<News> list;
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
 
     if (!query.exec(Queries::SELECT_ALL_NEWS)) {
         qDebug() << "getAllNews failed:" << query.lastError().text();
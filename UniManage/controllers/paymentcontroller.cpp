@@ -1,6 +1,10 @@
 #include "paymentcontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/tableversions.h"
+#include "../database/changebus.h"
+#include "ledgercontroller.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -13,16 +17,22 @@ PaymentController::PaymentController() {}
 
 /**
  * adds a new payment record to the database
+ * The student's ledger balance is updated in the same transaction
  * @param payment - The Payment object containing details
  * @return True if successful, otherwise false
  */
 bool PaymentController::addPayment(const Payment& payment)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    if (!DBConnection::instance().beginTransaction(db)) {
+        qDebug() << "addPayment failed to start transaction:" << db.lastError().text();
+        return false;
+    }
+
+    DBQuery query(db);
     query.prepare(Queries::INSERT_PAYMENT);
     query.addBindValue(payment.studentId());
-    query.addBindValue(payment.amount());
+    query.addBindValue(payment.amount().toString());
     query.addBindValue(payment.date().isValid() ? payment.date().toString(Qt::ISODate) : QString());
     query.addBindValue(payment.year().isValid() ? payment.year().toString(Qt::ISODate) : QString());
     query.addBindValue(payment.method());
@@ -31,22 +41,53 @@ bool PaymentController::addPayment(const Payment& payment)
 
     if (!query.exec()) {
         qDebug() << "addPayment failed:" << query.lastError().text();
+        DBConnection::instance().rollback(db);
         return false;
     }
+
+    Money paidDelta = LedgerController::countsAsPaid(payment.status()) ? payment.amount() : Money();
+    if (!LedgerController::applyPaidDelta(db, payment.studentId(), paidDelta)
+        || !TableVersions::bump(db, "payments") || !DBConnection::instance().commit(db)) {
+        qDebug() << "addPayment failed to update ledger:" << db.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+    ChangeBus::instance().deliver("payments", query.lastInsertId().toInt(), ChangeEvent::Inserted);
     return true;
 }
 
 /**
  * Updates an existing payment record in the database
+ * The previous row is locked for its student, whose ledger row is then
+ * rebuilt from the payments table in the same transaction
  * @param payment - The Payment object with updated details
  * @return True if successful, otherwise false
  */
 bool PaymentController::updatePayment(const Payment& payment)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    if (!DBConnection::instance().beginTransaction(db)) {
+        qDebug() << "updatePayment failed to start transaction:" << db.lastError().text();
+        return false;
+    }
+
+    DBQuery previous(db);
+    previous.prepare(Queries::SELECT_PAYMENT_FOR_UPDATE);
+    previous.addBindValue(payment.id());
+    if (!previous.exec()) {
+        qDebug() << "updatePayment failed:" << previous.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+
+    int studentId = payment.studentId();
+    if (previous.next()) {
+        studentId = previous.value(0).toInt();
+    }
+
+    DBQuery query(db);
     query.prepare(Queries::UPDATE_PAYMENT);
-    query.addBindValue(payment.amount());
+    query.addBindValue(payment.amount().toString());
     query.addBindValue(payment.method());
     query.addBindValue(payment.status());
     query.addBindValue(payment.notes());
@@ -54,27 +95,69 @@ bool PaymentController::updatePayment(const Payment& payment)
 
     if (!query.exec()) {
         qDebug() << "updatePayment failed:" << query.lastError().text();
+        DBConnection::instance().rollback(db);
         return false;
     }
+
+    if (!LedgerController::rebuildBalance(db, studentId)
+        || !TableVersions::bump(db, "payments") || !DBConnection::instance().commit(db)) {
+        qDebug() << "updatePayment failed to update ledger:" << db.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+    ChangeBus::instance().deliver("payments", payment.id(), ChangeEvent::Updated);
     return true;
 }
 
 /**
  * Deletes a payment record from the database
+ * Reverses the payment's effect on the student's ledger balance
  * @param id - The ID of the payment to delete
  * @return True if successful, otherwise false
  */
 bool PaymentController::deletePayment(int id)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    if (!DBConnection::instance().beginTransaction(db)) {
+        qDebug() << "deletePayment failed to start transaction:" << db.lastError().text();
+        return false;
+    }
+
+    DBQuery previous(db);
+    previous.prepare(Queries::SELECT_PAYMENT_FOR_UPDATE);
+    previous.addBindValue(id);
+    if (!previous.exec()) {
+        qDebug() << "deletePayment failed:" << previous.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+
+    int studentId = 0;
+    Money oldPaid;
+    if (previous.next()) {
+        studentId = previous.value(0).toInt();
+        if (LedgerController::countsAsPaid(previous.value(2).toString())) {
+            oldPaid = Money::fromVariant(previous.value(1));
+        }
+    }
+
+    DBQuery query(db);
     query.prepare(Queries::DELETE_PAYMENT);
     query.addBindValue(id);
 
     if (!query.exec()) {
         qDebug() << "deletePayment failed:" << query.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+
+    if (!LedgerController::applyPaidDelta(db, studentId, -oldPaid)
+        || !TableVersions::bump(db, "payments") || !DBConnection::instance().commit(db)) {
+        qDebug() << "deletePayment failed to update ledger:" << db.lastError().text();
+        DBConnection::instance().rollback(db);
         return false;
     }
+    ChangeBus::instance().deliver("payments", id, ChangeEvent::Deleted);
     return true;
 }
 
@@ -85,38 +168,36 @@ bool PaymentController::deletePayment(int id)
 QList<Payment> PaymentController::getAllPayments()
 {
     QList<Payment> list;
-    QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    forEachPayment(Filter(), [&list](const Payment& p) {
+        list.append(p);
+        return true;
+    });
+    return list;
+}
+
+/**
+ * Streams every payment off a forward-only cursor without building a list
+ * @param filter - Rows it rejects are skipped; empty to visit every row
+ * @param visit - Called once per payment; return false to stop early
+ * @return False if the query failed
+ */
+bool PaymentController::forEachPayment(const Filter& filter, const Visitor& visit)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
 
     if (!query.exec(Queries::SELECT_ALL_PAYMENTS)) {
         qDebug() << "getAllPayments failed:" << query.lastError().text();
-        return list;
+        return false;
     }
 
     while (query.next()) {
-        Payment p;
-        p.setId(query.value("id").toInt());
-        p.setStudentId(query.value("student_id").toInt());
-        p.setAmount(query.value("amount").toFloat());
-
-        QDateTime dt = query.value("date").toDateTime();
-        if (dt.isValid()) p.setDate(dt);
-
-        QDateTime yr = query.value("year").toDateTime();
-        if (yr.isValid()) p.setYear(yr);
-
-        p.setMethod(query.value("method").toString());
-        p.setStatus(query.value("status").toString());
-        p.setNotes(query.value("notes").toString());
-
-        QDateTime created = query.value("created_at").toDateTime();
-        if (created.isValid()) p.setCreatedAt(created);
-
+        Payment p = fromRow(query);
         p.setStudentNumber(query.value("student_number").toString());
-
-        list.append(p);
+        if (filter && !filter(p)) continue;
+        if (!visit(p)) break;
     }
-    return list;
+    return true;
 }
 
 /**
@@ -128,7 +209,7 @@ QList<Payment> PaymentController::getPaymentsByStudent(int studentId)
 {
     QList<Payment> list;
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::SELECT_PAYMENTS_BY_STUDENT);
     query.addBindValue(studentId);
 
@@ -138,25 +219,33 @@ QList<Payment> PaymentController::getPaymentsByStudent(int studentId)
     }
 
     while (query.next()) {
-        Payment p;
-        p.setId(query.value("id").toInt());
-        p.setStudentId(query.value("student_id").toInt());
-        p.setAmount(query.value("amount").toFloat());
+        list.append(fromRow(query));
+    }
+    return list;
+}
 
-        QDateTime dt = query.value("date").toDateTime();
-        if (dt.isValid()) p.setDate(dt);
+/**
+ * Builds a Payment from the current row of a payments query
+ * @param query - A query positioned on a row
+ */
+Payment PaymentController::fromRow(const QSqlQuery& query)
+{
+    Payment p;
+    p.setId(query.value("id").toInt());
+    p.setStudentId(query.value("student_id").toInt());
+    p.setAmount(Money::fromVariant(query.value("amount")));
 
-        QDateTime yr = query.value("year").toDateTime();
-        if (yr.isValid()) p.setYear(yr);
+    QDateTime dt = query.value("date").toDateTime();
+    if (dt.isValid()) p.setDate(dt);
 
-        p.setMethod(query.value("method").toString());
-        p.setStatus(query.value("status").toString());
-        p.setNotes(query.value("notes").toString());
+    QDateTime yr = query.value("year").toDateTime();
+    if (yr.isValid()) p.setYear(yr);
 
-        QDateTime created = query.value("created_at").toDateTime();
-        if (created.isValid()) p.setCreatedAt(created);
+    p.setMethod(query.value("method").toString());
+    p.setStatus(query.value("status").toString());
+    p.setNotes(query.value("notes").toString());
 
-        list.append(p);
-    }
-    return list;
+    QDateTime created = query.value("created_at").toDateTime();
+    if (created.isValid()) p.setCreatedAt(created);
+    return p;
 }
@@ -3,10 +3,17 @@
 
 #include "../models/payment.h"
 #include <QList>
+#include <functional>
+
+class QSqlQuery;
 
 class PaymentController
 {
 public:
+    typedef std::function<bool(const Payment&)> Filter;
+    // Called once per row; return false to stop the walk
+    typedef std::function<bool(const Payment&)> Visitor;
+
     PaymentController();
 
     bool addPayment(const Payment& payment);
@@ -15,6 +22,10 @@ public:
 
     QList<Payment> getAllPayments();
     QList<Payment> getPaymentsByStudent(int studentId);
+    bool forEachPayment(const Filter& filter, const Visitor& visit);
+
+private:
+    static Payment fromRow(const QSqlQuery& query);
 };
 
 #endif // PAYMENTCONTROLLER_H
@@ -1,30 +1,31 @@
 #include "professorcontroller.h"
-#include "../database/dbconnection.h"
-#include "../database/queries.h"
-#include <QSqlQuery>
-#include <QSqlError>
+#include "../dao/sql_professor_dao.h"
+#include "searchindex.h"
+#include "authservice.h"
+#include "../database/changebus.h"
 #include <QDebug>
 
 /**
  * Constructor for the ProfessorController class
+ * @param dao - Where professors are stored; the configured database if null
  */
-ProfessorController::ProfessorController() {}
+ProfessorController::ProfessorController(std::shared_ptr<ProfessorDAO> dao)
+    : m_dao(dao ? dao : std::make_shared<SqlProfessorDAO>())
+{
+}
 
 /**
  * Adds a new professor profile to the database
- * @param prof - The Professor object containing details
+ * @param prof - The Professor object containing details; receives the new ID
  * @return True if successful, otherwise false
  */
-bool ProfessorController::addProfessor(const Professor& prof)
+bool ProfessorController::addProfessor(Professor& prof)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::INSERT_PROFESSOR);
-    query.addBindValue(prof.userId());
-    query.addBindValue(prof.specialization());
-    query.addBindValue(prof.title());
-    query.addBindValue(prof.personalInfo());
-    query.addBindValue(prof.idNumber());
-    return query.exec();
+    if (!m_dao->insert(prof)) return false;
+    SearchIndex::instance().refreshProfessor(prof.id());
+    AuthService::instance().clearNegativeCache();
+    ChangeBus::instance().publish("professors", prof.id(), ChangeEvent::Inserted);
+    return true;
 }
 
 /**
@@ -34,14 +35,11 @@ bool ProfessorController::addProfessor(const Professor& prof)
  */
 bool ProfessorController::updateProfessor(const Professor& prof)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::UPDATE_PROFESSOR);
-    query.addBindValue(prof.specialization());
-    query.addBindValue(prof.title());
-    query.addBindValue(prof.personalInfo());
-    query.addBindValue(prof.idNumber());
-    query.addBindValue(prof.id());
-    return query.exec();
+    if (!m_dao->update(prof)) return false;
+    SearchIndex::instance().refreshProfessor(prof.id());
+    AuthService::instance().clearNegativeCache();
+    ChangeBus::instance().publish("professors", prof.id(), ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -51,10 +49,10 @@ bool ProfessorController::updateProfessor(const Professor& prof)
  */
 bool ProfessorController::deleteProfessor(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::DELETE_PROFESSOR);
-    query.addBindValue(id);
-    return query.exec();
+    if (!m_dao->remove(id)) return false;
+    SearchIndex::instance().remove(SearchIndex::Professor, id);
+    ChangeBus::instance().publish("professors", id, ChangeEvent::Deleted);
+    return true;
 }
 
 /**
@@ -64,22 +62,7 @@ bool ProfessorController::deleteProfessor(int id)
  */
 QList<Professor> ProfessorController::getAllProfessors()
 {
-    QList<Professor> list;
-    QSqlQuery query(DBConnection::instance().database());
-    if (query.exec(Queries::SELECT_ALL_PROFESSORS)) {
-        while (query.next()) {
-            Professor p;
-            p.setId(query.value("id").toInt());
-            p.setUserId(query.value("user_id").toInt());
-            p.setIdNumber(query.value("id_number").toString());
-            p.setSpecialization(query.value("specialization").toString());
-            p.setTitle(query.value("title").toString());
-            p.setPersonalInfo(query.value("personal_info").toString());
-            p.setFullName(query.value("full_name").toString());
-            list.append(p);
-        }
-    }
-    return list;
+    return m_dao->getAll();
 }
 
 /**
@@ -89,20 +72,7 @@ QList<Professor> ProfessorController::getAllProfessors()
  */
 Professor ProfessorController::getProfessorByUserId(int userId)
 {
-    Professor p;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_PROFESSOR_BY_USER_ID);
-    query.addBindValue(userId);
-    if (query.exec() && query.next()) {
-        p.setId(query.value("id").toInt());
-        p.setUserId(query.value("user_id").toInt());
-        p.setIdNumber(query.value("id_number").toString());
-        p.setSpecialization(query.value("specialization").toString());
-        p.setTitle(query.value("title").toString());
-        p.setPersonalInfo(query.value("personal_info").toString());
-        p.setFullName(query.value("full_name").toString());
-    }
-    return p;
+    return m_dao->getByUserId(userId);
 }
 
 /**
@@ -112,18 +82,5 @@ Professor ProfessorController::getProfessorByUserId(int userId)
  */
 Professor ProfessorController::getProfessorById(int id)
 {
-    Professor p;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare("SELECT p.*, u.full_name FROM professors p JOIN users u ON p.user_id = u.id WHERE p.id = ?");
-    query.addBindValue(id);
-    if (query.exec() && query.next()) {
-        p.setId(query.value("id").toInt());
-        p.setUserId(query.value("user_id").toInt());
-        p.setIdNumber(query.value("id_number").toString());
-        p.setSpecialization(query.value("specialization").toString());
-        p.setTitle(query.value("title").toString());
-        p.setPersonalInfo(query.value("personal_info").toString());
-        p.setFullName(query.value("full_name").toString());
-    }
-    return p;
+    return m_dao->getById(id);
 }
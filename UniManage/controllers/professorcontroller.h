@@ -2,18 +2,23 @@
 #define PROFESSORCONTROLLER_H
 
 #include "../models/professor.h"
+#include "../dao/professor_dao.h"
 #include <QList>
+#include <memory>
 
 class ProfessorController
 {
 public:
-    ProfessorController();
-    bool addProfessor(const Professor& prof);
+    explicit ProfessorController(std::shared_ptr<ProfessorDAO> dao = nullptr);
+    bool addProfessor(Professor& prof);
     bool updateProfessor(const Professor& prof);
     bool deleteProfessor(int id);
     QList<Professor> getAllProfessors();
     Professor getProfessorByUserId(int userId);
     Professor getProfessorById(int id);
+
+private:
+    std::shared_ptr<ProfessorDAO> m_dao;
 };
 
 #endif // PROFESSORCONTROLLER_H
@@ -0,0 +1,217 @@
+#include "promotioncontroller.h"
+#include "batchjobcontroller.h"
+#include "academic_level_controller.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/tableversions.h"
+#include "../database/changebus.h"
+#include "../database/persistence.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+const QString PromotionController::LevelPromotionJob = "level_promotion";
+
+/**
+ * Constructor for the PromotionController class
+ */
+PromotionController::PromotionController() {}
+
+/**
+ * Retrieves the promotion job of a level for an academic year
+ * @param levelId - The ID of the academic level students are promoted from
+ * @param academicYear - The year the academic year started in
+ * @return The BatchJob (ID 0 if the level was never promoted that year)
+ */
+BatchJob PromotionController::getPromotionJob(int levelId, int academicYear)
+{
+    return BatchJobController().getJob(LevelPromotionJob, scopeOf(levelId, academicYear));
+}
+
+/**
+ * Promotes the students of one level who passed it
+ * A student passes when they have at least one enrollment in the level's
+ * courses and no more than maxFailedCourses of them are below the pass mark.
+ * Passing students move to the next level (by level_number) and are enrolled
+ * in all of its courses with one INSERT ... SELECT per chunk; their old
+ * section is cleared so the section assigner can place them on the new
+ * level. On the last level they are marked graduated instead. Students
+ * who did not pass stay on the level with their enrollments untouched
+ * @param levelId - The ID of the academic level to promote from
+ * @param academicYear - The year the academic year started in (scopes the job)
+ * @param maxFailedCourses - Failed courses a student may carry and still pass
+ * @param chunkSize - Number of students per transaction
+ * @param progress - Optional callback invoked after every chunk
+ * @param restartCompleted - Re-run a job that already completed
+ * @return True if the run completed, false if it failed or was paused
+ */
+bool PromotionController::runLevelPromotion(int levelId, int academicYear, int maxFailedCourses, int chunkSize,
+                                            const ProgressCallback& progress, bool restartCompleted)
+{
+    if (levelId <= 0 || chunkSize <= 0) return false;
+
+    bool found = false;
+    const int nextLevel = nextLevelId(levelId, &found);
+    if (!found) return false;
+
+    QSqlDatabase& db = DBConnection::instance().database();
+    BatchJobController jobs;
+
+    DBQuery countQuery(db);
+    countQuery.prepare(Queries::COUNT_PROMOTION_CANDIDATES);
+    countQuery.addBindValue(levelId);
+    if (!countQuery.exec() || !countQuery.next()) {
+        qDebug() << "runLevelPromotion failed to count students:" << countQuery.lastError().text();
+        return false;
+    }
+    const int total = countQuery.value(0).toInt();
+
+    BatchJob job = jobs.startOrResume(LevelPromotionJob, scopeOf(levelId, academicYear), total);
+    if (job.id() == 0) return false;
+    if (job.status() == "Completed") {
+        if (!restartCompleted) return true;
+        if (!jobs.resetJob(job.id(), total)) return false;
+        job.setCheckpoint(0);
+        job.setProcessed(0);
+    }
+
+    int checkpoint = job.checkpoint();
+    int processed = job.processed();
+    if (progress && !progress(processed, total)) {
+        jobs.setStatus(job.id(), "Paused");
+        return false;
+    }
+
+    DBQuery bound(db);
+    bound.prepare(Queries::SELECT_PROMOTION_CHUNK_BOUND);
+    DBQuery enroll(db);
+    enroll.prepare(Queries::INSERT_PROMOTED_ENROLLMENTS_CHUNK);
+    DBQuery move(db);
+    move.prepare(nextLevel > 0 ? Queries::PROMOTE_STUDENTS_CHUNK : Queries::GRADUATE_STUDENTS_CHUNK);
+
+    int moved = 0;
+    while (true) {
+        bound.addBindValue(checkpoint);
+        bound.addBindValue(levelId);
+        bound.addBindValue(chunkSize);
+        if (!bound.exec() || !bound.next()) {
+            qDebug() << "runLevelPromotion failed to read chunk:" << bound.lastError().text();
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+        if (bound.value(0).isNull()) break;
+        const int upper = bound.value(0).toInt();
+        const int count = bound.value(1).toInt();
+        bound.finish();
+
+        if (!DBConnection::instance().beginTransaction(db)) {
+            qDebug() << "runLevelPromotion failed to start transaction:" << db.lastError().text();
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+
+        // Enroll first: both statements select passing students still on this level
+        bool ok = true;
+        if (nextLevel > 0) {
+            enroll.addBindValue(nextLevel);
+            enroll.addBindValue(levelId);
+            enroll.addBindValue(levelId);
+            enroll.addBindValue(checkpoint);
+            enroll.addBindValue(upper);
+            enroll.addBindValue(maxFailedCourses);
+            ok = enroll.exec();
+            if (!ok) qDebug() << "runLevelPromotion failed to enroll students:" << enroll.lastError().text();
+
+            move.addBindValue(nextLevel);
+        }
+        move.addBindValue(levelId);
+        move.addBindValue(levelId);
+        move.addBindValue(checkpoint);
+        move.addBindValue(upper);
+        move.addBindValue(maxFailedCourses);
+        if (ok) {
+            ok = move.exec();
+            if (!ok) qDebug() << "runLevelPromotion failed to move students:" << move.lastError().text();
+        }
+
+        ok = ok && BatchJobController::recordProgress(db, job.id(), upper, count)
+                && TableVersions::bump(db, "students_data")
+                && (nextLevel == 0 || TableVersions::bump(db, "enrollments"))
+                && DBConnection::instance().commit(db);
+        if (!ok) {
+            DBConnection::instance().rollback(db);
+            jobs.setStatus(job.id(), "Failed");
+            return false;
+        }
+        moved += move.numRowsAffected();
+        ChangeBus::instance().deliver("students_data", 0, ChangeEvent::Updated);
+        if (nextLevel > 0) ChangeBus::instance().deliver("enrollments", 0, ChangeEvent::Inserted);
+
+        checkpoint = upper;
+        processed += count;
+        if (progress && !progress(processed, total)) {
+            jobs.setStatus(job.id(), "Paused");
+            return false;
+        }
+    }
+
+    Persistence::logChange("Student", nextLevel > 0 ? "Promote" : "Graduate", levelId,
+                           QString("year %1, %2 student(s) in this run").arg(academicYear).arg(moved));
+    return jobs.setStatus(job.id(), "Completed");
+}
+
+/**
+ * Promotes every level for an academic year
+ * Levels run from the highest level_number down, so students moved up are
+ * not evaluated again against the courses of the level they just entered.
+ * Levels already completed for the year are skipped, so re-running after a
+ * pause or failure continues with the level that stopped
+ * @param academicYear - The year the academic year started in
+ * @param maxFailedCourses - Failed courses a student may carry and still pass
+ * @param chunkSize - Number of students per transaction
+ * @param progress - Optional callback invoked after every chunk of every level
+ * @return True if every level completed, false if one failed or was paused
+ */
+bool PromotionController::runCohortPromotion(int academicYear, int maxFailedCourses, int chunkSize,
+                                             const ProgressCallback& progress)
+{
+    const QList<AcademicLevel> levels = AcademicLevelController().getAllAcademicLevels();
+    for (int i = levels.size() - 1; i >= 0; --i) {
+        if (!runLevelPromotion(levels.at(i).id(), academicYear, maxFailedCourses, chunkSize, progress)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @param levelId - The ID of the academic level
+ * @param academicYear - The year the academic year started in
+ * @return The batch_jobs scope of that level's promotion
+ */
+QString PromotionController::scopeOf(int levelId, int academicYear)
+{
+    return QString("year:%1:level:%2").arg(academicYear).arg(levelId);
+}
+
+/**
+ * Finds the level students move to from a given level
+ * @param levelId - The ID of the current academic level
+ * @param ok - Set to true if the lookup succeeded, otherwise false
+ * @return The ID of the level with the next higher level_number, 0 if levelId is the last
+ */
+int PromotionController::nextLevelId(int levelId, bool* ok)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_NEXT_ACADEMIC_LEVEL);
+    query.addBindValue(levelId);
+
+    if (!query.exec()) {
+        qDebug() << "nextLevelId failed:" << query.lastError().text();
+        if (ok) *ok = false;
+        return 0;
+    }
+    if (ok) *ok = true;
+    return query.next() ? query.value(0).toInt() : 0;
+}
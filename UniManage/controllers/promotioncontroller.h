@@ -0,0 +1,39 @@
+#ifndef PROMOTIONCONTROLLER_H
+#define PROMOTIONCONTROLLER_H
+
+#include "../models/batch_job.h"
+#include <QString>
+#include <functional>
+
+/**
+ * Year-end cohort promotion
+ * Evaluates every active student of a level from their enrollments in the
+ * level's courses. Students who passed move to the next academic level and
+ * are enrolled in its courses; students who passed the last level are marked
+ * graduated. Each chunk of students_data.id is one transaction holding the
+ * INSERT ... SELECT of the new enrollments, the level UPDATE and the job
+ * checkpoint, so an interrupted run resumes where it stopped
+ */
+class PromotionController
+{
+public:
+    // Receives (processed, total) for the level being promoted; returning false pauses the run
+    typedef std::function<bool(int, int)> ProgressCallback;
+
+    static const QString LevelPromotionJob;
+
+    PromotionController();
+
+    BatchJob getPromotionJob(int levelId, int academicYear);
+    bool runLevelPromotion(int levelId, int academicYear, int maxFailedCourses = 0, int chunkSize = 2000,
+                           const ProgressCallback& progress = ProgressCallback(),
+                           bool restartCompleted = false);
+    bool runCohortPromotion(int academicYear, int maxFailedCourses = 0, int chunkSize = 2000,
+                            const ProgressCallback& progress = ProgressCallback());
+
+private:
+    static QString scopeOf(int levelId, int academicYear);
+    static int nextLevelId(int levelId, bool* ok);
+};
+
+#endif // PROMOTIONCONTROLLER_H
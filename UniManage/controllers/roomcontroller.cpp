@@ -1,10 +1,12 @@
 #include "roomcontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
 #include "../database/persistence.h"
+#include "../database/changebus.h"
 
 /**
  * Constructor for the RoomController class
@@ -20,7 +22,7 @@ RoomController::RoomController() {}
 bool RoomController::addRoom(const Room& room)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::INSERT_ROOM);
     query.addBindValue(room.name());
     query.addBindValue(room.type());
@@ -33,6 +35,7 @@ bool RoomController::addRoom(const Room& room)
     query.addBindValue(room.code());
     if (query.exec()) {
         Persistence::logChange(room.type(), "Create", query.lastInsertId().toInt(), room.name());
+        ChangeBus::instance().publish("rooms", query.lastInsertId().toInt(), ChangeEvent::Inserted);
         return true;
     }
     return false;
@@ -47,7 +50,7 @@ bool RoomController::addRoom(const Room& room)
 bool RoomController::updateRoom(const Room& room)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::UPDATE_ROOM);
     query.addBindValue(room.name());
     query.addBindValue(room.type());
@@ -61,6 +64,7 @@ bool RoomController::updateRoom(const Room& room)
     query.addBindValue(room.id());
     if (query.exec()) {
         Persistence::logChange(room.type(), "Edit", room.id(), room.name());
+        ChangeBus::instance().publish("rooms", room.id(), ChangeEvent::Updated);
         return true;
     }
     return false;
@@ -75,11 +79,12 @@ bool RoomController::updateRoom(const Room& room)
 bool RoomController::deleteRoom(int id)
 {
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::DELETE_ROOM);
     query.addBindValue(id);
     if (query.exec()) {
         Persistence::logChange("Facility", "Delete", id, "Removed Hall/Lab");
+        ChangeBus::instance().publish("rooms", id, ChangeEvent::Deleted);
         return true;
     }
     return false;
@@ -92,7 +97,7 @@ bool RoomController::deleteRoom(int id)
 QList<Room> RoomController::getAllRooms()
 {
     QList<Room> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (query.exec(Queries::SELECT_ALL_ROOMS)) {
         while (query.next()) {
             Room r;
@@ -122,13 +127,15 @@ QList<Room> RoomController::getAllRooms()
  */
 bool RoomController::addRoomSpec(int roomId, const QString& prodId, const QString& name, const QString& desc)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_ROOM_SPEC);
     query.addBindValue(roomId);
     query.addBindValue(prodId);
     query.addBindValue(name);
     query.addBindValue(desc);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("rooms", roomId, ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -139,7 +146,7 @@ bool RoomController::addRoomSpec(int roomId, const QString& prodId, const QStrin
 QList<RoomSpec> RoomController::getRoomSpecs(int roomId)
 {
     QList<RoomSpec> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_ROOM_SPECS);
     query.addBindValue(roomId);
     if (query.exec()) {
@@ -163,10 +170,12 @@ QList<RoomSpec> RoomController::getRoomSpecs(int roomId)
  */
 bool RoomController::deleteRoomSpecs(int roomId)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_ROOM_SPECS);
     query.addBindValue(roomId);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("rooms", roomId, ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -178,7 +187,7 @@ Room RoomController::getRoomById(int id)
 {
     Room r;
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::SELECT_ROOM_BY_ID);
     query.addBindValue(id);
     if (query.exec() && query.next()) {
@@ -1,6 +1,8 @@
 #include "schedulecontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -20,7 +22,7 @@ QList<Schedule> ScheduleController::getScheduleByProfessor(int professorId)
 {
     QList<Schedule> list;
     QSqlDatabase& db = DBConnection::instance().database();
-    QSqlQuery query(db);
+    DBQuery query(db);
     query.prepare(Queries::SELECT_SCHEDULE_BY_PROFESSOR);
     query.addBindValue(professorId);
     
@@ -56,28 +58,30 @@ bool ScheduleController::assignProfessorToCourse(int courseId, int professorId)
     QSqlDatabase& db = DBConnection::instance().database();
     
     // Check if a schedule entry already exists for this course
-    QSqlQuery check(db);
+    DBQuery check(db);
     check.prepare("SELECT id FROM schedules WHERE course_id = ? LIMIT 1");
     check.addBindValue(courseId);
     
     if (check.exec() && check.next()) {
         // Update existing entry
-        QSqlQuery update(db);
+        DBQuery update(db);
         update.prepare("UPDATE schedules SET professor_id = ? WHERE course_id = ?");
         update.addBindValue(professorId);
         update.addBindValue(courseId);
-        return update.exec();
+        if (!update.exec()) return false;
+        ChangeBus::instance().publish("schedules", 0, ChangeEvent::Updated);
+        return true;
     } else {
         // Insert new entry with default values for day/time/room
         // We need a roomId. We'll pick the first room or leave it 0 if DB allows (FK might fail if 0)
         
         int roomId = 0;
-        QSqlQuery roomQuery("SELECT id FROM rooms LIMIT 1", db);
+        DBQuery roomQuery("SELECT id FROM rooms LIMIT 1", db);
         if (roomQuery.exec() && roomQuery.next()) {
             roomId = roomQuery.value(0).toInt();
         } else {
             // No rooms exist! Create a default one to allow assignment
-            QSqlQuery createRoom(db);
+            DBQuery createRoom(db);
             createRoom.prepare("INSERT INTO rooms (name, type, capacity, ac_units, fans_count, lighting_points, computers_count, seating_description, code) "
                               "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?)");
             createRoom.addBindValue("Virtual/TBA");
@@ -92,13 +96,14 @@ bool ScheduleController::assignProfessorToCourse(int courseId, int professorId)
             
             if (createRoom.exec()) {
                 roomId = createRoom.lastInsertId().toInt();
+                ChangeBus::instance().publish("rooms", roomId, ChangeEvent::Inserted);
             } else {
                  qDebug() << "Failed to create default room:" << createRoom.lastError().text();
                  return false; 
             }
         }
         
-        QSqlQuery insert(db);
+        DBQuery insert(db);
         insert.prepare(Queries::INSERT_SCHEDULE);
         insert.addBindValue(courseId);
         insert.addBindValue(roomId);
@@ -111,6 +116,7 @@ bool ScheduleController::assignProfessorToCourse(int courseId, int professorId)
              qDebug() << "assignProfessorToCourse insert failed:" << insert.lastError().text();
              return false;
         }
+        ChangeBus::instance().publish("schedules", insert.lastInsertId().toInt(), ChangeEvent::Inserted);
         return true;
     }
 }
@@ -122,7 +128,7 @@ bool ScheduleController::assignProfessorToCourse(int courseId, int professorId)
  */
 bool ScheduleController::addSchedule(const Schedule& s)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_SCHEDULE);
     query.addBindValue(s.courseId());
     query.addBindValue(s.roomId());
@@ -130,7 +136,9 @@ bool ScheduleController::addSchedule(const Schedule& s)
     query.addBindValue(s.dayOfWeek());
     query.addBindValue(s.startTime().toString("HH:mm:ss"));
     query.addBindValue(s.endTime().toString("HH:mm:ss"));
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("schedules", query.lastInsertId().toInt(), ChangeEvent::Inserted);
+    return true;
 }
 
 /**
@@ -140,7 +148,7 @@ bool ScheduleController::addSchedule(const Schedule& s)
  */
 bool ScheduleController::updateSchedule(const Schedule& s)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_SCHEDULE);
     query.addBindValue(s.courseId());
     query.addBindValue(s.roomId());
@@ -149,7 +157,9 @@ bool ScheduleController::updateSchedule(const Schedule& s)
     query.addBindValue(s.startTime().toString("HH:mm:ss"));
     query.addBindValue(s.endTime().toString("HH:mm:ss"));
     query.addBindValue(s.id());
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("schedules", s.id(), ChangeEvent::Updated);
+    return true;
 }
 
 /**
@@ -159,10 +169,12 @@ bool ScheduleController::updateSchedule(const Schedule& s)
  */
 bool ScheduleController::deleteSchedule(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_SCHEDULE);
     query.addBindValue(id);
-    return query.exec();
+    if (!query.exec()) return false;
+    ChangeBus::instance().publish("schedules", id, ChangeEvent::Deleted);
+    return true;
 }
 
 /**
@@ -172,7 +184,7 @@ bool ScheduleController::deleteSchedule(int id)
 QList<Schedule> ScheduleController::getAllSchedules()
 {
     QList<Schedule> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (query.exec(Queries::SELECT_ALL_SCHEDULES)) {
         while (query.next()) {
             Schedule s;
@@ -192,6 +204,27 @@ QList<Schedule> ScheduleController::getAllSchedules()
     return list;
 }
 
+/**
+ * Retrieves the rows shown in the admin schedules table
+ * @return One row per slot: ID, course, room, professor, day, start and end time
+ */
+QList<QStringList> ScheduleController::getScheduleTableRows()
+{
+    QList<QStringList> rows;
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    if (!query.exec(Queries::SELECT_SCHEDULE_TABLE_ROWS)) {
+        qDebug() << "getScheduleTableRows failed:" << query.lastError().text();
+        return rows;
+    }
+    while (query.next()) {
+        QStringList row;
+        for (int i = 0; i < 7; ++i) row << query.value(i).toString();
+        rows.append(row);
+    }
+    return rows;
+}
+
 /**
  * Retrieves schedule slots for a specific course
  * @param courseId - The ID of the course
@@ -200,7 +233,7 @@ QList<Schedule> ScheduleController::getAllSchedules()
 QList<Schedule> ScheduleController::getScheduleByCourse(int courseId)
 {
     QList<Schedule> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_SCHEDULE_BY_COURSE);
     query.addBindValue(courseId);
     
@@ -230,7 +263,7 @@ QList<Schedule> ScheduleController::getScheduleByCourse(int courseId)
 QList<Schedule> ScheduleController::getScheduleByLevel(int levelId)
 {
     QList<Schedule> list;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_SCHEDULE_BY_LEVEL);
     query.addBindValue(levelId);
     
@@ -251,3 +284,34 @@ QList<Schedule> ScheduleController::getScheduleByLevel(int levelId)
     }
     return list;
 }
+
+/**
+ * Retrieves the schedule slots of every course a student is enrolled in
+ * Single query replacing one getScheduleByCourse() call per enrollment
+ * @param studentId - The ID of the student (students_data.id)
+ * @return A list of Schedule objects
+ */
+QList<Schedule> ScheduleController::getScheduleByStudent(int studentId)
+{
+    QList<Schedule> list;
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_SCHEDULE_BY_STUDENT);
+    query.addBindValue(studentId);
+    
+    if (query.exec()) {
+        while (query.next()) {
+            Schedule s;
+            s.setId(query.value("id").toInt());
+            s.setCourseId(query.value("course_id").toInt());
+            s.setRoomId(query.value("room_id").toInt());
+            s.setProfessorId(query.value("professor_id").toInt());
+            s.setDayOfWeek(query.value("day_of_week").toString());
+            s.setStartTime(query.value("start_time").toTime());
+            s.setEndTime(query.value("end_time").toTime());
+            s.setCourseName(query.value("course_name").toString());
+            s.setRoomName(query.value("room_name").toString());
+            list.append(s);
+        }
+    }
+    return list;
+}
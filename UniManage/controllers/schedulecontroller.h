@@ -3,6 +3,7 @@
 
 #include "../models/schedule.h"
 #include <QList>
+#include <QStringList>
 
 class ScheduleController
 {
@@ -14,8 +15,10 @@ public:
     bool updateSchedule(const Schedule& s);
     bool deleteSchedule(int id);
     QList<Schedule> getAllSchedules();
+    QList<QStringList> getScheduleTableRows();
     QList<Schedule> getScheduleByCourse(int courseId);
     QList<Schedule> getScheduleByLevel(int levelId);
+    QList<Schedule> getScheduleByStudent(int studentId);
     bool assignProfessorToCourse(int courseId, int professorId);
 };
 
@@ -0,0 +1,469 @@
+#include "searchindex.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include <QSqlQuery>
+#include <QSqlRecord>
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <iterator>
+
+namespace {
+
+// Tombstones tolerated before the postings are rebuilt from the live documents
+const int MinDeadBeforeCompact = 1024;
+
+quint64 gramKey(const QChar* chars, int length)
+{
+    quint64 key = static_cast<quint64>(length) << 48;
+    for (int i = 0; i < length; ++i) {
+        key |= static_cast<quint64>(chars[i].unicode()) << (16 * (length - 1 - i));
+    }
+    return key;
+}
+
+bool isSeparator(QChar c)
+{
+    return c == QLatin1Char(' ') || c == QLatin1Char('\n');
+}
+
+} // namespace
+
+/**
+ * Constructor for the SearchIndex class
+ */
+SearchIndex::SearchIndex()
+    : m_deadCount(0), m_loaded(false)
+{
+}
+
+/**
+ * @return The process wide search index
+ */
+SearchIndex& SearchIndex::instance()
+{
+    static SearchIndex index;
+    return index;
+}
+
+/**
+ * Loads every searchable student, course and professor from the database
+ * The new index is built off-lock and swapped in, searches keep running on
+ * the previous one meanwhile
+ * @return True if all three sources were loaded, otherwise false
+ */
+bool SearchIndex::rebuild()
+{
+    std::vector<Document> fetched;
+    if (!fetchDocuments(Queries::SELECT_SEARCH_STUDENTS, 0, Student, fetched) ||
+        !fetchDocuments(Queries::SELECT_SEARCH_COURSES, 0, Course, fetched) ||
+        !fetchDocuments(Queries::SELECT_SEARCH_PROFESSORS, 0, Professor, fetched)) {
+        return false;
+    }
+
+    std::vector<Document> docs;
+    PostingMap postings;
+    QHash<qint64, int> docByKey;
+    docs.reserve(fetched.size());
+    docByKey.reserve(static_cast<int>(fetched.size()));
+    for (auto& doc : fetched) {
+        addDocument(docs, postings, docByKey, std::move(doc));
+    }
+
+    QWriteLocker locker(&m_lock);
+    m_docs.swap(docs);
+    m_postings.swap(postings);
+    m_docByKey.swap(docByKey);
+    m_deadCount = 0;
+    m_loaded = true;
+    return true;
+}
+
+/**
+ * @return True once rebuild() has succeeded
+ */
+bool SearchIndex::isLoaded() const
+{
+    QReadLocker locker(&m_lock);
+    return m_loaded;
+}
+
+/**
+ * @return The number of live documents
+ */
+int SearchIndex::size() const
+{
+    QReadLocker locker(&m_lock);
+    return m_docByKey.size();
+}
+
+/**
+ * Adds or replaces one entity (ignored until the index has been loaded)
+ * @param type - The entity type
+ * @param id - The entity ID (students_data.id, courses.id or professors.id)
+ * @param title - Display name
+ * @param subtitle - Secondary display text (student number, course code, ...)
+ * @param fields - Every searchable field
+ */
+void SearchIndex::upsert(EntityType type, int id, const QString& title, const QString& subtitle, const QStringList& fields)
+{
+    QWriteLocker locker(&m_lock);
+    upsertLocked(makeDocument(type, id, title, subtitle, fields));
+}
+
+/**
+ * Drops one entity from the results
+ * @param type - The entity type
+ * @param id - The entity ID
+ */
+void SearchIndex::remove(EntityType type, int id)
+{
+    QWriteLocker locker(&m_lock);
+    removeLocked(type, id);
+}
+
+/**
+ * Re-reads one student after a write, removing it if it is gone or soft deleted
+ * Does nothing until the index has been loaded
+ * @param studentId - The ID of the student
+ */
+void SearchIndex::refreshStudent(int studentId)
+{
+    refresh(Queries::SELECT_SEARCH_STUDENT_BY_ID, studentId, Student, studentId);
+}
+
+/**
+ * Re-reads one course after a write
+ * @param courseId - The ID of the course
+ */
+void SearchIndex::refreshCourse(int courseId)
+{
+    refresh(Queries::SELECT_SEARCH_COURSE_BY_ID, courseId, Course, courseId);
+}
+
+/**
+ * Re-reads one professor after a write
+ * @param professorId - The ID of the professor
+ */
+void SearchIndex::refreshProfessor(int professorId)
+{
+    refresh(Queries::SELECT_SEARCH_PROFESSOR_BY_ID, professorId, Professor, professorId);
+}
+
+/**
+ * Re-reads the student and professor profiles of a user whose full name changed
+ * @param userId - The ID of the user
+ */
+void SearchIndex::refreshUser(int userId)
+{
+    refresh(Queries::SELECT_SEARCH_STUDENTS_BY_USER, userId, Student, 0);
+    refresh(Queries::SELECT_SEARCH_PROFESSORS_BY_USER, userId, Professor, 0);
+}
+
+/**
+ * Runs one of the SELECT_SEARCH_* queries and upserts its rows
+ * @param sql - The query, with a single placeholder
+ * @param bindId - Value bound to the placeholder
+ * @param type - The entity type returned by the query
+ * @param id - Entity removed when the query returns no row (ignored when <= 0)
+ */
+void SearchIndex::refresh(const QString& sql, int bindId, EntityType type, int id)
+{
+    if (!isLoaded()) return;
+
+    std::vector<Document> fetched;
+    if (!fetchDocuments(sql, bindId, type, fetched)) return;
+
+    QWriteLocker locker(&m_lock);
+    if (fetched.empty() && id > 0) {
+        removeLocked(type, id);
+        return;
+    }
+    for (auto& doc : fetched) {
+        upsertLocked(std::move(doc));
+    }
+}
+
+/**
+ * Type-ahead search
+ * Every query word must match: words of three or more characters match any
+ * substring of a field token, shorter words match token prefixes
+ * Results are ranked exact name > name prefix > field prefix > substring,
+ * shorter names first within a rank
+ * @param text - The raw user input
+ * @param limit - Maximum number of hits
+ * @param typeMask - Combination of TypeMask flags
+ * @return The best hits, highest score first
+ */
+QList<SearchIndex::Hit> SearchIndex::search(const QString& text, int limit, int typeMask) const
+{
+    QList<Hit> hits;
+    const QString normalized = normalize(text);
+    if (normalized.isEmpty() || limit <= 0) return hits;
+    const QStringList words = normalized.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    QReadLocker locker(&m_lock);
+
+    std::vector<quint64> keys;
+    for (const QString& word : words) queryKeys(word, keys);
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+    std::vector<const std::vector<int>*> lists;
+    lists.reserve(keys.size());
+    for (quint64 key : keys) {
+        auto it = m_postings.constFind(key);
+        if (it == m_postings.constEnd()) return hits;
+        lists.push_back(&it.value());
+    }
+    std::sort(lists.begin(), lists.end(), [](const std::vector<int>* a, const std::vector<int>* b) {
+        return a->size() < b->size();
+    });
+
+    // Posting lists are sorted by document index, intersect smallest first
+    std::vector<int> candidates(*lists.front());
+    std::vector<int> scratch;
+    for (std::size_t i = 1; i < lists.size() && !candidates.empty(); ++i) {
+        scratch.clear();
+        std::set_intersection(candidates.begin(), candidates.end(),
+                              lists[i]->begin(), lists[i]->end(),
+                              std::back_inserter(scratch));
+        candidates.swap(scratch);
+    }
+
+    // Every candidate is scored; only the best `limit` are kept, in a heap
+    // whose front is the worst of them, so memory stays O(limit)
+    const auto better = [this](const std::pair<int, int>& a, const std::pair<int, int>& b) {
+        if (a.first != b.first) return a.first > b.first;
+        return m_docs[a.second].normalizedTitle < m_docs[b.second].normalizedTitle;
+    };
+    const std::size_t capacity = static_cast<std::size_t>(limit);
+    const QString fieldPrefix = QLatin1Char(' ') + normalized;
+    std::vector<std::pair<int, int>> scored; // (score, document index)
+    scored.reserve(std::min(capacity, candidates.size()));
+    for (int docIndex : candidates) {
+        const Document& doc = m_docs[docIndex];
+        if (!doc.alive || !(typeMask & (1 << doc.type))) continue;
+
+        int score;
+        if (doc.normalizedTitle == normalized) score = 1000;
+        else if (doc.normalizedTitle.startsWith(normalized)) score = 800;
+        else if (doc.text.contains(fieldPrefix)) score = 600;
+        else score = 400;
+
+        bool matches = true;
+        for (const QString& word : words) {
+            if (doc.text.contains(QLatin1Char(' ') + word)) {
+                score += 20;
+            } else if (word.size() < 3 || !doc.text.contains(word)) {
+                matches = false; // trigrams matched across different tokens
+                break;
+            }
+        }
+        if (!matches) continue;
+
+        score -= std::min<int>(doc.normalizedTitle.size(), 100);
+        const std::pair<int, int> entry(score, docIndex);
+        if (scored.size() < capacity) {
+            scored.push_back(entry);
+            std::push_heap(scored.begin(), scored.end(), better);
+        } else if (better(entry, scored.front())) {
+            std::pop_heap(scored.begin(), scored.end(), better);
+            scored.back() = entry;
+            std::push_heap(scored.begin(), scored.end(), better);
+        }
+    }
+
+    std::sort_heap(scored.begin(), scored.end(), better);
+    const std::size_t count = scored.size();
+
+    hits.reserve(static_cast<int>(count));
+    for (std::size_t i = 0; i < count; ++i) {
+        const Document& doc = m_docs[scored[i].second];
+        Hit hit;
+        hit.type = doc.type;
+        hit.id = doc.id;
+        hit.title = doc.title;
+        hit.subtitle = doc.subtitle;
+        hit.score = scored[i].first;
+        hits.append(hit);
+    }
+    return hits;
+}
+
+/**
+ * Lowercases text and collapses every run of non letter/digit characters to one space
+ * @param text - The raw text
+ * @return The normalized text
+ */
+QString SearchIndex::normalize(const QString& text)
+{
+    QString out;
+    out.reserve(text.size());
+    bool pendingSpace = false;
+    for (const QChar c : text) {
+        if (c.isLetterOrNumber()) {
+            if (pendingSpace && !out.isEmpty()) out += QLatin1Char(' ');
+            pendingSpace = false;
+            out += c.toLower();
+        } else {
+            pendingSpace = true;
+        }
+    }
+    return out;
+}
+
+qint64 SearchIndex::documentKey(EntityType type, int id)
+{
+    return (static_cast<qint64>(type) << 32) | static_cast<quint32>(id);
+}
+
+/**
+ * Collects the index keys of one token: its 1 and 2 character prefixes and all trigrams
+ */
+void SearchIndex::tokenKeys(const QString& token, std::vector<quint64>& keys)
+{
+    const QChar* chars = token.constData();
+    const int n = token.size();
+    if (n >= 1) keys.push_back(gramKey(chars, 1));
+    if (n >= 2) keys.push_back(gramKey(chars, 2));
+    for (int i = 0; i + 3 <= n; ++i) {
+        keys.push_back(gramKey(chars + i, 3));
+    }
+}
+
+/**
+ * Collects the keys a query word must hit: its trigrams, or its prefix key if shorter
+ */
+void SearchIndex::queryKeys(const QString& word, std::vector<quint64>& keys)
+{
+    const QChar* chars = word.constData();
+    const int n = word.size();
+    if (n < 3) {
+        keys.push_back(gramKey(chars, n));
+        return;
+    }
+    for (int i = 0; i + 3 <= n; ++i) {
+        keys.push_back(gramKey(chars + i, 3));
+    }
+}
+
+/**
+ * Appends a document and its postings
+ * Document indexes only grow, so every posting list stays sorted
+ */
+void SearchIndex::addDocument(std::vector<Document>& docs, PostingMap& postings, QHash<qint64, int>& docByKey, Document doc)
+{
+    const int docIndex = static_cast<int>(docs.size());
+
+    std::vector<quint64> keys;
+    const QString& text = doc.text;
+    int start = -1;
+    for (int i = 0; i <= text.size(); ++i) {
+        const bool boundary = i == text.size() || isSeparator(text.at(i));
+        if (!boundary && start < 0) start = i;
+        if (boundary && start >= 0) {
+            tokenKeys(text.mid(start, i - start), keys);
+            start = -1;
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+    for (quint64 key : keys) {
+        postings[key].push_back(docIndex);
+    }
+
+    docByKey.insert(documentKey(doc.type, doc.id), docIndex);
+    docs.push_back(std::move(doc));
+}
+
+/**
+ * Builds a document from raw field values
+ */
+SearchIndex::Document SearchIndex::makeDocument(EntityType type, int id, const QString& title, const QString& subtitle, const QStringList& fields)
+{
+    Document doc;
+    doc.type = type;
+    doc.id = id;
+    doc.title = title;
+    doc.subtitle = subtitle;
+    doc.normalizedTitle = normalize(title);
+    doc.alive = true;
+    for (const QString& field : fields) {
+        const QString normalized = normalize(field);
+        if (normalized.isEmpty()) continue;
+        if (!doc.text.isEmpty()) doc.text += QLatin1Char('\n');
+        doc.text += QLatin1Char(' ') + normalized;
+    }
+    return doc;
+}
+
+/**
+ * Reads documents from one of the SELECT_SEARCH_* queries
+ * Column 0 is the ID, column 1 the title, column 2 the subtitle and every
+ * column from 1 on is searchable
+ * @return True if the query succeeded, otherwise false
+ */
+bool SearchIndex::fetchDocuments(const QString& sql, int bindId, EntityType type, std::vector<Document>& out)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    query.prepare(sql);
+    if (bindId > 0) query.addBindValue(bindId);
+
+    if (!query.exec()) {
+        qDebug() << "SearchIndex fetch failed:" << query.lastError().text();
+        return false;
+    }
+
+    const int columns = query.record().count();
+    if (query.size() > 0) out.reserve(out.size() + query.size());
+    while (query.next()) {
+        QStringList fields;
+        for (int c = 1; c < columns; ++c) {
+            fields << query.value(c).toString();
+        }
+        out.push_back(makeDocument(type, query.value(0).toInt(), query.value(1).toString(),
+                                   columns > 2 ? query.value(2).toString() : QString(), fields));
+    }
+    return true;
+}
+
+void SearchIndex::upsertLocked(Document doc)
+{
+    if (!m_loaded) return;
+    removeLocked(doc.type, doc.id);
+    addDocument(m_docs, m_postings, m_docByKey, std::move(doc));
+}
+
+void SearchIndex::removeLocked(EntityType type, int id)
+{
+    auto it = m_docByKey.find(documentKey(type, id));
+    if (it == m_docByKey.end()) return;
+    m_docs[it.value()].alive = false;
+    m_docByKey.erase(it);
+    ++m_deadCount;
+
+    if (m_deadCount >= MinDeadBeforeCompact && m_deadCount * 4 > static_cast<int>(m_docs.size())) {
+        compactLocked();
+    }
+}
+
+/**
+ * Rebuilds the postings from the live documents, dropping tombstones
+ */
+void SearchIndex::compactLocked()
+{
+    std::vector<Document> docs;
+    PostingMap postings;
+    QHash<qint64, int> docByKey;
+    docs.reserve(m_docs.size() - static_cast<std::size_t>(m_deadCount));
+    for (auto& doc : m_docs) {
+        if (doc.alive) addDocument(docs, postings, docByKey, std::move(doc));
+    }
+    m_docs.swap(docs);
+    m_postings.swap(postings);
+    m_docByKey.swap(docByKey);
+    m_deadCount = 0;
+}
@@ -0,0 +1,98 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QHash>
+#include <QList>
+#include <QReadWriteLock>
+#include <QString>
+#include <QStringList>
+#include <vector>
+
+/**
+ * In-memory inverted index over students, courses and professors
+ * Every searchable field is normalized (lowercase letters and digits) and
+ * indexed by the trigrams of its tokens plus their 1 and 2 character
+ * prefixes, so type-ahead lookups never touch the database
+ * The index is loaded on first use and then kept current by the controllers,
+ * which call the refresh/remove functions after every successful write
+ */
+class SearchIndex
+{
+public:
+    enum EntityType {
+        Student = 0,
+        Course,
+        Professor
+    };
+
+    enum TypeMask {
+        StudentMask = 1 << Student,
+        CourseMask = 1 << Course,
+        ProfessorMask = 1 << Professor,
+        AllTypes = StudentMask | CourseMask | ProfessorMask
+    };
+
+    struct Hit {
+        EntityType type = Student;
+        int id = 0;
+        QString title;
+        QString subtitle;
+        int score = 0;
+    };
+
+    static SearchIndex& instance();
+
+    bool rebuild();
+    bool isLoaded() const;
+    int size() const;
+
+    void upsert(EntityType type, int id, const QString& title, const QString& subtitle, const QStringList& fields);
+    void remove(EntityType type, int id);
+
+    void refreshStudent(int studentId);
+    void refreshCourse(int courseId);
+    void refreshProfessor(int professorId);
+    void refreshUser(int userId);
+
+    QList<Hit> search(const QString& text, int limit = 20, int typeMask = AllTypes) const;
+
+    static QString normalize(const QString& text);
+
+private:
+    SearchIndex();
+    SearchIndex(const SearchIndex&) = delete;
+    SearchIndex& operator=(const SearchIndex&) = delete;
+
+    struct Document {
+        EntityType type;
+        int id;
+        QString title;
+        QString subtitle;
+        QString normalizedTitle;
+        QString text; // normalized fields, each token preceded by a space
+        bool alive;
+    };
+
+    typedef QHash<quint64, std::vector<int>> PostingMap;
+
+    static qint64 documentKey(EntityType type, int id);
+    static void tokenKeys(const QString& token, std::vector<quint64>& keys);
+    static void queryKeys(const QString& word, std::vector<quint64>& keys);
+    static void addDocument(std::vector<Document>& docs, PostingMap& postings, QHash<qint64, int>& docByKey, Document doc);
+    static bool fetchDocuments(const QString& sql, int bindId, EntityType type, std::vector<Document>& out);
+    static Document makeDocument(EntityType type, int id, const QString& title, const QString& subtitle, const QStringList& fields);
+
+    void upsertLocked(Document doc);
+    void removeLocked(EntityType type, int id);
+    void compactLocked();
+    void refresh(const QString& sql, int bindId, EntityType type, int id);
+
+    mutable QReadWriteLock m_lock;
+    std::vector<Document> m_docs;
+    QHash<qint64, int> m_docByKey;
+    PostingMap m_postings;
+    int m_deadCount;
+    bool m_loaded;
+};
+
+#endif // SEARCHINDEX_H
@@ -0,0 +1,220 @@
+#include "sectionassigner.h"
+#include "../database/dbconnection.h"
+#include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/tableversions.h"
+#include "../database/changebus.h"
+#include "../database/persistence.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QStringList>
+#include <QDebug>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Student IDs per UPDATE; stays under SQLite's default 999 placeholders with the 3 leading binds
+const int IdsPerStatement = 900;
+
+} // namespace
+
+/**
+ * Constructor for the SectionAssigner class
+ */
+SectionAssigner::SectionAssigner() {}
+
+/**
+ * Works out which section each unsectioned student of a level goes to
+ * Nothing is written; pass the result to apply()
+ * @param levelId - The ID of the academic level
+ * @param balanceDepartments - Spread every department evenly over the sections
+ *                             instead of only evening out the section totals
+ * @return The plan; empty if the level has no candidates or the reads failed
+ */
+SectionAssigner::Plan SectionAssigner::plan(int levelId, bool balanceDepartments)
+{
+    Plan result;
+    result.levelId = levelId;
+    if (levelId <= 0) return result;
+
+    QSqlDatabase& db = DBConnection::instance().database();
+
+    // One row per (section, department) with the seats already taken
+    QVector<Seats> sections;
+    DBQuery loads(db);
+    loads.setForwardOnly(true);
+    loads.prepare(Queries::SELECT_SECTION_LOADS_BY_LEVEL);
+    loads.addBindValue(levelId);
+    if (!loads.exec()) {
+        qDebug() << "SectionAssigner failed to read sections:" << loads.lastError().text();
+        return result;
+    }
+    while (loads.next()) {
+        const int sectionId = loads.value(0).toInt();
+        if (sections.isEmpty() || sections.last().sectionId != sectionId) {
+            Seats seats;
+            seats.sectionId = sectionId;
+            seats.capacity = qMax(0, loads.value(1).toInt());
+            seats.load = 0;
+            sections.append(seats);
+        }
+        const int students = loads.value(3).toInt();
+        if (students == 0) continue; // the LEFT JOIN row of an empty section
+        Seats& seats = sections[sections.size() - 1];
+        seats.load += students;
+        seats.byDepartment[loads.value(2).toInt()] += students;
+    }
+
+    QVector<Candidate> candidates;
+    DBQuery students(db);
+    students.setForwardOnly(true);
+    students.prepare(Queries::SELECT_UNSECTIONED_STUDENTS_BY_LEVEL);
+    students.addBindValue(levelId);
+    if (!students.exec()) {
+        qDebug() << "SectionAssigner failed to read students:" << students.lastError().text();
+        return result;
+    }
+    while (students.next()) {
+        Candidate candidate;
+        candidate.studentId = students.value(0).toInt();
+        candidate.departmentId = students.value(1).toInt();
+        candidates.append(candidate);
+    }
+    result.candidates = candidates.size();
+    if (balanceDepartments) interleave(candidates);
+
+    for (int i = 0; i < candidates.size(); ++i) {
+        const Candidate& candidate = candidates.at(i);
+        const int index = pick(sections, candidate.departmentId, balanceDepartments);
+        if (index < 0) {
+            // pick() only fails when no section has a free seat left
+            result.unplaced = candidates.size() - i;
+            break;
+        }
+        Seats& seats = sections[index];
+        ++seats.load;
+        ++seats.byDepartment[candidate.departmentId];
+        result.bySection[seats.sectionId].append(candidate.studentId);
+    }
+    return result;
+}
+
+/**
+ * Writes a plan in one transaction
+ * Students are moved with one UPDATE per section and batch of IDs; a student
+ * who was given a section of the level after the plan was made keeps it
+ * @param plan - The result of plan()
+ * @return True if successful (or there was nothing to assign), otherwise false
+ */
+bool SectionAssigner::apply(const Plan& plan)
+{
+    if (plan.bySection.isEmpty()) return true;
+
+    QSqlDatabase& db = DBConnection::instance().database();
+    if (!DBConnection::instance().beginTransaction(db)) {
+        qDebug() << "SectionAssigner failed to start transaction:" << db.lastError().text();
+        return false;
+    }
+
+    int assigned = 0;
+    for (auto it = plan.bySection.constBegin(); it != plan.bySection.constEnd(); ++it) {
+        const QVector<int>& ids = it.value();
+        for (int from = 0; from < ids.size(); from += IdsPerStatement) {
+            const int count = qMin(IdsPerStatement, ids.size() - from);
+            QStringList placeholders;
+            for (int i = 0; i < count; ++i) placeholders.append("?");
+
+            DBQuery query(db);
+            query.prepare(Queries::ASSIGN_SECTION_BATCH_HEAD + placeholders.join(", ") + ")");
+            query.addBindValue(it.key());
+            query.addBindValue(plan.levelId);
+            query.addBindValue(plan.levelId);
+            for (int i = from; i < from + count; ++i) query.addBindValue(ids.at(i));
+
+            if (!query.exec()) {
+                qDebug() << "SectionAssigner failed to assign students:" << query.lastError().text();
+                DBConnection::instance().rollback(db);
+                return false;
+            }
+            assigned += query.numRowsAffected();
+        }
+    }
+
+    if (!TableVersions::bump(db, "students_data") || !DBConnection::instance().commit(db)) {
+        qDebug() << "SectionAssigner failed to commit:" << db.lastError().text();
+        DBConnection::instance().rollback(db);
+        return false;
+    }
+    Persistence::logChange("Section", "Assign", plan.levelId, QString("%1 student(s)").arg(assigned));
+    ChangeBus::instance().deliver("students_data", 0, ChangeEvent::Updated);
+    return true;
+}
+
+/**
+ * Chooses the section for one student
+ * Fill ratios are compared by cross-multiplying, so no rounding is involved;
+ * the earlier section wins ties
+ * @param sections - The level's sections with their current loads
+ * @param departmentId - The student's department (0 for none)
+ * @param balanceDepartments - Compare the department's share first
+ * @return Index into sections, -1 if every section is full
+ */
+int SectionAssigner::pick(const QVector<Seats>& sections, int departmentId, bool balanceDepartments)
+{
+    int best = -1;
+    for (int i = 0; i < sections.size(); ++i) {
+        const Seats& seats = sections.at(i);
+        if (seats.load >= seats.capacity) continue;
+        if (best < 0) {
+            best = i;
+            continue;
+        }
+
+        const Seats& current = sections.at(best);
+        if (balanceDepartments) {
+            const qint64 mine = qint64(seats.byDepartment.value(departmentId)) * current.capacity;
+            const qint64 theirs = qint64(current.byDepartment.value(departmentId)) * seats.capacity;
+            if (mine != theirs) {
+                if (mine < theirs) best = i;
+                continue;
+            }
+        }
+        if (qint64(seats.load) * current.capacity < qint64(current.load) * seats.capacity) best = i;
+    }
+    return best;
+}
+
+/**
+ * Reorders candidates so every department is spread over the whole list
+ * The i-th of n students of a department is placed at (2i + 1) / 2n of the
+ * way through, so sections that fill up late still see every department.
+ * Expects candidates grouped by department, as the query returns them
+ * @param candidates - The candidates, reordered in place
+ */
+void SectionAssigner::interleave(QVector<Candidate>& candidates)
+{
+    struct Ranked {
+        qint64 position; // 2i + 1
+        qint64 scale;    // 2n
+        Candidate candidate;
+    };
+
+    std::vector<Ranked> ranked;
+    ranked.reserve(candidates.size());
+    for (int begin = 0; begin < candidates.size();) {
+        int end = begin;
+        while (end < candidates.size() && candidates.at(end).departmentId == candidates.at(begin).departmentId) ++end;
+        for (int i = begin; i < end; ++i) {
+            ranked.push_back({2 * qint64(i - begin) + 1, 2 * qint64(end - begin), candidates.at(i)});
+        }
+        begin = end;
+    }
+
+    std::stable_sort(ranked.begin(), ranked.end(), [](const Ranked& a, const Ranked& b) {
+        return a.position * b.scale < b.position * a.scale;
+    });
+    for (int i = 0; i < candidates.size(); ++i) {
+        candidates[i] = ranked[i].candidate;
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef SECTIONASSIGNER_H
+#define SECTIONASSIGNER_H
+
+#include <QMap>
+#include <QVector>
+
+/**
+ * Distributes the students of a level who have no section of that level
+ * (new intake, or promoted with last year's section) across the level's
+ * sections without exceeding their capacity
+ * Each student goes to the section with the most free room relative to its
+ * capacity; with department balancing the room is measured per department,
+ * so every section receives a similar share of each department. Planning is
+ * two queries and O(students x sections) in memory; the plan is applied in
+ * one transaction of batched UPDATE ... WHERE id IN (...) statements
+ */
+class SectionAssigner
+{
+public:
+    struct Plan {
+        int levelId = 0;
+        int candidates = 0;                    // students without a section of the level
+        int unplaced = 0;                      // left without one because every section is full
+        QMap<int, QVector<int>> bySection;     // section ID -> student IDs to move there
+    };
+
+    SectionAssigner();
+
+    Plan plan(int levelId, bool balanceDepartments);
+    bool apply(const Plan& plan);
+
+private:
+    struct Seats {
+        int sectionId;
+        int capacity;
+        int load;                       // students holding a seat, planned ones included
+        QMap<int, int> byDepartment;    // department ID (0 for none) -> students
+    };
+
+    struct Candidate {
+        int studentId;
+        int departmentId;
+    };
+
+    static int pick(const QVector<Seats>& sections, int departmentId, bool balanceDepartments);
+    static void interleave(QVector<Candidate>& candidates);
+};
+
+#endif // SECTIONASSIGNER_H
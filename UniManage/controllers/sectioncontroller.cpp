@@ -1,6 +1,8 @@
 #include "sectioncontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -19,7 +21,7 @@ SectionController::SectionController() {}
  */
 bool SectionController::addSection(const Section& section)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_SECTION);
     query.addBindValue(section.name());
     
@@ -41,6 +43,7 @@ bool SectionController::addSection(const Section& section)
         qDebug() << "Error adding section:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("sections", query.lastInsertId().toInt(), ChangeEvent::Inserted);
 	return true;
 }
 
@@ -52,7 +55,7 @@ bool SectionController::addSection(const Section& section)
  */
 bool SectionController::updateSection(const Section& section)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_SECTION);
     query.addBindValue(section.name());
     
@@ -72,6 +75,7 @@ bool SectionController::updateSection(const Section& section)
         qDebug() << "Error updating section:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("sections", section.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -83,13 +87,14 @@ bool SectionController::updateSection(const Section& section)
  */
 bool SectionController::deleteSection(int id)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_SECTION);
     query.addBindValue(id);
 	if (!query.exec()) {
         qDebug() << "Error deleting section:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("sections", id, ChangeEvent::Deleted);
 	return true;
 }
 
@@ -101,7 +106,7 @@ bool SectionController::deleteSection(int id)
 QList<Section> SectionController::getAllSections()
 {
 	QList<Section> sections;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (!query.exec(Queries::SELECT_ALL_SECTIONS)) {
         qDebug() << "Error retrieving sections:" << query.lastError().text();
         return sections;
@@ -134,7 +139,7 @@ QList<Section> SectionController::getAllSections()
 QList<Section> SectionController::getSectionsByCourse(int courseId)
 {
 	QList<Section> sections;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_SECTIONS_BY_COURSE);
     query.addBindValue(courseId);
     if (!query.exec()) {
@@ -166,7 +171,7 @@ QList<Section> SectionController::getSectionsByCourse(int courseId)
 Section SectionController::getSectionById(int id)
 {
     Section section;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::SELECT_SECTION_BY_ID);
     query.addBindValue(id);
     
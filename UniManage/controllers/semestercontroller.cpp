@@ -1,6 +1,8 @@
 #include "semestercontroller.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
+#include "../database/dbquery.h"
+#include "../database/changebus.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -18,14 +20,17 @@ SemesterController::SemesterController() {}
  */
 bool SemesterController::addSemester(const Semester& semester)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_SEMESTER);
     query.addBindValue(semester.year());
     query.addBindValue(semester.semester());
+    query.addBindValue(semester.startDate().isValid() ? QVariant(semester.startDate()) : QVariant());
+    query.addBindValue(semester.endDate().isValid() ? QVariant(semester.endDate()) : QVariant());
     if (!query.exec()) {
         qDebug() << "Error adding semester:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("semesters", query.lastInsertId().toInt(), ChangeEvent::Inserted);
 	return true;
 }
 
@@ -37,15 +42,18 @@ bool SemesterController::addSemester(const Semester& semester)
  */
 bool SemesterController::updateSemester(const Semester& semester)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::UPDATE_SEMESTER);
     query.addBindValue(semester.year());
     query.addBindValue(semester.semester());
+    query.addBindValue(semester.startDate().isValid() ? QVariant(semester.startDate()) : QVariant());
+    query.addBindValue(semester.endDate().isValid() ? QVariant(semester.endDate()) : QVariant());
     query.addBindValue(semester.id());
     if (!query.exec()) {
         qDebug() << "Error updating semester:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("semesters", semester.id(), ChangeEvent::Updated);
 	return true;
 }
 
@@ -57,13 +65,14 @@ bool SemesterController::updateSemester(const Semester& semester)
  */
 bool SemesterController::deleteSemester(int id)
 {
-	QSqlQuery query(DBConnection::instance().database());
+	DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::DELETE_SEMESTER);
     query.addBindValue(id);
     if (!query.exec()) {
         qDebug() << "Error deleting semester:" << query.lastError().text();
         return false;
 	}
+    ChangeBus::instance().publish("semesters", id, ChangeEvent::Deleted);
     return true;
 }
 
@@ -75,7 +84,7 @@ bool SemesterController::deleteSemester(int id)
 QList<Semester> SemesterController::getAllSemesters()
 {
 	QList<Semester> semesters;
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     if (!query.exec(Queries::SELECT_ALL_SEMESTERS)) {
         qDebug() << "Error retrieving semesters:" << query.lastError().text();
         return semesters;
@@ -86,6 +95,8 @@ QList<Semester> SemesterController::getAllSemesters()
         semester.setId(query.value("id").toInt());
         semester.setYear(query.value("year").toDateTime());
         semester.setSemester(query.value("semester").toInt());
+        semester.setStartDate(query.value("start_date").toDate());
+        semester.setEndDate(query.value("end_date").toDate());
         semester.setCreatedAt(query.value("created_at").toDateTime());
         semester.setUpdatedAt(query.value("updated_at").toDateTime());
         
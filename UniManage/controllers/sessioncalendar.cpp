@@ -0,0 +1,342 @@
+#include "sessioncalendar.h"
+#include "calendarindex.h"
+#include "schedulecontroller.h"
+#include "../models/semester.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include "../database/tableversions.h"
+#include <QSqlError>
+#include <QDebug>
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// Longest term a course can have; Session::day is 16 bits
+const int MaxTermDays = 0xffff;
+
+// Prefixes of the day names stored in schedules.day_of_week, Monday first
+const char* const DayPrefixes[] = { "mon", "tue", "wed", "thu", "fri", "sat", "sun" };
+
+/**
+ * @param time - A time of day
+ * @return Minutes past midnight, 0 for an invalid time
+ */
+quint16 minuteOf(const QTime& time)
+{
+    return time.isValid() ? quint16(time.hour() * 60 + time.minute()) : 0;
+}
+
+/**
+ * @param termStart - The first day of the term
+ * @param date - Any date
+ * @return Days from termStart to date, clamped to the range Session::day can hold
+ */
+qint64 offsetOf(const QDate& termStart, const QDate& date)
+{
+    return qBound<qint64>(-1, date.toJulianDay() - termStart.toJulianDay(), MaxTermDays);
+}
+
+} // namespace
+
+/**
+ * Default Constructor
+ * An empty session list, as returned for a course without a term
+ */
+CourseSessions::CourseSessions()
+    : m_courseId(0)
+{
+}
+
+/**
+ * @return The ID of the course
+ */
+int CourseSessions::courseId() const { return m_courseId; }
+
+/**
+ * @return The first day of the term, invalid if the course has no semester
+ */
+QDate CourseSessions::termStart() const { return m_termStart; }
+
+/**
+ * @return The last day of the term, invalid if the course has no semester
+ */
+QDate CourseSessions::termEnd() const { return m_termEnd; }
+
+/**
+ * @return The number of days from termStart() to termEnd(), 0 without a term
+ */
+int CourseSessions::termDays() const
+{
+    return m_termStart.isValid() ? int(m_termStart.daysTo(m_termEnd)) + 1 : 0;
+}
+
+/**
+ * @return True if the course has no sessions in its term
+ */
+bool CourseSessions::isEmpty() const { return m_sessions.isEmpty(); }
+
+/**
+ * @return Every session of the term, ordered by day and start time
+ */
+const QVector<CourseSessions::Session>& CourseSessions::sessions() const { return m_sessions; }
+
+/**
+ * @param session - One of sessions()
+ * @return The date of the session
+ */
+QDate CourseSessions::dateOf(const Session& session) const { return m_termStart.addDays(session.day); }
+
+/**
+ * @param session - One of sessions()
+ * @return The time the session starts
+ */
+QTime CourseSessions::startOf(const Session& session) const { return QTime(session.startMinute / 60, session.startMinute % 60); }
+
+/**
+ * @param session - One of sessions()
+ * @return The time the session ends
+ */
+QTime CourseSessions::endOf(const Session& session) const { return QTime(session.endMinute / 60, session.endMinute % 60); }
+
+/**
+ * Lists the sessions in a date range, e.g. one week for a timetable grid
+ * @param from - First day of the range
+ * @param to - Last day of the range (inclusive)
+ * @return The sessions in the range, ordered by day and start time
+ */
+QVector<CourseSessions::Session> CourseSessions::between(const QDate& from, const QDate& to) const
+{
+    QVector<Session> out;
+    if (m_sessions.isEmpty() || !from.isValid() || !to.isValid()) return out;
+
+    const qint64 first = offsetOf(m_termStart, from);
+    const qint64 last = offsetOf(m_termStart, to);
+    auto it = std::lower_bound(m_sessions.cbegin(), m_sessions.cend(), first,
+                               [](const Session& s, qint64 day) { return s.day < day; });
+    for (; it != m_sessions.cend() && it->day <= last; ++it) {
+        out.append(*it);
+    }
+    return out;
+}
+
+/**
+ * @return The number of distinct days the course meets in its term
+ */
+int CourseSessions::dayCount() const { return m_days.size(); }
+
+/**
+ * @param index - 0 to dayCount() - 1
+ * @return The date of that teaching day, invalid if out of range
+ */
+QDate CourseSessions::dayAt(int index) const
+{
+    if (index < 0 || index >= m_days.size()) return QDate();
+    return m_termStart.addDays(m_days.at(index));
+}
+
+/**
+ * Position of a date among the teaching days
+ * @param date - Any date
+ * @return The index of the date in the teaching days, -1 if the course does not meet then
+ */
+int CourseSessions::dayIndex(const QDate& date) const
+{
+    if (m_days.isEmpty() || !date.isValid()) return -1;
+    const qint64 offset = offsetOf(m_termStart, date);
+    auto it = std::lower_bound(m_days.cbegin(), m_days.cend(), offset);
+    return it != m_days.cend() && *it == offset ? int(it - m_days.cbegin()) : -1;
+}
+
+/**
+ * @param date - Any date
+ * @return The number of teaching days on or before date, i.e. sessions held so far
+ */
+int CourseSessions::daysUpTo(const QDate& date) const
+{
+    if (m_days.isEmpty() || !date.isValid()) return 0;
+    const qint64 offset = offsetOf(m_termStart, date);
+    return int(std::upper_bound(m_days.cbegin(), m_days.cend(), offset) - m_days.cbegin());
+}
+
+/**
+ * @param from - Any date
+ * @return The first teaching day on or after from, invalid if the term is over
+ */
+QDate CourseSessions::nextDay(const QDate& from) const
+{
+    if (m_days.isEmpty() || !from.isValid()) return QDate();
+    const qint64 offset = offsetOf(m_termStart, from);
+    auto it = std::lower_bound(m_days.cbegin(), m_days.cend(), offset);
+    return it != m_days.cend() ? m_termStart.addDays(*it) : QDate();
+}
+
+/**
+ * Teaching days as a bit mask, laid out like the AttendanceBitmap planes
+ * (bit i of word i / 64 is termStart() + i days)
+ * @param upTo - Teaching days after this date are left out
+ * @return termDays() bits rounded up to whole 64-bit words
+ */
+QVector<quint64> CourseSessions::dayMask(const QDate& upTo) const
+{
+    QVector<quint64> mask((termDays() + 63) / 64, 0);
+    const int held = daysUpTo(upTo);
+    for (int i = 0; i < held; ++i) {
+        const quint16 day = m_days.at(i);
+        mask[day / 64] |= quint64(1) << (day % 64);
+    }
+    return mask;
+}
+
+/**
+ * Constructor for the SessionCalendar class
+ * Nothing is expanded until a course is asked for
+ */
+SessionCalendar::SessionCalendar()
+    : m_signature(-1)
+{
+}
+
+/**
+ * @return The process wide session calendar
+ */
+SessionCalendar& SessionCalendar::instance()
+{
+    static SessionCalendar calendar;
+    return calendar;
+}
+
+/**
+ * Returns the sessions of a course, expanding them on first use
+ * The whole cache is dropped when one of the dependencies() changed since it
+ * was filled; without change counters nothing is cached
+ * The result is immutable and can be kept for a batch of lookups
+ * @param courseId - The ID of the course
+ * @return The course's sessions (empty when it has no semester or schedule)
+ */
+SessionCalendar::Handle SessionCalendar::sessions(int courseId)
+{
+    QHash<QString, qint64> versions;
+    const bool tracked = TableVersions::fetch(versions);
+    const qint64 signature = TableVersions::combined(versions, dependencies());
+    {
+        QMutexLocker locker(&m_mutex);
+        if (!tracked || signature != m_signature) {
+            m_courses.clear();
+            m_signature = tracked ? signature : -1;
+        }
+        Handle cached = m_courses.value(courseId);
+        if (cached) return cached;
+    }
+
+    // Expand outside the lock; two threads may expand the same course once each
+    Handle expanded = expand(courseId);
+    if (tracked) {
+        QMutexLocker locker(&m_mutex);
+        if (m_signature == signature) m_courses.insert(courseId, expanded);
+    }
+    return expanded;
+}
+
+/**
+ * Drops every expanded course
+ */
+void SessionCalendar::invalidate()
+{
+    QMutexLocker locker(&m_mutex);
+    m_courses.clear();
+    m_signature = -1;
+}
+
+/**
+ * Lists the tables the sessions are computed from
+ * @return Table names as used with TableVersions::bump()
+ */
+QStringList SessionCalendar::dependencies()
+{
+    return {"courses", "semesters", "schedules", "calendar_events"};
+}
+
+/**
+ * @param name - A schedules.day_of_week value ("Monday", "mon", any case)
+ * @return The Qt day number (1 = Monday ... 7 = Sunday), 0 if not a day name
+ */
+int SessionCalendar::dayOfWeek(const QString& name)
+{
+    const QString prefix = name.trimmed().left(3).toLower();
+    for (int i = 0; i < 7; ++i) {
+        if (prefix == DayPrefixes[i]) return i + 1;
+    }
+    return 0;
+}
+
+/**
+ * Builds the session list of one course
+ * One query for the term, one for the weekly slots and one index lookup
+ * for the holidays of the term
+ * @param courseId - The ID of the course
+ * @return The sessions, empty if the course has no semester
+ */
+SessionCalendar::Handle SessionCalendar::expand(int courseId)
+{
+    std::shared_ptr<CourseSessions> result = std::make_shared<CourseSessions>();
+    result->m_courseId = courseId;
+
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_COURSE_TERM);
+    query.addBindValue(courseId);
+    if (!query.exec()) {
+        qDebug() << "SessionCalendar term lookup failed:" << query.lastError().text();
+        return result;
+    }
+    if (!query.next()) return result;
+
+    Semester semester;
+    semester.setId(query.value("id").toInt());
+    semester.setYear(query.value("year").toDateTime());
+    semester.setSemester(query.value("semester").toInt());
+    semester.setStartDate(query.value("start_date").toDate());
+    semester.setEndDate(query.value("end_date").toDate());
+
+    const QDate start = semester.termStart();
+    const QDate end = semester.termEnd();
+    if (!start.isValid() || !end.isValid() || end < start) return result;
+
+    const int length = int(qMin<qint64>(end.toJulianDay() - start.toJulianDay(), MaxTermDays - 1)) + 1;
+    result->m_termStart = start;
+    result->m_termEnd = start.addDays(length - 1);
+
+    std::vector<bool> holiday(length, false);
+    for (const CalendarEvent& e : CalendarIndex::instance().occurrences(start, result->m_termEnd)) {
+        if (e.eventType().compare("Holiday", Qt::CaseInsensitive) != 0) continue;
+        const QDate last = e.endDate().isValid() ? e.endDate() : e.startDate();
+        const qint64 from = qMax<qint64>(0, offsetOf(start, e.startDate()));
+        const qint64 to = qMin<qint64>(length - 1, offsetOf(start, last));
+        for (qint64 day = from; day <= to; ++day) holiday[day] = true;
+    }
+
+    for (const Schedule& slot : ScheduleController().getScheduleByCourse(courseId)) {
+        const int weekday = dayOfWeek(slot.dayOfWeek());
+        if (weekday == 0) continue;
+
+        CourseSessions::Session session;
+        session.startMinute = minuteOf(slot.startTime());
+        session.endMinute = minuteOf(slot.endTime());
+        session.scheduleId = slot.id();
+        for (int day = (weekday - start.dayOfWeek() + 7) % 7; day < length; day += 7) {
+            if (holiday[day]) continue;
+            session.day = quint16(day);
+            result->m_sessions.append(session);
+        }
+    }
+
+    std::sort(result->m_sessions.begin(), result->m_sessions.end(),
+              [](const CourseSessions::Session& a, const CourseSessions::Session& b) {
+                  return a.day != b.day ? a.day < b.day : a.startMinute < b.startMinute;
+              });
+    for (const CourseSessions::Session& s : result->m_sessions) {
+        if (result->m_days.isEmpty() || result->m_days.last() != s.day) result->m_days.append(s.day);
+    }
+    return result;
+}
@@ -0,0 +1,95 @@
+#ifndef SESSIONCALENDAR_H
+#define SESSIONCALENDAR_H
+
+#include <QDate>
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QStringList>
+#include <QTime>
+#include <QVector>
+#include <memory>
+
+/**
+ * Every class meeting of one course in its term
+ * Dates are stored as day offsets from the term start and times as minutes
+ * past midnight, so a full term of a course is a few hundred bytes.
+ * Sessions are ordered by day, then start time; dayAt() lists the distinct
+ * teaching days, which is what attendance is recorded against
+ */
+class CourseSessions
+{
+public:
+    struct Session {
+        quint16 day;         // days after termStart()
+        quint16 startMinute;
+        quint16 endMinute;
+        int scheduleId;      // the weekly schedules row it was expanded from
+    };
+
+    CourseSessions();
+
+    int courseId() const;
+    QDate termStart() const;
+    QDate termEnd() const;
+    int termDays() const;
+    bool isEmpty() const;
+
+    const QVector<Session>& sessions() const;
+    QDate dateOf(const Session& session) const;
+    QTime startOf(const Session& session) const;
+    QTime endOf(const Session& session) const;
+    QVector<Session> between(const QDate& from, const QDate& to) const;
+
+    int dayCount() const;
+    QDate dayAt(int index) const;
+    int dayIndex(const QDate& date) const;
+    int daysUpTo(const QDate& date) const;
+    QDate nextDay(const QDate& from) const;
+    QVector<quint64> dayMask(const QDate& upTo) const;
+
+private:
+    friend class SessionCalendar;
+
+    int m_courseId;
+    QDate m_termStart;
+    QDate m_termEnd;
+    QVector<Session> m_sessions;
+    QVector<quint16> m_days; // distinct Session::day values, ascending
+};
+
+/**
+ * Expands the weekly schedules of a course into its dated sessions
+ * A course's term comes from its semester (see Semester::termStart()),
+ * its weekly slots from schedules, and days covered by a Holiday calendar
+ * event (recurring ones included) are skipped. Courses are expanded on
+ * first use and kept until the change counter of one of dependencies()
+ * moves, so attendance percentages, unrecorded-session checks and weekly
+ * grids need no per-date queries
+ */
+class SessionCalendar
+{
+public:
+    typedef std::shared_ptr<const CourseSessions> Handle;
+
+    static SessionCalendar& instance();
+
+    Handle sessions(int courseId);
+    void invalidate();
+
+    static QStringList dependencies();
+    static int dayOfWeek(const QString& name);
+
+private:
+    SessionCalendar();
+    SessionCalendar(const SessionCalendar&) = delete;
+    SessionCalendar& operator=(const SessionCalendar&) = delete;
+
+    static Handle expand(int courseId);
+
+    QMutex m_mutex;
+    QHash<int, Handle> m_courses;
+    qint64 m_signature;
+};
+
+#endif // SESSIONCALENDAR_H
@@ -1,107 +1,72 @@
 #include "studentcontroller.h"
+#include "../dao/sql_student_dao.h"
 #include "../database/dbconnection.h"
 #include "../database/queries.h"
-#include <QSqlQuery>
+#include "../database/dbquery.h"
 #include <QSqlError>
 #include <QDebug>
-#include <QDateTime>
 #include "../database/persistence.h"
+#include "searchindex.h"
+#include "authservice.h"
+#include "../database/changebus.h"
+#include "ledgercontroller.h"
 
 /**
  * Constructor for the StudentController class
+ * @param dao - Where student profiles are stored; the configured database if null
  */
-StudentController::StudentController() {}
+StudentController::StudentController(std::shared_ptr<StudentDAO> dao)
+    : m_dao(dao ? dao : std::make_shared<SqlStudentDAO>())
+{
+}
 
 //function to add student data
 /**
  * Adds a new student profile to the database
  * Also handles auto-enrollment in courses based on the academic level
  * Logs the creation event after successful insertion
- * @param student - The StudentData object containing details
+ * @param student - The StudentData object containing details; receives the new ID
  * @param error - Optional string pointer to store error messages
  * @return True if successful, otherwise false
  */
-bool StudentController::addStudent(const StudentData& student, QString* error)
+bool StudentController::addStudent(StudentData& student, QString* error)
 {
-	QSqlQuery query(DBConnection::instance().database());
-	query.prepare(Queries::INSERT_STUDENT_DATA);
-    query.addBindValue(student.userId());
-    query.addBindValue(student.studentNumber());
-    query.addBindValue(student.idNumber());
-    query.addBindValue(student.dob());
-    query.addBindValue(student.department());
-    
-    // department_id
-    if (student.departmentId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.departmentId());
-
-    // academic_level_id
-    if (student.academicLevelId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.academicLevelId());
-
-    // Handle nullable section_id
-    if (student.sectionId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.sectionId());
-
-    // college_id
-    if (student.collegeId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.collegeId());
-
-    query.addBindValue(student.tuitionFees());
-    query.addBindValue(student.seatNumber());
-    query.addBindValue(student.status());
-	if (!query.exec()) {
-        QString errText = query.lastError().text();
-        qDebug() << "Error adding student data:" << errText;
-        if (error) *error = errText;
+    if (!m_dao->insert(student)) {
+        if (error) *error = m_dao->lastError();
         return false;
-	}
+    }
+
+    int newStudentId = student.id();
 
-    int newStudentId = query.lastInsertId().toInt();
-    
     // Auto-enroll in courses for this academic level
     if (student.academicLevelId() > 0) {
         enrollStudentInLevelCourses(newStudentId, student.academicLevelId());
     }
 
+    SearchIndex::instance().refreshStudent(newStudentId);
+    AuthService::instance().clearNegativeCache();
     Persistence::logChange("Student", "Enroll", newStudentId, student.studentNumber());
-	return true;
+    ChangeBus::instance().publish("students_data", newStudentId, ChangeEvent::Inserted);
+    return true;
 }
 
 //function to update student data
 /**
  * Updates an existing student profile in the database
- * Logs the update event after successful execution
+ * The student's ledger row is rebuilt, as the tuition fees or college it is
+ * charged from may have changed. Logs the update event after successful execution
  * @param student - The StudentData object with updated details
  * @return True if successful, otherwise false
  */
 bool StudentController::updateStudent(const StudentData& student)
 {
-	QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::UPDATE_STUDENT_DATA);
-    query.addBindValue(student.idNumber());
-    query.addBindValue(student.dob());
-    query.addBindValue(student.department());
-    
-    if (student.departmentId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.departmentId());
-
-    if (student.academicLevelId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.academicLevelId());
-
-    query.addBindValue(student.sectionId());
-    if (student.collegeId() <= 0) query.addBindValue(QVariant());
-    else query.addBindValue(student.collegeId());
-    query.addBindValue(student.tuitionFees());
-    query.addBindValue(student.seatNumber());
-    query.addBindValue(student.status());
-    query.addBindValue(student.id());
-    if (!query.exec()) {
-        qDebug() << "Error updating student data:" << query.lastError().text();
-        return false;
-	}
+    if (!m_dao->update(student)) return false;
+    LedgerController().rebuildBalance(student.id());
+    SearchIndex::instance().refreshStudent(student.id());
+    AuthService::instance().clearNegativeCache();
     Persistence::logChange("Student", "Edit", student.id(), student.studentNumber());
-	return true;
+    ChangeBus::instance().publish("students_data", student.id(), ChangeEvent::Updated);
+    return true;
 }
 
 //function to delete student data (Soft Delete)
@@ -113,14 +78,10 @@ bool StudentController::updateStudent(const StudentData& student)
  */
 bool StudentController::deleteStudent(int id)
 {
-   QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SOFT_DELETE_STUDENT_DATA);
-	query.addBindValue(id);
-    if (!query.exec()) {
-        qDebug() << "Error soft deleting student data:" << query.lastError().text();
-        return false;
-	}
+    if (!m_dao->softDelete(id)) return false;
+    SearchIndex::instance().remove(SearchIndex::Student, id);
     Persistence::logChange("Student", "Trash", id, "Moved to Draft");
+    ChangeBus::instance().publish("students_data", id, ChangeEvent::Updated);
     return true;
 }
 
@@ -132,14 +93,10 @@ bool StudentController::deleteStudent(int id)
  */
 bool StudentController::restoreStudent(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::RESTORE_STUDENT_DATA);
-    query.addBindValue(id);
-    if (!query.exec()) {
-        qDebug() << "Error restoring student data:" << query.lastError().text();
-        return false;
-    }
+    if (!m_dao->restore(id)) return false;
+    SearchIndex::instance().refreshStudent(id);
     Persistence::logChange("Student", "Restore", id, "Restored from Draft");
+    ChangeBus::instance().publish("students_data", id, ChangeEvent::Updated);
     return true;
 }
 
@@ -152,48 +109,13 @@ bool StudentController::restoreStudent(int id)
  */
 bool StudentController::hardDeleteStudent(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    
-    // 1. Get user_id first
-    int userId = -1;
-    query.prepare("SELECT user_id FROM students_data WHERE id = ?");
-    query.addBindValue(id);
-    if (query.exec() && query.next()) {
-        userId = query.value(0).toInt();
-    }
-
-    // 2. Cascade Delete Dependencies (Payments, Attendance, Enrollments)
-    // Delete payments
-    query.prepare("DELETE FROM payments WHERE student_id = ?");
-    query.addBindValue(id);
-    query.exec();
-    
-    // Delete attendance logs (via enrollments)
-    query.prepare("DELETE FROM attendance_logs WHERE enrollment_id IN (SELECT id FROM enrollments WHERE student_id = ?)");
-    query.addBindValue(id);
-    query.exec();
-    
-    // Delete enrollments
-    query.prepare("DELETE FROM enrollments WHERE student_id = ?");
-    query.addBindValue(id);
-    query.exec();
-
-    // 3. Delete student profile
-    query.prepare(Queries::DELETE_STUDENT_DATA);
-    query.addBindValue(id);
-    if (!query.exec()) {
-        qDebug() << "Error permanently deleting student data:" << query.lastError().text();
-        return false;
-    }
-
-    // 4. Delete user account if found
-    if (userId > 0) {
-        query.prepare(Queries::DELETE_USER);
-        query.addBindValue(userId);
-        query.exec();
-    }
-
+    if (!m_dao->remove(id)) return false;
+    SearchIndex::instance().remove(SearchIndex::Student, id);
     Persistence::logChange("Student", "HardDelete", id, "Permanently Removed Profile and User");
+    ChangeBus::instance().publish("students_data", id, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("enrollments", 0, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("payments", 0, ChangeEvent::Deleted);
+    ChangeBus::instance().publish("users", 0, ChangeEvent::Deleted);
     return true;
 }
 
@@ -205,51 +127,22 @@ bool StudentController::hardDeleteStudent(int id)
  */
 QList<StudentData> StudentController::getAllStudents()
 {
-	QList<StudentData> students;
-	QSqlQuery query(DBConnection::instance().database());
-
-    if (!query.exec(Queries::SELECT_ALL_STUDENTS_DATA)) {
-        qDebug() << "Error retrieving students data:" << query.lastError().text();
-        return students;
-    }
+    return m_dao->getAll();
+}
 
-    int count = 0;
-    
-    while (query.next()) {
-        count++;
-        StudentData student;
-        student.setId(query.value("id").toInt());
-        student.setUserId(query.value("user_id").toInt());
-        student.setStudentNumber(query.value("student_number").toString());
-        student.setIdNumber(query.value("id_number").toString());
-        student.setDob(query.value("dob").toDateTime());
-        student.setDepartment(query.value("department").toString());
-        student.setDepartmentId(query.value("department_id").toInt());
-        student.setAcademicLevelId(query.value("academic_level_id").toInt());
-        student.setSectionId(query.value("section_id").toInt());
-        student.setCollegeId(query.value("college_id").toInt());
-        student.setTuitionFees(query.value("tuition_fees").toDouble());
-        student.setSeatNumber(query.value("seat_number").toString());
-        student.setStatus(query.value("status").toString());
-        student.setCreatedAt(query.value("created_at").toDateTime());
-        student.setUpdatedAt(query.value("updated_at").toDateTime());
-        
-        // Additional info from joins
-        student.setFullName(query.value("full_name").toString());
-        student.setUsername(query.value("username").toString());
-        student.setRole(query.value("role").toString());
-        
-        QString dName = query.value("dept_name").toString();
-        if(!dName.isEmpty()) student.setDepartment(dName);
-        
-        student.setLevelName(query.value("level_name").toString());
-        student.setCollegeName(query.value("college_name").toString());
-        student.setSectionName(query.value("section_name").toString());
-        
-        students.append(student);
-    }
-    
-	return students;
+/**
+ * Streams the active students to a callback one at a time, without
+ * materializing the whole list
+ * @param filter - Students it rejects are skipped; empty to visit all
+ * @param visit - Called once per student; return false to stop early
+ * @return False if the store could not be read
+ */
+bool StudentController::forEachStudent(const Filter& filter, const StudentDAO::Visitor& visit)
+{
+    if (!filter) return m_dao->forEach(visit);
+    return m_dao->forEach([&](const StudentData& s) {
+        return !filter(s) || visit(s);
+    });
 }
 
 // Get students in draft/trash
@@ -259,46 +152,7 @@ QList<StudentData> StudentController::getAllStudents()
  */
 QList<StudentData> StudentController::getDeletedStudents()
 {
-    QList<StudentData> students;
-    QSqlQuery query(DBConnection::instance().database());
-    
-    if (!query.exec(Queries::SELECT_DELETED_STUDENTS_DATA)) {
-        qDebug() << "Error retrieving deleted students data:" << query.lastError().text();
-        return students;
-    }
-    
-    while (query.next()) {
-        StudentData student;
-        student.setId(query.value("id").toInt());
-        student.setUserId(query.value("user_id").toInt());
-        student.setStudentNumber(query.value("student_number").toString());
-        student.setIdNumber(query.value("id_number").toString());
-        student.setDob(query.value("dob").toDateTime());
-        student.setDepartment(query.value("department").toString());
-        student.setDepartmentId(query.value("department_id").toInt());
-        student.setAcademicLevelId(query.value("academic_level_id").toInt());
-        student.setSectionId(query.value("section_id").toInt());
-        student.setCollegeId(query.value("college_id").toInt());
-        student.setTuitionFees(query.value("tuition_fees").toDouble());
-        student.setSeatNumber(query.value("seat_number").toString());
-        student.setStatus(query.value("status").toString());
-        student.setCreatedAt(query.value("created_at").toDateTime());
-        student.setUpdatedAt(query.value("updated_at").toDateTime());
-        
-        student.setFullName(query.value("full_name").toString());
-        student.setUsername(query.value("username").toString());
-        student.setRole(query.value("role").toString());
-        
-        QString dName = query.value("dept_name").toString();
-        if(!dName.isEmpty()) student.setDepartment(dName);
-        
-        student.setLevelName(query.value("level_name").toString());
-        student.setCollegeName(query.value("college_name").toString());
-        student.setSectionName(query.value("section_name").toString());
-        
-        students.append(student);
-    }
-    return students;
+    return m_dao->getDeleted();
 }
 
 //function to get student data by id
@@ -309,42 +163,17 @@ QList<StudentData> StudentController::getDeletedStudents()
  */
 StudentData StudentController::getStudentById(int id)
 {
-	StudentData student;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_STUDENT_DATA_BY_ID);
-    query.addBindValue(id);
-    if (!query.exec()) {
-        qDebug() << "Error retrieving student data by ID:" << query.lastError().text();
-        return student;
-    }
-    
-    if (query.next()) {
-        student.setId(query.value("id").toInt());
-        student.setUserId(query.value("user_id").toInt());
-        student.setStudentNumber(query.value("student_number").toString());
-        student.setIdNumber(query.value("id_number").toString());
-        student.setDob(query.value("dob").toDateTime());
-        student.setDepartment(query.value("department").toString());
-        student.setDepartmentId(query.value("department_id").toInt());
-        student.setAcademicLevelId(query.value("academic_level_id").toInt());
-        student.setSectionId(query.value("section_id").toInt());
-        student.setCollegeId(query.value("college_id").toInt());
-        student.setTuitionFees(query.value("tuition_fees").toDouble());
-        student.setSeatNumber(query.value("seat_number").toString());
-        student.setStatus(query.value("status").toString());
-        student.setCreatedAt(query.value("created_at").toDateTime());
-        student.setUpdatedAt(query.value("updated_at").toDateTime());
-        // Additional user info
-        student.setFullName(query.value("full_name").toString());
-        student.setUsername(query.value("username").toString());
-        
-        QString dName = query.value("dept_name").toString();
-        if(!dName.isEmpty()) student.setDepartment(dName);
-        student.setLevelName(query.value("level_name").toString());
-        student.setCollegeName(query.value("college_name").toString());
-        student.setSectionName(query.value("section_name").toString());
-	}
-	return student;
+    return m_dao->getById(id);
+}
+
+/**
+ * Retrieves several student profiles in one batched lookup
+ * @param ids - The IDs of the student data rows
+ * @return The students found, in no particular order
+ */
+QList<StudentData> StudentController::getStudentsByIds(const QList<int>& ids)
+{
+    return m_dao->getByIds(ids);
 }
 
 //function to get student data by user id
@@ -355,42 +184,7 @@ StudentData StudentController::getStudentById(int id)
  */
 StudentData StudentController::getStudentByUserId(int userId)
 {
-	StudentData student;
-	QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_STUDENT_DATA_BY_USER_ID);
-    query.addBindValue(userId);
-    if (!query.exec()) {
-        qDebug() << "Error retrieving student data by user ID:" << query.lastError().text();
-        return student;
-    }
-    
-    if (query.next()) {
-        student.setId(query.value("id").toInt());
-        student.setUserId(query.value("user_id").toInt());
-        student.setStudentNumber(query.value("student_number").toString());
-        student.setIdNumber(query.value("id_number").toString());
-        student.setDob(query.value("dob").toDateTime());
-        student.setDepartment(query.value("department").toString());
-        student.setDepartmentId(query.value("department_id").toInt());
-        student.setAcademicLevelId(query.value("academic_level_id").toInt());
-        student.setSectionId(query.value("section_id").toInt());
-        student.setCollegeId(query.value("college_id").toInt());
-        student.setTuitionFees(query.value("tuition_fees").toDouble());
-        student.setSeatNumber(query.value("seat_number").toString());
-        student.setStatus(query.value("status").toString());
-        student.setCreatedAt(query.value("created_at").toDateTime());
-        student.setUpdatedAt(query.value("updated_at").toDateTime());
-        // Additional user info
-        student.setFullName(query.value("full_name").toString());
-        student.setUsername(query.value("username").toString());
-        
-        QString dName = query.value("dept_name").toString();
-        if(!dName.isEmpty()) student.setDepartment(dName);
-        student.setLevelName(query.value("level_name").toString());
-        student.setCollegeName(query.value("college_name").toString());
-        student.setSectionName(query.value("section_name").toString());
-	}
-	return student;
+    return m_dao->getByUserId(userId);
 }
 
 //function to get student data by id number
@@ -401,42 +195,7 @@ StudentData StudentController::getStudentByUserId(int userId)
  */
 StudentData StudentController::getStudentByIdNumber(int IdNumber)
 {
-    StudentData student;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_STUDENT_DATA_BY_STUDENT_NUMBER);
-    query.addBindValue(IdNumber);
-    if (!query.exec()) {
-        qDebug() << "Error retrieving student data by ID number:" << query.lastError().text();
-        return student;
-    }
-    
-    if (query.next()) {
-        student.setId(query.value("id").toInt());
-        student.setUserId(query.value("user_id").toInt());
-        student.setStudentNumber(query.value("student_number").toString());
-        student.setIdNumber(query.value("id_number").toString());
-        student.setDob(query.value("dob").toDateTime());
-        student.setDepartment(query.value("department").toString());
-        student.setDepartmentId(query.value("department_id").toInt());
-        student.setAcademicLevelId(query.value("academic_level_id").toInt());
-        student.setSectionId(query.value("section_id").toInt());
-        student.setCollegeId(query.value("college_id").toInt());
-        student.setTuitionFees(query.value("tuition_fees").toDouble());
-        student.setSeatNumber(query.value("seat_number").toString());
-        student.setStatus(query.value("status").toString());
-        student.setCreatedAt(query.value("created_at").toDateTime());
-        student.setUpdatedAt(query.value("updated_at").toDateTime());
-        // Additional user info
-        student.setFullName(query.value("full_name").toString());
-        student.setUsername(query.value("username").toString());
-
-        QString dName = query.value("dept_name").toString();
-        if(!dName.isEmpty()) student.setDepartment(dName);
-        student.setLevelName(query.value("level_name").toString());
-        student.setCollegeName(query.value("college_name").toString());
-        student.setSectionName(query.value("section_name").toString());
-    }
-    return student;
+    return m_dao->getByStudentNumber(QString::number(IdNumber));
 }
 
 /**
@@ -448,7 +207,7 @@ StudentData StudentController::getStudentByIdNumber(int IdNumber)
 bool StudentController::enrollStudentInLevelCourses(int studentId, int levelId) {
     if (studentId <= 0 || levelId <= 0) return false;
     
-    QSqlQuery query(DBConnection::instance().database());
+    DBQuery query(DBConnection::instance().database());
     query.prepare(Queries::INSERT_ENROLLMENT_BATCH_BY_LEVEL);
     query.addBindValue(studentId);
     query.addBindValue(levelId);
@@ -461,5 +220,6 @@ bool StudentController::enrollStudentInLevelCourses(int studentId, int levelId)
             return false;
         }
     }
+    ChangeBus::instance().publish("enrollments", 0, ChangeEvent::Inserted);
     return true;
 }
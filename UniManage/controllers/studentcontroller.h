@@ -2,15 +2,20 @@
 #define STUDENTCONTROLLER_H
 
 #include "../models/student_data.h"
+#include "../dao/student_dao.h"
 #include <QList>
 #include <QString>
+#include <functional>
+#include <memory>
 
 class StudentController
 {
 public:
-    StudentController();
+    typedef std::function<bool(const StudentData&)> Filter;
+
+    explicit StudentController(std::shared_ptr<StudentDAO> dao = nullptr);
     
-    bool addStudent(const StudentData& student, QString* error = nullptr);
+    bool addStudent(StudentData& student, QString* error = nullptr);
     bool updateStudent(const StudentData& student);
     bool deleteStudent(int id);
     bool restoreStudent(int id);
@@ -18,12 +23,16 @@ public:
     
     QList<StudentData> getAllStudents();
     QList<StudentData> getDeletedStudents();
+    bool forEachStudent(const Filter& filter, const StudentDAO::Visitor& visit);
     StudentData getStudentById(int id);
+    QList<StudentData> getStudentsByIds(const QList<int>& ids);
     StudentData getStudentByUserId(int userId);
     StudentData getStudentByIdNumber(int IdNumber);
     
 private:
     bool enrollStudentInLevelCourses(int studentId, int levelId);
+
+    std::shared_ptr<StudentDAO> m_dao;
 };
 
 #endif // STUDENTCONTROLLER_H
@@ -0,0 +1,186 @@
+#include "studentsessioncache.h"
+#include "../database/tableversions.h"
+#include "../database/querytracker.h"
+
+namespace {
+
+const StudentSessionCache::Part LoadOrder[] = {
+    StudentSessionCache::ProfilePart,
+    StudentSessionCache::GradesPart,
+    StudentSessionCache::PaymentsPart,
+    StudentSessionCache::SchedulePart,
+    StudentSessionCache::CalendarPart
+};
+
+} // namespace
+
+/**
+ * Constructor for the StudentSessionCache class
+ * Nothing is loaded until the first refresh()
+ * @param userId - The user ID of the logged-in student
+ */
+StudentSessionCache::StudentSessionCache(int userId)
+    : m_userId(userId)
+{
+}
+
+/**
+ * Brings the cache up to date
+ * Counters are read before the data, so a write racing with the load is
+ * picked up by the next refresh instead of being missed
+ * @return The Part flags that were reloaded (0 when nothing changed)
+ */
+int StudentSessionCache::refresh()
+{
+    QueryTracker::Scope scope("StudentSessionCache::refresh");
+    QHash<QString, qint64> versions;
+    const bool tracked = TableVersions::fetch(versions);
+
+    const int previousStudentId = m_student.id();
+    const int previousLevelId = m_student.academicLevelId();
+
+    int reloaded = 0;
+    for (Part part : LoadOrder) {
+        const qint64 signature = TableVersions::combined(versions, dependencies(part));
+        bool stale = !tracked || !m_signatures.contains(part) || m_signatures.value(part) != signature;
+
+        // Everything else is keyed by the student ID and level of the profile
+        if (part != ProfilePart && (reloaded & ProfilePart) &&
+            (m_student.id() != previousStudentId || m_student.academicLevelId() != previousLevelId)) {
+            stale = true;
+        }
+        if (!stale) continue;
+
+        load(part);
+        if (tracked) m_signatures.insert(part, signature);
+        else m_signatures.remove(part);
+        reloaded |= part;
+    }
+    return reloaded;
+}
+
+/**
+ * Forces the given parts to reload on the next refresh()
+ * @param parts - Combination of Part flags
+ */
+void StudentSessionCache::invalidate(int parts)
+{
+    for (Part part : LoadOrder) {
+        if (parts & part) m_signatures.remove(part);
+    }
+}
+
+/**
+ * @return The student profile (id() is 0 if the profile is incomplete)
+ */
+const StudentData& StudentSessionCache::student() const
+{
+    return m_student;
+}
+
+/**
+ * @return The academic level of the student (id() is 0 if not assigned)
+ */
+const AcademicLevel& StudentSessionCache::level() const
+{
+    return m_level;
+}
+
+/**
+ * @return The student's enrollments with grades
+ */
+const QList<Enrollment>& StudentSessionCache::enrollments() const
+{
+    return m_enrollments;
+}
+
+/**
+ * @return The student's payments
+ */
+const QList<Payment>& StudentSessionCache::payments() const
+{
+    return m_payments;
+}
+
+/**
+ * @return The student's ledger balance
+ */
+const StudentBalance& StudentSessionCache::balance() const
+{
+    return m_balance;
+}
+
+/**
+ * @return Schedule slots of the enrolled courses, or of the student's level
+ *         when none of the enrolled courses is scheduled
+ */
+const QList<Schedule>& StudentSessionCache::schedules() const
+{
+    return m_schedules;
+}
+
+/**
+ * @return All academic calendar events
+ */
+const QList<CalendarEvent>& StudentSessionCache::events() const
+{
+    return m_events;
+}
+
+/**
+ * Lists the tables a part is loaded from
+ * @param part - The part
+ * @return Table names as used with TableVersions::bump()
+ */
+QStringList StudentSessionCache::dependencies(Part part)
+{
+    switch (part) {
+        case ProfilePart:
+            return {"students_data", "users", "academic_levels", "colleges", "departments", "sections"};
+        case GradesPart:
+            return {"enrollments", "courses"};
+        case PaymentsPart:
+            return {"payments", "tuition_charges", "students_data", "colleges"};
+        case SchedulePart:
+            return {"schedules", "courses", "rooms", "enrollments", "semesters", "calendar_events"};
+        case CalendarPart:
+            return {"calendar_events"};
+        default:
+            return {};
+    }
+}
+
+/**
+ * Reloads one part from the database
+ * @param part - The part to reload
+ */
+void StudentSessionCache::load(Part part)
+{
+    const int studentId = m_student.id();
+    switch (part) {
+        case ProfilePart:
+            m_student = m_studentController.getStudentByUserId(m_userId);
+            m_level = m_student.academicLevelId() > 0
+                ? m_academicLevelController.getAcademicLevelById(m_student.academicLevelId())
+                : AcademicLevel();
+            break;
+        case GradesPart:
+            m_enrollments = studentId > 0 ? m_enrollmentController.getEnrollmentsByStudent(studentId) : QList<Enrollment>();
+            break;
+        case PaymentsPart:
+            m_payments = studentId > 0 ? m_paymentController.getPaymentsByStudent(studentId) : QList<Payment>();
+            m_balance = studentId > 0 ? m_ledgerController.getBalance(studentId) : StudentBalance();
+            break;
+        case SchedulePart:
+            m_schedules = studentId > 0 ? m_scheduleController.getScheduleByStudent(studentId) : QList<Schedule>();
+            if (m_schedules.isEmpty() && m_student.academicLevelId() > 0) {
+                m_schedules = m_scheduleController.getScheduleByLevel(m_student.academicLevelId());
+            }
+            break;
+        case CalendarPart:
+            m_events = m_calendarController.getAllEvents();
+            break;
+        default:
+            break;
+    }
+}
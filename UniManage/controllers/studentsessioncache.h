@@ -0,0 +1,77 @@
+#ifndef STUDENTSESSIONCACHE_H
+#define STUDENTSESSIONCACHE_H
+
+#include "studentcontroller.h"
+#include "enrollmentcontroller.h"
+#include "paymentcontroller.h"
+#include "calendarcontroller.h"
+#include "academic_level_controller.h"
+#include "schedulecontroller.h"
+#include "ledgercontroller.h"
+#include "../models/student_data.h"
+#include "../models/academic_level.h"
+#include "../models/student_balance.h"
+#include <QHash>
+#include <QList>
+#include <QStringList>
+
+/**
+ * Data shown by the student portal for one logged-in student
+ * Each part remembers the change counters (see TableVersions) of the tables
+ * it was loaded from; refresh() reads all counters in one query and reloads
+ * only the parts whose tables changed since
+ * A refresh with nothing changed is that single round trip. Parts are still
+ * loaded with one query each (through their controllers) rather than one
+ * combined fetch: their rows have unrelated shapes, and loading them
+ * separately is what lets a payment or grade change reload just that part
+ */
+class StudentSessionCache
+{
+public:
+    enum Part {
+        ProfilePart = 0x01,
+        GradesPart = 0x02,
+        PaymentsPart = 0x04,
+        SchedulePart = 0x08,
+        CalendarPart = 0x10,
+        AllParts = 0x1f
+    };
+
+    explicit StudentSessionCache(int userId);
+
+    int refresh();
+    void invalidate(int parts = AllParts);
+
+    const StudentData& student() const;
+    const AcademicLevel& level() const;
+    const QList<Enrollment>& enrollments() const;
+    const QList<Payment>& payments() const;
+    const StudentBalance& balance() const;
+    const QList<Schedule>& schedules() const;
+    const QList<CalendarEvent>& events() const;
+
+private:
+    static QStringList dependencies(Part part);
+    void load(Part part);
+
+    int m_userId;
+    QHash<int, qint64> m_signatures; // Part -> combined table versions at load time
+
+    StudentData m_student;
+    AcademicLevel m_level;
+    QList<Enrollment> m_enrollments;
+    QList<Payment> m_payments;
+    StudentBalance m_balance;
+    QList<Schedule> m_schedules;
+    QList<CalendarEvent> m_events;
+
+    StudentController m_studentController;
+    EnrollmentController m_enrollmentController;
+    PaymentController m_paymentController;
+    CalendarController m_calendarController;
+    AcademicLevelController m_academicLevelController;
+    ScheduleController m_scheduleController;
+    LedgerController m_ledgerController;
+};
+
+#endif // STUDENTSESSIONCACHE_H
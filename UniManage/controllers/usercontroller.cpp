@@ -1,43 +1,35 @@
 #include "usercontroller.h"
-#include "../database/dbconnection.h"
-#include "../database/queries.h"
-#include <QSqlQuery>
-#include <QSqlError>
+#include "../dao/sql_user_dao.h"
+#include "searchindex.h"
+#include "authservice.h"
+#include "../database/changebus.h"
 #include <QDebug>
-#include <QDateTime>
-#include <QCryptographicHash>
 
 /**
  * Constructor for the UserController class
+ * @param dao - Where users are stored; the configured database if null
  */
-UserController::UserController() {}
+UserController::UserController(std::shared_ptr<UserDAO> dao)
+    : m_dao(dao ? dao : std::make_shared<SqlUserDAO>())
+{
+}
 
 // function to add user
 /**
  * Adds a new user to the system (student, professor, or admin)
- * Hashes the password using SHA-256 before storing
- * @param user - The User object containing details
+ * The store hashes the password using SHA-256 before saving it
+ * @param user - The User object containing details; receives the new ID
  * @param error - Optional string pointer to store error messages
  * @return True if successful, otherwise false
  */
-bool UserController::addUser(const User& user, QString* error)
+bool UserController::addUser(User& user, QString* error)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::INSERT_USER);
-    query.addBindValue(user.fullName());
-    query.addBindValue(user.username());
-    
-    // Always hash password before storing
-    QString hashed = QString(QCryptographicHash::hash(user.password().toUtf8(), QCryptographicHash::Sha256).toHex());
-    query.addBindValue(hashed);
-    
-    query.addBindValue(user.role());
-    if (!query.exec()) {
-        QString err = query.lastError().text();
-        qDebug() << "Error adding user:" << err;
-        if (error) *error = err;
+    if (!m_dao->insert(user)) {
+        if (error) *error = m_dao->lastError();
         return false;
     }
+    AuthService::instance().clearNegativeCache();
+    ChangeBus::instance().publish("users", user.id(), ChangeEvent::Inserted);
     return true;
 }
 
@@ -50,16 +42,10 @@ bool UserController::addUser(const User& user, QString* error)
  */
 bool UserController::updateUser(const User& user)
 {
-    QSqlQuery query(DBConnection::instance().database());
-	query.prepare(Queries::UPDATE_USER);
-    query.addBindValue(user.fullName());
-    query.addBindValue(user.password());
-    query.addBindValue(user.role());
-    query.addBindValue(user.id());
-    if (!query.exec()) {
-        qDebug() << "Error updating user:" << query.lastError().text();
-        return false;
-	}
+    if (!m_dao->update(user)) return false;
+    SearchIndex::instance().refreshUser(user.id());
+    AuthService::instance().clearNegativeCache();
+    ChangeBus::instance().publish("users", user.id(), ChangeEvent::Updated);
     return true;
 }
 
@@ -71,14 +57,9 @@ bool UserController::updateUser(const User& user)
  */
 bool UserController::deleteUser(int id)
 {
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::DELETE_USER);
-    query.addBindValue(id);
-	if (!query.exec()) {
-        qDebug() << "Error deleting user:" << query.lastError().text();
-        return false;
-    }
-	return true;
+    if (!m_dao->remove(id)) return false;
+    ChangeBus::instance().publish("users", id, ChangeEvent::Deleted);
+    return true;
 }
 
 //function to get all users
@@ -88,24 +69,7 @@ bool UserController::deleteUser(int id)
  */
 QList<User> UserController::getAllUsers()
 {
-    QList<User> users;
-	QSqlQuery query(DBConnection::instance().database());
-	if (!query.exec(Queries::SELECT_ALL_USERS)) {
-        qDebug() << "Error retrieving users:" << query.lastError().text();
-        return users;
-    }
-    while (query.next()) {
-        User user;
-        user.setId(query.value("id").toInt());
-        user.setFullName(query.value("full_name").toString());
-        user.setUsername(query.value("username").toString());
-        user.setPassword(query.value("password").toString());
-        user.setRole(query.value("role").toString());
-        user.setCreatedAt(query.value("created_at").toDateTime());
-        user.setUpdatedAt(query.value("updated_at").toDateTime());
-        users.append(user);
-	}
-	return users;
+    return m_dao->getAll();
 }
 
 //function to get user by username
@@ -116,24 +80,7 @@ QList<User> UserController::getAllUsers()
  */
 User UserController::getUserByUsername(const QString& username)
 {
-	User user;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_USER_BY_USERNAME);
-    query.addBindValue(username);
-    if (!query.exec()) {
-        qDebug() << "Error retrieving user by username:" << query.lastError().text();
-        return user;
-    }
-    if (query.next()) {
-        user.setId(query.value("id").toInt());
-        user.setFullName(query.value("full_name").toString());
-        user.setUsername(query.value("username").toString());
-        user.setPassword(query.value("password").toString());
-        user.setRole(query.value("role").toString());
-        user.setCreatedAt(query.value("created_at").toDateTime());
-        user.setUpdatedAt(query.value("updated_at").toDateTime());
-    }
-	return user;
+    return m_dao->getByUsername(username);
 }
 
 //function to get user by id
@@ -144,44 +91,18 @@ User UserController::getUserByUsername(const QString& username)
  */
 User UserController::getUserById(int id)
 {
-    User user;
-    QSqlQuery query(DBConnection::instance().database());
-    query.prepare(Queries::SELECT_USER_BY_ID);
-    query.addBindValue(id);
-    if (!query.exec()) {
-        qDebug() << "Error retrieving user by id:" << query.lastError().text();
-        return user;
-    }
-    if (query.next()) {
-        user.setId(query.value("id").toInt());
-        user.setFullName(query.value("full_name").toString());
-        user.setUsername(query.value("username").toString());
-        user.setPassword(query.value("password").toString());
-        user.setRole(query.value("role").toString());
-        user.setCreatedAt(query.value("created_at").toDateTime());
-        user.setUpdatedAt(query.value("updated_at").toDateTime());
-    }
-    return user;
+    return m_dao->getById(id);
 }
 
 //function to authenticate user using username and password
 /**
- * Authenticates a user by checking their username and hashed password
- * Note: The input password should be pre-hashed or hashed here before comparison
- * In this implementation, it assumes 'password' acts as the hash if it matches stored.
- * (Ideally, you should hash the input password here before comparison if the DB stores hashes)
+ * Authenticates a user by checking their username and password
+ * The password is hashed and compared with the stored hash
  * @param username - The username
- * @param password - The password string (or hash, depending on usage context)
+ * @param password - The password as typed
  * @return The authenticated User object if successful, otherwise an empty object
  */
 User UserController::authenticateUsingUsername(const QString& username, const QString& password)
 {
-    User u = getUserByUsername(username);
-    if (u.id() != 0) {
-        QString providedHash = QString(QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex());
-        if (u.password() == providedHash) {
-            return u;
-        }
-    }
-    return User(); 
+    return m_dao->authenticate(username, password);
 }
@@ -2,15 +2,17 @@
 #define USERCONTROLLER_H
 
 #include "../models/user.h"
+#include "../dao/user_dao.h"
 #include <QList>
 #include <QString>
+#include <memory>
 
 class UserController
 {
 public:
-    UserController();
+    explicit UserController(std::shared_ptr<UserDAO> dao = nullptr);
     
-    bool addUser(const User& user, QString* error = nullptr);
+    bool addUser(User& user, QString* error = nullptr);
     bool updateUser(const User& user);
     bool deleteUser(int id);
     
@@ -18,6 +20,9 @@ public:
     User getUserByUsername(const QString& username);
     User getUserById(int id);
     User authenticateUsingUsername(const QString& username, const QString& password);
+
+private:
+    std::shared_ptr<UserDAO> m_dao;
 };
 
 #endif // USERCONTROLLER_H
@@ -0,0 +1,30 @@
+#ifndef COURSE_DAO_H
+#define COURSE_DAO_H
+
+#include "../models/course.h"
+#include <QList>
+#include <QString>
+#include <functional>
+
+class CourseDAO
+{
+public:
+    // Called once per row; return false to stop the walk
+    typedef std::function<bool(const Course&)> Visitor;
+
+    virtual ~CourseDAO() = default;
+
+    virtual bool insert(Course& course) = 0;
+    virtual bool update(const Course& course) = 0;
+    virtual bool remove(int id) = 0;
+    virtual QList<Course> getAll() = 0;
+    virtual bool forEach(const Visitor& visit) = 0;
+    virtual Course getById(int id) = 0;
+    virtual QList<Course> getBySemester(int semesterId) = 0;
+    virtual QList<Course> getByProfessor(int professorId) = 0;
+
+    // Driver message for the last failed call, if the store has one
+    virtual QString lastError() const { return QString(); }
+};
+
+#endif // COURSE_DAO_H
\ No newline at end of file
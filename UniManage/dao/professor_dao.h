@@ -1,7 +1,7 @@
 #ifndef PROFESSOR_DAO_H
 #define PROFESSOR_DAO_H
 
-#include "../UniManage/models/professor.h"
+#include "../models/professor.h"
 #include <QList>
 #include <QString>
 
@@ -17,6 +17,9 @@ public:
     virtual Professor getById(int id) = 0;
     virtual Professor getByUserId(int userId) = 0;
     virtual Professor getByIdNumber(const QString& idNumber) = 0;
+
+    // Driver message for the last failed call, if the store has one
+    virtual QString lastError() const { return QString(); }
 };
 
 #endif // PROFESSOR_DAO_H
\ No newline at end of file
@@ -0,0 +1,287 @@
+#include "sql_course_dao.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include <QSqlError>
+#include <QDateTime>
+#include <QDebug>
+
+/**
+ * Constructor for the SqlCourseDAO class
+ */
+SqlCourseDAO::SqlCourseDAO() {}
+
+/**
+ * Inserts a course
+ * @param course - The course to store; receives the new ID
+ * @return True if successful, otherwise false
+ */
+bool SqlCourseDAO::insert(Course& course)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::INSERT_COURSE);
+    bindCourse(query, course);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "addCourse failed:" << m_lastError;
+        return false;
+    }
+    course.setId(query.lastInsertId().toInt());
+    return true;
+}
+
+/**
+ * Updates a course
+ * @param course - The course with updated details
+ * @return True if successful, otherwise false
+ */
+bool SqlCourseDAO::update(const Course& course)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_COURSE);
+    bindCourse(query, course);
+    query.addBindValue(course.id());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "updateCourse failed:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Deletes a course with its schedules, sections, enrollments and attendance
+ * @param id - The ID of the course
+ * @return True if the course was deleted, otherwise false
+ */
+bool SqlCourseDAO::remove(int id)
+{
+    QSqlDatabase& db = DBConnection::instance().database();
+
+    DBQuery delSch(db);
+    delSch.prepare("DELETE FROM schedules WHERE course_id = ?");
+    delSch.addBindValue(id);
+    delSch.exec();
+
+    DBQuery delSec(db);
+    delSec.prepare("DELETE FROM sections WHERE course_id = ?");
+    delSec.addBindValue(id);
+    delSec.exec();
+
+    // Attendance logs reference enrollments, so they go first
+    DBQuery delLogs(db);
+    delLogs.prepare("DELETE FROM attendance_logs WHERE enrollment_id IN (SELECT id FROM enrollments WHERE course_id = ?)");
+    delLogs.addBindValue(id);
+    delLogs.exec();
+
+    DBQuery delEnr(db);
+    delEnr.prepare("DELETE FROM enrollments WHERE course_id = ?");
+    delEnr.addBindValue(id);
+    delEnr.exec();
+
+    DBQuery query(db);
+    query.prepare(Queries::DELETE_COURSE);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "deleteCourse failed:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Retrieves all courses with their semester, department and assigned professors
+ * @return A list of Course objects
+ */
+QList<Course> SqlCourseDAO::getAll()
+{
+    QList<Course> list;
+    forEach([&list](const Course& c) {
+        list.append(c);
+        return true;
+    });
+    return list;
+}
+
+/**
+ * Streams every course off a forward-only cursor, decoding one row at a time
+ * @param visit - Called once per course; return false to stop early
+ * @return False if the query failed
+ */
+bool SqlCourseDAO::forEach(const Visitor& visit)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+
+    if (!query.exec(Queries::SELECT_ALL_COURSES)) {
+        m_lastError = query.lastError().text();
+        qDebug() << "getAllCourses failed:" << m_lastError;
+        // Fallback: try simple query
+        if (!query.exec("SELECT * FROM courses ORDER BY name")) {
+            return false;
+        }
+    }
+
+    while (query.next()) {
+        Course c = fromRow(query);
+        readTimestamps(query, c);
+        readSemester(query, c);
+        c.setAssignedProfessor(query.value("assigned_professors").toString());
+        c.setDepartmentId(query.value("department_id").toInt());
+        c.setDepartmentName(query.value("department_name").toString());
+        if (!visit(c)) break;
+    }
+    return true;
+}
+
+/**
+ * @param id - The ID of the course
+ * @return The course with its semester if found, otherwise an empty object
+ */
+Course SqlCourseDAO::getById(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_COURSE_BY_ID);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "getCourseById failed:" << m_lastError;
+        return Course();
+    }
+
+    Course c;
+    if (query.next()) {
+        c = fromRow(query);
+        readTimestamps(query, c);
+        readSemester(query, c);
+    }
+    return c;
+}
+
+/**
+ * @param semesterId - The ID of the semester
+ * @return The courses taught in that semester
+ */
+QList<Course> SqlCourseDAO::getBySemester(int semesterId)
+{
+    QList<Course> list;
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_COURSES_BY_SEMESTER);
+    query.addBindValue(semesterId);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "getCoursesBySemester failed:" << m_lastError;
+        return list;
+    }
+
+    while (query.next()) {
+        Course c = fromRow(query);
+        readTimestamps(query, c);
+        list.append(c);
+    }
+    return list;
+}
+
+/**
+ * @param professorId - The ID of the professor
+ * @return The courses the professor is scheduled to teach
+ */
+QList<Course> SqlCourseDAO::getByProfessor(int professorId)
+{
+    QList<Course> list;
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_COURSES_BY_PROFESSOR);
+    query.addBindValue(professorId);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "getCoursesByProfessor failed:" << m_lastError;
+        return list;
+    }
+
+    while (query.next()) {
+        Course c = fromRow(query);
+        readSemester(query, c);
+        list.append(c);
+    }
+    return list;
+}
+
+/**
+ * @return Driver message for the last failed call
+ */
+QString SqlCourseDAO::lastError() const
+{
+    return m_lastError;
+}
+
+/**
+ * Binds the columns shared by INSERT_COURSE and UPDATE_COURSE, in order
+ * @param query - The prepared statement
+ * @param course - The course to bind
+ */
+void SqlCourseDAO::bindCourse(DBQuery& query, const Course& course) const
+{
+    query.addBindValue(course.name());
+    query.addBindValue(course.description());
+    query.addBindValue(course.yearLevel());
+    query.addBindValue(course.creditHours());
+    query.addBindValue(course.semesterId());
+    query.addBindValue(course.departmentId());
+    query.addBindValue(course.maxGrade());
+    query.addBindValue(course.courseTypeName());
+}
+
+/**
+ * Builds a Course from the courses columns of the current row
+ * @param query - A query positioned on a row
+ */
+Course SqlCourseDAO::fromRow(const QSqlQuery& query)
+{
+    Course c(query.value("id").toInt(),
+             query.value("name").toString(),
+             query.value("description").toString(),
+             query.value("year_level").toInt(),
+             query.value("credit_hours").toInt(),
+             query.value("semester_id").toInt());
+    c.setMaxGrade(query.value("max_grade").toInt());
+    c.setCourseType(query.value("course_type").toString());
+    return c;
+}
+
+/**
+ * Reads created_at / updated_at, leaving invalid values unset
+ * @param query - A query positioned on a row
+ * @param course - The course to fill
+ */
+void SqlCourseDAO::readTimestamps(const QSqlQuery& query, Course& course)
+{
+    QString createdStr = query.value("created_at").toString();
+    if (!createdStr.isEmpty()) {
+        QDateTime dt = QDateTime::fromString(createdStr, Qt::ISODate);
+        if (dt.isValid()) course.setCreatedAt(dt);
+    }
+
+    QString updatedStr = query.value("updated_at").toString();
+    if (!updatedStr.isEmpty()) {
+        QDateTime dt = QDateTime::fromString(updatedStr, Qt::ISODate);
+        if (dt.isValid()) course.setUpdatedAt(dt);
+    }
+}
+
+/**
+ * Reads the joined semester year and number and builds the display name
+ * @param query - A query positioned on a row
+ * @param course - The course to fill
+ */
+void SqlCourseDAO::readSemester(const QSqlQuery& query, Course& course)
+{
+    QString semesterYear = query.value("semester_year").toString();
+    QString semesterNumber = query.value("semester_number").toString();
+    course.setSemesterYear(semesterYear);
+    course.setSemesterNumber(semesterNumber.toInt());
+
+    if (!semesterYear.isEmpty() || !semesterNumber.isEmpty()) {
+        course.setSemesterName(QString("%1 - Sem %2").arg(semesterYear).arg(semesterNumber));
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef SQL_COURSE_DAO_H
+#define SQL_COURSE_DAO_H
+
+#include "course_dao.h"
+#include "../models/course.h"
+#include <QList>
+#include <QString>
+
+class DBQuery;
+class QSqlQuery;
+
+/**
+ * CourseDAO backed by the courses table of the configured database
+ * remove() also deletes the course's schedules, sections, enrollments and
+ * their attendance logs.
+ */
+class SqlCourseDAO : public CourseDAO
+{
+public:
+    SqlCourseDAO();
+    ~SqlCourseDAO() override = default;
+
+    bool insert(Course& course) override;
+    bool update(const Course& course) override;
+    bool remove(int id) override;
+    QList<Course> getAll() override;
+    bool forEach(const Visitor& visit) override;
+    Course getById(int id) override;
+    QList<Course> getBySemester(int semesterId) override;
+    QList<Course> getByProfessor(int professorId) override;
+    QString lastError() const override;
+
+private:
+    void bindCourse(DBQuery& query, const Course& course) const;
+    static Course fromRow(const QSqlQuery& query);
+    static void readTimestamps(const QSqlQuery& query, Course& course);
+    static void readSemester(const QSqlQuery& query, Course& course);
+
+    QString m_lastError;
+};
+
+#endif // SQL_COURSE_DAO_H
@@ -0,0 +1,164 @@
+#include "sql_professor_dao.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include <QSqlError>
+#include <QDebug>
+
+/**
+ * Constructor for the SqlProfessorDAO class
+ */
+SqlProfessorDAO::SqlProfessorDAO() {}
+
+/**
+ * Inserts a professor profile for an existing user account
+ * @param professor - The profile to store; receives the new ID
+ * @return True if successful, otherwise false
+ */
+bool SqlProfessorDAO::insert(Professor& professor)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::INSERT_PROFESSOR);
+    query.addBindValue(professor.userId());
+    query.addBindValue(professor.specialization());
+    query.addBindValue(professor.title());
+    query.addBindValue(professor.personalInfo());
+    query.addBindValue(professor.idNumber());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error adding professor:" << m_lastError;
+        return false;
+    }
+    professor.setId(query.lastInsertId().toInt());
+    return true;
+}
+
+/**
+ * Updates a professor profile
+ * @param professor - The profile with updated details
+ * @return True if successful, otherwise false
+ */
+bool SqlProfessorDAO::update(const Professor& professor)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_PROFESSOR);
+    query.addBindValue(professor.specialization());
+    query.addBindValue(professor.title());
+    query.addBindValue(professor.personalInfo());
+    query.addBindValue(professor.idNumber());
+    query.addBindValue(professor.id());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error updating professor:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Deletes a professor profile; the user account is kept
+ * @param id - The ID of the professor
+ * @return True if successful, otherwise false
+ */
+bool SqlProfessorDAO::remove(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::DELETE_PROFESSOR);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error deleting professor:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @return All professors ordered by name
+ */
+QList<Professor> SqlProfessorDAO::getAll()
+{
+    QList<Professor> list;
+    DBQuery query(DBConnection::instance().database());
+    if (!query.exec(Queries::SELECT_ALL_PROFESSORS)) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving professors:" << m_lastError;
+        return list;
+    }
+    while (query.next()) {
+        list.append(fromRow(query));
+    }
+    return list;
+}
+
+/**
+ * @param id - The ID of the professor
+ * @return The professor if found, otherwise an empty object
+ */
+Professor SqlProfessorDAO::getById(int id)
+{
+    return fetchOne(Queries::SELECT_PROFESSOR_BY_ID, id);
+}
+
+/**
+ * @param userId - The ID of the professor's user account
+ * @return The professor if found, otherwise an empty object
+ */
+Professor SqlProfessorDAO::getByUserId(int userId)
+{
+    return fetchOne(Queries::SELECT_PROFESSOR_BY_USER_ID, userId);
+}
+
+/**
+ * @param idNumber - The professor's national ID number
+ * @return The professor if found, otherwise an empty object
+ */
+Professor SqlProfessorDAO::getByIdNumber(const QString& idNumber)
+{
+    return fetchOne(Queries::SELECT_PROFESSOR_BY_ID_NUMBER, idNumber);
+}
+
+/**
+ * @return Driver message for the last failed call
+ */
+QString SqlProfessorDAO::lastError() const
+{
+    return m_lastError;
+}
+
+/**
+ * Runs a single-row lookup
+ * @param sql - A professor query with one placeholder
+ * @param key - The value bound to it
+ * @return The professor if found, otherwise an empty object
+ */
+Professor SqlProfessorDAO::fetchOne(const QString& sql, const QVariant& key)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(sql);
+    query.addBindValue(key);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving professor:" << m_lastError;
+        return Professor();
+    }
+    return query.next() ? fromRow(query) : Professor();
+}
+
+/**
+ * Builds a Professor from the current row of a professors/users join
+ * @param query - A query positioned on a row
+ */
+Professor SqlProfessorDAO::fromRow(const QSqlQuery& query)
+{
+    Professor p;
+    p.setId(query.value("id").toInt());
+    p.setUserId(query.value("user_id").toInt());
+    p.setIdNumber(query.value("id_number").toString());
+    p.setSpecialization(query.value("specialization").toString());
+    p.setTitle(query.value("title").toString());
+    p.setPersonalInfo(query.value("personal_info").toString());
+    p.setFullName(query.value("full_name").toString());
+    p.setUsername(query.value("username").toString());
+    return p;
+}
@@ -0,0 +1,38 @@
+#ifndef SQL_PROFESSOR_DAO_H
+#define SQL_PROFESSOR_DAO_H
+
+#include "professor_dao.h"
+#include "../models/professor.h"
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+class QSqlQuery;
+
+/**
+ * ProfessorDAO backed by the professors table of the configured database
+ * Rows are joined with users for the name and username
+ */
+class SqlProfessorDAO : public ProfessorDAO
+{
+public:
+    SqlProfessorDAO();
+    ~SqlProfessorDAO() override = default;
+
+    bool insert(Professor& professor) override;
+    bool update(const Professor& professor) override;
+    bool remove(int id) override;
+    QList<Professor> getAll() override;
+    Professor getById(int id) override;
+    Professor getByUserId(int userId) override;
+    Professor getByIdNumber(const QString& idNumber) override;
+    QString lastError() const override;
+
+private:
+    Professor fetchOne(const QString& sql, const QVariant& key);
+    static Professor fromRow(const QSqlQuery& query);
+
+    QString m_lastError;
+};
+
+#endif // SQL_PROFESSOR_DAO_H
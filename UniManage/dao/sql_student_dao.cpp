@@ -0,0 +1,356 @@
+#include "sql_student_dao.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include <QSqlError>
+#include <QStringList>
+#include <QDebug>
+
+namespace {
+
+// IDs per IN (...) lookup; stays under SQLite's default 999 placeholders
+const int IdsPerStatement = 900;
+
+} // namespace
+
+/**
+ * Constructor for the SqlStudentDAO class
+ */
+SqlStudentDAO::SqlStudentDAO() {}
+
+/**
+ * Inserts a student profile for an existing user account
+ * @param student - The profile to store; receives the new ID
+ * @return True if successful, otherwise false
+ */
+bool SqlStudentDAO::insert(StudentData& student)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::INSERT_STUDENT_DATA);
+    query.addBindValue(student.userId());
+    query.addBindValue(student.studentNumber());
+    query.addBindValue(student.idNumber());
+    query.addBindValue(student.dob());
+    query.addBindValue(student.department());
+    query.addBindValue(nullableId(student.departmentId()));
+    query.addBindValue(nullableId(student.academicLevelId()));
+    query.addBindValue(nullableId(student.sectionId()));
+    query.addBindValue(nullableId(student.collegeId()));
+    query.addBindValue(student.tuitionFees().toString());
+    query.addBindValue(student.seatNumber());
+    query.addBindValue(student.statusName());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error adding student data:" << m_lastError;
+        return false;
+    }
+    student.setId(query.lastInsertId().toInt());
+    return true;
+}
+
+/**
+ * Updates a student profile
+ * @param student - The profile with updated details
+ * @return True if successful, otherwise false
+ */
+bool SqlStudentDAO::update(const StudentData& student)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_STUDENT_DATA);
+    query.addBindValue(student.idNumber());
+    query.addBindValue(student.dob());
+    query.addBindValue(student.department());
+    query.addBindValue(nullableId(student.departmentId()));
+    query.addBindValue(nullableId(student.academicLevelId()));
+    query.addBindValue(student.sectionId());
+    query.addBindValue(nullableId(student.collegeId()));
+    query.addBindValue(student.tuitionFees().toString());
+    query.addBindValue(student.seatNumber());
+    query.addBindValue(student.statusName());
+    query.addBindValue(student.id());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error updating student data:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Permanently deletes a student and everything that references it
+ * Payments, attendance logs, enrollments and the user account go too
+ * @param id - The ID of the student
+ * @return True if the profile was deleted, otherwise false
+ */
+bool SqlStudentDAO::remove(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+
+    int userId = -1;
+    query.prepare("SELECT user_id FROM students_data WHERE id = ?");
+    query.addBindValue(id);
+    if (query.exec() && query.next()) {
+        userId = query.value(0).toInt();
+    }
+
+    query.prepare("DELETE FROM payments WHERE student_id = ?");
+    query.addBindValue(id);
+    query.exec();
+
+    query.prepare("DELETE FROM attendance_logs WHERE enrollment_id IN (SELECT id FROM enrollments WHERE student_id = ?)");
+    query.addBindValue(id);
+    query.exec();
+
+    query.prepare("DELETE FROM enrollments WHERE student_id = ?");
+    query.addBindValue(id);
+    query.exec();
+
+    if (!execById(Queries::DELETE_STUDENT_DATA, id, "permanently deleting")) {
+        return false;
+    }
+
+    if (userId > 0) {
+        query.prepare(Queries::DELETE_USER);
+        query.addBindValue(userId);
+        query.exec();
+    }
+    return true;
+}
+
+/**
+ * Moves a student to the deleted (draft) state
+ * @param id - The ID of the student
+ * @return True if successful, otherwise false
+ */
+bool SqlStudentDAO::softDelete(int id)
+{
+    return execById(Queries::SOFT_DELETE_STUDENT_DATA, id, "soft deleting");
+}
+
+/**
+ * Brings a student back from the deleted (draft) state
+ * @param id - The ID of the student
+ * @return True if successful, otherwise false
+ */
+bool SqlStudentDAO::restore(int id)
+{
+    return execById(Queries::RESTORE_STUDENT_DATA, id, "restoring");
+}
+
+/**
+ * @return All active students
+ */
+QList<StudentData> SqlStudentDAO::getAll()
+{
+    return fetchList(Queries::SELECT_ALL_STUDENTS_DATA);
+}
+
+/**
+ * @return Students in the deleted (draft) state, most recently deleted first
+ */
+QList<StudentData> SqlStudentDAO::getDeleted()
+{
+    return fetchList(Queries::SELECT_DELETED_STUDENTS_DATA);
+}
+
+/**
+ * Streams the active students straight off a forward-only cursor
+ * @param visit - Called once per student; return false to stop early
+ * @return False if the query failed
+ */
+bool SqlStudentDAO::forEach(const Visitor& visit)
+{
+    return visitRows(Queries::SELECT_ALL_STUDENTS_DATA, visit);
+}
+
+/**
+ * @param id - The ID of the student
+ * @return The student if found, otherwise an empty object
+ */
+StudentData SqlStudentDAO::getById(int id)
+{
+    return fetchOne(Queries::SELECT_STUDENT_DATA_BY_ID, id);
+}
+
+/**
+ * Looks up several students with one query per batch of IDs
+ * @param ids - The IDs of the students
+ * @return The students found, in no particular order
+ */
+QList<StudentData> SqlStudentDAO::getByIds(const QList<int>& ids)
+{
+    QList<StudentData> students;
+    for (int from = 0; from < ids.size(); from += IdsPerStatement) {
+        const int count = qMin(IdsPerStatement, ids.size() - from);
+        QStringList placeholders;
+        for (int i = 0; i < count; ++i) placeholders.append("?");
+
+        DBQuery query(DBConnection::instance().database());
+        query.setForwardOnly(true);
+        query.prepare(Queries::SELECT_STUDENT_DATA_BY_IDS_HEAD + placeholders.join(", ") + ")");
+        for (int i = from; i < from + count; ++i) query.addBindValue(ids.at(i));
+        if (!query.exec()) {
+            m_lastError = query.lastError().text();
+            qDebug() << "Error retrieving students data:" << m_lastError;
+            return students;
+        }
+        while (query.next()) students.append(fromRow(query));
+    }
+    return students;
+}
+
+/**
+ * @param userId - The ID of the student's user account
+ * @return The student if found, otherwise an empty object
+ */
+StudentData SqlStudentDAO::getByUserId(int userId)
+{
+    return fetchOne(Queries::SELECT_STUDENT_DATA_BY_USER_ID, userId);
+}
+
+/**
+ * @param idNumber - The student's national ID number
+ * @return The student if found, otherwise an empty object
+ */
+StudentData SqlStudentDAO::getByIdNumber(const QString& idNumber)
+{
+    return fetchOne(Queries::SELECT_STUDENT_BY_ID_NUMBER, idNumber);
+}
+
+/**
+ * @param studentNumber - The student's code
+ * @return The student if found, otherwise an empty object
+ */
+StudentData SqlStudentDAO::getByStudentNumber(const QString& studentNumber)
+{
+    return fetchOne(Queries::SELECT_STUDENT_DATA_BY_STUDENT_NUMBER, studentNumber);
+}
+
+/**
+ * @return Driver message for the last failed call
+ */
+QString SqlStudentDAO::lastError() const
+{
+    return m_lastError;
+}
+
+/**
+ * Runs a write that takes the student ID as its only parameter
+ * @param sql - The statement
+ * @param id - The ID of the student
+ * @param action - What the statement does, for the log
+ * @return True if successful, otherwise false
+ */
+bool SqlStudentDAO::execById(const QString& sql, int id, const char* action)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(sql);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error" << action << "student data:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Runs a student list query
+ * @param sql - A student query without parameters
+ * @return The students, empty on error
+ */
+QList<StudentData> SqlStudentDAO::fetchList(const QString& sql)
+{
+    QList<StudentData> students;
+    visitRows(sql, [&students](const StudentData& s) {
+        students.append(s);
+        return true;
+    });
+    return students;
+}
+
+/**
+ * Runs a student list query and decodes one row at a time
+ * @param sql - A student query without parameters
+ * @param visit - Called once per row; return false to stop early
+ * @return False if the query failed
+ */
+bool SqlStudentDAO::visitRows(const QString& sql, const Visitor& visit)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    if (!query.exec(sql)) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving students data:" << m_lastError;
+        return false;
+    }
+    while (query.next()) {
+        if (!visit(fromRow(query))) break;
+    }
+    return true;
+}
+
+/**
+ * Runs a single-row lookup
+ * @param sql - A student query with one placeholder
+ * @param key - The value bound to it
+ * @return The student if found, otherwise an empty object
+ */
+StudentData SqlStudentDAO::fetchOne(const QString& sql, const QVariant& key)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(sql);
+    query.addBindValue(key);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving student data:" << m_lastError;
+        return StudentData();
+    }
+    return query.next() ? fromRow(query) : StudentData();
+}
+
+/**
+ * Builds a StudentData from the current row of a student query
+ * @param query - A query positioned on a row
+ */
+StudentData SqlStudentDAO::fromRow(const QSqlQuery& query)
+{
+    StudentData student;
+    student.setId(query.value("id").toInt());
+    student.setUserId(query.value("user_id").toInt());
+    student.setStudentNumber(query.value("student_number").toString());
+    student.setIdNumber(query.value("id_number").toString());
+    student.setDob(query.value("dob").toDateTime());
+    student.setDepartment(query.value("department").toString());
+    student.setDepartmentId(query.value("department_id").toInt());
+    student.setAcademicLevelId(query.value("academic_level_id").toInt());
+    student.setSectionId(query.value("section_id").toInt());
+    student.setCollegeId(query.value("college_id").toInt());
+    student.setTuitionFees(Money::fromVariant(query.value("tuition_fees")));
+    student.setSeatNumber(query.value("seat_number").toString());
+    student.setStatus(query.value("status").toString());
+    student.setCreatedAt(query.value("created_at").toDateTime());
+    student.setUpdatedAt(query.value("updated_at").toDateTime());
+
+    // Additional info from joins
+    student.setFullName(query.value("full_name").toString());
+    student.setUsername(query.value("username").toString());
+    student.setRole(query.value("role").toString());
+
+    QString dName = query.value("dept_name").toString();
+    if (!dName.isEmpty()) student.setDepartment(dName);
+
+    student.setLevelName(query.value("level_name").toString());
+    student.setCollegeName(query.value("college_name").toString());
+    student.setSectionName(query.value("section_name").toString());
+    return student;
+}
+
+/**
+ * @param id - A foreign key value
+ * @return The ID, or NULL when it is not set
+ */
+QVariant SqlStudentDAO::nullableId(int id)
+{
+    return id <= 0 ? QVariant() : QVariant(id);
+}
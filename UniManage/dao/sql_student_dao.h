@@ -0,0 +1,50 @@
+#ifndef SQL_STUDENT_DAO_H
+#define SQL_STUDENT_DAO_H
+
+#include "student_dao.h"
+#include "../models/student_data.h"
+#include <QList>
+#include <QString>
+#include <QVariant>
+
+class QSqlQuery;
+
+/**
+ * StudentDAO backed by the students_data table of the configured database
+ * Rows are joined with users, departments, levels, colleges and sections.
+ * remove() is the permanent delete: it also drops the student's payments,
+ * attendance, enrollments and user account.
+ */
+class SqlStudentDAO : public StudentDAO
+{
+public:
+    SqlStudentDAO();
+    ~SqlStudentDAO() override = default;
+
+    bool insert(StudentData& student) override;
+    bool update(const StudentData& student) override;
+    bool remove(int id) override;
+    bool softDelete(int id) override;
+    bool restore(int id) override;
+    QList<StudentData> getAll() override;
+    QList<StudentData> getDeleted() override;
+    bool forEach(const Visitor& visit) override;
+    StudentData getById(int id) override;
+    QList<StudentData> getByIds(const QList<int>& ids) override;
+    StudentData getByUserId(int userId) override;
+    StudentData getByIdNumber(const QString& idNumber) override;
+    StudentData getByStudentNumber(const QString& studentNumber) override;
+    QString lastError() const override;
+
+private:
+    bool execById(const QString& sql, int id, const char* action);
+    QList<StudentData> fetchList(const QString& sql);
+    bool visitRows(const QString& sql, const Visitor& visit);
+    StudentData fetchOne(const QString& sql, const QVariant& key);
+    static StudentData fromRow(const QSqlQuery& query);
+    static QVariant nullableId(int id);
+
+    QString m_lastError;
+};
+
+#endif // SQL_STUDENT_DAO_H
@@ -0,0 +1,176 @@
+#include "sql_user_dao.h"
+#include "../database/dbconnection.h"
+#include "../database/dbquery.h"
+#include "../database/queries.h"
+#include <QSqlError>
+#include <QVariant>
+#include <QDebug>
+#include <QCryptographicHash>
+
+/**
+ * Constructor for the SqlUserDAO class
+ */
+SqlUserDAO::SqlUserDAO() {}
+
+/**
+ * Inserts a user account, hashing the password with SHA-256
+ * @param user - The user to store; receives the new ID
+ * @return True if successful, otherwise false
+ */
+bool SqlUserDAO::insert(User& user)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::INSERT_USER);
+    query.addBindValue(user.fullName());
+    query.addBindValue(user.username());
+    query.addBindValue(hashPassword(user.password()));
+    query.addBindValue(user.roleName());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error adding user:" << m_lastError;
+        return false;
+    }
+    user.setId(query.lastInsertId().toInt());
+    return true;
+}
+
+/**
+ * Updates a user's name, password and role
+ * The password is stored as given; callers hash a changed password
+ * @param user - The user with updated details
+ * @return True if successful, otherwise false
+ */
+bool SqlUserDAO::update(const User& user)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::UPDATE_USER);
+    query.addBindValue(user.fullName());
+    query.addBindValue(user.password());
+    query.addBindValue(user.roleName());
+    query.addBindValue(user.id());
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error updating user:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Deletes a user account
+ * @param id - The ID of the user
+ * @return True if successful, otherwise false
+ */
+bool SqlUserDAO::remove(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::DELETE_USER);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error deleting user:" << m_lastError;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @return All user accounts, newest first
+ */
+QList<User> SqlUserDAO::getAll()
+{
+    QList<User> users;
+    DBQuery query(DBConnection::instance().database());
+    if (!query.exec(Queries::SELECT_ALL_USERS)) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving users:" << m_lastError;
+        return users;
+    }
+    while (query.next()) {
+        users.append(fromRow(query));
+    }
+    return users;
+}
+
+/**
+ * @param id - The ID of the user
+ * @return The user if found, otherwise an empty object
+ */
+User SqlUserDAO::getById(int id)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_USER_BY_ID);
+    query.addBindValue(id);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving user by id:" << m_lastError;
+        return User();
+    }
+    return query.next() ? fromRow(query) : User();
+}
+
+/**
+ * @param username - The username to search for
+ * @return The user if found, otherwise an empty object
+ */
+User SqlUserDAO::getByUsername(const QString& username)
+{
+    DBQuery query(DBConnection::instance().database());
+    query.prepare(Queries::SELECT_USER_BY_USERNAME);
+    query.addBindValue(username);
+    if (!query.exec()) {
+        m_lastError = query.lastError().text();
+        qDebug() << "Error retrieving user by username:" << m_lastError;
+        return User();
+    }
+    return query.next() ? fromRow(query) : User();
+}
+
+/**
+ * Checks a username and plain-text password against the stored hash
+ * @param username - The username
+ * @param password - The password as typed
+ * @return The user if the credentials match, otherwise an empty object
+ */
+User SqlUserDAO::authenticate(const QString& username, const QString& password)
+{
+    User user = getByUsername(username);
+    if (user.id() != 0 && user.password() == hashPassword(password)) {
+        return user;
+    }
+    return User();
+}
+
+/**
+ * @return Driver message for the last failed call
+ */
+QString SqlUserDAO::lastError() const
+{
+    return m_lastError;
+}
+
+/**
+ * @param password - A plain-text password
+ * @return Its SHA-256 hash as stored in users.password
+ */
+QString SqlUserDAO::hashPassword(const QString& password)
+{
+    return QString(QCryptographicHash::hash(password.toUtf8(), QCryptographicHash::Sha256).toHex());
+}
+
+/**
+ * Builds a User from the current row of a users query
+ * @param query - A query positioned on a row
+ */
+User SqlUserDAO::fromRow(const QSqlQuery& query)
+{
+    User user;
+    user.setId(query.value("id").toInt());
+    user.setFullName(query.value("full_name").toString());
+    user.setUsername(query.value("username").toString());
+    user.setPassword(query.value("password").toString());
+    user.setRole(query.value("role").toString());
+    user.setCreatedAt(query.value("created_at").toDateTime());
+    user.setUpdatedAt(query.value("updated_at").toDateTime());
+    return user;
+}
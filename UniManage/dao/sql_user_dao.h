@@ -0,0 +1,38 @@
+#ifndef SQL_USER_DAO_H
+#define SQL_USER_DAO_H
+
+#include "user_dao.h"
+#include "../models/user.h"
+#include <QList>
+#include <QString>
+
+class QSqlQuery;
+
+/**
+ * UserDAO backed by the users table of the configured database
+ * Runs on the calling thread's connection (DBConnection::database())
+ */
+class SqlUserDAO : public UserDAO
+{
+public:
+    SqlUserDAO();
+    ~SqlUserDAO() override = default;
+
+    bool insert(User& user) override;
+    bool update(const User& user) override;
+    bool remove(int id) override;
+    QList<User> getAll() override;
+    User getById(int id) override;
+    User getByUsername(const QString& username) override;
+    User authenticate(const QString& username, const QString& password) override;
+    QString lastError() const override;
+
+    static QString hashPassword(const QString& password);
+
+private:
+    static User fromRow(const QSqlQuery& query);
+
+    QString m_lastError;
+};
+
+#endif // SQL_USER_DAO_H
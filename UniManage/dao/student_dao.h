@@ -0,0 +1,47 @@
+#ifndef STUDENT_DAO_H
+#define STUDENT_DAO_H
+
+#include "../models/student_data.h"
+#include <QList>
+#include <QString>
+#include <functional>
+
+class StudentDAO
+{
+public:
+    // Called once per row; return false to stop the walk
+    typedef std::function<bool(const StudentData&)> Visitor;
+
+    virtual ~StudentDAO() = default;
+
+    virtual bool insert(StudentData& student) = 0;
+    virtual bool update(const StudentData& student) = 0;
+    virtual bool remove(int id) = 0;
+    virtual bool softDelete(int id) = 0;
+    virtual bool restore(int id) = 0;
+    virtual QList<StudentData> getAll() = 0;
+    virtual QList<StudentData> getDeleted() = 0;
+    virtual bool forEach(const Visitor& visit) = 0;
+    virtual StudentData getById(int id) = 0;
+
+    // Students found among the IDs, in no particular order; stores without
+    // a batched lookup fall back to one getById() per ID
+    virtual QList<StudentData> getByIds(const QList<int>& ids)
+    {
+        QList<StudentData> students;
+        for (int id : ids) {
+            StudentData s = getById(id);
+            if (s.id() > 0) students.append(s);
+        }
+        return students;
+    }
+
+    virtual StudentData getByUserId(int userId) = 0;
+    virtual StudentData getByIdNumber(const QString& idNumber) = 0;
+    virtual StudentData getByStudentNumber(const QString& studentNumber) = 0;
+
+    // Driver message for the last failed call, if the store has one
+    virtual QString lastError() const { return QString(); }
+};
+
+#endif // STUDENT_DAO_H
\ No newline at end of file
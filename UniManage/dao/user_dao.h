@@ -1,7 +1,7 @@
 #ifndef USER_DAO_H
 #define USER_DAO_H
 
-#include "../UniManage/models/user.h"
+#include "../models/user.h"
 #include <QList>
 #include <QString>
 
@@ -17,6 +17,9 @@ public:
     virtual User getById(int id) = 0;
     virtual User getByUsername(const QString& username) = 0;
     virtual User authenticate(const QString& username, const QString& password) = 0;
+
+    // Driver message for the last failed call, if the store has one
+    virtual QString lastError() const { return QString(); }
 };
 
 #endif // USER_DAO_H
\ No newline at end of file
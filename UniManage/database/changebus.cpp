@@ -0,0 +1,82 @@
+#include "changebus.h"
+#include "tableversions.h"
+#include <QList>
+
+/**
+ * Constructor for the ChangeBus class
+ */
+ChangeBus::ChangeBus()
+    : m_nextToken(1)
+{
+}
+
+/**
+ * @return The process wide change bus
+ */
+ChangeBus& ChangeBus::instance()
+{
+    static ChangeBus bus;
+    return bus;
+}
+
+/**
+ * Registers a handler for every published event
+ * Handlers run synchronously on the publishing thread
+ * @param handler - The callback
+ * @return Token to pass to unsubscribe()
+ */
+int ChangeBus::subscribe(const Handler& handler)
+{
+    QMutexLocker locker(&m_mutex);
+    const int token = m_nextToken++;
+    m_handlers.insert(token, handler);
+    return token;
+}
+
+/**
+ * Removes a handler
+ * @param token - The token returned by subscribe()
+ */
+void ChangeBus::unsubscribe(int token)
+{
+    QMutexLocker locker(&m_mutex);
+    m_handlers.remove(token);
+}
+
+/**
+ * Bumps the table's change counter and notifies every subscriber
+ * Call after the write has been committed
+ * @param entity - The table that was written
+ * @param id - The affected row ID, or 0 when several rows changed
+ * @param kind - Inserted, Updated or Deleted
+ */
+void ChangeBus::publish(const QString& entity, int id, ChangeEvent::Kind kind)
+{
+    TableVersions::bump(entity);
+    deliver(entity, id, kind);
+}
+
+/**
+ * Notifies every subscriber without bumping the change counter
+ * For writes that bumped TableVersions inside their own transaction
+ * @param entity - The table that was written
+ * @param id - The affected row ID, or 0 when several rows changed
+ * @param kind - Inserted, Updated or Deleted
+ */
+void ChangeBus::deliver(const QString& entity, int id, ChangeEvent::Kind kind)
+{
+    ChangeEvent event;
+    event.entity = entity;
+    event.id = id;
+    event.kind = kind;
+
+    QList<Handler> handlers;
+    {
+        // Handlers may (un)subscribe, so call them outside the lock
+        QMutexLocker locker(&m_mutex);
+        handlers = m_handlers.values();
+    }
+    for (const Handler& handler : handlers) {
+        handler(event);
+    }
+}
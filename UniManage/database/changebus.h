@@ -0,0 +1,55 @@
+#ifndef CHANGEBUS_H
+#define CHANGEBUS_H
+
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <functional>
+
+/**
+ * One committed write, as published by a controller
+ */
+struct ChangeEvent
+{
+    enum Kind {
+        Inserted = 0,
+        Updated,
+        Deleted
+    };
+
+    QString entity; // table name, e.g. "students_data"
+    int id = 0;     // row ID, 0 when an unknown set of rows changed
+    Kind kind = Updated;
+};
+
+/**
+ * In-process change notifications
+ * Controllers publish an event after every successful insert, update or
+ * delete; panels and caches subscribe and apply the change to what they
+ * display instead of reloading everything. Publishing also bumps the
+ * table's counter in TableVersions so other sessions can detect the change
+ */
+class ChangeBus
+{
+public:
+    typedef std::function<void(const ChangeEvent&)> Handler;
+
+    static ChangeBus& instance();
+
+    int subscribe(const Handler& handler);
+    void unsubscribe(int token);
+
+    void publish(const QString& entity, int id, ChangeEvent::Kind kind);
+    void deliver(const QString& entity, int id, ChangeEvent::Kind kind);
+
+private:
+    ChangeBus();
+    ChangeBus(const ChangeBus&) = delete;
+    ChangeBus& operator=(const ChangeBus&) = delete;
+
+    QMutex m_mutex;
+    QMap<int, Handler> m_handlers;
+    int m_nextToken;
+};
+
+#endif // CHANGEBUS_H
@@ -1,4 +1,8 @@
 #include "dbconnection.h"
+#include "queries.h"
+#include "statementcache.h"
+#include "sqldialect.h"
+#include "dbquery.h"
 #include <QSqlQuery>
 #include <QSqlError>
 #include <QDebug>
@@ -7,8 +11,72 @@
 #include <QFile>
 #include <QTextStream>
 #include <QCoreApplication>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QSet>
 
-DBConnection::DBConnection() {}
+namespace {
+
+// Reconnect schedule: 100, 200, 400, 800 ms between five attempts
+const int MaxReconnectAttempts = 5;
+const int InitialBackoffMs = 100;
+const int MaxBackoffMs = 2000;
+
+// After giving up, later failures on the thread skip the schedule for this long
+const int ReconnectCooldownMs = 5000;
+
+// MySQL client errors meaning the session is gone
+// (server gone away, lost connection, can't connect, lost during prepare)
+const QStringList ConnectionLostCodes = { "2002", "2003", "2006", "2013", "2055" };
+
+// Connections are per thread, and so is their transaction state
+thread_local QSet<QString> openTransactions;
+thread_local qint64 reconnectBlockedUntil = 0;
+
+// Numbers the worker clones; thread addresses are reused once a thread exits
+std::atomic<int> threadConnectionCount(0);
+
+/**
+ * A worker thread's clone of the main connection
+ * Lives in thread-local storage, so it is closed and removed from the
+ * QSqlDatabase registry when its thread exits
+ */
+struct ThreadConnection
+{
+    ThreadConnection()
+        : name(QString("unimanage_thread_%1").arg(++threadConnectionCount))
+    {
+        // Creates the thread's statement caches before this object, so they
+        // are destroyed after it and the destructor can still release them
+        StatementCache::release(name);
+    }
+
+    ~ThreadConnection()
+    {
+        StatementCache::release(name);
+        database.close();
+        database = QSqlDatabase();
+        QSqlDatabase::removeDatabase(name);
+    }
+
+    const QString name;
+    QSqlDatabase database;
+};
+
+ThreadConnection& threadConnection()
+{
+    static thread_local ThreadConnection connection;
+    return connection;
+}
+
+} // namespace
+
+DBConnection::DBConnection()
+    : m_port(3306), m_disconnects(0), m_reconnects(0), m_failedReconnects(0),
+      m_retriedQueries(0), m_lastReconnectMs(0)
+{
+}
 
 /**
  * Destructor for the DBConnection class
@@ -33,6 +101,11 @@ DBConnection& DBConnection::instance()
     return instance;
 }
 
+/**
+ * Reads the connection settings from the .env file next to the executable
+ * Variables of the same name in the process environment take precedence,
+ * so tools such as the benchmark can point a run at a scratch database
+ */
 void DBConnection::loadEnvFile()
 {
     QFile envFile(QCoreApplication::applicationDirPath() + "/.env");
@@ -44,10 +117,8 @@ void DBConnection::loadEnvFile()
         m_user = "root";
         m_password = "root";
         m_dbName = "university";
-        return;
-    }
-
-    if (envFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        m_driver = "mysql";
+    } else if (envFile.open(QIODevice::ReadOnly | QIODevice::Text)) {
         QTextStream in(&envFile);
         while (!in.atEnd()) {
             QString line = in.readLine();
@@ -56,19 +127,36 @@ void DBConnection::loadEnvFile()
             }
             QStringList parts = line.split('=');
             if (parts.size() == 2) {
-                QString key = parts[0].trimmed();
-                QString value = parts[1].trimmed();
-                if (key == "DB_HOST") m_host = value;
-                else if (key == "DB_PORT") m_port = value.toInt();
-                else if (key == "DB_NAME") m_dbName = value;
-                else if (key == "DB_USER") m_user = value;
-                else if (key == "DB_PASS") m_password = value;
+                applySetting(parts[0].trimmed(), parts[1].trimmed());
             }
         }
         envFile.close();
     } else {
          qWarning() << "Could not open .env file.";
     }
+
+    const QStringList keys = {"DB_HOST", "DB_PORT", "DB_NAME", "DB_USER", "DB_PASS", "DB_DRIVER", "DB_PATH"};
+    for (const QString& key : keys) {
+        if (qEnvironmentVariableIsSet(key.toUtf8().constData())) {
+            applySetting(key, qEnvironmentVariable(key.toUtf8().constData()));
+        }
+    }
+}
+
+/**
+ * Stores one connection setting
+ * @param key - The .env key, e.g. DB_HOST
+ * @param value - Its value
+ */
+void DBConnection::applySetting(const QString& key, const QString& value)
+{
+    if (key == "DB_HOST") m_host = value;
+    else if (key == "DB_PORT") m_port = value.toInt();
+    else if (key == "DB_NAME") m_dbName = value;
+    else if (key == "DB_USER") m_user = value;
+    else if (key == "DB_PASS") m_password = value;
+    else if (key == "DB_DRIVER") m_driver = value;
+    else if (key == "DB_PATH") m_dbPath = value;
 }
 
 
@@ -76,48 +164,117 @@ bool DBConnection::initialize()
 {
     loadEnvFile();
 
+    bool knownDriver = true;
+    SqlDialect& dialect = SqlDialect::instance();
+    dialect.setBackend(SqlDialect::backendFromName(m_driver, &knownDriver));
+    if (!knownDriver) {
+        qWarning() << "Unknown DB_DRIVER" << m_driver << "- using MySQL";
+    }
+
     const QString connectionName = "unimanage_connection";
     if (QSqlDatabase::contains(connectionName)) {
         m_database = QSqlDatabase::database(connectionName);
     } else {
-        m_database = QSqlDatabase::addDatabase("QMYSQL", connectionName);
+        m_database = QSqlDatabase::addDatabase(dialect.driverName(), connectionName);
     }
 
-    m_database.setHostName(m_host);
-    m_database.setPort(m_port);
-    m_database.setUserName(m_user);
-    m_database.setPassword(m_password);
-    m_database.setDatabaseName(m_dbName);
+    if (dialect.isSqlite()) {
+        // A local file next to the executable unless DB_PATH says otherwise
+        QString path = m_dbPath.isEmpty() ? QString("unimanage.db") : m_dbPath;
+        if (QDir::isRelativePath(path)) {
+            path = QCoreApplication::applicationDirPath() + "/" + path;
+        }
+        m_database.setDatabaseName(path);
+    } else {
+        m_database.setHostName(m_host);
+        m_database.setPort(m_port);
+        m_database.setUserName(m_user);
+        m_database.setPassword(m_password);
+        m_database.setDatabaseName(m_dbName);
+    }
 
-    if (!m_database.open()) {
+    if (!m_database.open() || !configureSession(m_database)) {
         m_lastError = QString("Connection Failed: %1").arg(m_database.lastError().text());
         qCritical() << m_lastError;
         return false;
     }
+    // Statements prepared on an earlier session of this connection are gone
+    StatementCache::invalidate();
 
-    if (!createTables()) {
+    if (!createTables() || !addMissingColumns()) {
         m_lastError = "Failed to create tables.";
         qCritical() << m_lastError;
         return false;
     }
 
-    QSqlQuery checkUsers(m_database);
+    DBQuery checkUsers(m_database);
     if (checkUsers.exec("SELECT COUNT(*) FROM users") && checkUsers.next()) {
         if (checkUsers.value(0).toInt() == 0) {
             insertDefaultData();
         }
     }
 
+    // Seed the balances ledger once; payment writes keep it current afterwards
+    DBQuery checkBalances(m_database);
+    if (checkBalances.exec("SELECT COUNT(*) FROM student_balances") && checkBalances.next()) {
+        if (checkBalances.value(0).toInt() == 0 && !checkBalances.exec(Queries::REBUILD_ALL_BALANCES)) {
+            qWarning() << "Failed to seed student balances:" << checkBalances.lastError().text();
+        }
+    }
+
     return true;
 }
 
 /**
  * Returns a reference to the active database connection
+ * Off the application thread this is the calling thread's own clone (see
+ * threadDatabase()), so controllers can be used from worker threads
  * @return Reference to the QSqlDatabase object
  */
 QSqlDatabase& DBConnection::database()
 {
-    return m_database;
+    if (!QCoreApplication::instance() || QThread::currentThread() == QCoreApplication::instance()->thread()) {
+        return m_database;
+    }
+    return workerDatabase();
+}
+
+/**
+ * Returns a connection usable from the calling thread
+ * A QSqlDatabase may only be used by the thread that opened it, so worker
+ * threads get their own clone of the main connection, opened on first use
+ * and closed and removed when the thread exits
+ * @return The main connection on the application thread, otherwise a per-thread clone
+ */
+QSqlDatabase DBConnection::threadDatabase()
+{
+    if (!QCoreApplication::instance() || QThread::currentThread() == QCoreApplication::instance()->thread()) {
+        return m_database;
+    }
+    return workerDatabase();
+}
+
+/**
+ * Opens the calling worker thread's clone if it is not open yet
+ * A clone found closed is re-opened under the same name; only this thread's
+ * cached statements for it are dropped
+ * @return Reference to the thread's connection
+ */
+QSqlDatabase& DBConnection::workerDatabase()
+{
+    ThreadConnection& connection = threadConnection();
+    if (connection.database.isOpen()) return connection.database;
+
+    if (connection.database.isValid()) {
+        StatementCache::release(connection.name);
+    } else {
+        QMutexLocker locker(&m_cloneMutex);
+        connection.database = QSqlDatabase::cloneDatabase("unimanage_connection", connection.name);
+    }
+    if (!connection.database.open() || !configureSession(connection.database)) {
+        qWarning() << "Failed to open thread connection:" << connection.database.lastError().text();
+    }
+    return connection.database;
 }
 
 /**
@@ -125,37 +282,308 @@ QSqlDatabase& DBConnection::database()
  * Creates tables for users, colleges, departments, academic levels, semesters,
  * courses, sections, students, enrollments, payments, rooms, professors,
  * schedules, news, attendance logs, and calendar events
- * Also performs migrations to add missing columns to existing tables
+ * The DDL is written for MySQL; SqlDialect rewrites it for SQLite
  * @return true if all tables created successfully, false otherwise
  */
 bool DBConnection::createTables()
 {
+    // Parents before children so foreign keys resolve
+    const QStringList tables = {
+        // Users table
+        "CREATE TABLE IF NOT EXISTS `users` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "full_name VARCHAR(255) NOT NULL,"
+        "username VARCHAR(100) UNIQUE NOT NULL,"
+        "password VARCHAR(128) NOT NULL,"
+        "role VARCHAR(50),"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "updated_at DATETIME NULL,"
+        "INDEX idx_role (role))",
+        // Colleges / faculties
+        "CREATE TABLE IF NOT EXISTS `colleges` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(255) NOT NULL,"
+        "code VARCHAR(50) UNIQUE,"
+        "tuition_fees DECIMAL(10,2) DEFAULT 0,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Departments
+        "CREATE TABLE IF NOT EXISTS `departments` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(255) NOT NULL,"
+        "code VARCHAR(50),"
+        "college_id INT NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_college (college_id),"
+        "FOREIGN KEY (college_id) REFERENCES colleges(id) ON DELETE SET NULL)",
+        // Academic levels (First Year, Second Year, ...)
+        "CREATE TABLE IF NOT EXISTS `academic_levels` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(100) NOT NULL,"
+        "level_number INT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Semesters
+        "CREATE TABLE IF NOT EXISTS `semester` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "year DATE NOT NULL,"
+        "semester INT NOT NULL,"
+        "start_date DATE NULL,"
+        "end_date DATE NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Courses
+        "CREATE TABLE IF NOT EXISTS `courses` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(255) NOT NULL,"
+        "course_code VARCHAR(50),"
+        "course_type VARCHAR(50),"
+        "max_grade INT DEFAULT 100,"
+        "credit_hours INT,"
+        "year_level INT,"
+        "semester_id INT NULL,"
+        "department_id INT NULL,"
+        "description TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_semester (semester_id),"
+        "INDEX idx_department (department_id),"
+        "FOREIGN KEY (semester_id) REFERENCES semester(id) ON DELETE SET NULL)",
+        // Sections
+        "CREATE TABLE IF NOT EXISTS `sections` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(100),"
+        "course_id INT NULL,"
+        "capacity INT,"
+        "semester_id INT NULL,"
+        "academic_level_id INT NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Students Data table
+        "CREATE TABLE IF NOT EXISTS `students_data` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "user_id INT,"
+        "student_number VARCHAR(100) UNIQUE NOT NULL,"
+        "id_number VARCHAR(100) NOT NULL,"
+        "phone VARCHAR(20) NULL,"
+        "dob DATETIME NULL,"
+        "department VARCHAR(255) NULL,"
+        "department_id INT NULL,"
+        "academic_level_id INT NULL,"
+        "section_id INT NULL,"
+        "college_id INT NULL,"
+        "tuition_fees DECIMAL(10,2) DEFAULT 0,"
+        "seat_number VARCHAR(50) NULL,"
+        "status VARCHAR(50) DEFAULT 'active',"
+        "deleted_at DATETIME NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "updated_at DATETIME NULL,"
+        "INDEX idx_department (department_id),"
+        "INDEX idx_level (academic_level_id),"
+        "FOREIGN KEY (user_id) REFERENCES users(id))",
+        // Professors
+        "CREATE TABLE IF NOT EXISTS `professors` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "user_id INT NOT NULL UNIQUE,"
+        "specialization VARCHAR(255),"
+        "title VARCHAR(100),"
+        "personal_info TEXT,"
+        "id_number VARCHAR(14),"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "updated_at DATETIME NULL,"
+        "INDEX idx_id_number (id_number),"
+        "FOREIGN KEY (user_id) REFERENCES users(id) ON DELETE CASCADE)",
+        // Enrollments
+        "CREATE TABLE IF NOT EXISTS `enrollments` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "student_id INT NOT NULL,"
+        "course_id INT NOT NULL,"
+        "section_id INT NULL,"
+        "status VARCHAR(50) DEFAULT 'active',"
+        "attendance_count INT DEFAULT 0,"
+        "absence_count INT DEFAULT 0,"
+        "assignment_1_grade DOUBLE DEFAULT 0,"
+        "assignment_2_grade DOUBLE DEFAULT 0,"
+        "coursework_grade DOUBLE DEFAULT 0,"
+        "final_exam_grade DOUBLE DEFAULT 0,"
+        "experience_grade DOUBLE DEFAULT 0,"
+        "total_grade DOUBLE DEFAULT 0,"
+        "letter_grade VARCHAR(50) DEFAULT 'N/A',"
+        "enrolled_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_course (course_id),"
+        "UNIQUE KEY unique_enrollment (student_id, course_id),"
+        "FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE,"
+        "FOREIGN KEY (course_id) REFERENCES courses(id) ON DELETE CASCADE)",
+        // Attendance logs (one per enrollment and day)
+        "CREATE TABLE IF NOT EXISTS `attendance_logs` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "enrollment_id INT NOT NULL,"
+        "date DATE NOT NULL,"
+        "status VARCHAR(20),"
+        "notes TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_enrollment_date (enrollment_id, date),"
+        "FOREIGN KEY (enrollment_id) REFERENCES enrollments(id) ON DELETE CASCADE)",
+        // Attendance bitmaps (one per enrollment; bit i is day i of the course's term)
+        "CREATE TABLE IF NOT EXISTS `attendance_bitmaps` ("
+        "enrollment_id INT PRIMARY KEY,"
+        "term_start DATE NOT NULL,"
+        "day_count INT NOT NULL,"
+        "present BLOB,"
+        "absent BLOB,"
+        "late BLOB,"
+        "excused BLOB,"
+        "updated_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "FOREIGN KEY (enrollment_id) REFERENCES enrollments(id) ON DELETE CASCADE)",
+        // Rooms
+        "CREATE TABLE IF NOT EXISTS `rooms` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "name VARCHAR(255) NOT NULL,"
+        "code VARCHAR(50),"
+        "type VARCHAR(50),"
+        "capacity INT,"
+        "ac_units INT DEFAULT 0,"
+        "fans_count INT DEFAULT 0,"
+        "lighting_points INT DEFAULT 0,"
+        "computers_count INT DEFAULT 0,"
+        "seating_description TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Room equipment
+        "CREATE TABLE IF NOT EXISTS `room_specs` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "room_id INT NOT NULL,"
+        "product_id INT,"
+        "product_name VARCHAR(255),"
+        "product_description TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "FOREIGN KEY (room_id) REFERENCES rooms(id) ON DELETE CASCADE)",
+        // Schedules
+        "CREATE TABLE IF NOT EXISTS `schedules` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "course_id INT NOT NULL,"
+        "room_id INT NULL,"
+        "professor_id INT NULL,"
+        "day_of_week VARCHAR(20),"
+        "start_time TIME,"
+        "end_time TIME,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "FOREIGN KEY (course_id) REFERENCES courses(id) ON DELETE CASCADE,"
+        "FOREIGN KEY (room_id) REFERENCES rooms(id) ON DELETE SET NULL,"
+        "FOREIGN KEY (professor_id) REFERENCES professors(id) ON DELETE SET NULL)",
+        // Payments
+        "CREATE TABLE IF NOT EXISTS `payments` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "student_id INT NOT NULL,"
+        "amount DECIMAL(10,2) NOT NULL,"
+        "date DATE,"
+        "year VARCHAR(20),"
+        "method VARCHAR(50),"
+        "status VARCHAR(50) DEFAULT 'Success',"
+        "notes TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_student (student_id),"
+        "FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE)",
+        // Student balances ledger (running totals maintained by payment writes)
+        "CREATE TABLE IF NOT EXISTS `student_balances` ("
+        "student_id INT PRIMARY KEY,"
+        "total_charged DECIMAL(12,2) NOT NULL DEFAULT 0,"
+        "total_paid DECIMAL(12,2) NOT NULL DEFAULT 0,"
+        "updated_at DATETIME NULL,"
+        "FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE)",
+        // Fee rules (per-term tuition by college and/or academic level, 0 = any)
+        // The wildcard is 0 rather than NULL so the unique key covers it too
+        "CREATE TABLE IF NOT EXISTS `fee_rules` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "college_id INT NOT NULL DEFAULT 0,"
+        "academic_level_id INT NOT NULL DEFAULT 0,"
+        "amount DECIMAL(12,2) NOT NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "UNIQUE KEY uq_fee_rule_scope (college_id, academic_level_id))",
+        // Tuition charges (one per student and semester, written by term billing)
+        "CREATE TABLE IF NOT EXISTS `tuition_charges` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "student_id INT NOT NULL,"
+        "semester_id INT NOT NULL,"
+        "amount DECIMAL(12,2) NOT NULL,"
+        "billing_run_id INT NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "UNIQUE KEY uq_tuition_charge (student_id, semester_id),"
+        "FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE)",
+        // Batch jobs (checkpointed progress of restartable bulk operations)
+        "CREATE TABLE IF NOT EXISTS `batch_jobs` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "job_type VARCHAR(50) NOT NULL,"
+        "scope VARCHAR(100) NOT NULL,"
+        "status VARCHAR(20) NOT NULL DEFAULT 'Running',"
+        "checkpoint INT NOT NULL DEFAULT 0,"
+        "processed INT NOT NULL DEFAULT 0,"
+        "total INT NOT NULL DEFAULT 0,"
+        "started_at DATETIME NULL,"
+        "updated_at DATETIME NULL,"
+        "UNIQUE KEY uq_batch_job (job_type, scope))",
+        // Per-table change counters (see TableVersions)
+        "CREATE TABLE IF NOT EXISTS `table_versions` ("
+        "table_name VARCHAR(64) PRIMARY KEY,"
+        "version BIGINT NOT NULL DEFAULT 0)",
+        // News
+        "CREATE TABLE IF NOT EXISTS `news` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "title VARCHAR(255) NOT NULL,"
+        "body TEXT,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP)",
+        // Calendar events
+        "CREATE TABLE IF NOT EXISTS `calendar_events` ("
+        "id INT PRIMARY KEY AUTO_INCREMENT,"
+        "title VARCHAR(255) NOT NULL,"
+        "description TEXT,"
+        "start_date DATETIME,"
+        "end_date DATETIME,"
+        "event_type VARCHAR(50),"
+        "recurrence VARCHAR(16) NOT NULL DEFAULT 'none',"
+        "recurrence_until DATE NULL,"
+        "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
+        "INDEX idx_start_date (start_date))"
+    };
+
     QSqlQuery query(m_database);
-    // Users table
-    if (!query.exec("CREATE TABLE IF NOT EXISTS `users` ("
-                    "id INT PRIMARY KEY AUTO_INCREMENT,"
-                    "full_name VARCHAR(255) NOT NULL,"
-                    "username VARCHAR(100) UNIQUE NOT NULL,"
-                    "password VARCHAR(128) NOT NULL,"
-                    "role VARCHAR(50),"
-                    "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
-                    "updated_at DATETIME NULL) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4")) {
-        qDebug() << "Error creating users table:" << query.lastError().text();
-        return false;
+    for (const QString& table : tables) {
+        const QString ddl = table + " ENGINE=InnoDB DEFAULT CHARSET=utf8mb4";
+        for (const QString& statement : SqlDialect::instance().createTable(ddl)) {
+            if (!query.exec(statement)) {
+                qDebug() << "Error creating table:" << query.lastError().text() << statement;
+                return false;
+            }
+        }
     }
-    // Students Data table
-    if (!query.exec("CREATE TABLE IF NOT EXISTS `students_data` ("
-                    "id INT PRIMARY KEY AUTO_INCREMENT,"
-                    "user_id INT,"
-                    "student_number VARCHAR(100) UNIQUE NOT NULL,"
-                    "id_number VARCHAR(100) NOT NULL,"
-                    "dob DATETIME NULL,"
-                    "department VARCHAR(255) NULL,"
-                    "created_at DATETIME DEFAULT CURRENT_TIMESTAMP,"
-                    "updated_at DATETIME NULL,"
-                    "FOREIGN KEY (user_id) REFERENCES users(id)) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4")) {
-        qDebug() << "Error creating students_data table:" << query.lastError().text();
-        return false;
+    return true;
+}
+
+/**
+ * Adds columns introduced after a table was first created
+ * CREATE TABLE IF NOT EXISTS leaves existing tables alone, so databases
+ * created by an older build get the newer columns here. A column counts as
+ * present when selecting it succeeds, which works the same on both backends
+ * @return true if every column exists afterwards
+ */
+bool DBConnection::addMissingColumns()
+{
+    struct Column {
+        QString table;
+        QString name;
+        QString definition;
+    };
+    const Column columns[] = {
+        {"calendar_events", "recurrence", "VARCHAR(16) NOT NULL DEFAULT 'none'"},
+        {"calendar_events", "recurrence_until", "DATE NULL"},
+        {"semester", "start_date", "DATE NULL"},
+        {"semester", "end_date", "DATE NULL"}
+    };
+
+    QSqlQuery query(m_database);
+    for (const Column& column : columns) {
+        if (query.exec(QString("SELECT %1 FROM %2 LIMIT 1").arg(column.name, column.table))) {
+            continue;
+        }
+        const QString ddl = QString("ALTER TABLE %1 ADD COLUMN %2 %3").arg(column.table, column.name, column.definition);
+        if (!query.exec(ddl)) {
+            qDebug() << "Error adding column:" << query.lastError().text() << ddl;
+            return false;
+        }
     }
     return true;
 }
@@ -168,7 +596,7 @@ bool DBConnection::createTables()
  */
 bool DBConnection::insertDefaultData()
 {
-    QSqlQuery query(m_database);
+    DBQuery query(m_database);
 
     // Default admin
     QString password = "admin123";
@@ -228,3 +656,157 @@ QString DBConnection::getLastError() const
 {
   return m_lastError;
 }
+
+/**
+ * Re-opens a connection the server dropped
+ * Tries up to MaxReconnectAttempts times, doubling the wait in between.
+ * Prepared statements do not survive the new session, so the statement
+ * caches are invalidated. Callers must not reconnect inside a transaction:
+ * its remaining statements would run outside it on the new session.
+ * @param db - The connection to re-open (any handle to it)
+ * @return True if the connection is open again
+ */
+bool DBConnection::reconnect(QSqlDatabase& db)
+{
+    ++m_disconnects;
+
+    // The server was unreachable moments ago; don't stall every statement on the schedule
+    if (QDateTime::currentMSecsSinceEpoch() < reconnectBlockedUntil) {
+        ++m_failedReconnects;
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    int delay = InitialBackoffMs;
+    for (int attempt = 1; attempt <= MaxReconnectAttempts; ++attempt) {
+        db.close();
+        if (db.open() && configureSession(db)) {
+            StatementCache::invalidate();
+            ++m_reconnects;
+            m_lastReconnectMs = timer.elapsed();
+            reconnectBlockedUntil = 0;
+            qWarning() << "Reconnected" << db.connectionName() << "after" << attempt << "attempt(s)";
+            return true;
+        }
+        qWarning() << "Reconnect attempt" << attempt << "failed:" << db.lastError().text();
+        if (attempt < MaxReconnectAttempts) {
+            QThread::msleep(delay);
+            delay = qMin(delay * 2, MaxBackoffMs);
+        }
+    }
+
+    ++m_failedReconnects;
+    reconnectBlockedUntil = QDateTime::currentMSecsSinceEpoch() + ReconnectCooldownMs;
+    qCritical() << "Giving up reconnecting" << db.connectionName();
+    return false;
+}
+
+/**
+ * Applies the backend's per-connection settings (SQLite pragmas)
+ * Called on every connection right after it is opened
+ * @param db - The open connection
+ * @return True if all settings were applied
+ */
+bool DBConnection::configureSession(QSqlDatabase& db)
+{
+    QSqlQuery query(db);
+    for (const QString& statement : SqlDialect::instance().sessionSetup()) {
+        if (!query.exec(statement)) {
+            qWarning() << "Failed to apply" << statement << ":" << query.lastError().text();
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Starts a transaction, reconnecting first if the session was lost
+ * Use instead of QSqlDatabase::transaction() so reads inside the
+ * transaction are not silently retried on a new session
+ * @param db - The connection
+ * @return True if the transaction was started
+ */
+bool DBConnection::beginTransaction(QSqlDatabase& db)
+{
+    bool ok = db.transaction();
+    if (!ok && isConnectionError(db.lastError()) && reconnect(db)) {
+        ok = db.transaction();
+    }
+    if (ok) openTransactions.insert(db.connectionName());
+    return ok;
+}
+
+/**
+ * Commits the transaction started with beginTransaction()
+ * @param db - The connection
+ * @return True if committed
+ */
+bool DBConnection::commit(QSqlDatabase& db)
+{
+    openTransactions.remove(db.connectionName());
+    return db.commit();
+}
+
+/**
+ * Rolls back the transaction started with beginTransaction()
+ * @param db - The connection
+ * @return True if rolled back
+ */
+bool DBConnection::rollback(QSqlDatabase& db)
+{
+    openTransactions.remove(db.connectionName());
+    return db.rollback();
+}
+
+/**
+ * @param db - The connection
+ * @return True while a transaction from beginTransaction() is open on it
+ */
+bool DBConnection::inTransaction(const QSqlDatabase& db) const
+{
+    return openTransactions.contains(db.connectionName());
+}
+
+/**
+ * Counts a read that was re-run after a reconnect (called by DBQuery)
+ */
+void DBConnection::recordRetry()
+{
+    ++m_retriedQueries;
+}
+
+/**
+ * @return Reconnect counters since startup
+ */
+ReconnectStats DBConnection::reconnectStats() const
+{
+    ReconnectStats stats;
+    stats.disconnects = m_disconnects.load();
+    stats.reconnects = m_reconnects.load();
+    stats.failedReconnects = m_failedReconnects.load();
+    stats.retriedQueries = m_retriedQueries.load();
+    stats.lastReconnectMs = m_lastReconnectMs.load();
+    return stats;
+}
+
+/**
+ * @param error - The error of a failed statement
+ * @return True if the failure means the session is gone rather than a bad statement
+ */
+bool DBConnection::isConnectionError(const QSqlError& error)
+{
+    return error.type() == QSqlError::ConnectionError
+        || ConnectionLostCodes.contains(error.nativeErrorCode());
+}
+
+/**
+ * @param sql - The statement text
+ * @return True if running the statement twice has the same effect as once
+ */
+bool DBConnection::isIdempotent(const QString& sql)
+{
+    const QString head = sql.trimmed().left(8).toUpper();
+    return head.startsWith("SELECT") || head.startsWith("SHOW")
+        || head.startsWith("DESCRIBE") || head.startsWith("EXPLAIN");
+}
@@ -3,6 +3,21 @@
 
 #include <QSqlDatabase>
 #include <QString>
+#include <QMutex>
+#include <QSqlError>
+#include <atomic>
+
+/**
+ * Counters describing how the connections coped with server outages
+ */
+struct ReconnectStats
+{
+    qint64 disconnects = 0;       // connection losses detected
+    qint64 reconnects = 0;        // successful reconnects
+    qint64 failedReconnects = 0;  // reconnects that gave up after all attempts
+    qint64 retriedQueries = 0;    // reads re-run after a reconnect
+    qint64 lastReconnectMs = 0;   // time the last successful reconnect took
+};
 
 class DBConnection
 {
@@ -10,26 +25,52 @@ public:
     static DBConnection& instance();
     bool initialize();
     QSqlDatabase& database();
+    QSqlDatabase threadDatabase();
     QString getLastError() const;
 
+    bool reconnect(QSqlDatabase& db);
+    bool beginTransaction(QSqlDatabase& db);
+    bool commit(QSqlDatabase& db);
+    bool rollback(QSqlDatabase& db);
+    bool inTransaction(const QSqlDatabase& db) const;
+
+    void recordRetry();
+    ReconnectStats reconnectStats() const;
+
+    static bool isConnectionError(const QSqlError& error);
+    static bool isIdempotent(const QString& sql);
+
 private:
     DBConnection();
     ~DBConnection();
     DBConnection(const DBConnection&) = delete;
     DBConnection& operator=(const DBConnection&) = delete;
 
+    QSqlDatabase& workerDatabase();
     void loadEnvFile();
+    void applySetting(const QString& key, const QString& value);
+    bool configureSession(QSqlDatabase& db);
     bool createTables();
+    bool addMissingColumns();
     bool insertDefaultData();
 
 
     QSqlDatabase m_database;
+    QMutex m_cloneMutex;
     QString m_lastError;
     QString m_host;
     int m_port;
     QString m_user;
     QString m_password;
     QString m_dbName;
+    QString m_driver;  // DB_DRIVER: mysql (default) or sqlite
+    QString m_dbPath;  // DB_PATH: SQLite file, relative to the executable
+
+    std::atomic<qint64> m_disconnects;
+    std::atomic<qint64> m_reconnects;
+    std::atomic<qint64> m_failedReconnects;
+    std::atomic<qint64> m_retriedQueries;
+    std::atomic<qint64> m_lastReconnectMs;
 };
 
 #endif // DBCONNECTION_H
@@ -0,0 +1,262 @@
+#include "dbquery.h"
+#include "querymetrics.h"
+#include "querytracker.h"
+#include "statementcache.h"
+#include "dbconnection.h"
+#include "sqldialect.h"
+#include <QElapsedTimer>
+#include <QSqlError>
+
+/**
+ * Constructor for the DBQuery class
+ * @param db - The connection to run statements on
+ */
+DBQuery::DBQuery(const QSqlDatabase& db)
+    : QSqlQuery(db), m_db(db), m_cacheEpoch(0), m_fetchNsecs(0), m_fetchedRows(0), m_fetching(false), m_forwardOnly(false), m_reusable(false)
+{
+}
+
+/**
+ * Constructor that runs a statement immediately, like QSqlQuery
+ * @param sql - The statement to execute (ignored if empty)
+ * @param db - The connection to run statements on
+ */
+DBQuery::DBQuery(const QString& sql, const QSqlDatabase& db)
+    : QSqlQuery(db), m_db(db), m_cacheEpoch(0), m_fetchNsecs(0), m_fetchedRows(0), m_fetching(false), m_forwardOnly(false), m_reusable(false)
+{
+    if (!sql.isEmpty()) exec(sql);
+}
+
+/**
+ * Destructor; reports a result set that was not read to the end and
+ * returns a cached statement
+ */
+DBQuery::~DBQuery()
+{
+    flushFetch();
+    releaseCached(false);
+}
+
+/**
+ * Prepares a statement and remembers its text for tracking
+ * @param sql - The statement with ? placeholders
+ * @return True if the statement was prepared
+ */
+bool DBQuery::prepare(const QString& sql)
+{
+    flushFetch();
+    releaseCached(true);
+    m_sql = sql;
+    m_name = QueryMetrics::nameFor(sql);
+
+    const bool cacheable = StatementCache::isCacheable(sql);
+    if (cacheable && StatementCache::forConnection(m_db).take(sql, *this)) {
+        m_cachedSql = sql;
+        m_cacheEpoch = StatementCache::forConnection(m_db).epoch();
+        m_reusable = true;
+        QSqlQuery::setForwardOnly(m_forwardOnly);
+        return true;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    const bool ok = QSqlQuery::prepare(SqlDialect::instance().translate(sql));
+    QueryMetrics::instance().recordPrepare(m_name, timer.nsecsElapsed(), ok,
+                                           ok ? QString() : lastError().text());
+    if (ok && cacheable) {
+        m_cachedSql = sql;
+        m_cacheEpoch = StatementCache::forConnection(m_db).epoch();
+    }
+    m_reusable = ok;
+    return ok;
+}
+
+/**
+ * Binds the next positional placeholder
+ * @param value - The value
+ */
+void DBQuery::addBindValue(const QVariant& value)
+{
+    m_reusable = false;
+    QSqlQuery::addBindValue(value);
+}
+
+/**
+ * Binds a named placeholder
+ * @param placeholder - The placeholder, e.g. ":id"
+ * @param value - The value
+ */
+void DBQuery::bindValue(const QString& placeholder, const QVariant& value)
+{
+    m_reusable = false;
+    QSqlQuery::bindValue(placeholder, value);
+}
+
+/**
+ * Binds a placeholder by position
+ * @param pos - Zero-based placeholder index
+ * @param value - The value
+ */
+void DBQuery::bindValue(int pos, const QVariant& value)
+{
+    m_reusable = false;
+    QSqlQuery::bindValue(pos, value);
+}
+
+/**
+ * Executes the prepared statement
+ * @return True if successful
+ */
+bool DBQuery::exec()
+{
+    flushFetch();
+    QueryTracker::record(m_sql);
+
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = QSqlQuery::exec();
+    if (!ok && recoverConnection()) {
+        // The statement died with the old session; prepare it again on the new one
+        const QVariantList values = boundValues();
+        QSqlQuery::operator=(QSqlQuery(m_db));
+        QSqlQuery::setForwardOnly(m_forwardOnly);
+        if (QSqlQuery::prepare(SqlDialect::instance().translate(m_sql))) {
+            if (!m_cachedSql.isEmpty()) m_cacheEpoch = StatementCache::forConnection(m_db).epoch();
+            for (int i = 0; i < values.size(); ++i) QSqlQuery::bindValue(i, values.at(i));
+            ok = QSqlQuery::exec();
+        }
+    }
+    QueryMetrics::instance().recordExec(m_name, timer.nsecsElapsed(), ok,
+                                        ok ? QString() : lastError().text());
+    m_fetching = ok;
+    // A failed statement may be bound to a session that is gone; never hand it back
+    m_reusable = ok;
+    return ok;
+}
+
+/**
+ * Executes a statement directly
+ * @param sql - The statement text
+ * @return True if successful
+ */
+bool DBQuery::exec(const QString& sql)
+{
+    flushFetch();
+    releaseCached(true);
+    m_sql = sql;
+    m_name = QueryMetrics::nameFor(sql);
+    QueryTracker::record(sql);
+
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = QSqlQuery::exec(SqlDialect::instance().translate(sql));
+    if (!ok && recoverConnection()) {
+        QSqlQuery::operator=(QSqlQuery(m_db));
+        QSqlQuery::setForwardOnly(m_forwardOnly);
+        ok = QSqlQuery::exec(SqlDialect::instance().translate(sql));
+    }
+    QueryMetrics::instance().recordExec(m_name, timer.nsecsElapsed(), ok,
+                                        ok ? QString() : lastError().text());
+    m_fetching = ok;
+    return ok;
+}
+
+/**
+ * Moves to the next row, timing the fetch
+ * The result set is reported once it is exhausted, finished or discarded
+ * @return True if positioned on a valid row
+ */
+bool DBQuery::next()
+{
+    QElapsedTimer timer;
+    timer.start();
+    const bool found = QSqlQuery::next();
+    m_fetchNsecs += timer.nsecsElapsed();
+
+    if (found) {
+        ++m_fetchedRows;
+    } else {
+        flushFetch();
+    }
+    return found;
+}
+
+/**
+ * Releases the result set, reporting what was read of it
+ */
+void DBQuery::finish()
+{
+    flushFetch();
+    QSqlQuery::finish();
+}
+
+/**
+ * Sets forward-only mode; kept across statements taken from the cache
+ * @param forward - True to only allow next()
+ */
+void DBQuery::setForwardOnly(bool forward)
+{
+    m_forwardOnly = forward;
+    QSqlQuery::setForwardOnly(forward);
+}
+
+/**
+ * Hands the accumulated fetch time and row count to QueryMetrics
+ */
+void DBQuery::flushFetch()
+{
+    if (!m_fetching) return;
+    // Writes have no result set to read; only count statements that were fetched from
+    if (m_fetchedRows > 0 || m_fetchNsecs > 0) {
+        QueryMetrics::instance().recordFetch(m_name, m_fetchNsecs, m_fetchedRows);
+    }
+    m_fetching = false;
+    m_fetchNsecs = 0;
+    m_fetchedRows = 0;
+}
+
+/**
+ * Handles a statement that failed because the server dropped the session
+ * Reconnects unless a transaction is open (its work is lost and the owner
+ * must roll back first) and reports whether the statement is safe to re-run
+ * @return True if the connection was restored and the statement is a read
+ */
+bool DBQuery::recoverConnection()
+{
+    if (!DBConnection::isConnectionError(lastError())) return false;
+
+    DBConnection& connection = DBConnection::instance();
+    if (connection.inTransaction(m_db)) return false;
+    if (!connection.reconnect(m_db)) return false;
+    if (!DBConnection::isIdempotent(m_sql)) return false;
+
+    connection.recordRetry();
+    return true;
+}
+
+/**
+ * Returns a checked out statement to the connection's cache
+ * @param detach - True to continue with a fresh query on the same
+ *                 connection, false when the object is going away
+ */
+void DBQuery::releaseCached(bool detach)
+{
+    if (m_cachedSql.isEmpty()) return;
+
+    // Values bound but never executed would shift the next caller's
+    // positional binds, and a failed one may belong to a dropped session,
+    // so such a statement is dropped instead; give() also refuses one
+    // prepared before the connection was re-opened
+    // Only the QSqlQuery part moves into the cache; the moved-from base is
+    // re-assigned below or destroyed with this object
+    if (m_reusable) {
+        QSqlQuery::finish();
+        StatementCache::forConnection(m_db).give(m_cachedSql, std::move(static_cast<QSqlQuery&>(*this)), m_cacheEpoch);
+    }
+    m_cachedSql.clear();
+
+    if (detach) {
+        QSqlQuery::operator=(QSqlQuery(m_db));
+        QSqlQuery::setForwardOnly(m_forwardOnly);
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef DBQUERY_H
+#define DBQUERY_H
+
+#include <QSqlQuery>
+#include <QSqlDatabase>
+#include <QString>
+#include <QVariant>
+
+/**
+ * QSqlQuery that reports every execution to QueryTracker and QueryMetrics
+ * Drop-in replacement used by the controllers so N+1 patterns show up in
+ * debug builds and prepare/exec/fetch times, row counts and errors are
+ * recorded per statement; behaves exactly like QSqlQuery otherwise.
+ * Queries:: constants are taken from the connection's StatementCache, so
+ * they are prepared once and only rebound on later calls. Statements are
+ * rewritten by SqlDialect for the configured backend. A read that
+ * fails because the server dropped the session is re-run once after
+ * DBConnection reconnects
+ */
+class DBQuery : public QSqlQuery
+{
+public:
+    explicit DBQuery(const QSqlDatabase& db);
+    DBQuery(const QString& sql, const QSqlDatabase& db);
+    ~DBQuery();
+
+    bool prepare(const QString& sql);
+    void addBindValue(const QVariant& value);
+    void bindValue(const QString& placeholder, const QVariant& value);
+    void bindValue(int pos, const QVariant& value);
+    bool exec();
+    bool exec(const QString& sql);
+    bool next();
+    void finish();
+    void setForwardOnly(bool forward);
+
+private:
+    DBQuery(const DBQuery&) = delete;
+    DBQuery& operator=(const DBQuery&) = delete;
+
+    void flushFetch();
+    void releaseCached(bool detach);
+    bool recoverConnection();
+
+    QSqlDatabase m_db;
+    QString m_sql;
+    QString m_cachedSql; // set while a cached statement is checked out
+    quint64 m_cacheEpoch; // StatementCache::epoch() the statement was prepared under
+    QString m_name;
+    qint64 m_fetchNsecs;
+    qint64 m_fetchedRows;
+    bool m_fetching;
+    bool m_forwardOnly;
+    bool m_reusable; // executed with nothing bound since, safe to hand back
+};
+
+#endif // DBQUERY_H
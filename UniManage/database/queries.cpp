@@ -1,4 +1,184 @@
 #include "queries.h"
+#include <QHash>
 
-// This file is intentionally left mostly empty.
 // The queries are defined as constants in the header file.
+
+namespace {
+
+#define QUERY_NAME(constant) { Queries::constant, QString(#constant) }
+
+const QHash<QString, QString>& queryNames()
+{
+    static const QHash<QString, QString> names = {
+        QUERY_NAME(INSERT_USER),
+        QUERY_NAME(SELECT_USER_BY_USERNAME),
+        QUERY_NAME(SELECT_USER_BY_ID),
+        QUERY_NAME(SELECT_ALL_USERS),
+        QUERY_NAME(UPDATE_USER),
+        QUERY_NAME(DELETE_USER),
+        QUERY_NAME(Update_User_Password),
+        QUERY_NAME(SELECT_AUTH_CREDENTIALS),
+        QUERY_NAME(INSERT_STUDENT_DATA),
+        QUERY_NAME(UPDATE_STUDENT_DATA),
+        QUERY_NAME(DELETE_STUDENT_DATA),
+        QUERY_NAME(SOFT_DELETE_STUDENT_DATA),
+        QUERY_NAME(RESTORE_STUDENT_DATA),
+        QUERY_NAME(SELECT_ALL_STUDENTS_DATA),
+        QUERY_NAME(SELECT_DELETED_STUDENTS_DATA),
+        QUERY_NAME(SELECT_STUDENT_COMMON_JOIN),
+        QUERY_NAME(SELECT_STUDENT_DATA_BY_ID),
+        QUERY_NAME(SELECT_STUDENT_DATA_BY_IDS_HEAD),
+        QUERY_NAME(SELECT_STUDENT_DATA_BY_USER_ID),
+        QUERY_NAME(SELECT_STUDENT_DATA_BY_STUDENT_NUMBER),
+        QUERY_NAME(SELECT_STUDENT_BY_ID_NUMBER),
+        QUERY_NAME(INSERT_SEMESTER),
+        QUERY_NAME(UPDATE_SEMESTER),
+        QUERY_NAME(DELETE_SEMESTER),
+        QUERY_NAME(SELECT_ALL_SEMESTERS),
+        QUERY_NAME(INSERT_COURSE),
+        QUERY_NAME(UPDATE_COURSE),
+        QUERY_NAME(DELETE_COURSE),
+        QUERY_NAME(SELECT_ALL_COURSES),
+        QUERY_NAME(SELECT_COURSES_BY_SEMESTER),
+        QUERY_NAME(SELECT_COURSE_TERM),
+        QUERY_NAME(SELECT_COURSE_BY_ID),
+        QUERY_NAME(SELECT_COURSES_BY_PROFESSOR),
+        QUERY_NAME(INSERT_SECTION),
+        QUERY_NAME(UPDATE_SECTION),
+        QUERY_NAME(DELETE_SECTION),
+        QUERY_NAME(SELECT_ALL_SECTIONS),
+        QUERY_NAME(SELECT_SECTIONS_BY_COURSE),
+        QUERY_NAME(SELECT_SECTION_BY_ID),
+        QUERY_NAME(SELECT_SECTION_LOADS_BY_LEVEL),
+        QUERY_NAME(SELECT_UNSECTIONED_STUDENTS_BY_LEVEL),
+        QUERY_NAME(ASSIGN_SECTION_BATCH_HEAD),
+        QUERY_NAME(INSERT_ENROLLMENT),
+        QUERY_NAME(UPDATE_ENROLLMENT),
+        QUERY_NAME(DELETE_ENROLLMENT),
+        QUERY_NAME(SELECT_ENROLLMENT_BY_ID),
+        QUERY_NAME(ADJUST_ENROLLMENT_ATTENDANCE_COUNTS),
+        QUERY_NAME(SELECT_ENROLLMENTS_BY_STUDENT),
+        QUERY_NAME(SELECT_ENROLLMENTS_BY_COURSE),
+        QUERY_NAME(INSERT_ENROLLMENT_BATCH_BY_LEVEL),
+        QUERY_NAME(SELECT_GRADE_ROWS_BASE),
+        QUERY_NAME(SELECT_GRADE_ROWS_BY_COURSE),
+        QUERY_NAME(SELECT_GRADE_ROWS_BY_LEVEL),
+        QUERY_NAME(SELECT_ALL_GRADE_ROWS),
+        QUERY_NAME(SELECT_SEARCH_STUDENTS),
+        QUERY_NAME(SELECT_SEARCH_STUDENT_BY_ID),
+        QUERY_NAME(SELECT_SEARCH_STUDENTS_BY_USER),
+        QUERY_NAME(SELECT_SEARCH_COURSES),
+        QUERY_NAME(SELECT_SEARCH_COURSE_BY_ID),
+        QUERY_NAME(SELECT_SEARCH_PROFESSORS),
+        QUERY_NAME(SELECT_SEARCH_PROFESSOR_BY_ID),
+        QUERY_NAME(SELECT_SEARCH_PROFESSORS_BY_USER),
+        QUERY_NAME(INSERT_PAYMENT),
+        QUERY_NAME(UPDATE_PAYMENT),
+        QUERY_NAME(DELETE_PAYMENT),
+        QUERY_NAME(SELECT_PAYMENTS_BY_STUDENT),
+        QUERY_NAME(SELECT_ALL_PAYMENTS),
+        QUERY_NAME(SELECT_PAYMENT_FOR_UPDATE),
+        QUERY_NAME(UPDATE_BALANCE_PAID),
+        QUERY_NAME(SELECT_BALANCE_BY_STUDENT),
+        QUERY_NAME(SELECT_OUTSTANDING_BALANCES),
+        QUERY_NAME(REBUILD_BALANCES_BASE),
+        QUERY_NAME(REBUILD_BALANCES_UPDATE),
+        QUERY_NAME(REBUILD_BALANCE_BY_STUDENT),
+        QUERY_NAME(REBUILD_ALL_BALANCES),
+        QUERY_NAME(REBUILD_BALANCES_BY_RANGE),
+        QUERY_NAME(REBUILD_BALANCES_BY_COLLEGE),
+        QUERY_NAME(UPSERT_FEE_RULE),
+        QUERY_NAME(DELETE_FEE_RULE),
+        QUERY_NAME(SELECT_ALL_FEE_RULES),
+        QUERY_NAME(COUNT_BILLABLE_STUDENTS),
+        QUERY_NAME(SELECT_BILLING_CHUNK_BOUND),
+        QUERY_NAME(INSERT_TUITION_CHARGES_CHUNK),
+        QUERY_NAME(COUNT_PROMOTION_CANDIDATES),
+        QUERY_NAME(SELECT_PROMOTION_CHUNK_BOUND),
+        QUERY_NAME(SELECT_PASSED_STUDENTS_CHUNK),
+        QUERY_NAME(INSERT_PROMOTED_ENROLLMENTS_CHUNK),
+        QUERY_NAME(PROMOTE_STUDENTS_CHUNK),
+        QUERY_NAME(GRADUATE_STUDENTS_CHUNK),
+        QUERY_NAME(SELECT_NEXT_ACADEMIC_LEVEL),
+        QUERY_NAME(INSERT_BATCH_JOB),
+        QUERY_NAME(SELECT_BATCH_JOB),
+        QUERY_NAME(UPDATE_BATCH_JOB_STATUS),
+        QUERY_NAME(UPDATE_BATCH_JOB_PROGRESS),
+        QUERY_NAME(RESET_BATCH_JOB),
+        QUERY_NAME(BUMP_TABLE_VERSION),
+        QUERY_NAME(SELECT_TABLE_VERSIONS),
+        QUERY_NAME(INSERT_NEWS),
+        QUERY_NAME(UPDATE_NEWS),
+        QUERY_NAME(DELETE_NEWS),
+        QUERY_NAME(SELECT_ALL_NEWS),
+        QUERY_NAME(INSERT_COLLEGE),
+        QUERY_NAME(UPDATE_COLLEGE),
+        QUERY_NAME(DELETE_COLLEGE),
+        QUERY_NAME(SELECT_ALL_COLLEGES),
+        QUERY_NAME(INSERT_DEPARTMENT),
+        QUERY_NAME(UPDATE_DEPARTMENT),
+        QUERY_NAME(DELETE_DEPARTMENT),
+        QUERY_NAME(SELECT_ALL_DEPARTMENTS),
+        QUERY_NAME(SELECT_DEPARTMENT_BY_ID),
+        QUERY_NAME(SELECT_DEPARTMENTS_BY_COLLEGE),
+        QUERY_NAME(INSERT_ACADEMIC_LEVEL),
+        QUERY_NAME(UPDATE_ACADEMIC_LEVEL),
+        QUERY_NAME(DELETE_ACADEMIC_LEVEL),
+        QUERY_NAME(SELECT_ALL_ACADEMIC_LEVELS),
+        QUERY_NAME(SELECT_ACADEMIC_LEVEL_BY_ID),
+        QUERY_NAME(INSERT_ROOM),
+        QUERY_NAME(UPDATE_ROOM),
+        QUERY_NAME(DELETE_ROOM),
+        QUERY_NAME(SELECT_ALL_ROOMS),
+        QUERY_NAME(SELECT_ROOM_BY_ID),
+        QUERY_NAME(INSERT_ROOM_SPEC),
+        QUERY_NAME(DELETE_ROOM_SPECS),
+        QUERY_NAME(SELECT_ROOM_SPECS),
+        QUERY_NAME(INSERT_PROFESSOR),
+        QUERY_NAME(UPDATE_PROFESSOR),
+        QUERY_NAME(DELETE_PROFESSOR),
+        QUERY_NAME(SELECT_ALL_PROFESSORS),
+        QUERY_NAME(SELECT_PROFESSOR_BY_USER_ID),
+        QUERY_NAME(SELECT_PROFESSOR_BY_ID),
+        QUERY_NAME(SELECT_PROFESSOR_BY_ID_NUMBER),
+        QUERY_NAME(INSERT_SCHEDULE),
+        QUERY_NAME(UPDATE_SCHEDULE),
+        QUERY_NAME(DELETE_SCHEDULE),
+        QUERY_NAME(SELECT_ALL_SCHEDULES),
+        QUERY_NAME(SELECT_SCHEDULE_TABLE_ROWS),
+        QUERY_NAME(SELECT_SCHEDULE_BY_PROFESSOR),
+        QUERY_NAME(SELECT_SCHEDULE_BY_COURSE),
+        QUERY_NAME(SELECT_SCHEDULE_BY_LEVEL),
+        QUERY_NAME(SELECT_SCHEDULE_BY_STUDENT),
+        QUERY_NAME(INSERT_ATTENDANCE_LOG),
+        QUERY_NAME(UPDATE_ATTENDANCE_LOG),
+        QUERY_NAME(SELECT_ATTENDANCE_LOG_BY_DATE),
+        QUERY_NAME(SELECT_ATTENDANCE_LOGS_BY_ENROLLMENT),
+        QUERY_NAME(SELECT_ATTENDANCE_LOGS_BY_COURSE_DATE),
+        QUERY_NAME(SELECT_ATTENDANCE_DATES_BY_COURSE),
+        QUERY_NAME(SELECT_ATTENDANCE_STATUS_BY_COURSE),
+        QUERY_NAME(SELECT_ATTENDANCE_BITMAP_BY_ENROLLMENT),
+        QUERY_NAME(SELECT_ATTENDANCE_BITMAPS_BY_COURSE),
+        QUERY_NAME(UPSERT_ATTENDANCE_BITMAP),
+        QUERY_NAME(INSERT_CALENDAR_EVENT),
+        QUERY_NAME(UPDATE_CALENDAR_EVENT),
+        QUERY_NAME(DELETE_CALENDAR_EVENT),
+        QUERY_NAME(SELECT_ALL_CALENDAR_EVENTS)
+    };
+    return names;
+}
+
+#undef QUERY_NAME
+
+} // namespace
+
+/**
+ * Looks up the Queries constant a statement came from
+ * Used to label metrics with a stable name instead of the SQL text
+ * @param sql - The statement text
+ * @return The constant's name, or an empty string if it is not one of them
+ */
+QString Queries::nameOf(const QString& sql)
+{
+    return queryNames().value(sql);
+}
@@ -12,6 +12,14 @@ namespace Queries {
     const QString UPDATE_USER = "UPDATE users SET full_name = ?, password = ?, role = ? WHERE id = ?";
     const QString DELETE_USER = "DELETE FROM users WHERE id = ?";
 	const QString Update_User_Password = "UPDATE users SET password = ? WHERE id = ?";
+    // Login: user, role and the national ID of the matching profile in one round trip
+    const QString SELECT_AUTH_CREDENTIALS = "SELECT u.id, LOWER(u.role), u.password, "
+                                            "CASE LOWER(u.role) WHEN 'student' THEN sd.id_number "
+                                            "WHEN 'professor' THEN p.id_number END "
+                                            "FROM users u "
+                                            "LEFT JOIN students_data sd ON sd.user_id = u.id "
+                                            "LEFT JOIN professors p ON p.user_id = u.id "
+                                            "WHERE u.username = ? LIMIT 1";
 
     // Student Data queries
     const QString INSERT_STUDENT_DATA = "INSERT INTO students_data (user_id, student_number, id_number, dob, department, department_id, academic_level_id, section_id, college_id, tuition_fees, seat_number, status) "
@@ -67,6 +75,14 @@ namespace Queries {
                                               "d.name AS dept_name, al.name AS level_name, col.name AS college_name, sec.name AS section_name "
                                               + SELECT_STUDENT_COMMON_JOIN + " WHERE sd.id = ?";
 
+    // Followed by one placeholder per student ID and a closing parenthesis
+    const QString SELECT_STUDENT_DATA_BY_IDS_HEAD = "SELECT u.id AS user_id, u.full_name, u.username, u.role, sd.id, "
+                                                    "COALESCE(sd.student_number, u.username) AS student_number, "
+                                                    "sd.id_number, sd.dob, sd.department, sd.department_id, sd.academic_level_id, "
+                                                    "sd.section_id, sd.college_id, sd.tuition_fees, sd.seat_number, sd.status, sd.created_at, sd.updated_at, "
+                                                    "d.name AS dept_name, al.name AS level_name, col.name AS college_name, sec.name AS section_name "
+                                                    + SELECT_STUDENT_COMMON_JOIN + " WHERE sd.id IN (";
+
     const QString SELECT_STUDENT_DATA_BY_USER_ID = "SELECT u.id AS user_id, u.full_name, u.username, u.role, sd.id, "
                                                    "COALESCE(sd.student_number, u.username) AS student_number, "
                                                    "sd.id_number, sd.dob, sd.department, sd.department_id, sd.academic_level_id, "
@@ -89,8 +105,8 @@ namespace Queries {
                                                 + SELECT_STUDENT_COMMON_JOIN + " WHERE sd.id_number = ?";
 
     // Semester queries
-    const QString INSERT_SEMESTER = "INSERT INTO semester (year, semester) VALUES (?, ?)";
-    const QString UPDATE_SEMESTER = "UPDATE semester SET year = ?, semester = ? WHERE id = ?";
+    const QString INSERT_SEMESTER = "INSERT INTO semester (year, semester, start_date, end_date) VALUES (?, ?, ?, ?)";
+    const QString UPDATE_SEMESTER = "UPDATE semester SET year = ?, semester = ?, start_date = ?, end_date = ? WHERE id = ?";
     const QString DELETE_SEMESTER = "DELETE FROM semester WHERE id = ?";
     const QString SELECT_ALL_SEMESTERS = "SELECT * FROM semester ORDER BY year DESC, semester DESC";
 
@@ -99,16 +115,20 @@ namespace Queries {
     const QString UPDATE_COURSE = "UPDATE courses SET name = ?, description = ?, year_level = ?, credit_hours = ?, semester_id = ?, department_id = ?, max_grade = ?, course_type = ? WHERE id = ?";
     const QString DELETE_COURSE = "DELETE FROM courses WHERE id = ?";
     const QString SELECT_ALL_COURSES = "SELECT c.*, s.year AS semester_year, s.semester AS semester_number, d.name AS department_name, "
-                                       "(SELECT GROUP_CONCAT(DISTINCT u.full_name SEPARATOR ', ') "
-                                       " FROM schedules sch "
-                                       " JOIN professors p ON sch.professor_id = p.id "
-                                       " JOIN users u ON p.user_id = u.id "
-                                       " WHERE sch.course_id = c.id) AS assigned_professors "
+                                       "ap.assigned_professors "
                                        "FROM courses c "
                                        "LEFT JOIN semester s ON c.semester_id = s.id "
                                        "LEFT JOIN departments d ON c.department_id = d.id "
+                                       // Aggregated once for all courses instead of a subquery per row
+                                       "LEFT JOIN (SELECT sch.course_id, GROUP_CONCAT(DISTINCT u.full_name SEPARATOR ', ') AS assigned_professors "
+                                       "           FROM schedules sch "
+                                       "           JOIN professors p ON sch.professor_id = p.id "
+                                       "           JOIN users u ON p.user_id = u.id "
+                                       "           GROUP BY sch.course_id) ap ON ap.course_id = c.id "
                                        "ORDER BY c.name";
     const QString SELECT_COURSES_BY_SEMESTER = "SELECT * FROM courses WHERE semester_id = ?";
+    const QString SELECT_COURSE_TERM = "SELECT s.id, s.year, s.semester, s.start_date, s.end_date FROM courses c "
+                                       "JOIN semester s ON s.id = c.semester_id WHERE c.id = ?";
     const QString SELECT_COURSE_BY_ID = "SELECT c.*, s.year as semester_year, s.semester as semester_number FROM courses c "
                                         "LEFT JOIN semester s ON c.semester_id = s.id WHERE c.id = ?";
     const QString SELECT_COURSES_BY_PROFESSOR = "SELECT DISTINCT c.*, s.year as semester_year, s.semester as semester_number "
@@ -127,12 +147,35 @@ namespace Queries {
     const QString SELECT_SECTION_BY_ID = "SELECT sec.*, c.name as course_name FROM sections sec "
                                          "LEFT JOIN courses c ON sec.course_id = c.id WHERE sec.id = ?";
 
+    // Section assignment queries (seats are held by active students still on the section's level)
+    const QString SELECT_SECTION_LOADS_BY_LEVEL = "SELECT sec.id, sec.capacity, sd.department_id, COUNT(sd.id) AS students FROM sections sec "
+                                                  "LEFT JOIN students_data sd ON sd.section_id = sec.id AND sd.academic_level_id = sec.academic_level_id "
+                                                  "AND COALESCE(sd.status, 'active') = 'active' "
+                                                  "WHERE sec.academic_level_id = ? "
+                                                  "GROUP BY sec.id, sec.capacity, sd.department_id ORDER BY sec.id";
+    const QString SELECT_UNSECTIONED_STUDENTS_BY_LEVEL = "SELECT sd.id, sd.department_id FROM students_data sd "
+                                                         "LEFT JOIN sections sec ON sd.section_id = sec.id AND sec.academic_level_id = sd.academic_level_id "
+                                                         "WHERE sd.academic_level_id = ? AND COALESCE(sd.status, 'active') = 'active' AND sec.id IS NULL "
+                                                         "ORDER BY sd.department_id, sd.id";
+    // Followed by one placeholder per student ID and a closing parenthesis; students placed
+    // in one of the level's sections since the plan was made are left alone
+    const QString ASSIGN_SECTION_BATCH_HEAD = "UPDATE students_data SET section_id = ?, updated_at = NOW() "
+                                              "WHERE academic_level_id = ? "
+                                              "AND (section_id IS NULL OR section_id NOT IN (SELECT id FROM sections WHERE academic_level_id = ?)) "
+                                              "AND id IN (";
+
     // Enrollment queries
     const QString INSERT_ENROLLMENT = "INSERT INTO enrollments (student_id, course_id, status, attendance_count, absence_count, assignment_1_grade, assignment_2_grade, coursework_grade, final_exam_grade, experience_grade, total_grade, letter_grade) "
                                       "VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?)";
     const QString UPDATE_ENROLLMENT = "UPDATE enrollments SET status = ?, attendance_count = ?, absence_count = ?, assignment_1_grade = ?, assignment_2_grade = ?, coursework_grade = ?, final_exam_grade = ?, experience_grade = ?, total_grade = ?, letter_grade = ? "
                                       "WHERE id = ?";
     const QString DELETE_ENROLLMENT = "DELETE FROM enrollments WHERE id = ?";
+    // LEFT JOIN so an enrollment whose student row is missing still loads
+    const QString SELECT_ENROLLMENT_BY_ID = "SELECT e.*, u.full_name FROM enrollments e "
+                                            "LEFT JOIN students_data sd ON e.student_id = sd.id "
+                                            "LEFT JOIN users u ON sd.user_id = u.id "
+                                            "WHERE e.id = ?";
+    const QString ADJUST_ENROLLMENT_ATTENDANCE_COUNTS = "UPDATE enrollments SET attendance_count = attendance_count + ?, absence_count = absence_count + ? WHERE id = ?";
     const QString SELECT_ENROLLMENTS_BY_STUDENT = "SELECT e.*, c.name as course_name, c.course_type, c.max_grade FROM enrollments e "
                                                  "JOIN courses c ON e.course_id = c.id WHERE e.student_id = ?";
     const QString SELECT_ENROLLMENTS_BY_COURSE = "SELECT e.*, sd.student_number, u.full_name, s.name as section_name, al.name as level_name, sem.year as academic_year FROM enrollments e "
@@ -146,12 +189,108 @@ namespace Queries {
     const QString INSERT_ENROLLMENT_BATCH_BY_LEVEL = "INSERT INTO enrollments (student_id, course_id, status, attendance_count, absence_count, assignment_1_grade, assignment_2_grade, coursework_grade, final_exam_grade, experience_grade, total_grade, letter_grade, enrolled_at) "
                                                      "SELECT ?, id, 'Active', 0, 0, 0, 0, 0, 0, 0, 0, 'N/A', NOW() FROM courses WHERE year_level = ?";
 
+    // Grade statistics queries (column order matches GradeStatistics::Column, max_grade last)
+    const QString SELECT_GRADE_ROWS_BASE = "SELECT e.assignment_1_grade, e.assignment_2_grade, e.coursework_grade, e.final_exam_grade, e.experience_grade, e.total_grade, c.max_grade "
+                                           "FROM enrollments e JOIN courses c ON e.course_id = c.id ";
+    const QString SELECT_GRADE_ROWS_BY_COURSE = SELECT_GRADE_ROWS_BASE + "WHERE e.course_id = ?";
+    const QString SELECT_GRADE_ROWS_BY_LEVEL = SELECT_GRADE_ROWS_BASE + "WHERE c.year_level = ?";
+    const QString SELECT_ALL_GRADE_ROWS = SELECT_GRADE_ROWS_BASE;
+
+    // Search index queries (id, title, subtitle, then extra searchable columns)
+    const QString SELECT_SEARCH_STUDENTS = "SELECT sd.id, u.full_name, sd.student_number, sd.id_number "
+                                           "FROM students_data sd JOIN users u ON sd.user_id = u.id "
+                                           "WHERE COALESCE(sd.status, 'active') = 'active'";
+    const QString SELECT_SEARCH_STUDENT_BY_ID = SELECT_SEARCH_STUDENTS + " AND sd.id = ?";
+    const QString SELECT_SEARCH_STUDENTS_BY_USER = SELECT_SEARCH_STUDENTS + " AND u.id = ?";
+    const QString SELECT_SEARCH_COURSES = "SELECT id, name, course_code FROM courses";
+    const QString SELECT_SEARCH_COURSE_BY_ID = SELECT_SEARCH_COURSES + " WHERE id = ?";
+    const QString SELECT_SEARCH_PROFESSORS = "SELECT p.id, u.full_name, p.specialization, p.id_number "
+                                             "FROM professors p JOIN users u ON p.user_id = u.id";
+    const QString SELECT_SEARCH_PROFESSOR_BY_ID = SELECT_SEARCH_PROFESSORS + " WHERE p.id = ?";
+    const QString SELECT_SEARCH_PROFESSORS_BY_USER = SELECT_SEARCH_PROFESSORS + " WHERE u.id = ?";
+
     // Payment queries
     const QString INSERT_PAYMENT = "INSERT INTO payments (student_id, amount, date, year, method, status, notes) VALUES (?, ?, ?, ?, ?, ?, ?)";
     const QString UPDATE_PAYMENT = "UPDATE payments SET amount = ?, method = ?, status = ?, notes = ? WHERE id = ?";
     const QString DELETE_PAYMENT = "DELETE FROM payments WHERE id = ?";
     const QString SELECT_PAYMENTS_BY_STUDENT = "SELECT * FROM payments WHERE student_id = ? ORDER BY date DESC";
     const QString SELECT_ALL_PAYMENTS = "SELECT p.*, s.student_number FROM payments p JOIN students_data s ON p.student_id = s.id ORDER BY p.date DESC";
+    const QString SELECT_PAYMENT_FOR_UPDATE = "SELECT student_id, amount, status FROM payments WHERE id = ? FOR UPDATE";
+
+    // Ledger queries (student_balances holds running totals per student)
+    const QString UPDATE_BALANCE_PAID = "UPDATE student_balances SET total_paid = total_paid + ?, updated_at = NOW() WHERE student_id = ?";
+    const QString SELECT_BALANCE_BY_STUDENT = "SELECT * FROM student_balances WHERE student_id = ?";
+    const QString SELECT_OUTSTANDING_BALANCES = "SELECT b.*, sd.student_number, u.full_name FROM student_balances b "
+                                                "JOIN students_data sd ON b.student_id = sd.id "
+                                                "JOIN users u ON sd.user_id = u.id "
+                                                "WHERE b.total_charged - b.total_paid > ? "
+                                                "ORDER BY (b.total_charged - b.total_paid) DESC";
+    const QString REBUILD_BALANCES_BASE = "INSERT INTO student_balances (student_id, total_charged, total_paid, updated_at) "
+                                          "SELECT sd.id, COALESCE((SELECT SUM(tc.amount) FROM tuition_charges tc WHERE tc.student_id = sd.id), NULLIF(col.tuition_fees, 0), sd.tuition_fees, 0), "
+                                          "COALESCE((SELECT SUM(p.amount) FROM payments p WHERE p.student_id = sd.id AND LOWER(p.status) IN ('paid', 'success', 'completed')), 0), NOW() "
+                                          "FROM students_data sd LEFT JOIN colleges col ON sd.college_id = col.id ";
+    const QString REBUILD_BALANCES_UPDATE = " ON DUPLICATE KEY UPDATE total_charged = VALUES(total_charged), total_paid = VALUES(total_paid), updated_at = NOW()";
+    const QString REBUILD_BALANCE_BY_STUDENT = REBUILD_BALANCES_BASE + "WHERE sd.id = ?" + REBUILD_BALANCES_UPDATE;
+    const QString REBUILD_ALL_BALANCES = REBUILD_BALANCES_BASE + "WHERE sd.id > 0" + REBUILD_BALANCES_UPDATE;
+    const QString REBUILD_BALANCES_BY_RANGE = REBUILD_BALANCES_BASE + "WHERE sd.id > ? AND sd.id <= ?" + REBUILD_BALANCES_UPDATE;
+    const QString REBUILD_BALANCES_BY_COLLEGE = REBUILD_BALANCES_BASE + "WHERE sd.college_id = ?" + REBUILD_BALANCES_UPDATE;
+
+    // Fee rule queries
+    const QString UPSERT_FEE_RULE = "INSERT INTO fee_rules (college_id, academic_level_id, amount) VALUES (?, ?, ?) "
+                                    "ON DUPLICATE KEY UPDATE amount = VALUES(amount)";
+    const QString DELETE_FEE_RULE = "DELETE FROM fee_rules WHERE id = ?";
+    const QString SELECT_ALL_FEE_RULES = "SELECT * FROM fee_rules ORDER BY college_id, academic_level_id";
+
+    // Tuition billing queries (chunks are ranges of students_data.id)
+    const QString COUNT_BILLABLE_STUDENTS = "SELECT COUNT(*) FROM students_data WHERE COALESCE(status, 'active') = 'active'";
+    const QString SELECT_BILLING_CHUNK_BOUND = "SELECT MAX(id), COUNT(*) FROM (SELECT id FROM students_data "
+                                               "WHERE id > ? AND COALESCE(status, 'active') = 'active' ORDER BY id LIMIT ?) chunk";
+    const QString INSERT_TUITION_CHARGES_CHUNK = "INSERT IGNORE INTO tuition_charges (student_id, semester_id, amount, billing_run_id, created_at) "
+                                                 "SELECT sd.id, ?, COALESCE(r_cl.amount, r_c.amount, r_l.amount, NULLIF(col.tuition_fees, 0), sd.tuition_fees, 0), ?, NOW() "
+                                                 "FROM students_data sd "
+                                                 "LEFT JOIN fee_rules r_cl ON r_cl.college_id = sd.college_id AND r_cl.academic_level_id = sd.academic_level_id "
+                                                 "LEFT JOIN fee_rules r_c ON r_c.college_id = sd.college_id AND r_c.academic_level_id = 0 "
+                                                 "LEFT JOIN fee_rules r_l ON r_l.college_id = 0 AND r_l.academic_level_id = sd.academic_level_id "
+                                                 "LEFT JOIN colleges col ON sd.college_id = col.id "
+                                                 "WHERE sd.id > ? AND sd.id <= ? AND COALESCE(sd.status, 'active') = 'active'";
+
+    // Cohort promotion queries (chunks are ranges of students_data.id within one level)
+    // A student passes a level when no more than the allowed number of its courses are below
+    // 60% of their max grade, the Pass bound of GradeStatistics::letterForPercentage()
+    const QString COUNT_PROMOTION_CANDIDATES = "SELECT COUNT(*) FROM students_data WHERE academic_level_id = ? AND COALESCE(status, 'active') = 'active'";
+    const QString SELECT_PROMOTION_CHUNK_BOUND = "SELECT MAX(id), COUNT(*) FROM (SELECT id FROM students_data "
+                                                 "WHERE id > ? AND academic_level_id = ? AND COALESCE(status, 'active') = 'active' ORDER BY id LIMIT ?) chunk";
+    const QString SELECT_PASSED_STUDENTS_CHUNK = "SELECT e.student_id FROM enrollments e JOIN courses c ON e.course_id = c.id "
+                                                 "WHERE c.year_level = ? AND e.student_id > ? AND e.student_id <= ? "
+                                                 "GROUP BY e.student_id "
+                                                 "HAVING SUM(CASE WHEN e.total_grade * 100 < 60 * COALESCE(NULLIF(c.max_grade, 0), 100) THEN 1 ELSE 0 END) <= ?";
+    const QString INSERT_PROMOTED_ENROLLMENTS_CHUNK = "INSERT IGNORE INTO enrollments (student_id, course_id, status, attendance_count, absence_count, assignment_1_grade, assignment_2_grade, coursework_grade, final_exam_grade, experience_grade, total_grade, letter_grade, enrolled_at) "
+                                                      "SELECT sd.id, c.id, 'Active', 0, 0, 0, 0, 0, 0, 0, 0, 'N/A', NOW() "
+                                                      "FROM students_data sd JOIN courses c ON c.year_level = ? "
+                                                      "WHERE sd.academic_level_id = ? AND COALESCE(sd.status, 'active') = 'active' "
+                                                      "AND sd.id IN (" + SELECT_PASSED_STUDENTS_CHUNK + ")";
+    const QString PROMOTE_STUDENTS_CHUNK = "UPDATE students_data SET academic_level_id = ?, section_id = NULL, updated_at = NOW() "
+                                           "WHERE academic_level_id = ? AND COALESCE(status, 'active') = 'active' "
+                                           "AND id IN (" + SELECT_PASSED_STUDENTS_CHUNK + ")";
+    const QString GRADUATE_STUDENTS_CHUNK = "UPDATE students_data SET status = 'graduated', updated_at = NOW() "
+                                            "WHERE academic_level_id = ? AND COALESCE(status, 'active') = 'active' "
+                                            "AND id IN (" + SELECT_PASSED_STUDENTS_CHUNK + ")";
+    const QString SELECT_NEXT_ACADEMIC_LEVEL = "SELECT id FROM academic_levels "
+                                               "WHERE level_number > (SELECT level_number FROM academic_levels WHERE id = ?) "
+                                               "ORDER BY level_number LIMIT 1";
+
+    // Batch job queries
+    const QString INSERT_BATCH_JOB = "INSERT INTO batch_jobs (job_type, scope, status, checkpoint, processed, total, started_at, updated_at) "
+                                     "VALUES (?, ?, 'Running', 0, 0, ?, NOW(), NOW())";
+    const QString SELECT_BATCH_JOB = "SELECT * FROM batch_jobs WHERE job_type = ? AND scope = ?";
+    const QString UPDATE_BATCH_JOB_STATUS = "UPDATE batch_jobs SET status = ?, updated_at = NOW() WHERE id = ?";
+    const QString UPDATE_BATCH_JOB_PROGRESS = "UPDATE batch_jobs SET checkpoint = ?, processed = processed + ?, updated_at = NOW() WHERE id = ?";
+    const QString RESET_BATCH_JOB = "UPDATE batch_jobs SET status = 'Running', checkpoint = 0, processed = 0, total = ?, started_at = NOW(), updated_at = NOW() WHERE id = ?";
+
+    // Table version queries (change counters read by session caches)
+    const QString BUMP_TABLE_VERSION = "INSERT INTO table_versions (table_name, version) VALUES (?, 1) "
+                                       "ON DUPLICATE KEY UPDATE version = version + 1";
+    const QString SELECT_TABLE_VERSIONS = "SELECT table_name, version FROM table_versions";
 
     // News queries
     const QString INSERT_NEWS = "INSERT INTO news (title, body) VALUES (?, ?)";
@@ -198,9 +337,10 @@ namespace Queries {
     const QString INSERT_PROFESSOR = "INSERT INTO professors (user_id, specialization, title, personal_info, id_number) VALUES (?, ?, ?, ?, ?)";
     const QString UPDATE_PROFESSOR = "UPDATE professors SET specialization = ?, title = ?, personal_info = ?, id_number = ? WHERE id = ?";
     const QString DELETE_PROFESSOR = "DELETE FROM professors WHERE id = ?";
-    const QString SELECT_ALL_PROFESSORS = "SELECT p.*, u.full_name FROM professors p JOIN users u ON p.user_id = u.id ORDER BY u.full_name";
-    const QString SELECT_PROFESSOR_BY_USER_ID = "SELECT p.*, u.full_name FROM professors p JOIN users u ON p.user_id = u.id WHERE p.user_id = ?";
-    const QString SELECT_PROFESSOR_BY_ID_NUMBER = "SELECT p.*, u.full_name, u.role, u.password FROM professors p JOIN users u ON p.user_id = u.id WHERE p.id_number = ?";
+    const QString SELECT_ALL_PROFESSORS = "SELECT p.*, u.full_name, u.username FROM professors p JOIN users u ON p.user_id = u.id ORDER BY u.full_name";
+    const QString SELECT_PROFESSOR_BY_USER_ID = "SELECT p.*, u.full_name, u.username FROM professors p JOIN users u ON p.user_id = u.id WHERE p.user_id = ?";
+    const QString SELECT_PROFESSOR_BY_ID = "SELECT p.*, u.full_name, u.username FROM professors p JOIN users u ON p.user_id = u.id WHERE p.id = ?";
+    const QString SELECT_PROFESSOR_BY_ID_NUMBER = "SELECT p.*, u.full_name, u.username FROM professors p JOIN users u ON p.user_id = u.id WHERE p.id_number = ?";
 
     // Schedule queries
     const QString INSERT_SCHEDULE = "INSERT INTO schedules (course_id, room_id, professor_id, day_of_week, start_time, end_time) VALUES (?, ?, ?, ?, ?, ?)";
@@ -211,6 +351,13 @@ namespace Queries {
                                          "JOIN rooms r ON s.room_id = r.id "
                                          "JOIN professors p ON s.professor_id = p.id "
                                          "JOIN users u ON p.user_id = u.id";
+    // The admin schedules table, one text column per displayed field
+    const QString SELECT_SCHEDULE_TABLE_ROWS = "SELECT s.id, c.name, r.name, u.full_name, s.day_of_week, s.start_time, s.end_time "
+                                               "FROM schedules s "
+                                               "JOIN courses c ON s.course_id = c.id "
+                                               "JOIN rooms r ON s.room_id = r.id "
+                                               "JOIN professors p ON s.professor_id = p.id "
+                                               "JOIN users u ON p.user_id = u.id";
     const QString SELECT_SCHEDULE_BY_PROFESSOR = "SELECT s.*, c.name as course_name, r.name as room_name "
                                                  "FROM schedules s JOIN courses c ON s.course_id = c.id "
                                                  "JOIN rooms r ON s.room_id = r.id "
@@ -223,20 +370,50 @@ namespace Queries {
                                              "FROM schedules s JOIN courses c ON s.course_id = c.id "
                                              "JOIN rooms r ON s.room_id = r.id "
                                              "WHERE c.year_level = ? ORDER BY s.day_of_week, s.start_time";
+    const QString SELECT_SCHEDULE_BY_STUDENT = "SELECT s.*, c.name as course_name, r.name as room_name "
+                                               "FROM schedules s JOIN courses c ON s.course_id = c.id "
+                                               "JOIN rooms r ON s.room_id = r.id "
+                                               "WHERE s.course_id IN (SELECT course_id FROM enrollments WHERE student_id = ?) "
+                                               "ORDER BY s.day_of_week, s.start_time";
 
     // Attendance Log Queries
     const QString INSERT_ATTENDANCE_LOG = "INSERT INTO attendance_logs (enrollment_id, date, status, notes) VALUES (?, ?, ?, ?)";
+    const QString UPDATE_ATTENDANCE_LOG = "UPDATE attendance_logs SET status = ?, notes = ? WHERE id = ?";
+    const QString SELECT_ATTENDANCE_LOG_BY_DATE = "SELECT id, status FROM attendance_logs WHERE enrollment_id = ? AND date = ?";
     const QString SELECT_ATTENDANCE_LOGS_BY_ENROLLMENT = "SELECT * FROM attendance_logs WHERE enrollment_id = ? ORDER BY date DESC";
     const QString SELECT_ATTENDANCE_LOGS_BY_COURSE_DATE = "SELECT al.* FROM attendance_logs al "
                                                           "JOIN enrollments e ON al.enrollment_id = e.id "
                                                           "WHERE e.course_id = ? AND al.date = ?";
+    const QString SELECT_ATTENDANCE_DATES_BY_COURSE = "SELECT DISTINCT al.date FROM attendance_logs al "
+                                                      "JOIN enrollments e ON al.enrollment_id = e.id "
+                                                      "WHERE e.course_id = ?";
+    const QString SELECT_ATTENDANCE_STATUS_BY_COURSE = "SELECT al.enrollment_id, al.date, al.status FROM attendance_logs al "
+                                                       "JOIN enrollments e ON al.enrollment_id = e.id "
+                                                       "WHERE e.course_id = ?";
+
+    // Attendance Bitmap queries
+    const QString SELECT_ATTENDANCE_BITMAP_BY_ENROLLMENT = "SELECT e.id AS enrollment_id, e.course_id, b.term_start, b.day_count, "
+                                                           "b.present, b.absent, b.late, b.excused "
+                                                           "FROM enrollments e LEFT JOIN attendance_bitmaps b ON b.enrollment_id = e.id "
+                                                           "WHERE e.id = ?";
+    const QString SELECT_ATTENDANCE_BITMAPS_BY_COURSE = "SELECT e.id AS enrollment_id, e.course_id, b.term_start, b.day_count, "
+                                                        "b.present, b.absent, b.late, b.excused "
+                                                        "FROM enrollments e LEFT JOIN attendance_bitmaps b ON b.enrollment_id = e.id "
+                                                        "WHERE e.course_id = ?";
+    const QString UPSERT_ATTENDANCE_BITMAP = "INSERT INTO attendance_bitmaps (enrollment_id, term_start, day_count, present, absent, late, excused) "
+                                             "VALUES (?, ?, ?, ?, ?, ?, ?) "
+                                             "ON DUPLICATE KEY UPDATE term_start = VALUES(term_start), day_count = VALUES(day_count), "
+                                             "present = VALUES(present), absent = VALUES(absent), late = VALUES(late), "
+                                             "excused = VALUES(excused), updated_at = NOW()";
 
     // Calendar Event queries
-    const QString INSERT_CALENDAR_EVENT = "INSERT INTO calendar_events (title, description, start_date, end_date, event_type) VALUES (?, ?, ?, ?, ?)";
-    const QString UPDATE_CALENDAR_EVENT = "UPDATE calendar_events SET title = ?, description = ?, start_date = ?, end_date = ?, event_type = ? WHERE id = ?";
+    const QString INSERT_CALENDAR_EVENT = "INSERT INTO calendar_events (title, description, start_date, end_date, event_type, recurrence, recurrence_until) VALUES (?, ?, ?, ?, ?, ?, ?)";
+    const QString UPDATE_CALENDAR_EVENT = "UPDATE calendar_events SET title = ?, description = ?, start_date = ?, end_date = ?, event_type = ?, recurrence = ?, recurrence_until = ? WHERE id = ?";
     const QString DELETE_CALENDAR_EVENT = "DELETE FROM calendar_events WHERE id = ?";
     const QString SELECT_ALL_CALENDAR_EVENTS = "SELECT * FROM calendar_events ORDER BY start_date";
-    const QString SELECT_CALENDAR_EVENTS_BY_RANGE = "SELECT * FROM calendar_events WHERE start_date >= ? AND end_date <= ? ORDER BY start_date";
+
+    // Name of the constant holding this exact statement, empty for ad-hoc SQL
+    QString nameOf(const QString& sql);
 }
 
 #endif // QUERIES_H
@@ -0,0 +1,291 @@
+#include "querymetrics.h"
+#include "queries.h"
+#include "querytracker.h"
+#include <QMutexLocker>
+#include <QtGlobal>
+#include <algorithm>
+
+namespace {
+
+// Exact values below 2^SubBucketBits, then 2^(SubBucketBits-1) sub-buckets per power of two
+const int SubBucketBits = 5;
+const int SubBucketCount = 1 << SubBucketBits;
+const int SubBucketHalf = SubBucketCount / 2;
+
+// One hour; anything slower is recorded as this
+const qint64 MaxTrackableMicros = Q_INT64_C(3600000000);
+
+const int NameCacheLimit = 512;
+
+/**
+ * @return Index of the highest set bit of a positive value
+ */
+int highestBit(qint64 value)
+{
+    int bit = 0;
+    while (value >> (bit + 1)) ++bit;
+    return bit;
+}
+
+/**
+ * Formats a duration for the dump
+ * @param micros - The duration in microseconds
+ */
+QString formatMillis(qint64 micros)
+{
+    return QString::number(micros / 1000.0, 'f', 2);
+}
+
+} // namespace
+
+/**
+ * Constructor for the LatencyHistogram class
+ */
+LatencyHistogram::LatencyHistogram()
+    : m_count(0), m_sum(0), m_max(0)
+{
+}
+
+/**
+ * Adds one observation
+ * @param micros - The duration in microseconds
+ */
+void LatencyHistogram::record(qint64 micros)
+{
+    micros = qBound(Q_INT64_C(0), micros, MaxTrackableMicros);
+    if (m_buckets.isEmpty()) {
+        m_buckets.fill(0, bucketFor(MaxTrackableMicros) + 1);
+    }
+    ++m_buckets[bucketFor(micros)];
+    ++m_count;
+    m_sum += micros;
+    if (micros > m_max) m_max = micros;
+}
+
+/**
+ * @return Number of observations
+ */
+qint64 LatencyHistogram::count() const
+{
+    return m_count;
+}
+
+/**
+ * @return Largest observation in microseconds
+ */
+qint64 LatencyHistogram::max() const
+{
+    return m_max;
+}
+
+/**
+ * @return Average observation in microseconds
+ */
+double LatencyHistogram::mean() const
+{
+    return m_count > 0 ? double(m_sum) / m_count : 0.0;
+}
+
+/**
+ * Finds the value below which the given share of observations fall
+ * @param percent - 0 to 100, e.g. 99 for p99
+ * @return The upper edge of the bucket holding that observation, in microseconds
+ */
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    if (m_count == 0) return 0;
+
+    qint64 target = qint64(percent / 100.0 * m_count + 0.5);
+    target = qBound(Q_INT64_C(1), target, m_count);
+
+    qint64 seen = 0;
+    for (int i = 0; i < m_buckets.size(); ++i) {
+        seen += m_buckets[i];
+        if (seen >= target) return qMin(bucketUpperBound(i), m_max);
+    }
+    return m_max;
+}
+
+/**
+ * @param micros - A value between 0 and MaxTrackableMicros
+ * @return The bucket counting that value
+ */
+int LatencyHistogram::bucketFor(qint64 micros)
+{
+    if (micros < SubBucketCount) return int(micros);
+
+    const int shift = highestBit(micros) - (SubBucketBits - 1);
+    const int sub = int(micros >> shift) - SubBucketHalf;
+    return SubBucketCount + (shift - 1) * SubBucketHalf + sub;
+}
+
+/**
+ * @param bucket - A bucket index
+ * @return The largest value counted by that bucket
+ */
+qint64 LatencyHistogram::bucketUpperBound(int bucket)
+{
+    if (bucket < SubBucketCount) return bucket;
+
+    const int offset = bucket - SubBucketCount;
+    const int shift = offset / SubBucketHalf + 1;
+    const qint64 lower = qint64(offset % SubBucketHalf + SubBucketHalf) << shift;
+    return lower + (Q_INT64_C(1) << shift) - 1;
+}
+
+/**
+ * Constructor for the QueryMetrics class
+ */
+QueryMetrics::QueryMetrics()
+{
+}
+
+/**
+ * @return The process wide metrics registry
+ */
+QueryMetrics& QueryMetrics::instance()
+{
+    static QueryMetrics metrics;
+    return metrics;
+}
+
+/**
+ * Picks the name a statement is reported under
+ * @param sql - The statement text
+ * @return The Queries:: constant name, or the statement's template for ad-hoc SQL
+ */
+QString QueryMetrics::nameFor(const QString& sql)
+{
+    thread_local QHash<QString, QString> names;
+    QString name = names.value(sql);
+    if (name.isEmpty()) {
+        if (names.size() >= NameCacheLimit) names.clear();
+        name = Queries::nameOf(sql);
+        if (name.isEmpty()) name = QueryTracker::normalize(sql);
+        names.insert(sql, name);
+    }
+    return name;
+}
+
+/**
+ * Records the time taken to prepare a statement
+ * @param name - The statement name from nameFor()
+ * @param nsecs - Elapsed time in nanoseconds
+ * @param ok - False if the prepare failed
+ * @param error - The driver error when ok is false
+ */
+void QueryMetrics::recordPrepare(const QString& name, qint64 nsecs, bool ok, const QString& error)
+{
+    QMutexLocker locker(&m_mutex);
+    QueryStats& stats = statsFor(name);
+    stats.prepare.record(nsecs / 1000);
+    if (!ok) {
+        ++stats.errors;
+        stats.lastError = error;
+    }
+}
+
+/**
+ * Records one execution of a statement
+ * @param name - The statement name from nameFor()
+ * @param nsecs - Elapsed time in nanoseconds
+ * @param ok - False if the execution failed
+ * @param error - The driver error when ok is false
+ */
+void QueryMetrics::recordExec(const QString& name, qint64 nsecs, bool ok, const QString& error)
+{
+    QMutexLocker locker(&m_mutex);
+    QueryStats& stats = statsFor(name);
+    ++stats.executions;
+    stats.exec.record(nsecs / 1000);
+    if (!ok) {
+        ++stats.errors;
+        stats.lastError = error;
+    }
+}
+
+/**
+ * Records the time spent reading one result set
+ * @param name - The statement name from nameFor()
+ * @param nsecs - Time spent in next() over the whole result, in nanoseconds
+ * @param rows - Rows read
+ */
+void QueryMetrics::recordFetch(const QString& name, qint64 nsecs, qint64 rows)
+{
+    QMutexLocker locker(&m_mutex);
+    QueryStats& stats = statsFor(name);
+    stats.fetch.record(nsecs / 1000);
+    stats.rows += rows;
+}
+
+/**
+ * @return A copy of all statistics, slowest statements (by total exec time) first
+ */
+QList<QueryStats> QueryMetrics::snapshot() const
+{
+    QList<QueryStats> result;
+    {
+        QMutexLocker locker(&m_mutex);
+        for (auto it = m_stats.constBegin(); it != m_stats.constEnd(); ++it) {
+            result.append(it.value());
+        }
+    }
+    std::sort(result.begin(), result.end(), [](const QueryStats& a, const QueryStats& b) {
+        return a.exec.mean() * a.exec.count() > b.exec.mean() * b.exec.count();
+    });
+    return result;
+}
+
+/**
+ * Formats the statistics as plain text, one statement per line
+ * @return The diagnostics report
+ */
+QString QueryMetrics::dump() const
+{
+    const QList<QueryStats> all = snapshot();
+    if (all.isEmpty()) return "No statements recorded yet.\n";
+
+    QString report = "Times in ms: exec p50/p95/p99 (max) | fetch p95 | prepare p95\n";
+    for (const QueryStats& s : all) {
+        QString name = s.name;
+        if (name.length() > 60) name = name.left(57) + "...";
+        report += QString("%1\n   runs %2, errors %3, rows %4 | exec %5/%6/%7 (%8) | fetch %9 | prepare %10\n")
+            .arg(name)
+            .arg(s.executions).arg(s.errors).arg(s.rows)
+            .arg(formatMillis(s.exec.percentile(50)))
+            .arg(formatMillis(s.exec.percentile(95)))
+            .arg(formatMillis(s.exec.percentile(99)))
+            .arg(formatMillis(s.exec.max()))
+            .arg(formatMillis(s.fetch.percentile(95)))
+            .arg(formatMillis(s.prepare.percentile(95)));
+        if (!s.lastError.isEmpty()) {
+            report += "   last error: " + s.lastError + "\n";
+        }
+    }
+    return report;
+}
+
+/**
+ * Discards everything recorded so far
+ */
+void QueryMetrics::reset()
+{
+    QMutexLocker locker(&m_mutex);
+    m_stats.clear();
+}
+
+/**
+ * @param name - The statement name
+ * @return The statistics entry, created on first use; caller holds the mutex
+ */
+QueryStats& QueryMetrics::statsFor(const QString& name)
+{
+    auto it = m_stats.find(name);
+    if (it == m_stats.end()) {
+        QueryStats stats;
+        stats.name = name;
+        m_stats.insert(name, stats);
+        it = m_stats.find(name);
+    }
+    return it.value();
+}
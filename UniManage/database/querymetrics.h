@@ -0,0 +1,84 @@
+#ifndef QUERYMETRICS_H
+#define QUERYMETRICS_H
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <QVector>
+
+/**
+ * Latency histogram with HDR-style log-linear buckets
+ * Values below 32 us are exact; above that every power of two is split into
+ * 16 sub-buckets, so any recorded value is off by at most 1/16 while the
+ * whole range up to an hour fits in a few hundred counters
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(qint64 micros);
+
+    qint64 count() const;
+    qint64 max() const;
+    double mean() const;
+    qint64 percentile(double percent) const;
+
+private:
+    static int bucketFor(qint64 micros);
+    static qint64 bucketUpperBound(int bucket);
+
+    QVector<qint64> m_buckets; // allocated on first record
+    qint64 m_count;
+    qint64 m_sum;
+    qint64 m_max;
+};
+
+/**
+ * Everything measured for one named statement
+ * Times are in microseconds
+ */
+struct QueryStats
+{
+    QString name;
+    qint64 executions = 0;
+    qint64 errors = 0;
+    qint64 rows = 0;
+    QString lastError;
+    LatencyHistogram prepare;
+    LatencyHistogram exec;
+    LatencyHistogram fetch;
+};
+
+/**
+ * Process wide per-statement metrics, fed by DBQuery
+ * Statements are named after their Queries:: constant; ad-hoc SQL is named
+ * by its template (literals replaced by ?)
+ */
+class QueryMetrics
+{
+public:
+    static QueryMetrics& instance();
+    static QString nameFor(const QString& sql);
+
+    void recordPrepare(const QString& name, qint64 nsecs, bool ok, const QString& error);
+    void recordExec(const QString& name, qint64 nsecs, bool ok, const QString& error);
+    void recordFetch(const QString& name, qint64 nsecs, qint64 rows);
+
+    QList<QueryStats> snapshot() const;
+    QString dump() const;
+    void reset();
+
+private:
+    QueryMetrics();
+    QueryMetrics(const QueryMetrics&) = delete;
+    QueryMetrics& operator=(const QueryMetrics&) = delete;
+
+    QueryStats& statsFor(const QString& name);
+
+    mutable QMutex m_mutex;
+    QHash<QString, QueryStats> m_stats;
+};
+
+#endif // QUERYMETRICS_H
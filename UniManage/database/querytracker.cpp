@@ -0,0 +1,184 @@
+#include "querytracker.h"
+#include <QDebug>
+#include <QRegularExpression>
+#include <QtGlobal>
+#include <atomic>
+
+namespace {
+
+const int DefaultThreshold = 10;
+
+// Normalized templates kept per thread; SQL text is almost always a constant
+const int MaxCachedTemplates = 512;
+
+thread_local QueryTracker::Scope* currentScope = nullptr;
+
+std::atomic<int>& thresholdSetting()
+{
+    static std::atomic<int> value(qEnvironmentVariableIsSet("UNIMANAGE_N1_THRESHOLD")
+                                      ? qEnvironmentVariableIntValue("UNIMANAGE_N1_THRESHOLD")
+                                      : DefaultThreshold);
+    return value;
+}
+
+std::atomic<bool>& strictSetting()
+{
+    static std::atomic<bool> value(qEnvironmentVariableIntValue("UNIMANAGE_N1_STRICT") != 0);
+    return value;
+}
+
+} // namespace
+
+/**
+ * Opens a request scope on the calling thread
+ * Scopes nest; statements count against every open scope
+ * @param name - Shown in reports, e.g. the function serving the request
+ */
+QueryTracker::Scope::Scope(const QString& name)
+    : m_name(name), m_parent(nullptr), m_total(0)
+{
+#ifndef QT_NO_DEBUG
+    m_parent = currentScope;
+    currentScope = this;
+#endif
+}
+
+/**
+ * Closes the scope
+ */
+QueryTracker::Scope::~Scope()
+{
+#ifndef QT_NO_DEBUG
+    currentScope = m_parent;
+#endif
+}
+
+/**
+ * @return Statements run while the scope was open
+ */
+int QueryTracker::Scope::statementCount() const
+{
+    return m_total;
+}
+
+/**
+ * @return Executions by statement template
+ */
+QHash<QString, int> QueryTracker::Scope::counts() const
+{
+    return m_counts;
+}
+
+/**
+ * @return Templates that ran more than threshold() times
+ */
+QStringList QueryTracker::Scope::violations() const
+{
+    return m_violations;
+}
+
+/**
+ * @return True if tracking is compiled in (debug builds)
+ */
+bool QueryTracker::isEnabled()
+{
+#ifndef QT_NO_DEBUG
+    return true;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Counts one executed statement against the open scopes of this thread
+ * Called by DBQuery; does nothing outside a scope or in release builds
+ * @param sql - The statement text as prepared or executed
+ */
+void QueryTracker::record(const QString& sql)
+{
+#ifndef QT_NO_DEBUG
+    if (!currentScope) return;
+
+    thread_local QHash<QString, QString> templates;
+    QString key = templates.value(sql);
+    if (key.isEmpty()) {
+        if (templates.size() >= MaxCachedTemplates) templates.clear();
+        key = normalize(sql);
+        templates.insert(sql, key);
+    }
+    const int limit = threshold();
+
+    // The innermost scope that crosses the limit reports, enclosing ones only record it
+    bool reported = false;
+    for (Scope* scope = currentScope; scope; scope = scope->m_parent) {
+        ++scope->m_total;
+        const int count = ++scope->m_counts[key];
+        if (limit <= 0 || count != limit + 1) continue;
+
+        scope->m_violations.append(key);
+        if (reported) continue;
+        reported = true;
+
+        qWarning() << "N+1 query in" << scope->m_name << "- ran" << count << "times:" << key;
+        if (isStrict()) {
+            qFatal("N+1 query in %s: %s", qPrintable(scope->m_name), qPrintable(key));
+        }
+    }
+#else
+    Q_UNUSED(sql);
+#endif
+}
+
+/**
+ * @return Executions of one template allowed per scope (0 disables reports)
+ */
+int QueryTracker::threshold()
+{
+    return thresholdSetting().load();
+}
+
+/**
+ * @param repeats - Executions of one template allowed per scope (0 disables reports)
+ */
+void QueryTracker::setThreshold(int repeats)
+{
+    thresholdSetting().store(repeats);
+}
+
+/**
+ * @return True if a violation aborts the process
+ */
+bool QueryTracker::isStrict()
+{
+    return strictSetting().load();
+}
+
+/**
+ * @param strict - True to abort on the first violation (for test runs)
+ */
+void QueryTracker::setStrict(bool strict)
+{
+    strictSetting().store(strict);
+}
+
+/**
+ * Reduces a statement to its template
+ * String and number literals become ?, IN lists collapse to one ? and
+ * whitespace is folded, so the same query with different values matches
+ * @param sql - The statement text
+ * @return The template
+ */
+QString QueryTracker::normalize(const QString& sql)
+{
+    static const QRegularExpression quoted("'(?:[^']|'')*'");
+    static const QRegularExpression number("\\b\\d+(?:\\.\\d+)?\\b");
+    static const QRegularExpression list("\\(\\s*\\?(?:\\s*,\\s*\\?)+\\s*\\)");
+    static const QRegularExpression spaces("\\s+");
+
+    QString key = sql;
+    key.replace(quoted, "?");
+    key.replace(number, "?");
+    key.replace(list, "(?)");
+    key.replace(spaces, " ");
+    return key.trimmed();
+}
@@ -0,0 +1,59 @@
+#ifndef QUERYTRACKER_H
+#define QUERYTRACKER_H
+
+#include <QHash>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Debug-build N+1 query detector
+ * A Scope marks one request (a panel load, a cache refresh, ...). Every
+ * statement run through DBQuery on the same thread is counted against the
+ * innermost open scope by its template (the SQL with literals replaced by ?).
+ * When one template runs more than threshold() times in a scope the scope
+ * reports it, which almost always means a query issued once per row of a
+ * list. In strict mode a violation aborts, so test runs fail on regressions.
+ *
+ * Configured from the environment:
+ *   UNIMANAGE_N1_THRESHOLD - repeats allowed per template and scope (default 10)
+ *   UNIMANAGE_N1_STRICT    - 1 to abort on the first violation
+ *
+ * Release builds (QT_NO_DEBUG) compile all of this to no-ops.
+ */
+class QueryTracker
+{
+public:
+    class Scope
+    {
+    public:
+        explicit Scope(const QString& name);
+        ~Scope();
+
+        int statementCount() const;
+        QHash<QString, int> counts() const;
+        QStringList violations() const;
+
+    private:
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        friend class QueryTracker;
+        QString m_name;
+        Scope* m_parent;
+        int m_total;
+        QHash<QString, int> m_counts;
+        QStringList m_violations;
+    };
+
+    static bool isEnabled();
+    static void record(const QString& sql);
+
+    static int threshold();
+    static void setThreshold(int repeats);
+    static bool isStrict();
+    static void setStrict(bool strict);
+
+    static QString normalize(const QString& sql);
+};
+
+#endif // QUERYTRACKER_H
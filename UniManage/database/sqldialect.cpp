@@ -0,0 +1,232 @@
+#include "sqldialect.h"
+#include <QHash>
+#include <QRegularExpression>
+
+namespace {
+
+const QRegularExpression::PatternOption CaseInsensitive = QRegularExpression::CaseInsensitiveOption;
+
+// Translated statements kept per thread; SQL text is almost always a constant
+const int MaxCachedStatements = 512;
+
+} // namespace
+
+/**
+ * Constructor for the SqlDialect class
+ * MySQL until DBConnection::initialize() says otherwise
+ */
+SqlDialect::SqlDialect()
+    : m_backend(MySql)
+{
+}
+
+/**
+ * @return The process wide dialect
+ */
+SqlDialect& SqlDialect::instance()
+{
+    static SqlDialect dialect;
+    return dialect;
+}
+
+/**
+ * Parses the DB_DRIVER setting
+ * @param name - "mysql" or "sqlite" (Qt driver names are accepted too)
+ * @param ok - Set to false if the name is not recognised
+ * @return The backend, MySql for unknown names
+ */
+SqlDialect::Backend SqlDialect::backendFromName(const QString& name, bool* ok)
+{
+    const QString key = name.trimmed().toLower();
+    if (ok) *ok = true;
+    if (key == "sqlite" || key == "sqlite3" || key == "qsqlite") return Sqlite;
+    if (key.isEmpty() || key == "mysql" || key == "qmysql") return MySql;
+    if (ok) *ok = false;
+    return MySql;
+}
+
+/**
+ * @param backend - The backend every connection uses
+ */
+void SqlDialect::setBackend(Backend backend)
+{
+    m_backend = backend;
+}
+
+/**
+ * @return The configured backend
+ */
+SqlDialect::Backend SqlDialect::backend() const
+{
+    return m_backend;
+}
+
+/**
+ * @return True if statements run against a local SQLite file
+ */
+bool SqlDialect::isSqlite() const
+{
+    return m_backend == Sqlite;
+}
+
+/**
+ * @return The Qt SQL driver for the backend
+ */
+QString SqlDialect::driverName() const
+{
+    return m_backend == Sqlite ? "QSQLITE" : "QMYSQL";
+}
+
+/**
+ * Rewrites a statement for the configured backend
+ * @param sql - A statement written for MySQL
+ * @return The statement to hand to the driver (unchanged on MySQL)
+ */
+QString SqlDialect::translate(const QString& sql) const
+{
+    if (m_backend != Sqlite) return sql;
+
+    thread_local QHash<QString, QString> translated;
+    QString result = translated.value(sql);
+    if (result.isEmpty()) {
+        if (translated.size() >= MaxCachedStatements) translated.clear();
+        result = toSqlite(sql);
+        translated.insert(sql, result);
+    }
+    return result;
+}
+
+/**
+ * Turns a MySQL CREATE TABLE into the statements that build it on the backend
+ * On SQLite the auto-increment key, ENUM types and ON UPDATE clauses are
+ * rewritten, engine options dropped, and inline INDEX entries become
+ * separate CREATE INDEX statements run after the table
+ * @param ddl - A CREATE TABLE statement written for MySQL
+ * @return The statements to execute, in order
+ */
+QStringList SqlDialect::createTable(const QString& ddl) const
+{
+    if (m_backend != Sqlite) return QStringList() << ddl;
+
+    static const QRegularExpression tableName("CREATE\\s+TABLE\\s+(?:IF\\s+NOT\\s+EXISTS\\s+)?`?(\\w+)`?", CaseInsensitive);
+    static const QRegularExpression autoIncrement("\\bINT\\s+(?:PRIMARY\\s+KEY\\s+AUTO_INCREMENT|AUTO_INCREMENT\\s+PRIMARY\\s+KEY)\\b", CaseInsensitive);
+    static const QRegularExpression onUpdate("\\s+ON\\s+UPDATE\\s+CURRENT_TIMESTAMP\\b", CaseInsensitive);
+    static const QRegularExpression enumType("\\bENUM\\s*\\([^)]*\\)", CaseInsensitive);
+    static const QRegularExpression inlineIndex("^(?:INDEX|KEY)\\s+`?(\\w+)`?\\s*(\\(.*\\))$", CaseInsensitive);
+    static const QRegularExpression uniqueKey("^UNIQUE\\s+(?:KEY|INDEX)\\s+`?\\w+`?\\s*(\\(.*\\))$", CaseInsensitive);
+
+    const QRegularExpressionMatch name = tableName.match(ddl);
+    const int open = ddl.indexOf('(');
+    const int close = ddl.lastIndexOf(')');
+    if (!name.hasMatch() || open < 0 || close < open) return QStringList() << toSqlite(ddl);
+    const QString table = name.captured(1);
+
+    QStringList definitions;
+    QStringList indexes;
+    for (QString item : splitTopLevel(ddl.mid(open + 1, close - open - 1))) {
+        item = item.trimmed();
+
+        const QRegularExpressionMatch index = inlineIndex.match(item);
+        if (index.hasMatch()) {
+            // Index names are per database in SQLite, not per table
+            indexes << QString("CREATE INDEX IF NOT EXISTS %1_%2 ON %1 %3")
+                           .arg(table).arg(index.captured(1)).arg(index.captured(2));
+            continue;
+        }
+        const QRegularExpressionMatch unique = uniqueKey.match(item);
+        if (unique.hasMatch()) {
+            definitions << "UNIQUE " + unique.captured(1);
+            continue;
+        }
+
+        item.replace(autoIncrement, "INTEGER PRIMARY KEY AUTOINCREMENT");
+        item.replace(onUpdate, "");
+        item.replace(enumType, "TEXT");
+        definitions << item;
+    }
+
+    QStringList statements;
+    statements << QString("CREATE TABLE IF NOT EXISTS %1 (%2)").arg(table).arg(definitions.join(", "));
+    statements << indexes;
+    return statements;
+}
+
+/**
+ * Statements run on every new connection before it is used
+ * SQLite: WAL so readers never block the writer, NORMAL sync (safe with
+ * WAL), foreign keys on (off by default), a busy timeout so concurrent
+ * writers wait instead of failing, and a larger page cache and mmap window
+ * @return The statements, empty on MySQL
+ */
+QStringList SqlDialect::sessionSetup() const
+{
+    if (m_backend != Sqlite) return QStringList();
+
+    return QStringList()
+        << "PRAGMA journal_mode = WAL"
+        << "PRAGMA synchronous = NORMAL"
+        << "PRAGMA foreign_keys = ON"
+        << "PRAGMA busy_timeout = 5000"
+        << "PRAGMA temp_store = MEMORY"
+        << "PRAGMA cache_size = -16000"
+        << "PRAGMA mmap_size = 268435456";
+}
+
+/**
+ * Rewrites the MySQL-only constructs used by the queries
+ * @param sql - A statement written for MySQL
+ * @return The SQLite statement
+ */
+QString SqlDialect::toSqlite(const QString& sql)
+{
+    static const QRegularExpression now("\\bNOW\\(\\)", CaseInsensitive);
+    static const QRegularExpression curdate("\\bCURDATE\\(\\)", CaseInsensitive);
+    static const QRegularExpression lastInsertId("\\bLAST_INSERT_ID\\(\\)", CaseInsensitive);
+    static const QRegularExpression insertIgnore("\\bINSERT\\s+IGNORE\\b", CaseInsensitive);
+    static const QRegularExpression onDuplicate("\\bON\\s+DUPLICATE\\s+KEY\\s+UPDATE\\b", CaseInsensitive);
+    static const QRegularExpression insertedValue("\\bVALUES\\((\\w+)\\)", CaseInsensitive);
+    static const QRegularExpression forUpdate("\\s+FOR\\s+UPDATE\\s*$", CaseInsensitive);
+    // SQLite takes no separator with DISTINCT, so those fall back to ','
+    static const QRegularExpression distinctConcat("\\bGROUP_CONCAT\\(\\s*DISTINCT\\s+(.+?)\\s+SEPARATOR\\s+'(?:[^']|'')*'\\s*\\)", CaseInsensitive);
+    static const QRegularExpression separatorConcat("\\bGROUP_CONCAT\\((.+?)\\s+SEPARATOR\\s+('(?:[^']|'')*')\\s*\\)", CaseInsensitive);
+
+    QString result = sql;
+    result.replace(now, "CURRENT_TIMESTAMP");
+    result.replace(curdate, "DATE('now')");
+    result.replace(lastInsertId, "last_insert_rowid()");
+    result.replace(insertIgnore, "INSERT OR IGNORE");
+    if (onDuplicate.match(result).hasMatch()) {
+        result.replace(onDuplicate, "ON CONFLICT DO UPDATE SET");
+        result.replace(insertedValue, "excluded.\\1");
+    }
+    result.replace(forUpdate, "");
+    result.replace(distinctConcat, "GROUP_CONCAT(DISTINCT \\1)");
+    result.replace(separatorConcat, "GROUP_CONCAT(\\1, \\2)");
+    return result;
+}
+
+/**
+ * Splits a column list on the commas outside parentheses and quotes
+ * @param body - The text between the outer parentheses of CREATE TABLE
+ * @return The column and constraint definitions
+ */
+QStringList SqlDialect::splitTopLevel(const QString& body)
+{
+    QStringList items;
+    int depth = 0;
+    bool quoted = false;
+    int start = 0;
+    for (int i = 0; i < body.size(); ++i) {
+        const QChar c = body.at(i);
+        if (c == '\'') quoted = !quoted;
+        if (quoted) continue;
+        if (c == '(') ++depth;
+        else if (c == ')') --depth;
+        else if (c == ',' && depth == 0) {
+            items << body.mid(start, i - start);
+            start = i + 1;
+        }
+    }
+    items << body.mid(start);
+    return items;
+}
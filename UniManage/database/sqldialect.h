@@ -0,0 +1,50 @@
+#ifndef SQLDIALECT_H
+#define SQLDIALECT_H
+
+#include <QString>
+#include <QStringList>
+
+/**
+ * The SQL flavour of the configured storage backend
+ * Statements and DDL in this codebase are written for MySQL. When the
+ * backend is SQLite they are rewritten on the way to the driver: NOW(),
+ * INSERT IGNORE, ON DUPLICATE KEY UPDATE, GROUP_CONCAT ... SEPARATOR,
+ * LAST_INSERT_ID() and FOR UPDATE become their SQLite equivalents, and
+ * CREATE TABLE loses engine options and moves inline indexes out into
+ * CREATE INDEX statements.
+ *
+ * The backend is chosen once by DBConnection::initialize() (DB_DRIVER in
+ * .env) before any worker thread runs a statement.
+ */
+class SqlDialect
+{
+public:
+    enum Backend {
+        MySql = 0,
+        Sqlite
+    };
+
+    static SqlDialect& instance();
+    static Backend backendFromName(const QString& name, bool* ok = nullptr);
+
+    void setBackend(Backend backend);
+    Backend backend() const;
+    bool isSqlite() const;
+    QString driverName() const;
+
+    QString translate(const QString& sql) const;
+    QStringList createTable(const QString& ddl) const;
+    QStringList sessionSetup() const;
+
+private:
+    SqlDialect();
+    SqlDialect(const SqlDialect&) = delete;
+    SqlDialect& operator=(const SqlDialect&) = delete;
+
+    static QString toSqlite(const QString& sql);
+    static QStringList splitTopLevel(const QString& body);
+
+    Backend m_backend;
+};
+
+#endif // SQLDIALECT_H
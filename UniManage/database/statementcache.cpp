@@ -0,0 +1,156 @@
+#include "statementcache.h"
+#include "queries.h"
+#include <atomic>
+
+namespace {
+
+// Statements kept prepared per connection; the hot set is far smaller
+const int Capacity = 64;
+
+// Bumped by invalidate(); caches built under an older value are stale
+std::atomic<quint64> currentGeneration(0);
+
+// Source of epoch(); unique across threads, so a recreated cache never reuses one
+std::atomic<quint64> epochCount(0);
+
+// The calling thread's caches by connection name
+QHash<QString, StatementCache>& threadCaches()
+{
+    thread_local QHash<QString, StatementCache> caches;
+    return caches;
+}
+
+} // namespace
+
+/**
+ * Constructor for the StatementCache class
+ */
+StatementCache::StatementCache()
+    : m_clock(0), m_generation(currentGeneration.load()), m_epoch(++epochCount)
+{
+}
+
+/**
+ * Returns the calling thread's cache for a connection
+ * A cache created before the last invalidate() is emptied first
+ * @param db - The connection the statements run on
+ * @return The cache
+ */
+StatementCache& StatementCache::forConnection(const QSqlDatabase& db)
+{
+    StatementCache& cache = threadCaches()[db.connectionName()];
+    const quint64 generation = currentGeneration.load();
+    if (cache.m_generation != generation) {
+        cache.clear();
+        cache.m_generation = generation;
+    }
+    return cache;
+}
+
+/**
+ * Drops every cached statement on every thread
+ * Prepared statements die with the server session, so this must be called
+ * whenever a connection is opened again; each thread clears its cache on
+ * its next access
+ */
+void StatementCache::invalidate()
+{
+    ++currentGeneration;
+}
+
+/**
+ * Drops the calling thread's cache of one connection
+ * Used when that connection is re-opened or removed; other threads and
+ * connections keep their statements
+ * @param connectionName - The connection's name
+ */
+void StatementCache::release(const QString& connectionName)
+{
+    threadCaches().remove(connectionName);
+}
+
+/**
+ * @param sql - The statement text
+ * @return True for the Queries:: constants; ad-hoc SQL is not cached
+ */
+bool StatementCache::isCacheable(const QString& sql)
+{
+    return !Queries::nameOf(sql).isEmpty();
+}
+
+/**
+ * Checks out an idle prepared statement
+ * @param sql - The statement text
+ * @param query - Receives the prepared query if one was idle
+ * @return True on a hit; the statement stays checked out until give()
+ */
+bool StatementCache::take(const QString& sql, QSqlQuery& query)
+{
+    if (!m_idle.contains(sql)) return false;
+
+    Entry entry = m_idle.take(sql);
+    query = std::move(*entry.query);
+    return true;
+}
+
+/**
+ * Returns a statement to the cache after use
+ * The query is moved into the cache and must not be used afterwards. If
+ * an idle one of the same statement is already cached, or the statement
+ * was prepared before the cache was last emptied, the returned one is dropped.
+ * @param sql - The statement text it was prepared with
+ * @param query - The prepared query, finished
+ * @param epoch - epoch() when the statement was prepared or taken
+ */
+void StatementCache::give(const QString& sql, QSqlQuery&& query, quint64 epoch)
+{
+    if (epoch != m_epoch || m_idle.contains(sql)) return;
+    if (m_idle.size() >= Capacity) evictLeastRecentlyUsed();
+
+    Entry entry;
+    entry.query = std::make_shared<QSqlQuery>(std::move(query));
+    entry.lastUsed = ++m_clock;
+    m_idle.insert(sql, entry);
+}
+
+/**
+ * Releases all cached statements and starts a new epoch
+ */
+void StatementCache::clear()
+{
+    m_idle.clear();
+    m_epoch = ++epochCount;
+}
+
+/**
+ * @return Number of idle statements held
+ */
+int StatementCache::size() const
+{
+    return m_idle.size();
+}
+
+/**
+ * @return Identifies the current set of statements; changes whenever the
+ *         cache is emptied or recreated
+ */
+quint64 StatementCache::epoch() const
+{
+    return m_epoch;
+}
+
+/**
+ * Drops the statement that was returned longest ago
+ */
+void StatementCache::evictLeastRecentlyUsed()
+{
+    QString oldest;
+    quint64 oldestUse = 0;
+    for (auto it = m_idle.constBegin(); it != m_idle.constEnd(); ++it) {
+        if (oldest.isEmpty() || it.value().lastUsed < oldestUse) {
+            oldest = it.key();
+            oldestUse = it.value().lastUsed;
+        }
+    }
+    if (!oldest.isEmpty()) m_idle.remove(oldest);
+}
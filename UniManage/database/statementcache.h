@@ -0,0 +1,59 @@
+#ifndef STATEMENTCACHE_H
+#define STATEMENTCACHE_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <memory>
+
+/**
+ * Per-connection cache of prepared statements
+ * Holds idle QSqlQuery objects for the Queries:: constants so a statement is
+ * prepared on the server once and later calls only rebind and execute.
+ * A statement is checked out with take() and handed back with give(), so two
+ * callers never share one prepared query; when the same statement is needed
+ * twice at once (e.g. a lookup inside a loop over its own results) the second
+ * caller simply prepares a fresh one.
+ *
+ * Caches live on the thread that owns the connection, like the connections
+ * themselves, and need no locking. invalidate() drops every cache, and is
+ * called whenever a connection is (re)opened; release() drops only the
+ * calling thread's cache of one connection. Every set of statements has
+ * its own epoch(); a statement checked out under an earlier one belongs
+ * to a dead session and is refused by give().
+ */
+class StatementCache
+{
+public:
+    StatementCache();
+
+    static StatementCache& forConnection(const QSqlDatabase& db);
+    static void invalidate();
+    static void release(const QString& connectionName);
+    static bool isCacheable(const QString& sql);
+
+    bool take(const QString& sql, QSqlQuery& query);
+    void give(const QString& sql, QSqlQuery&& query, quint64 epoch);
+    void clear();
+    int size() const;
+    quint64 epoch() const;
+
+private:
+    // Queries are only ever moved in and out (copies would share one result
+    // set); the pointer keeps Entry copyable, as QHash requires
+    struct Entry
+    {
+        std::shared_ptr<QSqlQuery> query;
+        quint64 lastUsed = 0;
+    };
+
+    void evictLeastRecentlyUsed();
+
+    QHash<QString, Entry> m_idle;
+    quint64 m_clock;
+    quint64 m_generation;
+    quint64 m_epoch;
+};
+
+#endif // STATEMENTCACHE_H
@@ -0,0 +1,72 @@
+#include "tableversions.h"
+#include "dbconnection.h"
+#include "queries.h"
+#include "dbquery.h"
+#include <QSqlQuery>
+#include <QSqlError>
+#include <QDebug>
+
+/**
+ * Increments the change counter of a table on the main connection
+ * @param table - The table that was written
+ * @return True if the counter was updated, otherwise false
+ */
+bool TableVersions::bump(const QString& table)
+{
+    return bump(DBConnection::instance().database(), table);
+}
+
+/**
+ * Increments the change counter of a table
+ * Pass the connection of an open transaction so the bump commits with the write
+ * @param db - The connection to use
+ * @param table - The table that was written
+ * @return True if the counter was updated, otherwise false
+ */
+bool TableVersions::bump(QSqlDatabase& db, const QString& table)
+{
+    DBQuery query(db);
+    query.prepare(Queries::BUMP_TABLE_VERSION);
+    query.addBindValue(table);
+    if (!query.exec()) {
+        qDebug() << "TableVersions bump failed:" << query.lastError().text();
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Reads every change counter in one query
+ * @param versions - Receives table name -> version (tables never written are absent)
+ * @return True if the counters were read, otherwise false
+ */
+bool TableVersions::fetch(QHash<QString, qint64>& versions)
+{
+    versions.clear();
+    DBQuery query(DBConnection::instance().database());
+    query.setForwardOnly(true);
+    if (!query.exec(Queries::SELECT_TABLE_VERSIONS)) {
+        qDebug() << "TableVersions fetch failed:" << query.lastError().text();
+        return false;
+    }
+    while (query.next()) {
+        versions.insert(query.value(0).toString(), query.value(1).toLongLong());
+    }
+    return true;
+}
+
+/**
+ * Combines the counters of several tables into one signature
+ * Counters only grow, so the sum changes whenever any of the tables changes
+ * @param versions - Counters returned by fetch()
+ * @param tables - The tables to combine
+ * @return The signature
+ */
+qint64 TableVersions::combined(const QHash<QString, qint64>& versions, const QStringList& tables)
+{
+    qint64 signature = 0;
+    for (const QString& table : tables) {
+        signature += versions.value(table, 0);
+    }
+    return signature;
+}
@@ -0,0 +1,23 @@
+#ifndef TABLEVERSIONS_H
+#define TABLEVERSIONS_H
+
+#include <QHash>
+#include <QSqlDatabase>
+#include <QString>
+#include <QStringList>
+
+/**
+ * Per-table change counters stored in the table_versions table
+ * Controllers bump the counter of every table they write, readers compare
+ * the counters of the tables they depend on to decide whether to reload
+ */
+class TableVersions
+{
+public:
+    static bool bump(const QString& table);
+    static bool bump(QSqlDatabase& db, const QString& table);
+    static bool fetch(QHash<QString, qint64>& versions);
+    static qint64 combined(const QHash<QString, qint64>& versions, const QStringList& tables);
+};
+
+#endif // TABLEVERSIONS_H
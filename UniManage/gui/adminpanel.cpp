@@ -3,6 +3,12 @@
 #include "loginwindow.h"
 #include "database/dbconnection.h"
 #include "database/queries.h"
+#include "controllers/searchindex.h"
+#include "database/changebus.h"
+#include "database/tableversions.h"
+#include "database/dbquery.h"
+#include "database/querytracker.h"
+#include "database/querymetrics.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QLabel>
@@ -14,6 +20,7 @@
 #include <QLineEdit>
 #include <QSpinBox>
 #include <QComboBox>
+#include <QCheckBox>
 #include <QDateEdit>
 #include <QDateTime>
 #include <QTextEdit>
@@ -27,6 +34,120 @@
 #include <QSqlError>
 #include <QFont>
 #include <QMap>
+#include <QSet>
+#include <QProgressDialog>
+#include <QTimer>
+#include <QMetaObject>
+#include <QPointer>
+
+namespace {
+
+// Tables of the panel, combined as flags by refreshTables()
+enum PanelTable {
+    CollegesTable = 0x001,
+    CoursesTable = 0x002,
+    DepartmentsTable = 0x004,
+    RoomsTable = 0x008,
+    LevelsTable = 0x010,
+    ProfessorsTable = 0x020,
+    SchedulesTable = 0x040,
+    StudentsTable = 0x080,
+    CalendarTable = 0x100,
+    SectionsTable = 0x200,
+    DraftTable = 0x400,
+    AllTables = 0x7ff
+};
+
+/**
+ * Lists the panel tables that display data of a database table
+ * @param entity - The database table name, as published on the ChangeBus
+ * @return Combination of PanelTable flags
+ */
+int affectedTables(const QString& entity)
+{
+    if (entity == "students_data") return StudentsTable | DraftTable;
+    if (entity == "users") return StudentsTable | DraftTable | ProfessorsTable | CoursesTable | SchedulesTable;
+    if (entity == "colleges") return CollegesTable | DepartmentsTable | StudentsTable | DraftTable;
+    if (entity == "departments") return DepartmentsTable | CoursesTable | StudentsTable | DraftTable;
+    if (entity == "academic_levels") return LevelsTable | CoursesTable | SectionsTable | StudentsTable | DraftTable;
+    if (entity == "courses") return CoursesTable | SchedulesTable | SectionsTable;
+    if (entity == "rooms") return RoomsTable | SchedulesTable;
+    if (entity == "professors") return ProfessorsTable | CoursesTable | SchedulesTable;
+    if (entity == "schedules") return SchedulesTable | CoursesTable;
+    if (entity == "sections") return SectionsTable | StudentsTable;
+    if (entity == "calendar_events") return CalendarTable;
+    return 0;
+}
+
+// Rows of a table together with the academic level names they display
+template <typename T>
+struct LevelledRows
+{
+    QList<T> rows;
+    QMap<int, QString> levels;
+};
+
+// Earliest date of the "repeat until" editors; showing it means the series never ends
+const QDate NoRecurrenceEnd(2000, 1, 1);
+
+/**
+ * Adds the repeat rule and series end editors of the calendar event dialogs
+ * @param form - The dialog's form
+ * @param event - The event being edited (a default one when adding)
+ * @param repeat - Receives the repeat rule combo box
+ * @param until - Receives the series end editor
+ */
+void addRecurrenceRows(QFormLayout* form, const CalendarEvent& event, QComboBox*& repeat, QDateEdit*& until)
+{
+    repeat = new QComboBox();
+    repeat->addItem("Does not repeat", int(Recurrence::None));
+    repeat->addItem("Weekly", int(Recurrence::Weekly));
+    repeat->addItem("Yearly", int(Recurrence::Yearly));
+    repeat->setCurrentIndex(repeat->findData(int(event.recurrence())));
+
+    until = new QDateEdit();
+    until->setMinimumDate(NoRecurrenceEnd);
+    until->setSpecialValueText("Never");
+    until->setDate(event.recurrenceUntil().isValid() ? event.recurrenceUntil() : NoRecurrenceEnd);
+
+    form->addRow("Repeats:", repeat);
+    form->addRow("Repeat Until:", until);
+}
+
+/**
+ * Copies the repeat editors back into an event
+ */
+void readRecurrenceRows(CalendarEvent& event, const QComboBox* repeat, const QDateEdit* until)
+{
+    event.setRecurrence(static_cast<Recurrence>(repeat->currentData().toInt()));
+    event.setRecurrenceUntil(until->date() == NoRecurrenceEnd ? QDate() : until->date());
+}
+
+/**
+ * @return Display names of the academic levels by ID
+ */
+QMap<int, QString> levelNames()
+{
+    QMap<int, QString> levelMap;
+    for(const auto& l : AcademicLevelController().getAllAcademicLevels()) 
+        levelMap[l.id()] = QString("Year %1").arg(l.levelNumber());
+    return levelMap;
+}
+
+/**
+ * @return The row whose ID column holds the given ID, or -1
+ */
+int findRowById(QTableWidget* table, int id)
+{
+    const QString key = QString::number(id);
+    for (int r = 0; r < table->rowCount(); ++r) {
+        QTableWidgetItem* item = table->item(r, 0);
+        if (item && item->text() == key) return r;
+    }
+    return -1;
+}
+
+} // namespace
 
 /**
  * Constructor for the AdminPanel class
@@ -35,22 +156,38 @@
  * @param parent - Parent widget (default nullptr)
  */
 AdminPanel::AdminPanel(int adminId, QWidget *parent)
-    : QWidget(parent), m_adminId(adminId)
+    : QWidget(parent), m_adminId(adminId), m_changeToken(0), m_loadedTables(0)
 {
+    // One loader thread keeps its own connection open for the panel's lifetime
+    m_loader.setMaxThreadCount(1);
+    m_loader.setExpiryTimeout(-1);
+
     setStyleSheet(StyleHelper::getMainStyle());
     setupUI();
     setWindowTitle("Admin Panel - University Management System");
     resize(1280, 850);
     
-    // Initial data load
-    refreshAllData();
+    // Initial data load: only the visible tab, the others load when first shown
+    // (counters first, so a concurrent write is not missed)
+    TableVersions::fetch(m_seenVersions);
+    onTabChanged(m_tabWidget->currentIndex());
+
+    // Apply committed writes as they happen; publishers may run on worker threads
+    m_changeToken = ChangeBus::instance().subscribe([this](const ChangeEvent& event) {
+        QMetaObject::invokeMethod(this, [this, event]() { onDataChanged(event); }, Qt::QueuedConnection);
+    });
 }
 
 /**
  * Destructor for the AdminPanel class
- * Cleans up resources when the admin panel is destroyed
+ * Stops listening for data changes and waits for a running load to finish
  */
-AdminPanel::~AdminPanel() {}
+AdminPanel::~AdminPanel()
+{
+    ChangeBus::instance().unsubscribe(m_changeToken);
+    m_loader.clear();
+    m_loader.waitForDone();
+}
 
 /**
  * Sets up the user interface for the admin panel
@@ -93,7 +230,7 @@ void AdminPanel::setupUI()
     
     m_tabWidget = new QTabWidget(this);
     
-    // Reorganized Tabs as requested
+    // Reorganized Tabs as requested; m_tabTables lists the data each tab shows
     m_tabWidget->addTab(createStudentsTab(), "Students");
     m_tabWidget->addTab(createFacultiesTab(), "Faculties");
     m_tabWidget->addTab(createDepartmentsTab(), "Departments");
@@ -105,26 +242,170 @@ void AdminPanel::setupUI()
     m_tabWidget->addTab(createSectionsTab(), "Sections/Groups");
     m_tabWidget->addTab(createCalendarTab(), "Events Management");
     m_tabWidget->addTab(createDraftTab(), "Students Draft");
+    m_tabTables = {StudentsTable, CollegesTable, DepartmentsTable, LevelsTable, CoursesTable, RoomsTable,
+                   ProfessorsTable, SchedulesTable, SectionsTable, CalendarTable, DraftTable};
+    connect(m_tabWidget, &QTabWidget::currentChanged, this, &AdminPanel::onTabChanged);
     
     mainLayout->addWidget(m_tabWidget);
 }
 
 /**
- * Refreshes all data tables in the admin panel
- * Reloads data for every entity: colleges, departments, courses, students, professors, etc.
+ * Loads a tab's data the first time it is shown
+ * Later visits reuse the table, which change events keep current
+ * @param index - The index of the tab now shown
+ */
+void AdminPanel::onTabChanged(int index) {
+    ensureLoaded(m_tabTables.value(index));
+}
+
+/**
+ * Starts the first load of the given tables, skipping those already loaded
+ * @param tables - Combination of PanelTable flags
+ */
+void AdminPanel::ensureLoaded(int tables) {
+    const int missing = tables & ~m_loadedTables;
+    if (!missing) return;
+    m_loadedTables |= missing;
+    refreshTables(missing);
+}
+
+/**
+ * Runs a fetch on the loader thread and applies the result on the GUI thread
+ * The loader has a single thread, so reloads of a table finish in the order
+ * they were started and an older result never overwrites a newer one
+ * @param table - The PanelTable being loaded
+ * @param fetch - Reads the data; must not touch widgets or member controllers
+ * @param fill - Populates the widgets from the fetched data
+ */
+template <typename T>
+void AdminPanel::loadAsync(int table, std::function<T()> fetch, std::function<void(const T&)> fill) {
+    m_loadsInFlight[table]++;
+    QPointer<AdminPanel> guard(this);
+    m_loader.start([guard, table, fetch, fill]() {
+        QueryTracker::Scope scope(QString("AdminPanel table load %1").arg(table));
+        const T data = fetch();
+        AdminPanel* panel = guard.data();
+        if (!panel) return;
+        QMetaObject::invokeMethod(panel, [guard, table, fill, data]() {
+            if (!guard) return;
+            guard->m_loadsInFlight[table]--;
+            fill(data);
+        }, Qt::QueuedConnection);
+    });
+}
+
+/**
+ * Reloads a subset of the data tables
+ * Tables that were never shown are skipped; they load fresh on first show
+ * @param tables - Combination of PanelTable flags
+ */
+void AdminPanel::refreshTables(int tables) {
+    tables &= m_loadedTables;
+    if (tables & CollegesTable) refreshCollegesTable();
+    if (tables & CoursesTable) refreshCoursesTable();
+    if (tables & DepartmentsTable) refreshDepartmentsTable();
+    if (tables & RoomsTable) refreshRoomsTable();
+    if (tables & LevelsTable) refreshLevelsTable();
+    if (tables & ProfessorsTable) refreshProfessorsTable();
+    if (tables & SchedulesTable) refreshSchedulesTable();
+    if (tables & StudentsTable) refreshStudentsTable();
+    if (tables & CalendarTable) refreshCalendarTable();
+    if (tables & SectionsTable) refreshSectionsTable();
+    if (tables & DraftTable) refreshDraftTable();
+}
+
+/**
+ * Queues a committed write for display
+ * Events published in one go (e.g. a course delete and its cascades) are
+ * applied together once control returns to the event loop
+ * @param event - The change published on the ChangeBus
+ */
+void AdminPanel::onDataChanged(const ChangeEvent& event) {
+    m_pendingChanges.append(event);
+    if (m_pendingChanges.size() == 1) {
+        QTimer::singleShot(0, this, &AdminPanel::applyPendingChanges);
+    }
+}
+
+/**
+ * Applies the queued changes
+ * Single student rows are patched in place, other tables are reloaded once
+ * no matter how many of their rows changed
+ */
+void AdminPanel::applyPendingChanges() {
+    QueryTracker::Scope scope("AdminPanel::applyPendingChanges");
+    const QList<ChangeEvent> changes = m_pendingChanges;
+    m_pendingChanges.clear();
+
+    int tables = 0;
+    QList<int> studentIds;
+    for (const ChangeEvent& e : changes) {
+        if (e.entity == "students_data" && e.id > 0) {
+            if (!studentIds.contains(e.id)) studentIds.append(e.id);
+        } else {
+            tables |= affectedTables(e.entity);
+        }
+    }
+
+    // A reload still in flight may have read the rows before this write;
+    // queue another one behind it instead of patching rows it will replace
+    if (!studentIds.isEmpty()) {
+        if (m_loadsInFlight.value(StudentsTable) > 0) tables |= StudentsTable;
+        if (m_loadsInFlight.value(DraftTable) > 0) tables |= DraftTable;
+    }
+
+    refreshTables(tables);
+    const int patched = m_loadedTables & ~tables & (StudentsTable | DraftTable);
+    if (patched && !studentIds.isEmpty()) {
+        applyStudentChanges(studentIds, patched);
+    }
+}
+
+/**
+ * Re-reads the changed students in one batched lookup and moves their rows
+ * between the students and draft tables according to their status
+ * @param ids - IDs of the changed students_data rows
+ * @param tables - StudentsTable and/or DraftTable, the tables to patch
  */
-void AdminPanel::refreshAllData() {
-    refreshCollegesTable();
-    refreshCoursesTable();
-    refreshDepartmentsTable();
-    refreshRoomsTable();
-    refreshLevelsTable();
-    refreshProfessorsTable();
-    refreshSchedulesTable();
-    refreshStudentsTable();
-    refreshCalendarTable();
-    refreshSectionsTable();
-    refreshDraftTable();
+void AdminPanel::applyStudentChanges(const QList<int>& ids, int tables) {
+    const QMap<int, QString> levelMap = levelNames();
+
+    QHash<int, StudentData> changed;
+    for (const StudentData& s : m_studentController.getStudentsByIds(ids)) changed.insert(s.id(), s);
+
+    for (int id : ids) {
+        const StudentData s = changed.value(id);
+        const bool exists = s.id() > 0;
+        const bool drafted = exists && s.status() == StudentStatus::Deleted;
+
+        if (tables & StudentsTable) {
+            int row = findRowById(m_studentsTable, id);
+            if (exists && !drafted) {
+                if (row < 0) {
+                    row = m_studentsTable->rowCount();
+                    m_studentsTable->insertRow(row);
+                }
+                setStudentRow(row, s, levelMap);
+            } else if (row >= 0) {
+                m_studentsTable->removeRow(row);
+            }
+        }
+
+        if (tables & DraftTable) {
+            int draftRow = findRowById(m_draftStudentsTable, id);
+            if (drafted) {
+                if (draftRow < 0) {
+                    draftRow = m_draftStudentsTable->rowCount();
+                    m_draftStudentsTable->insertRow(draftRow);
+                }
+                setDraftRow(draftRow, s, levelMap);
+            } else if (draftRow >= 0) {
+                m_draftStudentsTable->removeRow(draftRow);
+            }
+        }
+    }
+
+    if (!m_studentSearchEdit->text().isEmpty()) onSearchStudents(m_studentSearchEdit->text());
 }
 
 /**
@@ -132,36 +413,33 @@ void AdminPanel::refreshAllData() {
  * Retrieves all sections and populates the table with their details including academic year
  */
 void AdminPanel::refreshSectionsTable() {
-    m_sectionsTable->setRowCount(0);
-    for (const auto& s : m_sectionController.getAllSections()) {
-        int r = m_sectionsTable->rowCount();
-        m_sectionsTable->insertRow(r);
-        m_sectionsTable->setItem(r, 0, new QTableWidgetItem(QString::number(s.id())));
-        m_sectionsTable->setItem(r, 1, new QTableWidgetItem(s.name()));
-        m_sectionsTable->setItem(r, 2, new QTableWidgetItem(QString::number(s.capacity())));
-        
-        // Read correctly from academicLevelId() now
-        QString levelName = "---";
-        int lvlId = s.academicLevelId();
-        
-        // If 0, maybe fallback to semesterId or just iterate
-        if (lvlId > 0) {
-            // Find name
-             // Optim: could cache levels map, but this is fine for now
-             QList<AcademicLevel> levels = m_academicLevelController.getAllAcademicLevels();
-             for(const auto& l : levels) {
-                 if (l.id() == lvlId) {
-                     levelName = QString("Year %1").arg(l.levelNumber());
-                     break;
-                 }
-             }
-        } else if (s.semesterId() > 0) { 
-             // Legacy fallback
-             levelName = "Year " + QString::number(s.semesterId());
-        }
-        
-        m_sectionsTable->setItem(r, 3, new QTableWidgetItem(levelName));
-    }
+    loadAsync<LevelledRows<Section>>(SectionsTable,
+        []() {
+            LevelledRows<Section> data;
+            data.rows = SectionController().getAllSections();
+            data.levels = levelNames();
+            return data;
+        },
+        [this](const LevelledRows<Section>& data) {
+            m_sectionsTable->setRowCount(0);
+            for (const auto& s : data.rows) {
+                int r = m_sectionsTable->rowCount();
+                m_sectionsTable->insertRow(r);
+                m_sectionsTable->setItem(r, 0, new QTableWidgetItem(QString::number(s.id())));
+                m_sectionsTable->setItem(r, 1, new QTableWidgetItem(s.name()));
+                m_sectionsTable->setItem(r, 2, new QTableWidgetItem(QString::number(s.capacity())));
+
+                QString levelName = "---";
+                if (s.academicLevelId() > 0) {
+                    levelName = data.levels.value(s.academicLevelId(), "---");
+                } else if (s.semesterId() > 0) {
+                    // Legacy fallback
+                    levelName = "Year " + QString::number(s.semesterId());
+                }
+
+                m_sectionsTable->setItem(r, 3, new QTableWidgetItem(levelName));
+            }
+        });
 }
 
 /**
@@ -169,17 +447,22 @@ void AdminPanel::refreshSectionsTable() {
  * Retrieves all events and populates the table
  */
 void AdminPanel::refreshCalendarTable() {
-    m_calendarTable->setRowCount(0);
-    for (const auto& e : m_calendarController.getAllEvents()) {
-        int r = m_calendarTable->rowCount();
-        m_calendarTable->insertRow(r);
-        m_calendarTable->setItem(r, 0, new QTableWidgetItem(QString::number(e.id())));
-        m_calendarTable->setItem(r, 1, new QTableWidgetItem(e.title()));
-        m_calendarTable->setItem(r, 2, new QTableWidgetItem(e.startDate().toString("yyyy-MM-dd")));
-        m_calendarTable->setItem(r, 3, new QTableWidgetItem(e.endDate().toString("yyyy-MM-dd")));
-        m_calendarTable->setItem(r, 4, new QTableWidgetItem(e.eventType()));
-        m_calendarTable->setItem(r, 5, new QTableWidgetItem(e.description()));
-    }
+    loadAsync<QList<CalendarEvent>>(CalendarTable,
+        []() { return CalendarController().getAllEvents(); },
+        [this](const QList<CalendarEvent>& events) {
+            m_calendarTable->setRowCount(0);
+            for (const auto& e : events) {
+                int r = m_calendarTable->rowCount();
+                m_calendarTable->insertRow(r);
+                m_calendarTable->setItem(r, 0, new QTableWidgetItem(QString::number(e.id())));
+                m_calendarTable->setItem(r, 1, new QTableWidgetItem(e.title()));
+                m_calendarTable->setItem(r, 2, new QTableWidgetItem(e.startDate().toString("yyyy-MM-dd")));
+                m_calendarTable->setItem(r, 3, new QTableWidgetItem(e.endDate().toString("yyyy-MM-dd")));
+                m_calendarTable->setItem(r, 4, new QTableWidgetItem(e.eventType()));
+                m_calendarTable->setItem(r, 5, new QTableWidgetItem(e.recurrenceName()));
+                m_calendarTable->setItem(r, 6, new QTableWidgetItem(e.description()));
+            }
+        });
 }
 
 /**
@@ -204,8 +487,8 @@ QWidget* AdminPanel::createCalendarTab() {
     btns->addStretch();
     
     m_calendarTable = new QTableWidget();
-    m_calendarTable->setColumnCount(6);
-    m_calendarTable->setHorizontalHeaderLabels({"ID", "Title", "Start", "End", "Type", "Description"});
+    m_calendarTable->setColumnCount(7);
+    m_calendarTable->setHorizontalHeaderLabels({"ID", "Title", "Start", "End", "Type", "Repeats", "Description"});
     m_calendarTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     m_calendarTable->setSelectionBehavior(QAbstractItemView::SelectRows);
     
@@ -216,7 +499,6 @@ QWidget* AdminPanel::createCalendarTab() {
     connect(editBtn, &QPushButton::clicked, this, &AdminPanel::onEditCalendarEvent);
     connect(deleteBtn, &QPushButton::clicked, this, &AdminPanel::onDeleteCalendarEvent);
     
-    refreshCalendarTable();
     return widget;
 }
 
@@ -262,7 +544,6 @@ void AdminPanel::onAssignProfessor() {
         int profId = profCb->currentData().toInt();
         if (m_scheduleController.assignProfessorToCourse(courseId, profId)) {
             QMessageBox::information(this, "Success", "Course assigned successfully.");
-            refreshCoursesTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to assign course.");
         }
@@ -289,6 +570,9 @@ void AdminPanel::onAddCalendarEvent() {
     form->addRow("Start:", start);
     form->addRow("End:", end);
     form->addRow("Type:", type);
+    QComboBox* repeat = nullptr;
+    QDateEdit* until = nullptr;
+    addRecurrenceRows(form, CalendarEvent(), repeat, until);
     
     QPushButton* btn = new QPushButton("Add Event");
     connect(btn, &QPushButton::clicked, &dlg, &QDialog::accept);
@@ -301,9 +585,9 @@ void AdminPanel::onAddCalendarEvent() {
         e.setStartDate(start->date());
         e.setEndDate(end->date());
         e.setEventType(type->currentText());
+        readRecurrenceRows(e, repeat, until);
         if (m_calendarController.addEvent(e)) {
             QMessageBox::information(this, "Success", "Event added.");
-            refreshCalendarTable();
         }
     }
 }
@@ -317,11 +601,8 @@ void AdminPanel::onEditCalendarEvent() {
     if(cur < 0) return;
     int eid = m_calendarTable->item(cur, 0)->text().toInt();
     
-    QList<CalendarEvent> all = m_calendarController.getAllEvents();
-    CalendarEvent e;
-    bool found = false;
-    for(const auto& item : all) { if(item.id() == eid) { e = item; found = true; break; } }
-    if(!found) return;
+    CalendarEvent e = m_calendarController.getEventById(eid);
+    if(e.id() == 0) return;
 
     QDialog dlg(this);
     dlg.setWindowTitle("Edit Event");
@@ -339,6 +620,9 @@ void AdminPanel::onEditCalendarEvent() {
     form->addRow("Start Date:", start);
     form->addRow("End Date:", end);
     form->addRow("Event Type:", type);
+    QComboBox* repeat = nullptr;
+    QDateEdit* until = nullptr;
+    addRecurrenceRows(form, e, repeat, until);
     
     QPushButton* btn = new QPushButton("Save Changes");
     connect(btn, &QPushButton::clicked, &dlg, &QDialog::accept);
@@ -350,9 +634,9 @@ void AdminPanel::onEditCalendarEvent() {
         e.setStartDate(start->date());
         e.setEndDate(end->date());
         e.setEventType(type->currentText());
+        readRecurrenceRows(e, repeat, until);
         if (m_calendarController.updateEvent(e)) {
             QMessageBox::information(this, "Success", "Event updated.");
-            refreshCalendarTable();
         }
     }
 }
@@ -366,9 +650,7 @@ void AdminPanel::onDeleteCalendarEvent() {
     if(cur < 0) return;
     int eid = m_calendarTable->item(cur, 0)->text().toInt();
     if (QMessageBox::question(this, "Confirm", "Delete this event?") == QMessageBox::Yes) {
-        if (m_calendarController.deleteEvent(eid)) {
-            refreshCalendarTable();
-        }
+        m_calendarController.deleteEvent(eid);
     }
 }
 
@@ -400,18 +682,14 @@ void AdminPanel::onEditLevel() {
 
     if (dialog.exec() == QDialog::Accepted) {
         AcademicLevel updated(id, name->text(), num->value());
-        if (m_academicLevelController.updateAcademicLevel(updated)) {
-            refreshLevelsTable();
-        }
+        m_academicLevelController.updateAcademicLevel(updated);
     }
 }
 void AdminPanel::onDeleteLevel() {
     int row = m_levelsTable->currentRow();
     if (row < 0) return;
     int id = m_levelsTable->item(row, 0)->text().toInt();
-    if (m_academicLevelController.deleteAcademicLevel(id)) {
-        refreshLevelsTable();
-    }
+    m_academicLevelController.deleteAcademicLevel(id);
 }
 
 // Section Management
@@ -452,9 +730,7 @@ void AdminPanel::onAddSection() {
         s.setCapacity(cap->value());
         s.setSemesterId(0); // Explicitly 0
         s.setAcademicLevelId(level->currentData().toInt()); // Correct field
-        if(m_sectionController.addSection(s)) {
-            refreshSectionsTable();
-        }
+        m_sectionController.addSection(s);
     }
 }
 /**
@@ -509,9 +785,7 @@ void AdminPanel::onEditSection() {
         s.setCapacity(cap->value());
         s.setSemesterId(0);
         s.setAcademicLevelId(level->currentData().toInt()); // Correct field
-        if(m_sectionController.updateSection(s)) {
-            refreshSectionsTable();
-        }
+        m_sectionController.updateSection(s);
     }
 }
 /**
@@ -522,7 +796,55 @@ void AdminPanel::onDeleteSection() {
     int row = m_sectionsTable->currentRow();
     if (row < 0) return;
     int id = m_sectionsTable->item(row, 0)->text().toInt();
-    if(m_sectionController.deleteSection(id)) refreshSectionsTable();
+    m_sectionController.deleteSection(id);
+}
+
+/**
+ * Assigns sections to the students of a level who have none
+ * Shows how the students would be spread before writing anything
+ */
+void AdminPanel::onAutoAssignSections() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Auto-Assign Sections");
+    QFormLayout* layout = new QFormLayout(&dialog);
+
+    QComboBox* level = new QComboBox();
+    for(const auto& l : m_academicLevelController.getAllAcademicLevels()) level->addItem(QString("Year %1").arg(l.levelNumber()), l.id());
+    layout->addRow("Academic Year:", level);
+
+    QCheckBox* balance = new QCheckBox("Spread each department evenly");
+    balance->setChecked(true);
+    layout->addRow("Departments:", balance);
+
+    QPushButton* btn = new QPushButton("Plan Assignment");
+    btn->setObjectName("primaryBtn");
+    layout->addRow(btn);
+    connect(btn, &QPushButton::clicked, &dialog, &QDialog::accept);
+
+    if (dialog.exec() != QDialog::Accepted || level->currentIndex() < 0) return;
+
+    const SectionAssigner::Plan plan = m_sectionAssigner.plan(level->currentData().toInt(), balance->isChecked());
+    if (plan.candidates == 0) {
+        QMessageBox::information(this, "Nothing to Assign", "Every student of this year already has a section.");
+        return;
+    }
+
+    QString summary = QString("%1 student(s) without a section.\n%2 will be placed in %3 section(s).")
+                          .arg(plan.candidates).arg(plan.candidates - plan.unplaced).arg(plan.bySection.size());
+    if (plan.unplaced > 0) {
+        summary += QString("\n%1 cannot be placed: all sections of this year are full.").arg(plan.unplaced);
+    }
+    if (plan.bySection.isEmpty()) {
+        QMessageBox::warning(this, "Sections Full", summary);
+        return;
+    }
+    if (QMessageBox::question(this, "Confirm", summary + "\n\nApply this assignment?") != QMessageBox::Yes) return;
+
+    if (m_sectionAssigner.apply(plan)) {
+        QMessageBox::information(this, "Sections Assigned", "Students were assigned to their sections.");
+    } else {
+        QMessageBox::critical(this, "Error", "Could not assign sections. No student was changed.");
+    }
 }
 
 // Schedule Edits
@@ -594,9 +916,7 @@ void AdminPanel::onEditSchedule() {
         s.setStartTime(start->time());
         s.setEndTime(end->time());
 
-        if (m_scheduleController.updateSchedule(s)) {
-            refreshSchedulesTable();
-        } else {
+        if (!m_scheduleController.updateSchedule(s)) {
             QMessageBox::critical(this, "Error", "Failed to update schedule slot. Check if room is already booked.");
         }
     }
@@ -609,15 +929,26 @@ void AdminPanel::onDeleteSchedule() {
     int row = m_schedulesTable->currentRow();
     if (row < 0) return;
     int id = m_schedulesTable->item(row, 0)->text().toInt();
-    if(m_scheduleController.deleteSchedule(id)) refreshSchedulesTable();
+    m_scheduleController.deleteSchedule(id);
 }
 
 /**
  * User-invoked refresh function
- * Calls refreshAllData() and displays a success message
+ * Reloads the shown tables whose data changed since the last load and
+ * displays a success message
  */
 void AdminPanel::onRefreshAll() {
-    refreshAllData();
+    // Reload only what other sessions changed since the last load
+    QHash<QString, qint64> versions;
+    int tables = AllTables;
+    if (TableVersions::fetch(versions)) {
+        tables = 0;
+        for (auto it = versions.constBegin(); it != versions.constEnd(); ++it) {
+            if (m_seenVersions.value(it.key(), -1) != it.value()) tables |= affectedTables(it.key());
+        }
+        m_seenVersions = versions;
+    }
+    refreshTables(tables);
     QMessageBox::information(this, "Success", "Application data has been refreshed successfully.");
 }
 
@@ -647,7 +978,7 @@ void AdminPanel::onTestDatabase() {
     
     // Test 2: Users Table
     report += "2. USERS TABLE TEST:\n";
-    QSqlQuery userQuery(db);
+    DBQuery userQuery(db);
     if (userQuery.exec("SELECT COUNT(*) as total, SUM(CASE WHEN role='student' THEN 1 ELSE 0 END) as students FROM users")) {
         if (userQuery.next()) {
             int total = userQuery.value("total").toInt();
@@ -661,7 +992,7 @@ void AdminPanel::onTestDatabase() {
     
     // Test 3: Students Data Table
     report += "3. STUDENTS_DATA TABLE TEST:\n";
-    QSqlQuery studentDataQuery(db);
+    DBQuery studentDataQuery(db);
     if (studentDataQuery.exec("SELECT COUNT(*) as total FROM students_data")) {
         if (studentDataQuery.next()) {
             int total = studentDataQuery.value("total").toInt();
@@ -675,7 +1006,7 @@ void AdminPanel::onTestDatabase() {
     report += "4. STUDENT RETRIEVAL QUERY TEST:\n";
     report += "   Query: " + Queries::SELECT_ALL_STUDENTS_DATA + "\n\n";
     
-    QSqlQuery testQuery(db);
+    DBQuery testQuery(db);
     if (testQuery.exec(Queries::SELECT_ALL_STUDENTS_DATA)) {
         int count = 0;
         report += "   ✓ Query executed successfully!\n";
@@ -711,7 +1042,7 @@ void AdminPanel::onTestDatabase() {
     
     // Test 5: Check for orphaned records
     report += "5. ORPHANED RECORDS CHECK:\n";
-    QSqlQuery orphanQuery(db);
+    DBQuery orphanQuery(db);
     if (orphanQuery.exec("SELECT u.id, u.full_name, u.username FROM users u LEFT JOIN students_data sd ON u.id = sd.user_id WHERE u.role='student' AND sd.id IS NULL")) {
         int orphans = 0;
         QString orphanList = "";
@@ -737,12 +1068,25 @@ void AdminPanel::onTestDatabase() {
         }
     }
     
+    // Test 6: Latency of every statement run since startup
+    report += "6. QUERY LATENCY (since startup):\n";
+    report += QueryMetrics::instance().dump();
+    report += "\n";
+    
+    // Test 7: Connection losses survived since startup
+    const ReconnectStats reconnects = DBConnection::instance().reconnectStats();
+    report += "7. RECONNECTS (since startup):\n";
+    report += QString("   Connection losses: %1, reconnected: %2, gave up: %3\n")
+        .arg(reconnects.disconnects).arg(reconnects.reconnects).arg(reconnects.failedReconnects);
+    report += QString("   Reads retried: %1, last reconnect took: %2 ms\n\n")
+        .arg(reconnects.retriedQueries).arg(reconnects.lastReconnectMs);
+    
     report += "=== END OF TEST ===";
     
     // Show in a scrollable dialog
     QDialog* dialog = new QDialog(this);
     dialog->setWindowTitle("Database Connection Test Results");
-    dialog->resize(700, 500);
+    dialog->resize(900, 600);
     
     QVBoxLayout* layout = new QVBoxLayout(dialog);
     QTextEdit* textEdit = new QTextEdit();
@@ -772,10 +1116,16 @@ QWidget* AdminPanel::createFacultiesTab() {
     editBtn->setObjectName("secondaryBtn");
     QPushButton* deleteBtn = new QPushButton("Delete Faculty");
     deleteBtn->setObjectName("dangerBtn");
+    QPushButton* feeRulesBtn = new QPushButton("Fee Rules");
+    feeRulesBtn->setObjectName("secondaryBtn");
+    QPushButton* billingBtn = new QPushButton("Run Term Billing");
+    billingBtn->setObjectName("secondaryBtn");
     btns->addWidget(addBtn);
     btns->addWidget(editBtn);
     btns->addWidget(deleteBtn);
     btns->addStretch();
+    btns->addWidget(feeRulesBtn);
+    btns->addWidget(billingBtn);
     
     m_collegesTable = new QTableWidget();
     m_collegesTable->setColumnCount(4);
@@ -789,6 +1139,8 @@ QWidget* AdminPanel::createFacultiesTab() {
     connect(addBtn, &QPushButton::clicked, this, &AdminPanel::onAddCollege);
     connect(editBtn, &QPushButton::clicked, this, &AdminPanel::onEditCollege);
     connect(deleteBtn, &QPushButton::clicked, this, &AdminPanel::onDeleteCollege);
+    connect(feeRulesBtn, &QPushButton::clicked, this, &AdminPanel::onManageFeeRules);
+    connect(billingBtn, &QPushButton::clicked, this, &AdminPanel::onRunTermBilling);
     return widget;
 }
 
@@ -943,11 +1295,14 @@ QWidget* AdminPanel::createAcademicSetupTab() {
     editBtn->setObjectName("secondaryBtn");
     QPushButton* deleteBtn = new QPushButton("Remove Level");
     deleteBtn->setObjectName("dangerBtn");
+    QPushButton* promoteBtn = new QPushButton("Year-End Promotion");
+    promoteBtn->setObjectName("secondaryBtn");
     
     btns->addWidget(addBtn);
     btns->addWidget(editBtn);
     btns->addWidget(deleteBtn);
     btns->addStretch();
+    btns->addWidget(promoteBtn);
 
     m_levelsTable = new QTableWidget();
     m_levelsTable->setColumnCount(3);
@@ -961,6 +1316,7 @@ QWidget* AdminPanel::createAcademicSetupTab() {
     connect(addBtn, &QPushButton::clicked, this, &AdminPanel::onAddLevel);
     connect(editBtn, &QPushButton::clicked, this, &AdminPanel::onEditLevel);
     connect(deleteBtn, &QPushButton::clicked, this, &AdminPanel::onDeleteLevel);
+    connect(promoteBtn, &QPushButton::clicked, this, &AdminPanel::onRunCohortPromotion);
     return widget;
 }
 
@@ -979,11 +1335,14 @@ QWidget* AdminPanel::createSectionsTab() {
     editBtn->setObjectName("secondaryBtn");
     QPushButton* deleteBtn = new QPushButton("Remove Section");
     deleteBtn->setObjectName("dangerBtn");
+    QPushButton* assignBtn = new QPushButton("Auto-Assign Students");
+    assignBtn->setObjectName("secondaryBtn");
     
     btns->addWidget(addBtn);
     btns->addWidget(editBtn);
     btns->addWidget(deleteBtn);
     btns->addStretch();
+    btns->addWidget(assignBtn);
 
     m_sectionsTable = new QTableWidget();
     m_sectionsTable->setColumnCount(4);
@@ -997,6 +1356,7 @@ QWidget* AdminPanel::createSectionsTab() {
     connect(addBtn, &QPushButton::clicked, this, &AdminPanel::onAddSection);
     connect(editBtn, &QPushButton::clicked, this, &AdminPanel::onEditSection);
     connect(deleteBtn, &QPushButton::clicked, this, &AdminPanel::onDeleteSection);
+    connect(assignBtn, &QPushButton::clicked, this, &AdminPanel::onAutoAssignSections);
     return widget;
 }
 
@@ -1090,6 +1450,11 @@ QWidget* AdminPanel::createStudentsTab() {
     btns->addWidget(editBtn);
     btns->addWidget(deleteBtn);
     btns->addStretch();
+    m_studentSearchEdit = new QLineEdit();
+    m_studentSearchEdit->setPlaceholderText("Search by name, code or ID number...");
+    m_studentSearchEdit->setClearButtonEnabled(true);
+    m_studentSearchEdit->setMinimumWidth(280);
+    btns->addWidget(m_studentSearchEdit);
     m_studentsTable = new QTableWidget();
     m_studentsTable->setColumnCount(10);
     m_studentsTable->setHorizontalHeaderLabels({"ID", "Code", "Name", "ID Number", "College", "Dept", "Section", "Year/Level", "Fees", "Status"});
@@ -1100,6 +1465,7 @@ QWidget* AdminPanel::createStudentsTab() {
     connect(addBtn, &QPushButton::clicked, this, &AdminPanel::onAddStudent);
     connect(editBtn, &QPushButton::clicked, this, &AdminPanel::onEditStudent);
     connect(deleteBtn, &QPushButton::clicked, this, &AdminPanel::onDeleteStudent);
+    connect(m_studentSearchEdit, &QLineEdit::textChanged, this, &AdminPanel::onSearchStudents);
     return widget;
 }
 
@@ -1119,81 +1485,101 @@ void AdminPanel::onLogout() {
  * Fetches latest student data and populates the table
  */
 void AdminPanel::refreshStudentsTable() {
-    m_studentsTable->setRowCount(0);
-    
-    QList<StudentData> allStudents = m_studentController.getAllStudents();
-    
-    QMap<int, QString> levelMap;
-    for(const auto& l : m_academicLevelController.getAllAcademicLevels()) 
-        levelMap[l.id()] = QString("Year %1").arg(l.levelNumber());
-    
-    for (const auto& s : allStudents) {
-        int r = m_studentsTable->rowCount();
-        m_studentsTable->insertRow(r);
-        
-        // Use user ID if profile ID is missing (0)
-        QString idStr = (s.id() == 0) ? QString("U-%1").arg(s.userId()) : QString::number(s.id());
-        m_studentsTable->setItem(r, 0, new QTableWidgetItem(idStr));
-        
-        m_studentsTable->setItem(r, 1, new QTableWidgetItem(s.studentNumber()));
-        m_studentsTable->setItem(r, 2, new QTableWidgetItem(s.fullName()));
-        m_studentsTable->setItem(r, 3, new QTableWidgetItem(s.idNumber().isEmpty() ? "---" : s.idNumber()));
-        m_studentsTable->setItem(r, 4, new QTableWidgetItem(s.collegeName().isEmpty() ? "---" : s.collegeName()));
-        m_studentsTable->setItem(r, 5, new QTableWidgetItem(s.department().isEmpty() ? "---" : s.department())); // Added Department column
-        m_studentsTable->setItem(r, 6, new QTableWidgetItem(s.sectionName().isEmpty() ? "---" : s.sectionName()));
-        
-        QString levelStr = levelMap.value(s.academicLevelId(), "---");
-        m_studentsTable->setItem(r, 7, new QTableWidgetItem(levelStr));
-        
-        m_studentsTable->setItem(r, 8, new QTableWidgetItem(QString("%1").arg(s.tuitionFees())));
+    loadAsync<LevelledRows<StudentData>>(StudentsTable,
+        []() {
+            LevelledRows<StudentData> data;
+            data.rows = StudentController().getAllStudents();
+            data.levels = levelNames();
+            return data;
+        },
+        [this](const LevelledRows<StudentData>& data) {
+            m_studentsTable->setRowCount(0);
+            for (const auto& s : data.rows) {
+                int r = m_studentsTable->rowCount();
+                m_studentsTable->insertRow(r);
+                setStudentRow(r, s, data.levels);
+            }
 
-        QString status = s.status();
-        if (status.isEmpty()) status = (s.id() == 0) ? "Incomplete Profile" : "Pending";
-        m_studentsTable->setItem(r, 9, new QTableWidgetItem(status));
+            // Keep the current search applied after a reload
+            if (!m_studentSearchEdit->text().isEmpty()) onSearchStudents(m_studentSearchEdit->text());
+        });
+}
 
-        // Color code incomplete records
-        if (s.id() == 0) {
-            for (int col = 0; col < 10; ++col) {
-                m_studentsTable->item(r, col)->setForeground(Qt::red);
-            }
+/**
+ * Fills one row of the students table
+ * @param r - The row index
+ * @param s - The student to display
+ * @param levelMap - Academic level names by ID
+ */
+void AdminPanel::setStudentRow(int r, const StudentData& s, const QMap<int, QString>& levelMap) {
+    // Use user ID if profile ID is missing (0)
+    QString idStr = (s.id() == 0) ? QString("U-%1").arg(s.userId()) : QString::number(s.id());
+    m_studentsTable->setItem(r, 0, new QTableWidgetItem(idStr));
+    
+    m_studentsTable->setItem(r, 1, new QTableWidgetItem(s.studentNumber()));
+    m_studentsTable->setItem(r, 2, new QTableWidgetItem(s.fullName()));
+    m_studentsTable->setItem(r, 3, new QTableWidgetItem(s.idNumber().isEmpty() ? "---" : s.idNumber()));
+    m_studentsTable->setItem(r, 4, new QTableWidgetItem(s.collegeName().isEmpty() ? "---" : s.collegeName()));
+    m_studentsTable->setItem(r, 5, new QTableWidgetItem(s.department().isEmpty() ? "---" : s.department())); // Added Department column
+    m_studentsTable->setItem(r, 6, new QTableWidgetItem(s.sectionName().isEmpty() ? "---" : s.sectionName()));
+    
+    QString levelStr = levelMap.value(s.academicLevelId(), "---");
+    m_studentsTable->setItem(r, 7, new QTableWidgetItem(levelStr));
+    
+    m_studentsTable->setItem(r, 8, new QTableWidgetItem(s.tuitionFees().toString()));
+
+    QString status = (s.id() == 0) ? QString("Incomplete Profile") : s.statusName();
+    if (status.isEmpty()) status = "Pending";
+    m_studentsTable->setItem(r, 9, new QTableWidgetItem(status));
+
+    // Color code incomplete records
+    if (s.id() == 0) {
+        for (int col = 0; col < 10; ++col) {
+            m_studentsTable->item(r, col)->setForeground(Qt::red);
         }
-        
     }
 }
 
+
 /**
  * Refreshes the courses table
  * Fetches latest course data and populates the table
  */
 void AdminPanel::refreshCoursesTable() {
-    m_coursesTable->setRowCount(0);
-    m_coursesTable->setColumnCount(10);
-    m_coursesTable->setHorizontalHeaderLabels({"ID", "Name", "Department", "Professor", "Type", "Max Grade", "Credits", "Level", "Semester", "Description"});
-    QMap<int, QString> levelMap;
-    for(const auto& l : m_academicLevelController.getAllAcademicLevels()) 
-        levelMap[l.id()] = QString("Year %1").arg(l.levelNumber());
-
-    for (const auto& c : m_courseController.getAllCourses()) {
-        int r = m_coursesTable->rowCount();
-        m_coursesTable->insertRow(r);
-        m_coursesTable->setItem(r, 0, new QTableWidgetItem(QString::number(c.id())));
-        m_coursesTable->setItem(r, 1, new QTableWidgetItem(c.name()));
-        m_coursesTable->setItem(r, 2, new QTableWidgetItem(c.departmentName().isEmpty() ? "General" : c.departmentName()));
-        m_coursesTable->setItem(r, 3, new QTableWidgetItem(c.assignedProfessor().isEmpty() ? "---" : c.assignedProfessor()));
-        m_coursesTable->setItem(r, 4, new QTableWidgetItem(c.courseType()));
-        m_coursesTable->setItem(r, 5, new QTableWidgetItem(QString::number(c.maxGrade())));
-        m_coursesTable->setItem(r, 6, new QTableWidgetItem(QString::number(c.creditHours())));
+    loadAsync<LevelledRows<Course>>(CoursesTable,
+        []() {
+            LevelledRows<Course> data;
+            data.rows = CourseController().getAllCourses();
+            data.levels = levelNames();
+            return data;
+        },
+        [this](const LevelledRows<Course>& data) {
+            m_coursesTable->setRowCount(0);
+            m_coursesTable->setColumnCount(10);
+            m_coursesTable->setHorizontalHeaderLabels({"ID", "Name", "Department", "Professor", "Type", "Max Grade", "Credits", "Level", "Semester", "Description"});
+
+            for (const auto& c : data.rows) {
+                int r = m_coursesTable->rowCount();
+                m_coursesTable->insertRow(r);
+                m_coursesTable->setItem(r, 0, new QTableWidgetItem(QString::number(c.id())));
+                m_coursesTable->setItem(r, 1, new QTableWidgetItem(c.name()));
+                m_coursesTable->setItem(r, 2, new QTableWidgetItem(c.departmentName().isEmpty() ? "General" : c.departmentName()));
+                m_coursesTable->setItem(r, 3, new QTableWidgetItem(c.assignedProfessor().isEmpty() ? "---" : c.assignedProfessor()));
+                m_coursesTable->setItem(r, 4, new QTableWidgetItem(c.courseTypeName()));
+                m_coursesTable->setItem(r, 5, new QTableWidgetItem(QString::number(c.maxGrade())));
+                m_coursesTable->setItem(r, 6, new QTableWidgetItem(QString::number(c.creditHours())));
         
-        // Use name lookup from map
-        QString levelStr = levelMap.value(c.yearLevel(), "---");
-        m_coursesTable->setItem(r, 7, new QTableWidgetItem(levelStr));
+                // Use name lookup from map
+                QString levelStr = data.levels.value(c.yearLevel(), "---");
+                m_coursesTable->setItem(r, 7, new QTableWidgetItem(levelStr));
         
-        // Simplified Semester Display
-        QString semStr = (c.semesterNumber() > 0) ? QString("Semester %1").arg(c.semesterNumber()) : "---";
-        m_coursesTable->setItem(r, 8, new QTableWidgetItem(semStr));
+                // Simplified Semester Display
+                QString semStr = (c.semesterNumber() > 0) ? QString("Semester %1").arg(c.semesterNumber()) : "---";
+                m_coursesTable->setItem(r, 8, new QTableWidgetItem(semStr));
         
-        m_coursesTable->setItem(r, 9, new QTableWidgetItem(c.description()));
-    }
+                m_coursesTable->setItem(r, 9, new QTableWidgetItem(c.description()));
+            }
+        });
 }
 
 /**
@@ -1201,15 +1587,19 @@ void AdminPanel::refreshCoursesTable() {
  * Fetches latest college data and populates the table
  */
 void AdminPanel::refreshCollegesTable() {
-    m_collegesTable->setRowCount(0);
-    for (const auto& c : m_collegeController.getAllColleges()) {
-        int r = m_collegesTable->rowCount();
-        m_collegesTable->insertRow(r);
-        m_collegesTable->setItem(r, 0, new QTableWidgetItem(QString::number(c.id())));
-        m_collegesTable->setItem(r, 1, new QTableWidgetItem(c.name()));
-        m_collegesTable->setItem(r, 2, new QTableWidgetItem(c.code()));
-        m_collegesTable->setItem(r, 3, new QTableWidgetItem(QString("%1").arg(c.tuitionFees())));
-    }
+    loadAsync<QList<College>>(CollegesTable,
+        []() { return CollegeController().getAllColleges(); },
+        [this](const QList<College>& colleges) {
+            m_collegesTable->setRowCount(0);
+            for (const auto& c : colleges) {
+                int r = m_collegesTable->rowCount();
+                m_collegesTable->insertRow(r);
+                m_collegesTable->setItem(r, 0, new QTableWidgetItem(QString::number(c.id())));
+                m_collegesTable->setItem(r, 1, new QTableWidgetItem(c.name()));
+                m_collegesTable->setItem(r, 2, new QTableWidgetItem(c.code()));
+                m_collegesTable->setItem(r, 3, new QTableWidgetItem(c.tuitionFees().toString()));
+            }
+        });
 }
 
 /**
@@ -1217,15 +1607,19 @@ void AdminPanel::refreshCollegesTable() {
  * Fetches latest department data and populates the table
  */
 void AdminPanel::refreshDepartmentsTable() {
-    m_departmentsTable->setRowCount(0);
-    for (const auto& d : m_departmentController.getAllDepartments()) {
-        int r = m_departmentsTable->rowCount();
-        m_departmentsTable->insertRow(r);
-        m_departmentsTable->setItem(r, 0, new QTableWidgetItem(QString::number(d.id())));
-        m_departmentsTable->setItem(r, 1, new QTableWidgetItem(d.name()));
-        m_departmentsTable->setItem(r, 2, new QTableWidgetItem(d.collegeName()));
-        m_departmentsTable->setItem(r, 3, new QTableWidgetItem(d.code()));
-    }
+    loadAsync<QList<Department>>(DepartmentsTable,
+        []() { return DepartmentController().getAllDepartments(); },
+        [this](const QList<Department>& departments) {
+            m_departmentsTable->setRowCount(0);
+            for (const auto& d : departments) {
+                int r = m_departmentsTable->rowCount();
+                m_departmentsTable->insertRow(r);
+                m_departmentsTable->setItem(r, 0, new QTableWidgetItem(QString::number(d.id())));
+                m_departmentsTable->setItem(r, 1, new QTableWidgetItem(d.name()));
+                m_departmentsTable->setItem(r, 2, new QTableWidgetItem(d.collegeName()));
+                m_departmentsTable->setItem(r, 3, new QTableWidgetItem(d.code()));
+            }
+        });
 }
 
 /**
@@ -1233,15 +1627,19 @@ void AdminPanel::refreshDepartmentsTable() {
  * Fetches latest academic level data and populates the table
  */
 void AdminPanel::refreshLevelsTable() {
-    m_levelsTable->setRowCount(0);
-    for (const auto& l : m_academicLevelController.getAllAcademicLevels()) {
-        int r = m_levelsTable->rowCount();
-        m_levelsTable->insertRow(r);
-        m_levelsTable->setItem(r, 0, new QTableWidgetItem(QString::number(l.id())));
-        // Even in the management table, emphasize the Year X identity
-        m_levelsTable->setItem(r, 1, new QTableWidgetItem(QString("Year %1").arg(l.levelNumber())));
-        m_levelsTable->setItem(r, 2, new QTableWidgetItem(l.name())); // Move internal name to column 2
-    }
+    loadAsync<QList<AcademicLevel>>(LevelsTable,
+        []() { return AcademicLevelController().getAllAcademicLevels(); },
+        [this](const QList<AcademicLevel>& levels) {
+            m_levelsTable->setRowCount(0);
+            for (const auto& l : levels) {
+                int r = m_levelsTable->rowCount();
+                m_levelsTable->insertRow(r);
+                m_levelsTable->setItem(r, 0, new QTableWidgetItem(QString::number(l.id())));
+                // Even in the management table, emphasize the Year X identity
+                m_levelsTable->setItem(r, 1, new QTableWidgetItem(QString("Year %1").arg(l.levelNumber())));
+                m_levelsTable->setItem(r, 2, new QTableWidgetItem(l.name())); // Move internal name to column 2
+            }
+        });
 }
 
 /**
@@ -1249,37 +1647,41 @@ void AdminPanel::refreshLevelsTable() {
  * Fetches latest room data and separates them into appropriate tables based on type
  */
 void AdminPanel::refreshRoomsTable() {
-    if (!m_roomsTable || !m_labsTable) return;
-    m_roomsTable->setRowCount(0);
-    m_labsTable->setRowCount(0);
-    
-    for (const auto& r_obj : m_roomController.getAllRooms()) {
-        QString type = r_obj.type().trimmed();
-        if (type.compare("Hall", Qt::CaseInsensitive) == 0) {
-            int r = m_roomsTable->rowCount();
-            m_roomsTable->insertRow(r);
-            m_roomsTable->setItem(r, 0, new QTableWidgetItem(QString::number(r_obj.id())));
-            m_roomsTable->setItem(r, 1, new QTableWidgetItem(r_obj.code()));
-            m_roomsTable->setItem(r, 2, new QTableWidgetItem(r_obj.name()));
-            m_roomsTable->setItem(r, 3, new QTableWidgetItem(QString::number(r_obj.capacity())));
-            m_roomsTable->setItem(r, 4, new QTableWidgetItem(QString::number(r_obj.acUnits())));
-            m_roomsTable->setItem(r, 5, new QTableWidgetItem(QString::number(r_obj.fansCount())));
-            m_roomsTable->setItem(r, 6, new QTableWidgetItem(QString::number(r_obj.lightingPoints())));
-            m_roomsTable->setItem(r, 7, new QTableWidgetItem(r_obj.seatingDescription()));
-        } else if (type.compare("Lab", Qt::CaseInsensitive) == 0 || type.isEmpty()) {
-            // Defaulting unknown or "Lab" to Labs tab
-            int r = m_labsTable->rowCount();
-            m_labsTable->insertRow(r);
-            m_labsTable->setItem(r, 0, new QTableWidgetItem(QString::number(r_obj.id())));
-            m_labsTable->setItem(r, 1, new QTableWidgetItem(r_obj.code()));
-            m_labsTable->setItem(r, 2, new QTableWidgetItem(r_obj.name()));
-            m_labsTable->setItem(r, 3, new QTableWidgetItem(QString::number(r_obj.capacity())));
-            m_labsTable->setItem(r, 4, new QTableWidgetItem(QString::number(r_obj.acUnits())));
-            m_labsTable->setItem(r, 5, new QTableWidgetItem(QString::number(r_obj.fansCount())));
-            m_labsTable->setItem(r, 6, new QTableWidgetItem(QString::number(r_obj.lightingPoints())));
-            m_labsTable->setItem(r, 7, new QTableWidgetItem(QString::number(r_obj.computersCount())));
-        }
-    }
+    loadAsync<QList<Room>>(RoomsTable,
+        []() { return RoomController().getAllRooms(); },
+        [this](const QList<Room>& rooms) {
+            if (!m_roomsTable || !m_labsTable) return;
+            m_roomsTable->setRowCount(0);
+            m_labsTable->setRowCount(0);
+    
+            for (const auto& r_obj : rooms) {
+                QString type = r_obj.type().trimmed();
+                if (type.compare("Hall", Qt::CaseInsensitive) == 0) {
+                    int r = m_roomsTable->rowCount();
+                    m_roomsTable->insertRow(r);
+                    m_roomsTable->setItem(r, 0, new QTableWidgetItem(QString::number(r_obj.id())));
+                    m_roomsTable->setItem(r, 1, new QTableWidgetItem(r_obj.code()));
+                    m_roomsTable->setItem(r, 2, new QTableWidgetItem(r_obj.name()));
+                    m_roomsTable->setItem(r, 3, new QTableWidgetItem(QString::number(r_obj.capacity())));
+                    m_roomsTable->setItem(r, 4, new QTableWidgetItem(QString::number(r_obj.acUnits())));
+                    m_roomsTable->setItem(r, 5, new QTableWidgetItem(QString::number(r_obj.fansCount())));
+                    m_roomsTable->setItem(r, 6, new QTableWidgetItem(QString::number(r_obj.lightingPoints())));
+                    m_roomsTable->setItem(r, 7, new QTableWidgetItem(r_obj.seatingDescription()));
+                } else if (type.compare("Lab", Qt::CaseInsensitive) == 0 || type.isEmpty()) {
+                    // Defaulting unknown or "Lab" to Labs tab
+                    int r = m_labsTable->rowCount();
+                    m_labsTable->insertRow(r);
+                    m_labsTable->setItem(r, 0, new QTableWidgetItem(QString::number(r_obj.id())));
+                    m_labsTable->setItem(r, 1, new QTableWidgetItem(r_obj.code()));
+                    m_labsTable->setItem(r, 2, new QTableWidgetItem(r_obj.name()));
+                    m_labsTable->setItem(r, 3, new QTableWidgetItem(QString::number(r_obj.capacity())));
+                    m_labsTable->setItem(r, 4, new QTableWidgetItem(QString::number(r_obj.acUnits())));
+                    m_labsTable->setItem(r, 5, new QTableWidgetItem(QString::number(r_obj.fansCount())));
+                    m_labsTable->setItem(r, 6, new QTableWidgetItem(QString::number(r_obj.lightingPoints())));
+                    m_labsTable->setItem(r, 7, new QTableWidgetItem(QString::number(r_obj.computersCount())));
+                }
+            }
+        });
 }
 
 /**
@@ -1287,20 +1689,23 @@ void AdminPanel::refreshRoomsTable() {
  * Fetches latest professor data and populates the table
  */
 void AdminPanel::refreshProfessorsTable() {
-    m_professorsTable->setRowCount(0);
-    for (const auto& p : m_professorController.getAllProfessors()) {
-        int r = m_professorsTable->rowCount();
-        m_professorsTable->insertRow(r);
-        m_professorsTable->setItem(r, 0, new QTableWidgetItem(QString::number(p.id())));
-        m_professorsTable->setItem(r, 1, new QTableWidgetItem(p.fullName()));
-        
-        // Get username (code) from user table
-        User u = m_userController.getUserById(p.userId());
-        m_professorsTable->setItem(r, 2, new QTableWidgetItem(u.username()));
-        
-        m_professorsTable->setItem(r, 3, new QTableWidgetItem(p.idNumber()));
-        m_professorsTable->setItem(r, 4, new QTableWidgetItem(p.specialization()));
-    }
+    loadAsync<QList<Professor>>(ProfessorsTable,
+        []() {
+            // Username (code) comes from the same join as the name
+            return ProfessorController().getAllProfessors();
+        },
+        [this](const QList<Professor>& professors) {
+            m_professorsTable->setRowCount(0);
+            for (const auto& p : professors) {
+                int r = m_professorsTable->rowCount();
+                m_professorsTable->insertRow(r);
+                m_professorsTable->setItem(r, 0, new QTableWidgetItem(QString::number(p.id())));
+                m_professorsTable->setItem(r, 1, new QTableWidgetItem(p.fullName()));
+                m_professorsTable->setItem(r, 2, new QTableWidgetItem(p.username()));
+                m_professorsTable->setItem(r, 3, new QTableWidgetItem(p.idNumber()));
+                m_professorsTable->setItem(r, 4, new QTableWidgetItem(p.specialization()));
+            }
+        });
 }
 
 /**
@@ -1308,24 +1713,18 @@ void AdminPanel::refreshProfessorsTable() {
  * Fetches latest schedule data with joined details and populates the table
  */
 void AdminPanel::refreshSchedulesTable() {
-    m_schedulesTable->setRowCount(0);
-    QSqlQuery query("SELECT s.id, c.name, r.name, u.full_name, s.day_of_week, s.start_time, s.end_time "
-                    "FROM schedules s "
-                    "JOIN courses c ON s.course_id = c.id "
-                    "JOIN rooms r ON s.room_id = r.id "
-                    "JOIN professors p ON s.professor_id = p.id "
-                    "JOIN users u ON p.user_id = u.id", 
-                    DBConnection::instance().database());
-    
-    if (query.exec()) {
-        while (query.next()) {
-            int r = m_schedulesTable->rowCount();
-            m_schedulesTable->insertRow(r);
-            for(int i=0; i<7; ++i) {
-                m_schedulesTable->setItem(r, i, new QTableWidgetItem(query.value(i).toString()));
+    loadAsync<QList<QStringList>>(SchedulesTable,
+        []() { return ScheduleController().getScheduleTableRows(); },
+        [this](const QList<QStringList>& rows) {
+            m_schedulesTable->setRowCount(0);
+            for (const auto& row : rows) {
+                int r = m_schedulesTable->rowCount();
+                m_schedulesTable->insertRow(r);
+                for (int i = 0; i < row.size(); ++i) {
+                    m_schedulesTable->setItem(r, i, new QTableWidgetItem(row.at(i)));
+                }
             }
-        }
-    }
+        });
 }
 
 /**
@@ -1382,7 +1781,7 @@ void AdminPanel::onAddStudent() {
         int cid = college->currentData().toInt();
         for(const auto& c : colleges) {
             if(c.id() == cid) {
-                tuition->setValue(c.tuitionFees());
+                tuition->setValue(c.tuitionFees().toDouble());
                 break;
             }
         }
@@ -1417,7 +1816,7 @@ void AdminPanel::onAddStudent() {
         User u; 
         u.setFullName(name->text()); 
         u.setUsername(code->text()); 
-        u.setRole("student"); 
+        u.setRole(UserRole::Student); 
         u.setPassword(code->text()); // Initial password is their code
 
         QString userError;
@@ -1452,12 +1851,11 @@ void AdminPanel::onAddStudent() {
             sd.setAcademicLevelId(level->currentData().toInt());
             sd.setSectionId(section->currentData().toInt());
             sd.setCollegeId(college->currentData().toInt());
-            sd.setTuitionFees(tuition->value());
-            sd.setStatus("active");
+            sd.setTuitionFees(Money::fromDouble(tuition->value()));
+            sd.setStatus(StudentStatus::Active);
 
             if (m_studentController.addStudent(sd)) {
                 QMessageBox::information(this, "Success", "Student registered successfully (Linked to existing identity).");
-                refreshStudentsTable();
             } else {
                 // Only rollback if we just created the user in this session
                 if (!userError.contains("Duplicate entry")) {
@@ -1521,7 +1919,7 @@ void AdminPanel::onEditStudent() {
 
     QDoubleSpinBox* tuitionEdit = new QDoubleSpinBox();
     tuitionEdit->setRange(0, 1000000);
-    tuitionEdit->setValue(student.tuitionFees());
+    tuitionEdit->setValue(student.tuitionFees().toDouble());
 
     layout->addRow("Full Name:", nameEdit);
     layout->addRow("National ID:", idEdit);
@@ -1547,11 +1945,10 @@ void AdminPanel::onEditStudent() {
         student.setDepartment(deptEdit->currentText());
         student.setAcademicLevelId(levelEdit->currentData().toInt());
         student.setSectionId(sectionEdit->currentData().toInt());
-        student.setTuitionFees(tuitionEdit->value());
+        student.setTuitionFees(Money::fromDouble(tuitionEdit->value()));
 
         if (m_studentController.updateStudent(student)) {
             QMessageBox::information(this, "Success", "Student records updated successfully.");
-            refreshStudentsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to update student records.");
         }
@@ -1574,7 +1971,6 @@ void AdminPanel::onDeleteStudent() {
             int userId = idText.mid(2).toInt();
             if (m_userController.deleteUser(userId)) {
                 QMessageBox::information(this, "Success", "Incomplete profile removed permanently.");
-                refreshStudentsTable();
             } else {
                 QMessageBox::critical(this, "Error", "Failed to remove user account.");
             }
@@ -1583,8 +1979,6 @@ void AdminPanel::onDeleteStudent() {
             int id = idText.toInt();
             if (m_studentController.deleteStudent(id)) {
                 QMessageBox::information(this, "Moved to Draft", "Student has been moved to the draft tab. You can restore or permanently delete them from there.");
-                refreshStudentsTable();
-                refreshDraftTable();
             } else {
                 QMessageBox::critical(this, "Error", "Failed to move student to draft.");
             }
@@ -1592,6 +1986,27 @@ void AdminPanel::onDeleteStudent() {
     }
 }
 
+/**
+ * Filters the students table as the admin types
+ * Matches come from the in-memory search index, which is built on first use
+ * @param text - The search box contents
+ */
+void AdminPanel::onSearchStudents(const QString& text) {
+    const bool filtering = !text.trimmed().isEmpty();
+    QSet<QString> matches;
+    if (filtering) {
+        SearchIndex& index = SearchIndex::instance();
+        if (!index.isLoaded()) index.rebuild();
+        const auto hits = index.search(text, qMax(1, m_studentsTable->rowCount()), SearchIndex::StudentMask);
+        for (const auto& hit : hits) matches.insert(QString::number(hit.id));
+    }
+
+    for (int r = 0; r < m_studentsTable->rowCount(); ++r) {
+        QTableWidgetItem* idItem = m_studentsTable->item(r, 0);
+        m_studentsTable->setRowHidden(r, filtering && !(idItem && matches.contains(idItem->text())));
+    }
+}
+
 /**
  * Creates the Student Draft/Recycle Bin tab
  * Allows restoring or permanently deleting removed students
@@ -1631,28 +2046,40 @@ QWidget* AdminPanel::createDraftTab() {
  * Fetches soft-deleted students and populates the table
  */
 void AdminPanel::refreshDraftTable() {
-    m_draftStudentsTable->setRowCount(0);
-    QList<StudentData> deleted = m_studentController.getDeletedStudents();
-    
-    QMap<int, QString> levelMap;
-    for(const auto& l : m_academicLevelController.getAllAcademicLevels()) 
-        levelMap[l.id()] = QString("Year %1").arg(l.levelNumber());
+    loadAsync<LevelledRows<StudentData>>(DraftTable,
+        []() {
+            LevelledRows<StudentData> data;
+            data.rows = StudentController().getDeletedStudents();
+            data.levels = levelNames();
+            return data;
+        },
+        [this](const LevelledRows<StudentData>& data) {
+            m_draftStudentsTable->setRowCount(0);
+            for (const auto& s : data.rows) {
+                int r = m_draftStudentsTable->rowCount();
+                m_draftStudentsTable->insertRow(r);
+                setDraftRow(r, s, data.levels);
+            }
+        });
+}
 
-    for (const auto& s : deleted) {
-        int r = m_draftStudentsTable->rowCount();
-        m_draftStudentsTable->insertRow(r);
-        
-        m_draftStudentsTable->setItem(r, 0, new QTableWidgetItem(QString::number(s.id())));
-        m_draftStudentsTable->setItem(r, 1, new QTableWidgetItem(s.studentNumber()));
-        m_draftStudentsTable->setItem(r, 2, new QTableWidgetItem(s.fullName()));
-        m_draftStudentsTable->setItem(r, 3, new QTableWidgetItem(s.idNumber()));
-        m_draftStudentsTable->setItem(r, 4, new QTableWidgetItem(s.collegeName()));
-        m_draftStudentsTable->setItem(r, 5, new QTableWidgetItem(s.department()));
-        
-        QString levelStr = levelMap.value(s.academicLevelId(), "---");
-        m_draftStudentsTable->setItem(r, 6, new QTableWidgetItem(levelStr));
-        m_draftStudentsTable->setItem(r, 7, new QTableWidgetItem(s.status()));
-    }
+/**
+ * Fills one row of the draft students table
+ * @param r - The row index
+ * @param s - The soft-deleted student to display
+ * @param levelMap - Academic level names by ID
+ */
+void AdminPanel::setDraftRow(int r, const StudentData& s, const QMap<int, QString>& levelMap) {
+    m_draftStudentsTable->setItem(r, 0, new QTableWidgetItem(QString::number(s.id())));
+    m_draftStudentsTable->setItem(r, 1, new QTableWidgetItem(s.studentNumber()));
+    m_draftStudentsTable->setItem(r, 2, new QTableWidgetItem(s.fullName()));
+    m_draftStudentsTable->setItem(r, 3, new QTableWidgetItem(s.idNumber()));
+    m_draftStudentsTable->setItem(r, 4, new QTableWidgetItem(s.collegeName()));
+    m_draftStudentsTable->setItem(r, 5, new QTableWidgetItem(s.department()));
+    
+    QString levelStr = levelMap.value(s.academicLevelId(), "---");
+    m_draftStudentsTable->setItem(r, 6, new QTableWidgetItem(levelStr));
+    m_draftStudentsTable->setItem(r, 7, new QTableWidgetItem(s.statusName()));
 }
 
 /**
@@ -1666,8 +2093,6 @@ void AdminPanel::onRestoreStudent() {
     
     if (m_studentController.restoreStudent(id)) {
         QMessageBox::information(this, "Success", "Student has been restored to the main list.");
-        refreshStudentsTable();
-        refreshDraftTable();
     }
 }
 
@@ -1683,7 +2108,6 @@ void AdminPanel::onHardDeleteStudent() {
     if (QMessageBox::question(this, "Permanent Delete", "This will permanently remove the student profile. This cannot be undone. Proceed?") == QMessageBox::Yes) {
         if (m_studentController.hardDeleteStudent(id)) {
             QMessageBox::information(this, "Deleted", "Student permanently removed from system.");
-            refreshDraftTable();
         }
     }
 }
@@ -1739,14 +2163,14 @@ void AdminPanel::onAddCourse() {
         int targetSemNum = semester->currentData().toInt();
         int finalSemId = 0;
         
-        QSqlQuery semQ(DBConnection::instance().database());
+        DBQuery semQ(DBConnection::instance().database());
         semQ.prepare("SELECT id FROM semester WHERE semester = ? LIMIT 1");
         semQ.addBindValue(targetSemNum);
         if (semQ.exec() && semQ.next()) {
             finalSemId = semQ.value(0).toInt();
         } else {
             // Create new generic semester
-            QSqlQuery createSem(DBConnection::instance().database());
+            DBQuery createSem(DBConnection::instance().database());
             createSem.prepare("INSERT INTO semester (year, semester) VALUES (NOW(), ?)");
             createSem.addBindValue(targetSemNum);
             if(createSem.exec()) finalSemId = createSem.lastInsertId().toInt();
@@ -1768,7 +2192,7 @@ void AdminPanel::onAddCourse() {
 
         if (m_courseController.addCourse(c)) {
             if (prof->currentData().toInt() > 0) {
-                QSqlQuery idQ(DBConnection::instance().database());
+                DBQuery idQ(DBConnection::instance().database());
                 idQ.exec("SELECT LAST_INSERT_ID()");
                 int nid = 0;
                 if (idQ.next()) {
@@ -1777,7 +2201,6 @@ void AdminPanel::onAddCourse() {
                 m_scheduleController.assignProfessorToCourse(nid, prof->currentData().toInt());
             }
             QMessageBox::information(this, "Success", "Course created successfully.");
-            refreshCoursesTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to create course. Please check database connectivity.");
         }
@@ -1800,7 +2223,7 @@ void AdminPanel::onEditCourse() {
     
     QLineEdit* name = new QLineEdit(c.name());
     QComboBox* type = new QComboBox(); type->addItems({"Theoretical", "Practical"});
-    type->setCurrentText(c.courseType());
+    type->setCurrentText(c.courseTypeName());
     
     QComboBox* maxG = new QComboBox(); maxG->addItems({"100", "150"});
     maxG->setCurrentText(QString::number(c.maxGrade()));
@@ -1857,14 +2280,14 @@ void AdminPanel::onEditCourse() {
         int targetSemNum = semester->currentData().toInt();
         int finalSemId = 0;
         
-        QSqlQuery semQ(DBConnection::instance().database());
+        DBQuery semQ(DBConnection::instance().database());
         semQ.prepare("SELECT id FROM semester WHERE semester = ? LIMIT 1");
         semQ.addBindValue(targetSemNum);
         if (semQ.exec() && semQ.next()) {
             finalSemId = semQ.value(0).toInt();
         } else {
             // Create new generic semester
-            QSqlQuery createSem(DBConnection::instance().database());
+            DBQuery createSem(DBConnection::instance().database());
             createSem.prepare("INSERT INTO semester (year, semester) VALUES (NOW(), ?)");
             createSem.addBindValue(targetSemNum);
             if(createSem.exec()) finalSemId = createSem.lastInsertId().toInt();
@@ -1888,7 +2311,6 @@ void AdminPanel::onEditCourse() {
                 m_scheduleController.assignProfessorToCourse(c.id(), prof->currentData().toInt());
             }
             QMessageBox::information(this, "Success", "Course updated successfully.");
-            refreshCoursesTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to update course.");
         }
@@ -1906,7 +2328,6 @@ void AdminPanel::onDeleteCourse() {
     if (QMessageBox::question(this, "Confirm", "Delete this course?") == QMessageBox::Yes) {
         if (m_courseController.deleteCourse(id)) {
             QMessageBox::information(this, "Deleted", "Course removed.");
-            refreshCoursesTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to delete course.");
         }
@@ -1985,7 +2406,6 @@ void AdminPanel::onAddRoom() {
 
         if (m_roomController.addRoom(r)) {
             QMessageBox::information(this, "Success", "Physical room/lab registered.");
-            refreshRoomsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to add room to registry.");
         }
@@ -2062,7 +2482,6 @@ void AdminPanel::onEditRoom() {
 
         if (m_roomController.updateRoom(r)) {
             QMessageBox::information(this, "Success", "Facility details updated.");
-            refreshRoomsTable();
         }
     }
 }
@@ -2083,9 +2502,7 @@ void AdminPanel::onDeleteRoom() {
     int id = table->item(row, 0)->text().toInt();
 
     if (QMessageBox::question(this, "Confirm Removal", "Are you sure you want to remove this facility?") == QMessageBox::Yes) {
-        if (m_roomController.deleteRoom(id)) {
-            refreshRoomsTable();
-        }
+        m_roomController.deleteRoom(id);
     }
 }
 
@@ -2115,10 +2532,9 @@ void AdminPanel::onAddCollege() {
             return;
         }
         College c; c.setName(name->text()); c.setCode(code->text());
-        c.setTuitionFees(fees->value());
+        c.setTuitionFees(Money::fromDouble(fees->value()));
         if (m_collegeController.addCollege(c)) {
             QMessageBox::information(this, "Success", "College/Faculty added.");
-            refreshCollegesTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to add college.");
         }
@@ -2146,7 +2562,7 @@ void AdminPanel::onEditCollege() {
     QLineEdit* code = new QLineEdit(target.code());
     QDoubleSpinBox* fees = new QDoubleSpinBox();
     fees->setRange(0, 1000000);
-    fees->setValue(target.tuitionFees());
+    fees->setValue(target.tuitionFees().toDouble());
     
     layout->addRow("Name:", name);
     layout->addRow("Code:", code);
@@ -2159,10 +2575,8 @@ void AdminPanel::onEditCollege() {
     if (dialog.exec() == QDialog::Accepted) {
         target.setName(name->text());
         target.setCode(code->text());
-        target.setTuitionFees(fees->value());
-        if (m_collegeController.updateCollege(target)) {
-            refreshCollegesTable();
-        }
+        target.setTuitionFees(Money::fromDouble(fees->value()));
+        m_collegeController.updateCollege(target);
     }
 }
 
@@ -2176,9 +2590,217 @@ void AdminPanel::onDeleteCollege() {
     int id = m_collegesTable->item(row, 0)->text().toInt();
 
     if (QMessageBox::question(this, "Confirm", "Deleting a Faculty will NOT remove its departments automatically. Proceed?") == QMessageBox::Yes) {
-        if (m_collegeController.deleteCollege(id)) {
-            refreshCollegesTable();
+        m_collegeController.deleteCollege(id);
+    }
+}
+
+/**
+ * Manages the fee rules term billing charges from
+ * A rule applies to a faculty, an academic level or both; saving a rule for
+ * a scope that already has one replaces its amount
+ */
+void AdminPanel::onManageFeeRules() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Fee Rules");
+    dialog.resize(600, 400);
+    QVBoxLayout* layout = new QVBoxLayout(&dialog);
+
+    QHash<int, QString> colleges;
+    QHash<int, QString> levels;
+    QComboBox* college = new QComboBox();
+    QComboBox* level = new QComboBox();
+    college->addItem("Any Faculty", 0);
+    level->addItem("Any Level", 0);
+    for (const auto& c : m_collegeController.getAllColleges()) {
+        colleges.insert(c.id(), c.name());
+        college->addItem(c.name(), c.id());
+    }
+    for (const auto& l : m_academicLevelController.getAllAcademicLevels()) {
+        levels.insert(l.id(), QString("Year %1").arg(l.levelNumber()));
+        level->addItem(QString("Year %1").arg(l.levelNumber()), l.id());
+    }
+
+    QTableWidget* table = new QTableWidget();
+    table->setColumnCount(4);
+    table->setHorizontalHeaderLabels({"ID", "Faculty", "Level", "Amount per Term"});
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->setSelectionBehavior(QAbstractItemView::SelectRows);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    layout->addWidget(table);
+
+    auto reload = [&]() {
+        table->setRowCount(0);
+        for (const auto& rule : m_billingController.getAllFeeRules()) {
+            int r = table->rowCount();
+            table->insertRow(r);
+            table->setItem(r, 0, new QTableWidgetItem(QString::number(rule.id())));
+            table->setItem(r, 1, new QTableWidgetItem(rule.collegeId() > 0 ? colleges.value(rule.collegeId()) : "Any"));
+            table->setItem(r, 2, new QTableWidgetItem(rule.academicLevelId() > 0 ? levels.value(rule.academicLevelId()) : "Any"));
+            table->setItem(r, 3, new QTableWidgetItem(rule.amount().toString()));
+        }
+    };
+    reload();
+
+    QHBoxLayout* inputL = new QHBoxLayout();
+    QDoubleSpinBox* amount = new QDoubleSpinBox();
+    amount->setRange(0, 1000000);
+    amount->setPrefix("$");
+    inputL->addWidget(college);
+    inputL->addWidget(level);
+    inputL->addWidget(amount);
+    layout->addLayout(inputL);
+
+    QHBoxLayout* btns = new QHBoxLayout();
+    QPushButton* saveBtn = new QPushButton("Save Rule");
+    QPushButton* deleteBtn = new QPushButton("Delete Rule");
+    deleteBtn->setObjectName("dangerBtn");
+    QPushButton* closeBtn = new QPushButton("Close");
+    btns->addWidget(saveBtn);
+    btns->addWidget(deleteBtn);
+    btns->addStretch();
+    btns->addWidget(closeBtn);
+    layout->addLayout(btns);
+
+    connect(saveBtn, &QPushButton::clicked, [&]() {
+        FeeRule rule;
+        rule.setCollegeId(college->currentData().toInt());
+        rule.setAcademicLevelId(level->currentData().toInt());
+        rule.setAmount(Money::fromDouble(amount->value()));
+        if (rule.collegeId() == 0 && rule.academicLevelId() == 0) {
+            QMessageBox::warning(&dialog, "Input Error", "Select a faculty, a level or both.");
+            return;
+        }
+        if (!m_billingController.addFeeRule(rule)) {
+            QMessageBox::critical(&dialog, "Error", "Failed to save fee rule.");
+            return;
+        }
+        reload();
+    });
+    connect(deleteBtn, &QPushButton::clicked, [&]() {
+        int row = table->currentRow();
+        if (row < 0) return;
+        if (!m_billingController.deleteFeeRule(table->item(row, 0)->text().toInt())) {
+            QMessageBox::critical(&dialog, "Error", "Failed to delete fee rule.");
+            return;
+        }
+        reload();
+    });
+    connect(closeBtn, &QPushButton::clicked, &dialog, &QDialog::accept);
+
+    dialog.exec();
+}
+
+/**
+ * Runs the term billing job for a selected semester
+ * Charges every student from the fee rules in chunks and shows progress;
+ * a cancelled or failed run resumes from its checkpoint next time
+ */
+void AdminPanel::onRunTermBilling() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Run Term Billing");
+    QFormLayout* layout = new QFormLayout(&dialog);
+
+    QComboBox* semester = new QComboBox();
+    for (const auto& s : m_semesterController.getAllSemesters()) {
+        semester->addItem(QString("Semester %1 (%2)").arg(s.semester()).arg(s.year().date().year()), s.id());
+    }
+    layout->addRow("Semester:", semester);
+
+    QPushButton* btn = new QPushButton("Start Billing");
+    btn->setObjectName("primaryBtn");
+    layout->addRow(btn);
+    connect(btn, &QPushButton::clicked, &dialog, &QDialog::accept);
+
+    if (dialog.exec() != QDialog::Accepted || semester->currentIndex() < 0) return;
+    int semesterId = semester->currentData().toInt();
+
+    bool restart = false;
+    BatchJob previous = m_billingController.getTermBillingJob(semesterId);
+    if (previous.status() == "Completed") {
+        if (QMessageBox::question(this, "Already Billed",
+                "This semester has already been billed. Run again to bill students added since?") != QMessageBox::Yes) {
+            return;
         }
+        restart = true;
+    }
+
+    QProgressDialog progressDialog("Generating tuition charges...", "Pause", 0, 100, this);
+    progressDialog.setWindowTitle("Term Billing");
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+
+    bool ok = m_billingController.runTermBilling(semesterId, 2000, [&progressDialog](int processed, int total) {
+        progressDialog.setMaximum(qMax(total, 1));
+        progressDialog.setValue(qMin(processed, qMax(total, 1)));
+        progressDialog.setLabelText(QString("Billed %1 of %2 students...").arg(processed).arg(total));
+        return !progressDialog.wasCanceled();
+    }, restart);
+    progressDialog.close();
+
+    if (ok) {
+        QMessageBox::information(this, "Billing Complete", "Tuition charges were generated and balances updated.");
+    } else if (progressDialog.wasCanceled()) {
+        QMessageBox::information(this, "Billing Paused", "Billing was paused. Run it again to resume from the last checkpoint.");
+    } else {
+        QMessageBox::critical(this, "Billing Failed", "Term billing failed. Run it again to resume from the last checkpoint.");
+    }
+}
+
+/**
+ * Runs the year-end promotion for every academic level
+ * Students who passed their level move up and are enrolled in the next
+ * level's courses (or graduate from the last one); a cancelled or failed run
+ * resumes from its checkpoint next time
+ */
+void AdminPanel::onRunCohortPromotion() {
+    QDialog dialog(this);
+    dialog.setWindowTitle("Year-End Promotion");
+    QFormLayout* layout = new QFormLayout(&dialog);
+
+    // The academic year starts in the autumn, so a June run belongs to last year's
+    const QDate today = QDate::currentDate();
+    QSpinBox* year = new QSpinBox();
+    year->setRange(2000, 2100);
+    year->setValue(today.month() >= 8 ? today.year() : today.year() - 1);
+    layout->addRow("Academic year starting:", year);
+
+    QSpinBox* carried = new QSpinBox();
+    carried->setRange(0, 10);
+    carried->setValue(0);
+    layout->addRow("Failed courses allowed:", carried);
+
+    QPushButton* btn = new QPushButton("Start Promotion");
+    btn->setObjectName("primaryBtn");
+    layout->addRow(btn);
+    connect(btn, &QPushButton::clicked, &dialog, &QDialog::accept);
+
+    if (dialog.exec() != QDialog::Accepted) return;
+    if (QMessageBox::question(this, "Confirm",
+            QString("Promote every level for %1/%2? Students who passed will be moved up and enrolled in their new courses.")
+                .arg(year->value()).arg(year->value() + 1)) != QMessageBox::Yes) {
+        return;
+    }
+
+    QProgressDialog progressDialog("Promoting students...", "Pause", 0, 100, this);
+    progressDialog.setWindowTitle("Year-End Promotion");
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(0);
+
+    bool ok = m_promotionController.runCohortPromotion(year->value(), carried->value(), 2000,
+                                                         [&progressDialog](int processed, int total) {
+        progressDialog.setMaximum(qMax(total, 1));
+        progressDialog.setValue(qMin(processed, qMax(total, 1)));
+        progressDialog.setLabelText(QString("Evaluated %1 of %2 students in this level...").arg(processed).arg(total));
+        return !progressDialog.wasCanceled();
+    });
+    progressDialog.close();
+
+    if (ok) {
+        QMessageBox::information(this, "Promotion Complete", "Students who passed were moved to their next level.");
+    } else if (progressDialog.wasCanceled()) {
+        QMessageBox::information(this, "Promotion Paused", "Promotion was paused. Run it again to resume from the last checkpoint.");
+    } else {
+        QMessageBox::critical(this, "Promotion Failed", "Promotion failed. Run it again to resume from the last checkpoint.");
     }
 }
 
@@ -2193,20 +2815,37 @@ void AdminPanel::onPrintData() {
     content += "--- COLLEGES/FACULTIES ---\n";
     for(const auto& c : m_collegeController.getAllColleges()) {
         content += QString("ID: %1 | Name: %2 | Code: %3 | Tuition: %4\n")
-                   .arg(c.id()).arg(c.name()).arg(c.code()).arg(c.tuitionFees());
+                   .arg(c.id()).arg(c.name()).arg(c.code()).arg(c.tuitionFees().toString());
     }
 
     content += "\n--- COURSES ---\n";
-    for(const auto& crs : m_courseController.getAllCourses()) {
+    m_courseController.forEachCourse(nullptr, [&content](const Course& crs) {
         content += QString("ID: %1 | Name: %2 | Dept: %3 | Prof: %4\n")
                    .arg(crs.id()).arg(crs.name()).arg(crs.departmentName()).arg(crs.assignedProfessor());
-    }
+        return true;
+    });
 
     content += "\n--- STUDENTS ---\n";
-    for(const auto& s : m_studentController.getAllStudents()) {
+    m_studentController.forEachStudent(nullptr, [&content](const StudentData& s) {
         content += QString("Num: %1 | Name: %2 | College: %3 | Tuition Paid/Fees: %4\n")
-                   .arg(s.studentNumber()).arg(s.fullName()).arg(s.collegeName()).arg(s.tuitionFees());
-    }
+                   .arg(s.studentNumber()).arg(s.fullName()).arg(s.collegeName()).arg(s.tuitionFees().toString());
+        return true;
+    });
+
+    content += "\n--- OUTSTANDING BALANCES ---\n";
+    int owing = 0;
+    Money totalCharged, totalPaid;
+    for(const auto& b : m_ledgerController.getOutstandingBalances()) {
+        content += QString("Num: %1 | Name: %2 | Charged: %3 | Paid: %4 | Balance: %5\n")
+                   .arg(b.studentNumber()).arg(b.fullName())
+                   .arg(b.totalCharged().toString()).arg(b.totalPaid().toString()).arg(b.balance().toString());
+        ++owing;
+        totalCharged += b.totalCharged();
+        totalPaid += b.totalPaid();
+    }
+    content += QString("Total (%1 students) | Charged: %2 | Paid: %3 | Balance: %4\n")
+               .arg(owing).arg(totalCharged.toString()).arg(totalPaid.toString())
+               .arg((totalCharged - totalPaid).toString());
 
     if (Persistence::exportData("unimanage_full_report.txt", content)) {
         QMessageBox::information(this, "Export Success", "Full system report saved to D:/unimanage_full_report.txt");
@@ -2246,7 +2885,7 @@ void AdminPanel::onEditDepartment() {
         d.setName(name->text());
         d.setCode(code->text());
         d.setCollegeId(faculty->currentData().toInt());
-        if (m_departmentController.updateDepartment(d)) refreshDepartmentsTable();
+        m_departmentController.updateDepartment(d);
     }
 }
 
@@ -2259,8 +2898,8 @@ void AdminPanel::onDeleteDepartment() {
     if (row < 0) return;
     int id = m_departmentsTable->item(row, 0)->text().toInt();
     if (QMessageBox::question(this, "Confirm", "Remove this department?") == QMessageBox::Yes) {
-        if (m_departmentController.deleteDepartment(id)) refreshDepartmentsTable();
-        else QMessageBox::warning(this, "Constraint", "Cannot delete department with active linked courses.");
+        if (!m_departmentController.deleteDepartment(id))
+            QMessageBox::warning(this, "Constraint", "Cannot delete department with active linked courses.");
     }
 }
 
@@ -2290,7 +2929,6 @@ void AdminPanel::onAddDepartment() {
         Department d; d.setName(name->text()); d.setCollegeId(college->currentData().toInt()); d.setCode(code->text());
         if (m_departmentController.addDepartment(d)) {
             QMessageBox::information(this, "Success", "Department created.");
-            refreshDepartmentsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to create department.");
         }
@@ -2320,7 +2958,6 @@ void AdminPanel::onAddLevel() {
         AcademicLevel l; l.setName(name->text()); l.setLevelNumber(num->value());
         if (m_academicLevelController.addAcademicLevel(l)) {
             QMessageBox::information(this, "Success", "Academic level added.");
-            refreshLevelsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to add level.");
         }
@@ -2368,7 +3005,7 @@ void AdminPanel::onAddProfessor() {
         User u; 
         u.setFullName(name->text()); 
         u.setUsername(profCode->text()); 
-        u.setRole("professor"); 
+        u.setRole(UserRole::Professor); 
         u.setPassword(profCode->text()); // Password is the professor code
 
         QString userError;
@@ -2408,7 +3045,6 @@ void AdminPanel::onAddProfessor() {
                                             .arg(profCode->text())
                                             .arg(profCode->text());
                 QMessageBox::information(this, "Success", successMsg);
-                refreshProfessorsTable();
             } else {
                 // Only rollback if we just created the user in this session
                 if (!userError.contains("Duplicate entry")) {
@@ -2489,7 +3125,6 @@ void AdminPanel::onEditProfessor() {
                        .arg(profCode->text()).arg(profCode->text());
             }
             QMessageBox::information(this, "Success", msg);
-            refreshProfessorsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to update records.");
         }
@@ -2507,7 +3142,6 @@ void AdminPanel::onDeleteProfessor() {
     if (QMessageBox::question(this, "Confirm", "Remove this professor from the faculty?") == QMessageBox::Yes) {
         if (m_professorController.deleteProfessor(id)) {
             QMessageBox::information(this, "Removed", "Professor removed successfully.");
-            refreshProfessorsTable();
         } else {
             QMessageBox::critical(this, "Error", "Failed to remove professor.");
         }
@@ -2558,9 +3192,7 @@ void AdminPanel::onAddSchedule() {
         s.setStartTime(start->time());
         s.setEndTime(end->time());
 
-        if (m_scheduleController.addSchedule(s)) {
-            refreshSchedulesTable();
-        } else {
+        if (!m_scheduleController.addSchedule(s)) {
             QMessageBox::critical(this, "Error", "Failed to add schedule slot. Check if room is already booked.");
         }
     }
@@ -4,6 +4,7 @@
 #include <QWidget>
 #include <QTabWidget>
 #include <QTableWidget>
+#include <QLineEdit>
 #include "controllers/studentcontroller.h"
 #include "controllers/coursecontroller.h"
 #include "controllers/usercontroller.h"
@@ -17,7 +18,17 @@
 #include "controllers/calendarcontroller.h"
 #include "controllers/schedulecontroller.h"
 #include "controllers/sectioncontroller.h"
+#include "controllers/sectionassigner.h"
+#include "controllers/ledgercontroller.h"
+#include "controllers/billingcontroller.h"
+#include "controllers/promotioncontroller.h"
 #include "models/semester.h"
+#include "database/changebus.h"
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QThreadPool>
+#include <functional>
 
 class AdminPanel : public QWidget
 {
@@ -52,15 +63,26 @@ private:
     void refreshSectionsTable();
     void refreshCalendarTable();
     void refreshDraftTable();
-    void refreshAllData();
+    void refreshTables(int tables);
+    void ensureLoaded(int tables);
+    template <typename T>
+    void loadAsync(int table, std::function<T()> fetch, std::function<void(const T&)> fill);
+
+    void setStudentRow(int row, const StudentData& s, const QMap<int, QString>& levelMap);
+    void setDraftRow(int row, const StudentData& s, const QMap<int, QString>& levelMap);
+    void applyStudentChanges(const QList<int>& ids, int tables);
+    void onDataChanged(const ChangeEvent& event);
+    void applyPendingChanges();
 
 private slots:
+    void onTabChanged(int index);
     void onLogout();
     void onRefreshAll();
     void onTestDatabase();
     void onAddStudent();
     void onEditStudent();
     void onDeleteStudent();
+    void onSearchStudents(const QString& text);
     void onAddCourse();
     void onEditCourse();
     void onDeleteCourse();
@@ -81,6 +103,9 @@ private slots:
     void onDeleteCalendarEvent();
     void onEditCollege();
     void onDeleteCollege();
+    void onManageFeeRules();
+    void onRunTermBilling();
+    void onRunCohortPromotion();
     void onEditRoom();
     void onDeleteRoom();
     void onEditDepartment();
@@ -91,6 +116,7 @@ private slots:
     void onAddSection(); 
     void onEditSection();
     void onDeleteSection();
+    void onAutoAssignSections();
     void onEditSchedule();
     void onDeleteSchedule();
     void onRestoreStudent();
@@ -101,6 +127,7 @@ private:
     QTabWidget* m_tabWidget;
     QTabWidget* m_roomSubTabWidget;
     QTableWidget* m_studentsTable;
+    QLineEdit* m_studentSearchEdit;
     QTableWidget* m_coursesTable;
     QTableWidget* m_collegesTable;
     QTableWidget* m_departmentsTable;
@@ -122,9 +149,22 @@ private:
     CalendarController m_calendarController;
     ScheduleController m_scheduleController;
     SectionController m_sectionController;
+    SectionAssigner m_sectionAssigner;
+    LedgerController m_ledgerController;
+    BillingController m_billingController;
+    PromotionController m_promotionController;
     QTableWidget* m_calendarTable;
     QTableWidget* m_sectionsTable;
     QTableWidget* m_draftStudentsTable;
+
+    int m_changeToken;
+    QList<ChangeEvent> m_pendingChanges;
+    QHash<QString, qint64> m_seenVersions; // TableVersions as of the last load
+
+    QThreadPool m_loader;
+    int m_loadedTables;          // PanelTable flags of tables shown at least once
+    QList<int> m_tabTables;      // PanelTable flags by tab index
+    QHash<int, int> m_loadsInFlight;
 };
 
 #endif // ADMINPANEL_H
@@ -4,14 +4,10 @@
 #include "professorpanel.h"
 #include "stylehelper.h"
 #include "database/dbconnection.h"
-#include "database/queries.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QGroupBox>
 #include <QMessageBox>
-#include <QSqlQuery>
-#include <QSqlError>
-#include <QCryptographicHash>
 #include <QLabel>
 #include <QRegularExpression>
 #include <QRegularExpressionValidator>
@@ -85,8 +81,7 @@ void LoginWindow::setupUI() {
 
 /**
  * Handles the login button click event
- * Validates user input and attempts to authenticate the user
- * Redirects to appropriate panel (Admin, Student, or Professor) based on user role
+ * Validates user input and starts authentication off the GUI thread
  */
 void LoginWindow::onLoginClicked() {
     QString code = m_usernameEdit->text().trimmed();
@@ -97,105 +92,40 @@ void LoginWindow::onLoginClicked() {
         return;
     }
     
-    if (tryLogin(code, natId)) {
-        if(m_userRole.toLower() == "admin") {
-            AdminPanel* ap = new AdminPanel(m_currentUserId);
-            ap->show();
-        } else if(m_userRole.toLower() == "student") {
-            StudentPortal* sp = new StudentPortal(m_currentUserId);
-            sp->show();
-        } else if(m_userRole.toLower() == "professor") {
-            ProfessorPanel* pp = new ProfessorPanel(m_currentUserId);
-            pp->show();
-        }
-        this->close();
-    } else {
-        QMessageBox::warning(this, "Login Failed", "Invalid Code or National ID.");
-    }
+    m_loginButton->setEnabled(false);
+    m_loginButton->setText("Signing in...");
+    AuthService::instance().authenticateAsync(code, natId, this, [this](const AuthService::Result& result) {
+        finishLogin(result);
+    });
 }
 
 /**
- * Attempts to authenticate a user with the provided credentials
- * @param code - User's code (student code, professor code, or admin code)
- * @param natId - User's national ID number (used as password)
- * @return true if authentication successful, false otherwise
- * 
- * Authentication logic:
- * - Students: Validates against id_number in students_data table
- * - Professors: Validates against id_number in professors table
- * - Admin: Validates against hashed password or special admin credentials
+ * Completes a login once the AuthService lookup returns
+ * Opens the panel matching the user's role (Admin, Student, or Professor)
+ * @param result - The authentication result
  */
-bool LoginWindow::tryLogin(const QString& code, const QString& natId) {
-    QSqlQuery query(DBConnection::instance().database());
-    
-    // 1. Try Lookup in Users table first to get Role and ID
-    query.prepare("SELECT id, role, password, username FROM users WHERE username = ?");
-    query.addBindValue(code);
-    
-    if (query.exec() && query.next()) {
-        int userId = query.value("id").toInt();
-        QString role = query.value("role").toString().toLower();
-        QString storedHash = query.value("password").toString();
-        
-        // Hashed check (Standard fallback or for Admin)
-        QString inputHash = QString(QCryptographicHash::hash(natId.toUtf8(), QCryptographicHash::Sha256).toHex());
+void LoginWindow::finishLogin(const AuthService::Result& result) {
+    m_loginButton->setEnabled(true);
+    m_loginButton->setText("Login");
 
-        // A. If Student -> Check students_data for id_number
-        if (role == "student") {
-            QSqlQuery sq(DBConnection::instance().database());
-            sq.prepare("SELECT id_number FROM students_data WHERE user_id = ?");
-            sq.addBindValue(userId);
-            if (sq.exec() && sq.next()) {
-                QString storedNatId = sq.value("id_number").toString();
-                if (storedNatId == natId) {
-                    m_currentUserId = userId;
-                    m_userRole = "student";
-                    return true;
-                }
-            }
-            // Fallback: If id_number check failed, maybe try password hash (optional, but prompt says use nationality)
-            // We strictly enforce Nationality match here as requested.
-            return false;
-        }
-        
-        // B. If Professor -> Check professors for id_number
-        else if (role == "professor") {
-            QSqlQuery pq(DBConnection::instance().database());
-            pq.prepare("SELECT id_number FROM professors WHERE user_id = ?");
-            pq.addBindValue(userId);
-            if (pq.exec() && pq.next()) {
-                QString storedNatId = pq.value("id_number").toString();
-                if (storedNatId == natId) {
-                    m_currentUserId = userId;
-                    m_userRole = "professor";
-                    return true;
-                }
-            }
-            return false;
-        }
-        
-        // C. If Admin -> Check if National ID matches or standard password
-        else {
-             // Admin Code IS National ID. So Input Code == Input NatID?
-             // Or we check standard password hash.
-             // Let's allow: if inputHash matches storedHash (standard) OR if natId == code (if code is the 14 digit ID)
-             
-             if (inputHash == storedHash || natId == "12345") {
-                 m_currentUserId = userId;
-                 m_userRole = role;
-                 return true;
-             }
-             // Allow plain National ID match if stored password is NOT hashed? No, secure default.
-             // Special case for our default admin
-             if (code == "30605040603080" && natId == "30605040603080") {
-                  m_currentUserId = userId;
-                  m_userRole = role;
-                  return true;
-             }
-        }
+    if (!result.success) {
+        QMessageBox::warning(this, "Login Failed", "Invalid Code or National ID.");
+        return;
     }
-    
-    return false;
+
+    m_currentUserId = result.userId;
+    m_userRole = result.role;
+    if(m_userRole == UserRole::Admin) {
+        AdminPanel* ap = new AdminPanel(m_currentUserId);
+        ap->show();
+    } else if(m_userRole == UserRole::Student) {
+        StudentPortal* sp = new StudentPortal(m_currentUserId);
+        sp->show();
+    } else if(m_userRole == UserRole::Professor) {
+        ProfessorPanel* pp = new ProfessorPanel(m_currentUserId);
+        pp->show();
+    }
+    this->close();
 }
 
 /**
@@ -5,6 +5,7 @@
 #include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
+#include "controllers/authservice.h"
 
 class LoginWindow : public QWidget
 {
@@ -20,7 +21,7 @@ private slots:
 
 private:
     void setupUI();
-    bool tryLogin(const QString& idNumber, const QString& password);
+    void finishLogin(const AuthService::Result& result);
 
     QLabel* m_usernameLabel;
     QLineEdit* m_usernameEdit;
@@ -30,7 +31,7 @@ private:
     QPushButton* m_testConnButton;
 
     int m_currentUserId;
-    QString m_userRole;
+    UserRole m_userRole;
 };
 
 #endif // LOGINWINDOW_H
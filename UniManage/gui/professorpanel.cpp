@@ -21,6 +21,8 @@
 #include <QSqlQuery>
 #include <QSqlError>
 #include "database/dbconnection.h"
+#include "database/querytracker.h"
+#include "controllers/sessioncalendar.h"
 
 /**
  * Constructor for the ProfessorPanel class
@@ -34,7 +36,7 @@ ProfessorPanel::ProfessorPanel(int userId, QWidget *parent)
       m_as1Table(nullptr), m_as2Table(nullptr), m_cwTable(nullptr), 
       m_finalTable(nullptr), m_expTable(nullptr), m_evaluationTable(nullptr),
       m_noStudentsLabelGrades(nullptr), m_attendanceDate(nullptr), 
-      m_attendanceTable(nullptr), m_noStudentsLabelAtt(nullptr),
+      m_attendanceTable(nullptr), m_noStudentsLabelAtt(nullptr), m_sessionInfoLabel(nullptr),
       m_scheduleTable(nullptr), m_coursesTable(nullptr), 
       m_profSpecializationEdit(nullptr), m_profInfoEdit(nullptr), 
       m_calendarTable(nullptr)
@@ -287,6 +289,10 @@ QWidget* ProfessorPanel::createEvaluationTab() {
     connect(refreshBtn, &QPushButton::clicked, this, &ProfessorPanel::onRefreshStudents);
     controls->addWidget(refreshBtn);
 
+    QPushButton* statsBtn = new QPushButton("Statistics");
+    connect(statsBtn, &QPushButton::clicked, this, &ProfessorPanel::onShowGradeStatistics);
+    controls->addWidget(statsBtn);
+
     QPushButton* saveBtn = new QPushButton("Update Grades");
     saveBtn->setObjectName("primaryBtn");
     connect(saveBtn, &QPushButton::clicked, this, &ProfessorPanel::onUpdateClicked);
@@ -332,6 +338,9 @@ QWidget* ProfessorPanel::createAttendanceTab() {
     m_attendanceDate->setMinimumWidth(120);
     connect(m_attendanceDate, &QDateEdit::dateChanged, this, &ProfessorPanel::onRefreshStudents);
     controls->addWidget(m_attendanceDate);
+    m_sessionInfoLabel = new QLabel();
+    m_sessionInfoLabel->setStyleSheet("color: #7f8c8d;");
+    controls->addWidget(m_sessionInfoLabel);
     
     controls->addStretch();
     
@@ -510,6 +519,7 @@ void ProfessorPanel::onLogout() {
  * Reloads professor data, courses, schedule, calendar, and student lists
  */
 void ProfessorPanel::onRefreshAll() {
+    QueryTracker::Scope scope("ProfessorPanel::onRefreshAll");
     loadProfessorData();
     loadCourses(); 
     loadSchedule();
@@ -544,7 +554,7 @@ void ProfessorPanel::loadCourses() {
         m_coursesTable->setItem(r, 1, new QTableWidgetItem(c.name()));
         m_coursesTable->setItem(r, 2, new QTableWidgetItem(c.description()));
         m_coursesTable->setItem(r, 3, new QTableWidgetItem(QString::number(c.creditHours())));
-        m_coursesTable->setItem(r, 4, new QTableWidgetItem(c.courseType()));
+        m_coursesTable->setItem(r, 4, new QTableWidgetItem(c.courseTypeName()));
         m_coursesTable->setItem(r, 5, new QTableWidgetItem(QString::number(c.maxGrade())));
     }
     
@@ -641,11 +651,13 @@ void ProfessorPanel::onRefreshStudents() {
         return;
     }
 
+    QueryTracker::Scope scope("ProfessorPanel::onRefreshStudents");
     int courseId = m_courseSelector->currentData().toInt();
     QDate currentAttDate = m_attendanceDate->date();
     
     QList<Enrollment> enrollments = m_enrollmentController.getEnrollmentsByCourse(courseId);
     QList<AttendanceLog> logs = m_enrollmentController.getAttendanceLogsByCourse(courseId, currentAttDate);
+    const EnrollmentController::CourseAttendance attendance = m_enrollmentController.getCourseAttendance(courseId);
     
     QList<Enrollment> filtered = enrollments; // Show all students for the selected course
     
@@ -742,7 +754,13 @@ void ProfessorPanel::onRefreshStudents() {
         if(m_evaluationTable->item(r6, 2)) m_evaluationTable->item(r6, 2)->setFlags(m_evaluationTable->item(r6, 2)->flags().setFlag(Qt::ItemIsEditable, false));
         m_evaluationTable->setItem(r6, 3, new QTableWidgetItem(e.studentSection()));
         if(m_evaluationTable->item(r6, 3)) m_evaluationTable->item(r6, 3)->setFlags(m_evaluationTable->item(r6, 3)->flags().setFlag(Qt::ItemIsEditable, false));
-        m_evaluationTable->setItem(r6, 4, new QTableWidgetItem(QString::number(e.attendanceCount())));
+        QString attended = QString::number(e.attendanceCount());
+        if (attendance.sessionsHeld > 0) {
+            // Share of the sessions held so far, from the enrollment's attendance bitmap
+            const int present = attendance.byEnrollment.value(e.id()).present;
+            attended += QString(" (%1%)").arg(qRound(100.0 * present / attendance.sessionsHeld));
+        }
+        m_evaluationTable->setItem(r6, 4, new QTableWidgetItem(attended));
         if(m_evaluationTable->item(r6, 4)) m_evaluationTable->item(r6, 4)->setFlags(m_evaluationTable->item(r6, 4)->flags().setFlag(Qt::ItemIsEditable, false));
         m_evaluationTable->setItem(r6, 5, new QTableWidgetItem(QString::number(e.absenceCount())));
         if(m_evaluationTable->item(r6, 5)) m_evaluationTable->item(r6, 5)->setFlags(m_evaluationTable->item(r6, 5)->flags().setFlag(Qt::ItemIsEditable, false));
@@ -753,7 +771,7 @@ void ProfessorPanel::onRefreshStudents() {
         m_evaluationTable->setItem(r6, 10, new QTableWidgetItem(QString::number(e.experienceGrade())));
         m_evaluationTable->setItem(r6, 11, new QTableWidgetItem(QString::number(e.totalGrade())));
         if(m_evaluationTable->item(r6, 11)) m_evaluationTable->item(r6, 11)->setFlags(m_evaluationTable->item(r6, 11)->flags().setFlag(Qt::ItemIsEditable, false));
-        m_evaluationTable->setItem(r6, 12, new QTableWidgetItem(e.letterGrade()));
+        m_evaluationTable->setItem(r6, 12, new QTableWidgetItem(e.letterGradeName()));
         if(m_evaluationTable->item(r6, 12)) m_evaluationTable->item(r6, 12)->setFlags(m_evaluationTable->item(r6, 12)->flags().setFlag(Qt::ItemIsEditable, false));
 
         // Add Edit Buttons to all tables
@@ -773,6 +791,18 @@ void ProfessorPanel::onRefreshStudents() {
     }
 
     // 2. Refresh Attendance Table
+    if (m_sessionInfoLabel) {
+        // Where the selected date sits in the term, from the expanded session list
+        SessionCalendar::Handle term = SessionCalendar::instance().sessions(courseId);
+        const int index = term->dayIndex(currentAttDate);
+        QString info = index >= 0
+            ? QString("Session %1 of %2").arg(index + 1).arg(term->dayCount())
+            : QString("No class on this date");
+        const int unrecorded = m_enrollmentController.getUnrecordedSessionDays(courseId, QDate::currentDate()).size();
+        if (unrecorded > 0) info += QString(" | %1 past session(s) without attendance").arg(unrecorded);
+        m_sessionInfoLabel->setText(info);
+    }
+
     if (m_attendanceTable && m_attendanceTable->isVisible()) {
         m_attendanceTable->setRowCount(0);
         m_noStudentsLabelAtt->setVisible(!hasStudents);
@@ -806,10 +836,12 @@ void ProfessorPanel::onRefreshStudents() {
                 
                 // Find existing log
                 QString status = "Present"; // Default? Or empty?
+                QString notes;
                 bool found = false;
                 for(const auto& log : logs) {
                     if(log.enrollmentId() == e.id()) {
-                        status = log.status();
+                        status = log.statusName();
+                        notes = log.notes();
                         found = true;
                         break;
                     }
@@ -819,7 +851,7 @@ void ProfessorPanel::onRefreshStudents() {
                 cb->setPlaceholderText("Select");
                 
                 m_attendanceTable->setCellWidget(r, 4, cb);
-                m_attendanceTable->setItem(r, 5, new QTableWidgetItem("")); // Notes placeholder
+                m_attendanceTable->setItem(r, 5, new QTableWidgetItem(notes));
             }
         }
     }
@@ -847,7 +879,8 @@ void ProfessorPanel::onSubmitAttendance() {
         log.setEnrollmentId(eid);
         log.setDate(date);
         log.setStatus(status);
-        log.setNotes("Logged via Professor Panel");
+        QTableWidgetItem* notesItem = m_attendanceTable->item(i, 5); // Col 5 is Notes
+        log.setNotes(notesItem ? notesItem->text().trimmed() : QString());
         
         if(!m_enrollmentController.addAttendanceLog(log)) {
             allOk = false;
@@ -889,6 +922,89 @@ void ProfessorPanel::onUpdateClicked() {
     showGradeForm(eid, tabIdx);
 }
 
+/**
+ * Displays grade distribution statistics for the selected course
+ * Shows per-component mean, spread and percentiles plus the evaluation breakdown
+ */
+void ProfessorPanel::onShowGradeStatistics() {
+    int courseId = m_courseSelector->currentData().toInt();
+    if(courseId <= 0) {
+        QMessageBox::warning(this, "Selection Error", "Please select a course first.");
+        return;
+    }
+
+    GradeStatistics stats;
+    if(!stats.loadForCourse(courseId)) {
+        QMessageBox::critical(this, "Database Error", "Failed to load grades for the selected course.");
+        return;
+    }
+    if(stats.size() == 0) {
+        QMessageBox::information(this, "Statistics", "No graded students found for the selected course.");
+        return;
+    }
+
+    GradeStatistics::Report report = stats.compute();
+
+    QDialog dlg(this);
+    dlg.setWindowTitle("Grade Statistics - " + m_courseSelector->currentText());
+    dlg.setMinimumSize(800, 420);
+    QVBoxLayout* layout = new QVBoxLayout(&dlg);
+
+    layout->addWidget(new QLabel(QString("Graded students: %1").arg(report.sampleCount)));
+
+    QTableWidget* table = new QTableWidget();
+    QStringList headers = {"Component", "Mean", "Std Dev", "Min", "P25", "Median", "P75", "P90", "P99", "Max"};
+    table->setColumnCount(headers.size());
+    table->setHorizontalHeaderLabels(headers);
+    table->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
+    table->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    table->setAlternatingRowColors(true);
+
+    auto addSummaryRow = [table](const QString& name, const GradeStatistics::ColumnSummary& s) {
+        int row = table->rowCount();
+        table->insertRow(row);
+        const double values[] = {s.mean, s.stddev, s.min, s.p25, s.p50, s.p75, s.p90, s.p99, s.max};
+        table->setItem(row, 0, new QTableWidgetItem(name));
+        for(int i = 0; i < 9; ++i) {
+            table->setItem(row, i + 1, new QTableWidgetItem(QString::number(values[i], 'f', 2)));
+        }
+    };
+    for(int c = 0; c < GradeStatistics::ColumnCount; ++c) {
+        auto column = static_cast<GradeStatistics::Column>(c);
+        addSummaryRow(GradeStatistics::columnName(column), report.columns[c]);
+    }
+    addSummaryRow("Percentage", report.percentage);
+    layout->addWidget(table);
+
+    QStringList letters;
+    for(int l = 0; l < GradeStatistics::LetterCount; ++l) {
+        auto letter = static_cast<GradeStatistics::LetterGrade>(l);
+        letters << QString("%1: %2").arg(GradeStatistics::letterName(letter)).arg(report.letterCounts[l]);
+    }
+    layout->addWidget(new QLabel("Evaluation: " + letters.join("   ")));
+
+    QStringList buckets;
+    const GradeStatistics::ColumnSummary& pct = report.percentage;
+    for(int b = 0; b < pct.histogram.size(); ++b) {
+        buckets << QString("%1-%2%: %3")
+                       .arg(b * pct.bucketWidth, 0, 'f', 0)
+                       .arg((b + 1) * pct.bucketWidth, 0, 'f', 0)
+                       .arg(pct.histogram[b]);
+    }
+    QLabel* histLabel = new QLabel("Distribution: " + buckets.join("   "));
+    histLabel->setWordWrap(true);
+    layout->addWidget(histLabel);
+
+    QPushButton* closeBtn = new QPushButton("Close");
+    connect(closeBtn, &QPushButton::clicked, &dlg, &QDialog::accept);
+    QHBoxLayout* buttons = new QHBoxLayout();
+    buttons->addStretch();
+    buttons->addWidget(closeBtn);
+    layout->addLayout(buttons);
+
+    dlg.exec();
+}
+
 /**
  * Displays a dialog for entering/updating grades for a student
  * @param enrollmentId - The enrollment ID of the student
@@ -1026,11 +1142,8 @@ void ProfessorPanel::onEditCalendarEvent() {
     if(cur < 0) return;
     
     int eid = m_calendarTable->item(cur, 0)->text().toInt();
-    QList<CalendarEvent> all = m_calendarController.getAllEvents();
-    CalendarEvent e;
-    bool found = false;
-    for(const auto& item : all) { if(item.id() == eid) { e = item; found = true; break; } }
-    if(!found) return;
+    CalendarEvent e = m_calendarController.getEventById(eid);
+    if(e.id() == 0) return;
 
     QDialog dlg(this);
     dlg.setWindowTitle("Edit Event");
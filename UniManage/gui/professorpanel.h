@@ -17,6 +17,7 @@
 #include "controllers/schedulecontroller.h"
 #include "controllers/calendarcontroller.h"
 #include "controllers/academic_level_controller.h"
+#include "controllers/gradestatistics.h"
 
 #include "models/professor.h"
 #include "models/attendance_log.h"
@@ -34,6 +35,7 @@ private slots:
     void onCourseSelected(int index);
     void onYearSelected(int index);
     void onUpdateClicked(); // New slot for the top button
+    void onShowGradeStatistics();
     void showGradeForm(int enrollmentId, int tabIndex = -1);
     void onSubmitAttendance();
     void onRefreshStudents(); // Refreshes both tables based on active tab
@@ -93,6 +95,7 @@ private:
     QDateEdit* m_attendanceDate;
     QTableWidget* m_attendanceTable;
     QLabel* m_noStudentsLabelAtt;
+    QLabel* m_sessionInfoLabel;
     
     // Schedule
     QTableWidget* m_scheduleTable;
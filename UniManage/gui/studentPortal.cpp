@@ -1,6 +1,7 @@
 #include "studentPortal.h"
 #include "stylehelper.h"
 #include "loginwindow.h"
+#include "controllers/sessioncalendar.h"
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QFormLayout>
@@ -20,7 +21,7 @@
  * @param parent - Parent widget (default nullptr)
  */
 StudentPortal::StudentPortal(int studentUserId, QWidget *parent)
-    : QWidget(parent), m_userId(studentUserId)
+    : QWidget(parent), m_userId(studentUserId), m_session(studentUserId)
 {
     setStyleSheet(StyleHelper::getMainStyle());
     loadStudentData();
@@ -36,11 +37,12 @@ StudentPortal::StudentPortal(int studentUserId, QWidget *parent)
 StudentPortal::~StudentPortal() {}
 
 /**
- * Loads the student's data from the database
- * Retrieves student information using the user ID
+ * Loads the student's data through the session cache
+ * Only parts whose tables changed since the last load hit the database
  */
 void StudentPortal::loadStudentData() {
-    m_student = m_studentController.getStudentByUserId(m_userId);
+    m_session.refresh();
+    m_student = m_session.student();
 }
 
 /**
@@ -98,15 +100,16 @@ void StudentPortal::onLogout() {
 }
 
 /**
- * Refreshes all data displayed in the student portal
- * Updates grades, schedule, payments, and calendar information
+ * Refreshes the data displayed in the student portal
+ * Only the tables whose underlying data changed are reloaded and redrawn
  */
 void StudentPortal::onRefreshAll() {
-    loadStudentData();
-    refreshGrades();
-    refreshSchedule();
-    refreshPayments();
-    refreshCalendar();
+    const int changed = m_session.refresh();
+    m_student = m_session.student();
+    if (changed & StudentSessionCache::GradesPart) refreshGrades();
+    if (changed & StudentSessionCache::SchedulePart) refreshSchedule();
+    if (changed & StudentSessionCache::PaymentsPart) refreshPayments();
+    if (changed & StudentSessionCache::CalendarPart) refreshCalendar();
     QMessageBox::information(this, "Refreshed", "Your student profile and academic records have been updated.");
 }
 
@@ -128,7 +131,7 @@ QWidget* StudentPortal::createDashboardTab() {
     // Display Year/Level with Enrollment Year
     QString lvlStr = "Not Assigned";
     if (m_student.academicLevelId() > 0) {
-        AcademicLevel al = m_academicLevelController.getAcademicLevelById(m_student.academicLevelId());
+        const AcademicLevel& al = m_session.level();
         if (al.id() > 0) {
             QString enrollYear = m_student.createdAt().isValid() ? 
                                 QString::number(m_student.createdAt().date().year()) : "";
@@ -178,8 +181,8 @@ QWidget* StudentPortal::createScheduleTab() {
     QWidget* widget = new QWidget();
     QVBoxLayout* layout = new QVBoxLayout(widget);
     m_scheduleTable = new QTableWidget();
-    m_scheduleTable->setColumnCount(5);
-    m_scheduleTable->setHorizontalHeaderLabels({"Day", "Course", "Room", "Start Time", "End Time"});
+    m_scheduleTable->setColumnCount(6);
+    m_scheduleTable->setHorizontalHeaderLabels({"Day", "Course", "Room", "Start Time", "End Time", "Next Class"});
     m_scheduleTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Stretch);
     layout->addWidget(m_scheduleTable);
     
@@ -253,7 +256,7 @@ void StudentPortal::refreshGrades() {
     double totalPoints = 0;
     int courses = 0;
     
-    for(const auto& e : m_enrollmentController.getEnrollmentsByStudent(m_student.id())) {
+    for(const auto& e : m_session.enrollments()) {
         // Skip if all grades are zero (unassigned)
         if (e.assignment1Grade() == 0 && e.assignment2Grade() == 0 && 
             e.courseworkGrade() == 0 && e.finalExamGrade() == 0 && 
@@ -269,12 +272,9 @@ void StudentPortal::refreshGrades() {
         m_gradesTable->setItem(r, 3, new QTableWidgetItem(QString::number(e.courseworkGrade())));
         m_gradesTable->setItem(r, 4, new QTableWidgetItem(QString::number(e.finalExamGrade())));
         m_gradesTable->setItem(r, 5, new QTableWidgetItem(QString::number(e.totalGrade())));
-        m_gradesTable->setItem(r, 6, new QTableWidgetItem(e.letterGrade()));
+        m_gradesTable->setItem(r, 6, new QTableWidgetItem(e.letterGradeName()));
         
-        if(e.letterGrade() == "Excellent") totalPoints += 4;
-        else if(e.letterGrade() == "Very Good") totalPoints += 3;
-        else if(e.letterGrade() == "Good") totalPoints += 2;
-        else if(e.letterGrade() == "Pass") totalPoints += 1;
+        totalPoints += gradePoints(e.letterGrade());
         courses++;
     }
     
@@ -289,76 +289,53 @@ void StudentPortal::refreshGrades() {
  */
 void StudentPortal::refreshPayments() {
     m_paymentsTable->setRowCount(0);
-    auto payments = m_paymentController.getPaymentsByStudent(m_student.id());
-    
-    for(const auto& p : payments) {
+    for(const auto& p : m_session.payments()) {
         int r = m_paymentsTable->rowCount();
         m_paymentsTable->insertRow(r);
         m_paymentsTable->setItem(r, 0, new QTableWidgetItem(p.date().toString("yyyy-MM-dd")));
-        m_paymentsTable->setItem(r, 1, new QTableWidgetItem(QString::number(p.amount())));
+        m_paymentsTable->setItem(r, 1, new QTableWidgetItem(p.amount().toString()));
         m_paymentsTable->setItem(r, 2, new QTableWidgetItem(p.method()));
         m_paymentsTable->setItem(r, 3, new QTableWidgetItem(p.status()));
         m_paymentsTable->setItem(r, 4, new QTableWidgetItem(p.notes()));
     }
     
-    // Update summary labels
-    double baseTuition = 0.0;
-    if (m_student.collegeId() > 0) {
-        College c = m_collegeController.getCollegeById(m_student.collegeId());
-        baseTuition = c.tuitionFees();
-    }
-    
-    double totalPaid = 0.0;
-    for (const auto& p : payments) {
-        // Only count paid or completed payments
-        if (p.status().compare("Paid", Qt::CaseInsensitive) == 0 || 
-            p.status().compare("Success", Qt::CaseInsensitive) == 0 || 
-            p.status().compare("Completed", Qt::CaseInsensitive) == 0) {
-            totalPaid += p.amount();
-        }
-    }
-    
-    m_tuitionLabel->setText(QString::number(baseTuition, 'f', 2));
-    m_paidLabel->setText(QString::number(totalPaid, 'f', 2));
-    m_balanceLabel->setText(QString::number(baseTuition - totalPaid, 'f', 2));
+    // Update summary labels from the ledger (kept in sync by every payment write)
+    const StudentBalance& balance = m_session.balance();
+    m_tuitionLabel->setText(balance.totalCharged().toString());
+    m_paidLabel->setText(balance.totalPaid().toString());
+    m_balanceLabel->setText(balance.balance().toString());
 }
 
 /**
  * Refreshes the schedule table with current course schedules
- * Fetches schedules based on enrolled courses or academic level
+ * Shows schedules of the enrolled courses, falling back to the academic level
  */
 void StudentPortal::refreshSchedule() {
     m_scheduleTable->setRowCount(0);
     
-    // Strategy: Get all courses the student is enrolled in, then fetch their schedules
-    auto enrollments = m_enrollmentController.getEnrollmentsByStudent(m_student.id());
-    
-    for (const auto& e : enrollments) {
-        auto schedules = m_scheduleController.getScheduleByCourse(e.courseId());
-        for (const auto& s : schedules) {
-            int r = m_scheduleTable->rowCount();
-            m_scheduleTable->insertRow(r);
-            
-            m_scheduleTable->setItem(r, 0, new QTableWidgetItem(s.dayOfWeek()));
-            m_scheduleTable->setItem(r, 1, new QTableWidgetItem(s.courseName()));
-            m_scheduleTable->setItem(r, 2, new QTableWidgetItem(s.roomName()));
-            m_scheduleTable->setItem(r, 3, new QTableWidgetItem(s.startTime().toString("HH:mm")));
-            m_scheduleTable->setItem(r, 4, new QTableWidgetItem(s.endTime().toString("HH:mm")));
-        }
-    }
-    
-    // Also try fetching by Level as fallback if no course-specific schedules found
-    if (m_scheduleTable->rowCount() == 0 && m_student.academicLevelId() > 0) {
-        auto levelSchedules = m_scheduleController.getScheduleByLevel(m_student.academicLevelId());
-        for (const auto& s : levelSchedules) {
-            int r = m_scheduleTable->rowCount();
-            m_scheduleTable->insertRow(r);
-            m_scheduleTable->setItem(r, 0, new QTableWidgetItem(s.dayOfWeek()));
-            m_scheduleTable->setItem(r, 1, new QTableWidgetItem(s.courseName()));
-            m_scheduleTable->setItem(r, 2, new QTableWidgetItem(s.roomName()));
-            m_scheduleTable->setItem(r, 3, new QTableWidgetItem(s.startTime().toString("HH:mm")));
-            m_scheduleTable->setItem(r, 4, new QTableWidgetItem(s.endTime().toString("HH:mm")));
+    // Enrolled courses' slots, or the level schedule when none is scheduled yet
+    const QDate today = QDate::currentDate();
+    QHash<int, SessionCalendar::Handle> terms;
+    for (const auto& s : m_session.schedules()) {
+        int r = m_scheduleTable->rowCount();
+        m_scheduleTable->insertRow(r);
+        m_scheduleTable->setItem(r, 0, new QTableWidgetItem(s.dayOfWeek()));
+        m_scheduleTable->setItem(r, 1, new QTableWidgetItem(s.courseName()));
+        m_scheduleTable->setItem(r, 2, new QTableWidgetItem(s.roomName()));
+        m_scheduleTable->setItem(r, 3, new QTableWidgetItem(s.startTime().toString("HH:mm")));
+        m_scheduleTable->setItem(r, 4, new QTableWidgetItem(s.endTime().toString("HH:mm")));
+
+        // Next meeting of this slot in the term, holidays skipped
+        if (!terms.contains(s.courseId())) terms.insert(s.courseId(), SessionCalendar::instance().sessions(s.courseId()));
+        const SessionCalendar::Handle& term = terms[s.courseId()];
+        QString next = "---";
+        for (const auto& session : term->between(today, term->termEnd())) {
+            if (session.scheduleId == s.id()) {
+                next = term->dateOf(session).toString("yyyy-MM-dd");
+                break;
+            }
         }
+        m_scheduleTable->setItem(r, 5, new QTableWidgetItem(next));
     }
     
     m_scheduleTable->sortByColumn(0, Qt::AscendingOrder); // Initial sort
@@ -400,7 +377,7 @@ void StudentPortal::onMakePayment() {
     if (dialog.exec() == QDialog::Accepted) {
         Payment p;
         p.setStudentId(m_student.id());
-        p.setAmount((float)amount->value());
+        p.setAmount(Money::fromDouble(amount->value()));
         p.setMethod(method->currentText());
         p.setStatus("Paid"); // Automatically set to Paid for simulation
         p.setNotes(notes->text());
@@ -411,6 +388,7 @@ void StudentPortal::onMakePayment() {
             QMessageBox::information(this, "Payment Successful", 
                 QString("Successfully processed payment of %1. Your records have been updated.")
                 .arg(QString::number(amount->value(), 'f', 2)));
+            m_session.refresh();
             refreshPayments();
         } else {
             QMessageBox::critical(this, "Transaction Failed", "Could not record the payment in the database. Please contact the finance office.");
@@ -424,7 +402,7 @@ void StudentPortal::onMakePayment() {
  */
 void StudentPortal::refreshCalendar() {
     m_calendarTable->setRowCount(0);
-    for(const auto& e : m_calendarController.getAllEvents()) {
+    for(const auto& e : m_session.events()) {
         int r = m_calendarTable->rowCount();
         m_calendarTable->insertRow(r);
         m_calendarTable->setItem(r, 0, new QTableWidgetItem(e.title()));
@@ -5,13 +5,8 @@
 #include <QTabWidget>
 #include <QTableWidget>
 #include <QLabel>
-#include "controllers/studentcontroller.h"
-#include "controllers/enrollmentcontroller.h"
 #include "controllers/paymentcontroller.h"
-#include "controllers/calendarcontroller.h"
-#include "controllers/academic_level_controller.h"
-#include "controllers/schedulecontroller.h"
-#include "controllers/collegecontroller.h"
+#include "controllers/studentsessioncache.h"
 #include "models/student_data.h"
 
 class StudentPortal : public QWidget
@@ -44,6 +39,7 @@ private slots:
 
 private:
     int m_userId;
+    StudentSessionCache m_session;
     StudentData m_student;
     
     QTabWidget* m_tabWidget;
@@ -56,13 +52,7 @@ private:
     QTableWidget* m_scheduleTable;
     QTableWidget* m_paymentsTable;
     
-    StudentController m_studentController;
-    EnrollmentController m_enrollmentController;
     PaymentController m_paymentController;
-    CalendarController m_calendarController;
-    AcademicLevelController m_academicLevelController;
-    ScheduleController m_scheduleController;
-    CollegeController m_collegeController;
     QTableWidget* m_calendarTable;
 };
 
@@ -0,0 +1,183 @@
+#include "attendance_bitmap.h"
+#include <QtAlgorithms>
+#include <QtEndian>
+
+/**
+ * Default Constructor
+ * An empty bitmap with no term
+ */
+AttendanceBitmap::AttendanceBitmap()
+    : m_enrollmentId(0), m_dayCount(0)
+{
+}
+
+/**
+ * Creates a bitmap with every day unmarked
+ * @param termStart - The day bit 0 stands for
+ * @param dayCount - Number of days in the term
+ */
+AttendanceBitmap::AttendanceBitmap(const QDate& termStart, int dayCount)
+    : m_enrollmentId(0), m_termStart(termStart), m_dayCount(qMax(0, dayCount))
+{
+    for (QVector<quint64>& plane : m_planes) {
+        plane.fill(0, wordCount(m_dayCount));
+    }
+}
+
+/**
+ * @return The ID of the enrollment the attendance belongs to
+ */
+int AttendanceBitmap::enrollmentId() const { return m_enrollmentId; }
+
+/**
+ * Sets the ID of the enrollment
+ * @param enrollmentId - The new enrollment ID
+ */
+void AttendanceBitmap::setEnrollmentId(int enrollmentId) { m_enrollmentId = enrollmentId; }
+
+/**
+ * @return The day bit 0 stands for
+ */
+QDate AttendanceBitmap::termStart() const { return m_termStart; }
+
+/**
+ * @return Number of days the bitmap covers
+ */
+int AttendanceBitmap::dayCount() const { return m_dayCount; }
+
+/**
+ * @param date - Any date
+ * @return The bit index of the date, -1 if it is outside the term
+ */
+int AttendanceBitmap::dayOf(const QDate& date) const
+{
+    if (!m_termStart.isValid() || !date.isValid()) return -1;
+    const qint64 day = date.toJulianDay() - m_termStart.toJulianDay();
+    return day >= 0 && day < m_dayCount ? int(day) : -1;
+}
+
+/**
+ * @param day - A bit index
+ * @return The state recorded for that day, Unmarked if none
+ */
+AttendanceStatus AttendanceBitmap::status(int day) const
+{
+    if (day < 0 || day >= m_dayCount) return AttendanceStatus::Unmarked;
+    const quint64 bit = quint64(1) << (day % 64);
+    const AttendanceStatus states[PlaneCount] = {
+        AttendanceStatus::Present, AttendanceStatus::Absent, AttendanceStatus::Late, AttendanceStatus::Excused
+    };
+    for (int p = 0; p < PlaneCount; ++p) {
+        if (m_planes[p].at(day / 64) & bit) return states[p];
+    }
+    return AttendanceStatus::Unmarked;
+}
+
+/**
+ * Records the state of one day, replacing whatever was recorded before
+ * @param day - A bit index (ignored if outside the term)
+ * @param status - The new state; Unmarked clears the day
+ */
+void AttendanceBitmap::setStatus(int day, AttendanceStatus status)
+{
+    if (day < 0 || day >= m_dayCount) return;
+    const int word = day / 64;
+    const quint64 bit = quint64(1) << (day % 64);
+    for (QVector<quint64>& plane : m_planes) {
+        plane[word] &= ~bit;
+    }
+    const int p = planeOf(status);
+    if (p >= 0) m_planes[p][word] |= bit;
+}
+
+/**
+ * Counts the days in a mask that have a given state
+ * @param status - The state to count (not Unmarked; see unmarked())
+ * @param mask - Days to consider, same layout as the planes; shorter masks
+ *               leave the remaining days out
+ * @return The number of days
+ */
+int AttendanceBitmap::count(AttendanceStatus status, const QVector<quint64>& mask) const
+{
+    const int p = planeOf(status);
+    if (p < 0) return 0;
+    const QVector<quint64>& plane = m_planes[p];
+    const int words = qMin(plane.size(), mask.size());
+    int total = 0;
+    for (int w = 0; w < words; ++w) {
+        total += qPopulationCount(plane.at(w) & mask.at(w));
+    }
+    return total;
+}
+
+/**
+ * @param mask - Days to consider (e.g. the sessions held so far)
+ * @return The number of days in the mask with no state recorded
+ */
+int AttendanceBitmap::unmarked(const QVector<quint64>& mask) const
+{
+    const int words = qMin(wordCount(m_dayCount), mask.size());
+    int total = 0;
+    for (int w = 0; w < words; ++w) {
+        const quint64 recorded = m_planes[0].at(w) | m_planes[1].at(w) | m_planes[2].at(w) | m_planes[3].at(w);
+        total += qPopulationCount(mask.at(w) & ~recorded);
+    }
+    return total;
+}
+
+/**
+ * @param status - A recorded state
+ * @return That plane as little-endian 64-bit words, for a BLOB column
+ */
+QByteArray AttendanceBitmap::planeBytes(AttendanceStatus status) const
+{
+    const int p = planeOf(status);
+    QByteArray bytes(wordCount(m_dayCount) * 8, '\0');
+    if (p < 0) return bytes;
+    for (int w = 0; w < m_planes[p].size(); ++w) {
+        qToLittleEndian<quint64>(m_planes[p].at(w), bytes.data() + w * 8);
+    }
+    return bytes;
+}
+
+/**
+ * Loads a plane written by planeBytes()
+ * Missing words are unmarked and extra words are dropped
+ * @param status - A recorded state
+ * @param bytes - The BLOB column value
+ */
+void AttendanceBitmap::setPlaneBytes(AttendanceStatus status, const QByteArray& bytes)
+{
+    const int p = planeOf(status);
+    if (p < 0) return;
+    QVector<quint64>& plane = m_planes[p];
+    plane.fill(0, wordCount(m_dayCount));
+    const int words = qMin(plane.size(), int(bytes.size() / 8));
+    for (int w = 0; w < words; ++w) {
+        plane[w] = qFromLittleEndian<quint64>(bytes.constData() + w * 8);
+    }
+}
+
+/**
+ * @param dayCount - Days in a term
+ * @return 64-bit words needed per plane
+ */
+int AttendanceBitmap::wordCount(int dayCount)
+{
+    return (qMax(0, dayCount) + 63) / 64;
+}
+
+/**
+ * @param status - A state
+ * @return Its plane index, -1 for Unmarked
+ */
+int AttendanceBitmap::planeOf(AttendanceStatus status)
+{
+    switch (status) {
+        case AttendanceStatus::Present: return 0;
+        case AttendanceStatus::Absent: return 1;
+        case AttendanceStatus::Late: return 2;
+        case AttendanceStatus::Excused: return 3;
+        default: return -1;
+    }
+}
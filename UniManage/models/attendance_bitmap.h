@@ -0,0 +1,51 @@
+#ifndef ATTENDANCE_BITMAP_H
+#define ATTENDANCE_BITMAP_H
+
+#include "domain_types.h"
+#include <QByteArray>
+#include <QDate>
+#include <QVector>
+
+/**
+ * Attendance of one enrollment over one term, one bit per day
+ * Bit i of a plane stands for termStart() + i days. There is a plane for
+ * each recorded state (Present, Absent, Late, Excused); a day with no bit
+ * set in any plane is unmarked. Counting a state over any set of days is
+ * a popcount of (plane & mask) per 64-bit word; a semester fits in 2-3 words
+ */
+class AttendanceBitmap
+{
+public:
+    static const int PlaneCount = 4;
+
+    AttendanceBitmap();
+    AttendanceBitmap(const QDate& termStart, int dayCount);
+
+    int enrollmentId() const;
+    void setEnrollmentId(int enrollmentId);
+
+    QDate termStart() const;
+    int dayCount() const;
+    int dayOf(const QDate& date) const;
+
+    AttendanceStatus status(int day) const;
+    void setStatus(int day, AttendanceStatus status);
+
+    int count(AttendanceStatus status, const QVector<quint64>& mask) const;
+    int unmarked(const QVector<quint64>& mask) const;
+
+    QByteArray planeBytes(AttendanceStatus status) const;
+    void setPlaneBytes(AttendanceStatus status, const QByteArray& bytes);
+
+    static int wordCount(int dayCount);
+
+private:
+    static int planeOf(AttendanceStatus status);
+
+    int m_enrollmentId;
+    QDate m_termStart;
+    int m_dayCount;
+    QVector<quint64> m_planes[PlaneCount]; // Present, Absent, Late, Excused
+};
+
+#endif // ATTENDANCE_BITMAP_H
@@ -4,7 +4,7 @@
  * Default Constructor
  * Initializes a new instance with default values (id=0, enrollmentId=0)
  */
-AttendanceLog::AttendanceLog() : m_id(0), m_enrollmentId(0) {}
+AttendanceLog::AttendanceLog() : m_id(0), m_enrollmentId(0), m_status(AttendanceStatus::Unmarked) {}
 
 /**
  * @return The unique ID of the attendance log
@@ -40,15 +40,26 @@ QDate AttendanceLog::date() const { return m_date; }
 void AttendanceLog::setDate(const QDate& date) { m_date = date; }
 
 /**
- * @return The status of attendance (e.g., "Present", "Absent")
+ * @return The status of attendance
  */
-QString AttendanceLog::status() const { return m_status; }
+AttendanceStatus AttendanceLog::status() const { return m_status; }
+
+/**
+ * @return The status of attendance as stored (e.g., "Present", "Absent")
+ */
+QString AttendanceLog::statusName() const { return attendanceStatusName(m_status); }
 
 /**
  * Sets the status of attendance
  * @param status - The new status
  */
-void AttendanceLog::setStatus(const QString& status) { m_status = status; }
+void AttendanceLog::setStatus(AttendanceStatus status) { m_status = status; }
+
+/**
+ * Sets the status of attendance from its stored text
+ * @param status - The status text (unknown values read as unmarked)
+ */
+void AttendanceLog::setStatus(const QString& status) { m_status = attendanceStatusFromName(status); }
 
 /**
  * @return Optional notes or remarks about the attendance
@@ -4,6 +4,7 @@
 #include <QString>
 #include <QDate>
 #include <QDateTime>
+#include "domain_types.h"
 
 class AttendanceLog
 {
@@ -19,7 +20,9 @@ public:
     QDate date() const;
     void setDate(const QDate& date);
     
-    QString status() const;
+    AttendanceStatus status() const;
+    QString statusName() const;
+    void setStatus(AttendanceStatus status);
     void setStatus(const QString& status);
     
     QString notes() const;
@@ -29,7 +32,7 @@ private:
     int m_id;
     int m_enrollmentId;
     QDate m_date;
-    QString m_status;
+    AttendanceStatus m_status;
     QString m_notes;
 };
 
@@ -0,0 +1,163 @@
+#include "batch_job.h"
+
+/**
+ * Default Constructor
+ * Defaults: m_id=0, m_checkpoint=0, m_processed=0, m_total=0
+ */
+BatchJob::BatchJob()
+    : m_id(0), m_checkpoint(0), m_processed(0), m_total(0)
+{
+}
+
+/**
+ * @return The unique ID of the job
+ */
+int BatchJob::id() const
+{
+    return m_id;
+}
+
+/**
+ * Sets the unique ID of the job
+ * @param id - The new ID
+ */
+void BatchJob::setId(int id)
+{
+    m_id = id;
+}
+
+/**
+ * @return The job type (e.g. "term_billing")
+ */
+QString BatchJob::jobType() const
+{
+    return m_jobType;
+}
+
+/**
+ * Sets the job type (e.g. "term_billing")
+ * @param jobType - The job type
+ */
+void BatchJob::setJobType(const QString& jobType)
+{
+    m_jobType = jobType;
+}
+
+/**
+ * @return The scope the job runs over (e.g. "semester:3")
+ */
+QString BatchJob::scope() const
+{
+    return m_scope;
+}
+
+/**
+ * Sets the scope the job runs over (e.g. "semester:3")
+ * @param scope - The scope
+ */
+void BatchJob::setScope(const QString& scope)
+{
+    m_scope = scope;
+}
+
+/**
+ * @return The job status (Running, Paused, Completed, Failed)
+ */
+QString BatchJob::status() const
+{
+    return m_status;
+}
+
+/**
+ * Sets the job status (Running, Paused, Completed, Failed)
+ * @param status - The new status
+ */
+void BatchJob::setStatus(const QString& status)
+{
+    m_status = status;
+}
+
+/**
+ * @return The last key fully processed
+ */
+int BatchJob::checkpoint() const
+{
+    return m_checkpoint;
+}
+
+/**
+ * Sets the last key fully processed
+ * @param checkpoint - The new checkpoint
+ */
+void BatchJob::setCheckpoint(int checkpoint)
+{
+    m_checkpoint = checkpoint;
+}
+
+/**
+ * @return The number of records processed so far
+ */
+int BatchJob::processed() const
+{
+    return m_processed;
+}
+
+/**
+ * Sets the number of records processed so far
+ * @param processed - The processed count
+ */
+void BatchJob::setProcessed(int processed)
+{
+    m_processed = processed;
+}
+
+/**
+ * @return The number of records the job expects to process
+ */
+int BatchJob::total() const
+{
+    return m_total;
+}
+
+/**
+ * Sets the number of records the job expects to process
+ * @param total - The total count
+ */
+void BatchJob::setTotal(int total)
+{
+    m_total = total;
+}
+
+/**
+ * @return The timestamp when the job was started
+ */
+QDateTime BatchJob::startedAt() const
+{
+    return m_startedAt;
+}
+
+/**
+ * Sets the timestamp when the job was started
+ * @param startedAt - The start timestamp
+ */
+void BatchJob::setStartedAt(const QDateTime& startedAt)
+{
+    m_startedAt = startedAt;
+}
+
+/**
+ * @return The timestamp of the last checkpoint
+ */
+QDateTime BatchJob::updatedAt() const
+{
+    return m_updatedAt;
+}
+
+/**
+ * Sets the timestamp of the last checkpoint
+ * @param updatedAt - The update timestamp
+ */
+void BatchJob::setUpdatedAt(const QDateTime& updatedAt)
+{
+    m_updatedAt = updatedAt;
+}
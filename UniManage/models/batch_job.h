@@ -0,0 +1,55 @@
+#ifndef BATCH_JOB_H
+#define BATCH_JOB_H
+
+#include <QString>
+#include <QDateTime>
+
+/**
+ * Restartable background job record (batch_jobs table)
+ * checkpoint is the last students_data.id (or other key) fully processed
+ */
+class BatchJob
+{
+public:
+    BatchJob();
+
+    int id() const;
+    void setId(int id);
+
+    QString jobType() const;
+    void setJobType(const QString& jobType);
+
+    QString scope() const;
+    void setScope(const QString& scope);
+
+    QString status() const;
+    void setStatus(const QString& status);
+
+    int checkpoint() const;
+    void setCheckpoint(int checkpoint);
+
+    int processed() const;
+    void setProcessed(int processed);
+
+    int total() const;
+    void setTotal(int total);
+
+    QDateTime startedAt() const;
+    void setStartedAt(const QDateTime& startedAt);
+
+    QDateTime updatedAt() const;
+    void setUpdatedAt(const QDateTime& updatedAt);
+
+private:
+    int m_id;
+    QString m_jobType;
+    QString m_scope;
+    QString m_status;
+    int m_checkpoint;
+    int m_processed;
+    int m_total;
+    QDateTime m_startedAt;
+    QDateTime m_updatedAt;
+};
+
+#endif // BATCH_JOB_H
@@ -5,7 +5,7 @@
  * Initializes a new instance with default ID 0
  */
 CalendarEvent::CalendarEvent()
-    : m_id(0)
+    : m_id(0), m_recurrence(Recurrence::None)
 {
 }
 
@@ -19,7 +19,8 @@ CalendarEvent::CalendarEvent()
  * @param eventType - The type/category of the event
  */
 CalendarEvent::CalendarEvent(int id, const QString& title, const QString& description, const QDate& startDate, const QDate& endDate, const QString& eventType)
-    : m_id(id), m_title(title), m_description(description), m_startDate(startDate), m_endDate(endDate), m_eventType(eventType)
+    : m_id(id), m_title(title), m_description(description), m_startDate(startDate), m_endDate(endDate), m_eventType(eventType),
+      m_recurrence(Recurrence::None)
 {
 }
 
@@ -88,3 +89,41 @@ QString CalendarEvent::eventType() const { return m_eventType; }
  * @param eventType - The new event type
  */
 void CalendarEvent::setEventType(const QString& eventType) { m_eventType = eventType; }
+
+/**
+ * @return How the event repeats (None for a one-off event)
+ */
+Recurrence CalendarEvent::recurrence() const { return m_recurrence; }
+
+/**
+ * @return The repeat rule as stored in calendar_events.recurrence
+ */
+QString CalendarEvent::recurrenceName() const { return ::recurrenceName(m_recurrence); }
+
+/**
+ * Sets how the event repeats
+ * @param recurrence - The new repeat rule
+ */
+void CalendarEvent::setRecurrence(Recurrence recurrence) { m_recurrence = recurrence; }
+
+/**
+ * Sets how the event repeats from its stored name
+ * @param recurrence - "none", "weekly" or "yearly"; anything else means none
+ */
+void CalendarEvent::setRecurrence(const QString& recurrence) { m_recurrence = recurrenceFromName(recurrence); }
+
+/**
+ * @return The last date an occurrence may start, invalid if it repeats forever
+ */
+QDate CalendarEvent::recurrenceUntil() const { return m_recurrenceUntil; }
+
+/**
+ * Sets the last date an occurrence may start
+ * @param until - The end of the series, or an invalid date for no end
+ */
+void CalendarEvent::setRecurrenceUntil(const QDate& until) { m_recurrenceUntil = until; }
+
+/**
+ * @return True if the event repeats
+ */
+bool CalendarEvent::isRecurring() const { return m_recurrence != Recurrence::None; }
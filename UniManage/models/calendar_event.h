@@ -1,6 +1,7 @@
 #ifndef CALENDAR_EVENT_H
 #define CALENDAR_EVENT_H
 
+#include "domain_types.h"
 #include <QString>
 #include <QDate>
 #include <QDateTime>
@@ -29,6 +30,16 @@ public:
     QString eventType() const;
     void setEventType(const QString& eventType);
 
+    Recurrence recurrence() const;
+    QString recurrenceName() const;
+    void setRecurrence(Recurrence recurrence);
+    void setRecurrence(const QString& recurrence);
+
+    QDate recurrenceUntil() const;
+    void setRecurrenceUntil(const QDate& until);
+
+    bool isRecurring() const;
+
 private:
     int m_id;
     QString m_title;
@@ -36,6 +47,8 @@ private:
     QDate m_startDate;
     QDate m_endDate;
     QString m_eventType;
+    QDate m_recurrenceUntil; // last day an occurrence may start; invalid repeats forever
+    Recurrence m_recurrence;
 };
 
 #endif // CALENDAR_EVENT_H
@@ -4,7 +4,7 @@
  * Default Constructor
  * Initializes a new instance with default ID 0
  */
-College::College() : m_id(0) {}
+College::College() : m_id(0), m_tuitionFees() {}
 
 /**
  * Parameterized Constructor
@@ -13,7 +13,7 @@ College::College() : m_id(0) {}
  * @param code - A short code for the college (e.g., "ENG")
  * @param tuitionFees - The base tuition fees for this college
  */
-College::College(int id, const QString& name, const QString& code, double tuitionFees)
+College::College(int id, const QString& name, const QString& code, Money tuitionFees)
     : m_id(id), m_name(name), m_code(code), m_tuitionFees(tuitionFees) {}
 
 /**
@@ -52,10 +52,10 @@ void College::setCode(const QString& code) { m_code = code; }
 /**
  * @return The base tuition fees for the college
  */
-double College::tuitionFees() const { return m_tuitionFees; }
+Money College::tuitionFees() const { return m_tuitionFees; }
 
 /**
  * Sets the base tuition fees for the college
  * @param fees - The new fees
  */
-void College::setTuitionFees(double fees) { m_tuitionFees = fees; }
+void College::setTuitionFees(Money fees) { m_tuitionFees = fees; }
@@ -2,12 +2,13 @@
 #define COLLEGE_H
 
 #include <QString>
+#include "money.h"
 
 class College
 {
 public:
     College();
-    College(int id, const QString& name, const QString& code, double tuitionFees = 0.0);
+    College(int id, const QString& name, const QString& code, Money tuitionFees = Money());
 
     int id() const;
     void setId(int id);
@@ -18,14 +19,14 @@ public:
     QString code() const;
     void setCode(const QString& code);
 
-    double tuitionFees() const;
-    void setTuitionFees(double fees);
+    Money tuitionFees() const;
+    void setTuitionFees(Money fees);
 
 private:
     int m_id;
     QString m_name;
     QString m_code;
-    double m_tuitionFees;
+    Money m_tuitionFees;
 };
 
 #endif // COLLEGE_H
@@ -3,10 +3,10 @@
 /**
  * Default Constructor
  * Initializes a new instance with default values
- * Defaults: m_yearLevel=1, m_creditHours=3, m_maxGrade=100, m_courseType="Theoretical"
+ * Defaults: m_yearLevel=1, m_creditHours=3, m_maxGrade=100, m_courseType=Theoretical
  */
 Course::Course()
-    : m_id(0), m_yearLevel(1), m_creditHours(3), m_semesterId(0), m_departmentId(0), m_maxGrade(100), m_courseType("Theoretical")
+    : m_id(0), m_yearLevel(1), m_creditHours(3), m_semesterId(0), m_departmentId(0), m_maxGrade(100), m_courseType(CourseType::Theoretical)
 {
 }
 
@@ -197,15 +197,26 @@ int Course::maxGrade() const { return m_maxGrade; }
 void Course::setMaxGrade(int maxGrade) { m_maxGrade = maxGrade; }
 
 /**
- * @return The type of course (e.g., "Theoretical", "Practical")
+ * @return The type of course
  */
-QString Course::courseType() const { return m_courseType; }
+CourseType Course::courseType() const { return m_courseType; }
+
+/**
+ * @return The type of course as stored ("Theoretical" or "Practical")
+ */
+QString Course::courseTypeName() const { return ::courseTypeName(m_courseType); }
 
 /**
  * Sets the course type
  * @param courseType - The new course type
  */
-void Course::setCourseType(const QString& courseType) { m_courseType = courseType; }
+void Course::setCourseType(CourseType courseType) { m_courseType = courseType; }
+
+/**
+ * Sets the course type from its stored text
+ * @param courseType - The type text (unknown values read as Theoretical)
+ */
+void Course::setCourseType(const QString& courseType) { m_courseType = courseTypeFromName(courseType); }
 
 /**
  * @return The name of the professor assigned to this course
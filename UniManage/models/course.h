@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include "domain_types.h"
 
 class Course
 {
@@ -37,7 +38,9 @@ public:
     int maxGrade() const;
     void setMaxGrade(int maxGrade);
 
-    QString courseType() const;
+    CourseType courseType() const;
+    QString courseTypeName() const;
+    void setCourseType(CourseType courseType);
     void setCourseType(const QString& courseType);
 
     // Helper fields
@@ -72,7 +75,7 @@ private:
     QString m_semesterName;
     QString m_departmentName;
     int m_maxGrade;
-    QString m_courseType;
+    CourseType m_courseType;
     QString m_assignedProfessor;
     QString m_semesterYear;
     int m_semesterNumber;
@@ -0,0 +1,129 @@
+#include "domain_types.h"
+
+namespace {
+
+// Built once; returning a name only bumps a reference count
+const QString RoleNames[] = { QString(), "admin", "professor", "student" };
+const QString StudentStatusNames[] = { "active", "inactive", "suspended", "graduated", "deleted" };
+const QString CourseTypeNames[] = { "Theoretical", "Practical" };
+const QString AttendanceStatusNames[] = { QString(), "Present", "Absent", "Late", "Excused" };
+const QString GradeLetterNames[] = { "N/A", "Excellent", "Very Good", "Good", "Pass", "Fail" };
+const QString RecurrenceNames[] = { "none", "weekly", "yearly" };
+
+/**
+ * @param names - The names, in enumerator order
+ * @param index - The enumerator value
+ * @return Its name, the default's name if out of range
+ */
+template <int N>
+QString nameAt(const QString (&names)[N], int index)
+{
+    return names[index >= 0 && index < N ? index : 0];
+}
+
+/**
+ * Looks a stored name up, case-insensitively
+ * The length check rejects most candidates before any character is compared
+ * @param name - The stored text
+ * @param names - The names, in enumerator order
+ * @return The matching enumerator, or the first one (the default) if none matches
+ */
+template <typename Enum, int N>
+Enum fromName(QStringView name, const QString (&names)[N])
+{
+    for (int i = 0; i < N; ++i) {
+        if (name.size() == names[i].size() && name.compare(names[i], Qt::CaseInsensitive) == 0) {
+            return static_cast<Enum>(i);
+        }
+    }
+    return static_cast<Enum>(0);
+}
+
+} // namespace
+
+/**
+ * @param role - The role
+ * @return The users.role value ("admin", "professor", "student"; empty if unknown)
+ */
+QString roleName(UserRole role) { return nameAt(RoleNames, int(role)); }
+
+/**
+ * @param name - A users.role value, any case
+ * @return The role, Unknown if the text is not a known role
+ */
+UserRole roleFromName(QStringView name) { return fromName<UserRole>(name, RoleNames); }
+
+/**
+ * @param status - The status
+ * @return The students_data.status value ("active", "deleted", ...)
+ */
+QString studentStatusName(StudentStatus status) { return nameAt(StudentStatusNames, int(status)); }
+
+/**
+ * @param name - A students_data.status value, any case
+ * @return The status, Active if the text is not a known status
+ */
+StudentStatus studentStatusFromName(QStringView name) { return fromName<StudentStatus>(name, StudentStatusNames); }
+
+/**
+ * @param type - The course type
+ * @return The courses.course_type value ("Theoretical" or "Practical")
+ */
+QString courseTypeName(CourseType type) { return nameAt(CourseTypeNames, int(type)); }
+
+/**
+ * @param name - A courses.course_type value, any case
+ * @return The type, Theoretical if the text is not a known type
+ */
+CourseType courseTypeFromName(QStringView name) { return fromName<CourseType>(name, CourseTypeNames); }
+
+/**
+ * @param status - The attendance state
+ * @return The attendance_logs.status value ("Present", "Absent", ...; empty if unmarked)
+ */
+QString attendanceStatusName(AttendanceStatus status) { return nameAt(AttendanceStatusNames, int(status)); }
+
+/**
+ * @param name - An attendance_logs.status value, any case
+ * @return The state, Unmarked if the text is not a known state
+ */
+AttendanceStatus attendanceStatusFromName(QStringView name) { return fromName<AttendanceStatus>(name, AttendanceStatusNames); }
+
+/**
+ * @param letter - The evaluation
+ * @return The enrollments.letter_grade value ("Excellent", ..., "N/A" if not graded)
+ */
+QString gradeLetterName(GradeLetter letter) { return nameAt(GradeLetterNames, int(letter)); }
+
+/**
+ * @param name - An enrollments.letter_grade value, any case
+ * @return The evaluation, NotGraded if the text is not a known evaluation
+ */
+GradeLetter gradeLetterFromName(QStringView name) { return fromName<GradeLetter>(name, GradeLetterNames); }
+
+/**
+ * @param letter - The evaluation
+ * @return Its grade points for the GPA (Excellent 4 ... Pass 1, otherwise 0)
+ */
+int gradePoints(GradeLetter letter)
+{
+    switch (letter) {
+        case GradeLetter::Excellent: return 4;
+        case GradeLetter::VeryGood: return 3;
+        case GradeLetter::Good: return 2;
+        case GradeLetter::Pass: return 1;
+        default: return 0;
+    }
+}
+
+/**
+ * @param rule - The repeat rule
+ * @return The calendar_events.recurrence value ("none", "weekly" or "yearly")
+ */
+QString recurrenceName(Recurrence rule) { return nameAt(RecurrenceNames, int(rule)); }
+
+/**
+ * @param name - A calendar_events.recurrence value, any case
+ * @return The rule, None if the text is not a known rule
+ */
+Recurrence recurrenceFromName(QStringView name) { return fromName<Recurrence>(name, RecurrenceNames); }
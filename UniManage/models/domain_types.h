@@ -0,0 +1,84 @@
+#ifndef DOMAIN_TYPES_H
+#define DOMAIN_TYPES_H
+
+#include <QString>
+#include <QStringView>
+#include <QtGlobal>
+
+/**
+ * Closed vocabularies that the database and FileDB store as text
+ * Models keep them as one-byte enums; the text form is only produced or
+ * parsed at the storage and display boundaries. Names are shared static
+ * strings (no allocation), parsing is case-insensitive and allocation-free,
+ * and unknown text maps to the first enumerator, the column's default
+ */
+
+// users.role
+enum class UserRole : quint8 {
+    Unknown = 0,
+    Admin,
+    Professor,
+    Student
+};
+
+// students_data.status
+enum class StudentStatus : quint8 {
+    Active = 0,
+    Inactive,
+    Suspended,
+    Graduated,
+    Deleted
+};
+
+// courses.course_type
+enum class CourseType : quint8 {
+    Theoretical = 0,
+    Practical
+};
+
+// attendance_logs.status
+enum class AttendanceStatus : quint8 {
+    Unmarked = 0,
+    Present,
+    Absent,
+    Late,
+    Excused
+};
+
+// enrollments.letter_grade
+enum class GradeLetter : quint8 {
+    NotGraded = 0,
+    Excellent,
+    VeryGood,
+    Good,
+    Pass,
+    Fail
+};
+
+// calendar_events.recurrence
+enum class Recurrence : quint8 {
+    None = 0,
+    Weekly,
+    Yearly
+};
+
+QString roleName(UserRole role);
+UserRole roleFromName(QStringView name);
+
+QString studentStatusName(StudentStatus status);
+StudentStatus studentStatusFromName(QStringView name);
+
+QString courseTypeName(CourseType type);
+CourseType courseTypeFromName(QStringView name);
+
+QString attendanceStatusName(AttendanceStatus status);
+AttendanceStatus attendanceStatusFromName(QStringView name);
+
+QString gradeLetterName(GradeLetter letter);
+GradeLetter gradeLetterFromName(QStringView name);
+int gradePoints(GradeLetter letter);
+
+QString recurrenceName(Recurrence rule);
+Recurrence recurrenceFromName(QStringView name);
+
+#endif // DOMAIN_TYPES_H
@@ -1,4 +1,5 @@
 #include "enrollment.h"
+#include "stringpool.h"
 
 /**
  * Default Constructor
@@ -10,8 +11,8 @@ Enrollment::Enrollment()
       m_attendanceCount(0), m_absenceCount(0),
       m_assignment1Grade(0.0), m_assignment2Grade(0.0),
       m_courseworkGrade(0.0), m_finalExamGrade(0.0), m_experienceGrade(0.0),
-      m_totalGrade(0.0), m_isRafaaApplied(false),
-      m_courseMaxGrade(100), m_courseType("Theoretical")
+      m_totalGrade(0.0), m_letterGrade(GradeLetter::NotGraded), m_isRafaaApplied(false),
+      m_courseMaxGrade(100), m_courseType(CourseType::Theoretical)
 {
     m_enrolledAt = QDateTime::currentDateTime();
 }
@@ -149,15 +150,26 @@ double Enrollment::totalGrade() const { return m_totalGrade; }
 void Enrollment::setTotalGrade(double grade) { m_totalGrade = grade; }
 
 /**
- * @return The letter grade (e.g., "A", "B", "C")
+ * @return The evaluation (letter grade)
  */
-QString Enrollment::letterGrade() const { return m_letterGrade; }
+GradeLetter Enrollment::letterGrade() const { return m_letterGrade; }
+
+/**
+ * @return The evaluation as stored (e.g., "Excellent", "N/A")
+ */
+QString Enrollment::letterGradeName() const { return gradeLetterName(m_letterGrade); }
 
 /**
  * Sets the letter grade
- * @param grade - The letter grade
+ * @param grade - The evaluation
+ */
+void Enrollment::setLetterGrade(GradeLetter grade) { m_letterGrade = grade; }
+
+/**
+ * Sets the letter grade from its stored text
+ * @param grade - The evaluation text (unknown values read as not graded)
  */
-void Enrollment::setLetterGrade(const QString& grade) { m_letterGrade = grade; }
+void Enrollment::setLetterGrade(const QString& grade) { m_letterGrade = gradeLetterFromName(grade); }
 
 /**
  * @return True if "Rafaa" (grade boosting/mercy) has been applied
@@ -215,15 +227,26 @@ int Enrollment::courseMaxGrade() const { return m_courseMaxGrade; }
 void Enrollment::setCourseMaxGrade(int maxGrade) { m_courseMaxGrade = maxGrade; }
 
 /**
- * @return The type of the course ("Theoretical" vs "Practical")
+ * @return The type of the course
  */
-QString Enrollment::courseType() const { return m_courseType; }
+CourseType Enrollment::courseType() const { return m_courseType; }
+
+/**
+ * @return The type of the course as stored ("Theoretical" or "Practical")
+ */
+QString Enrollment::courseTypeName() const { return ::courseTypeName(m_courseType); }
 
 /**
  * Sets the type of the course
  * @param type - The new course type
  */
-void Enrollment::setCourseType(const QString& type) { m_courseType = type; }
+void Enrollment::setCourseType(CourseType type) { m_courseType = type; }
+
+/**
+ * Sets the type of the course from its stored text
+ * @param type - The type text (unknown values read as Theoretical)
+ */
+void Enrollment::setCourseType(const QString& type) { m_courseType = courseTypeFromName(type); }
 
 /**
  * @return The student's section/group (e.g., "Group A")
@@ -234,7 +257,7 @@ QString Enrollment::studentSection() const { return m_studentSection; }
  * Sets the student's section/group
  * @param section - The section name
  */
-void Enrollment::setStudentSection(const QString& section) { m_studentSection = section; }
+void Enrollment::setStudentSection(const QString& section) { m_studentSection = StringPool::instance().intern(section); }
 
 /**
  * @return The student's academic level/year (e.g., "Year 1")
@@ -245,7 +268,7 @@ QString Enrollment::studentLevel() const { return m_studentLevel; }
  * Sets the student's academic level/year
  * @param level - The level name
  */
-void Enrollment::setStudentLevel(const QString& level) { m_studentLevel = level; }
+void Enrollment::setStudentLevel(const QString& level) { m_studentLevel = StringPool::instance().intern(level); }
 
 /**
  * @return The student's unique code identifier
@@ -267,4 +290,4 @@ QString Enrollment::academicYear() const { return m_academicYear; }
  * Sets the academic year for this enrollment
  * @param year - The academic year
  */
-void Enrollment::setAcademicYear(const QString& year) { m_academicYear = year; }
+void Enrollment::setAcademicYear(const QString& year) { m_academicYear = StringPool::instance().intern(year); }
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include "domain_types.h"
 
 class Enrollment
 {
@@ -45,7 +46,9 @@ public:
     double totalGrade() const;
     void setTotalGrade(double grade);
 
-    QString letterGrade() const;
+    GradeLetter letterGrade() const;
+    QString letterGradeName() const;
+    void setLetterGrade(GradeLetter grade);
     void setLetterGrade(const QString& grade);
 
     bool isRafaaApplied() const;
@@ -64,7 +67,9 @@ public:
     int courseMaxGrade() const;
     void setCourseMaxGrade(int maxGrade);
     
-    QString courseType() const;
+    CourseType courseType() const;
+    QString courseTypeName() const;
+    void setCourseType(CourseType type);
     void setCourseType(const QString& type);
     
     QString studentSection() const;
@@ -92,14 +97,14 @@ private:
     double m_finalExamGrade;
     double m_experienceGrade;
     double m_totalGrade;
-    QString m_letterGrade;
+    GradeLetter m_letterGrade;
     bool m_isRafaaApplied;
     QDateTime m_enrolledAt;
     
     QString m_studentName;
     QString m_courseName;
     int m_courseMaxGrade;
-    QString m_courseType;
+    CourseType m_courseType;
     QString m_studentSection;
     QString m_studentLevel;
     QString m_studentCode;
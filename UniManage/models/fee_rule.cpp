@@ -0,0 +1,90 @@
+#include "fee_rule.h"
+
+/**
+ * Default Constructor
+ * Defaults: m_id=0, m_collegeId=0, m_academicLevelId=0, m_amount=0.00
+ */
+FeeRule::FeeRule()
+    : m_id(0), m_collegeId(0), m_academicLevelId(0), m_amount()
+{
+}
+
+/**
+ * Parameterized Constructor
+ * @param id - The unique ID of the rule
+ * @param collegeId - The college the rule applies to (0 for any)
+ * @param academicLevelId - The academic level the rule applies to (0 for any)
+ * @param amount - The amount charged per term
+ */
+FeeRule::FeeRule(int id, int collegeId, int academicLevelId, Money amount)
+    : m_id(id), m_collegeId(collegeId), m_academicLevelId(academicLevelId), m_amount(amount)
+{
+}
+
+/**
+ * @return The unique ID of the rule
+ */
+int FeeRule::id() const
+{
+    return m_id;
+}
+
+/**
+ * Sets the unique ID of the rule
+ * @param id - The new ID
+ */
+void FeeRule::setId(int id)
+{
+    m_id = id;
+}
+
+/**
+ * @return The college ID (0 for any college)
+ */
+int FeeRule::collegeId() const
+{
+    return m_collegeId;
+}
+
+/**
+ * Sets the college ID
+ * @param collegeId - The college ID (0 for any college)
+ */
+void FeeRule::setCollegeId(int collegeId)
+{
+    m_collegeId = collegeId;
+}
+
+/**
+ * @return The academic level ID (0 for any level)
+ */
+int FeeRule::academicLevelId() const
+{
+    return m_academicLevelId;
+}
+
+/**
+ * Sets the academic level ID
+ * @param academicLevelId - The academic level ID (0 for any level)
+ */
+void FeeRule::setAcademicLevelId(int academicLevelId)
+{
+    m_academicLevelId = academicLevelId;
+}
+
+/**
+ * @return The amount charged per term
+ */
+Money FeeRule::amount() const
+{
+    return m_amount;
+}
+
+/**
+ * Sets the amount charged per term
+ * @param amount - The new amount
+ */
+void FeeRule::setAmount(Money amount)
+{
+    m_amount = amount;
+}
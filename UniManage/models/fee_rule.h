@@ -0,0 +1,35 @@
+#ifndef FEE_RULE_H
+#define FEE_RULE_H
+
+#include "money.h"
+
+/**
+ * Per-term tuition amount for a college and/or academic level
+ * A zero collegeId or academicLevelId means the rule applies to any value
+ */
+class FeeRule
+{
+public:
+    FeeRule();
+    FeeRule(int id, int collegeId, int academicLevelId, Money amount);
+
+    int id() const;
+    void setId(int id);
+
+    int collegeId() const;
+    void setCollegeId(int collegeId);
+
+    int academicLevelId() const;
+    void setAcademicLevelId(int academicLevelId);
+
+    Money amount() const;
+    void setAmount(Money amount);
+
+private:
+    int m_id;
+    int m_collegeId;
+    int m_academicLevelId;
+    Money m_amount;
+};
+
+#endif // FEE_RULE_H
@@ -0,0 +1,118 @@
+#include "money.h"
+#include <QtNumeric>
+#include <cmath>
+
+/**
+ * Converts a floating point amount (e.g. from a spin box) to Money
+ * Rounds half away from zero to the nearest minor unit
+ * @param value - The amount in major units
+ * @return The Money value
+ */
+Money Money::fromDouble(double value)
+{
+    return Money(static_cast<qint64>(std::llround(value * MinorPerMajor)));
+}
+
+/**
+ * Parses a decimal string such as "1250", "-3.5" or "1,250.75" exactly
+ * Digits beyond the second fractional place are rounded half away from zero
+ * @param text - The decimal text
+ * @param ok - Optional flag set to false when the text is not a valid amount
+ *             or does not fit in 64-bit minor units
+ * @return The Money value (zero when invalid)
+ */
+Money Money::fromString(const QString& text, bool* ok)
+{
+    const QString s = text.trimmed();
+    int i = 0;
+    bool negative = false;
+    if (i < s.size() && (s.at(i) == QChar('-') || s.at(i) == QChar('+'))) {
+        negative = s.at(i) == QChar('-');
+        ++i;
+    }
+
+    qint64 minor = 0;
+    int digits = 0;
+    int fractionDigits = -1; // -1 until the decimal point is seen
+    bool roundUp = false;
+    bool valid = true;
+
+    for (; i < s.size(); ++i) {
+        const QChar c = s.at(i);
+        if (c == QChar(',') && fractionDigits < 0) continue;
+        if (c == QChar('.') && fractionDigits < 0) {
+            fractionDigits = 0;
+            continue;
+        }
+        if (!c.isDigit()) {
+            valid = false;
+            break;
+        }
+        const int d = c.digitValue();
+        ++digits;
+        if (fractionDigits >= 2) {
+            if (fractionDigits == 2) roundUp = d >= 5;
+            ++fractionDigits;
+            continue;
+        }
+        if (qMulOverflow(minor, qint64(10), &minor) || qAddOverflow(minor, qint64(d), &minor)) {
+            valid = false;
+            break;
+        }
+        if (fractionDigits >= 0) ++fractionDigits;
+    }
+
+    if (digits == 0) valid = false;
+    // Scale to minor units; the missing fraction digits can still overflow
+    for (int f = qMax(fractionDigits, 0); valid && f < 2; ++f) {
+        if (qMulOverflow(minor, qint64(10), &minor)) valid = false;
+    }
+    if (valid && roundUp && qAddOverflow(minor, qint64(1), &minor)) valid = false;
+
+    if (ok) *ok = valid;
+    if (!valid) return Money();
+    return Money(negative ? -minor : minor);
+}
+
+/**
+ * Converts a database value to Money
+ * DECIMAL columns arrive as strings and are parsed exactly; numeric
+ * variants fall back to rounding
+ * @param value - The value read from a query
+ * @return The Money value (zero for NULL)
+ */
+Money Money::fromVariant(const QVariant& value)
+{
+    if (value.isNull()) return Money();
+    switch (value.typeId()) {
+        case QMetaType::Double:
+        case QMetaType::Float:
+            return fromDouble(value.toDouble());
+        case QMetaType::Int:
+        case QMetaType::LongLong:
+        case QMetaType::UInt:
+        case QMetaType::ULongLong:
+            return Money(value.toLongLong() * MinorPerMajor);
+        default:
+            return fromString(value.toString());
+    }
+}
+
+/**
+ * @return The amount in major units as a double (display/spin box use only)
+ */
+double Money::toDouble() const
+{
+    return static_cast<double>(m_minor) / MinorPerMajor;
+}
+
+/**
+ * @return The amount formatted with two decimals, e.g. "-1250.05"
+ */
+QString Money::toString() const
+{
+    const quint64 magnitude = m_minor < 0 ? 0 - static_cast<quint64>(m_minor) : static_cast<quint64>(m_minor);
+    QString result = QString::number(magnitude / MinorPerMajor) + "." +
+                     QString::number(magnitude % MinorPerMajor).rightJustified(2, QChar('0'));
+    return m_minor < 0 ? "-" + result : result;
+}
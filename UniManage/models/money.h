@@ -0,0 +1,49 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <QString>
+#include <QVariant>
+#include <QtGlobal>
+
+/**
+ * Exact monetary amount stored as integer minor units (cents)
+ * Sums and differences never drift, unlike float/double amounts
+ * Bound to SQL as a decimal string so DECIMAL columns receive the exact value
+ */
+class Money
+{
+public:
+    static constexpr int MinorPerMajor = 100;
+
+    constexpr Money() : m_minor(0) {}
+
+    static constexpr Money fromMinorUnits(qint64 minor) { return Money(minor); }
+    static Money fromDouble(double value);
+    static Money fromString(const QString& text, bool* ok = nullptr);
+    static Money fromVariant(const QVariant& value);
+
+    constexpr qint64 minorUnits() const { return m_minor; }
+    double toDouble() const;
+    QString toString() const;
+    constexpr bool isZero() const { return m_minor == 0; }
+
+    constexpr Money operator+(Money other) const { return Money(m_minor + other.m_minor); }
+    constexpr Money operator-(Money other) const { return Money(m_minor - other.m_minor); }
+    constexpr Money operator-() const { return Money(-m_minor); }
+    Money& operator+=(Money other) { m_minor += other.m_minor; return *this; }
+    Money& operator-=(Money other) { m_minor -= other.m_minor; return *this; }
+
+    constexpr bool operator==(Money other) const { return m_minor == other.m_minor; }
+    constexpr bool operator!=(Money other) const { return m_minor != other.m_minor; }
+    constexpr bool operator<(Money other) const { return m_minor < other.m_minor; }
+    constexpr bool operator<=(Money other) const { return m_minor <= other.m_minor; }
+    constexpr bool operator>(Money other) const { return m_minor > other.m_minor; }
+    constexpr bool operator>=(Money other) const { return m_minor >= other.m_minor; }
+
+private:
+    constexpr explicit Money(qint64 minor) : m_minor(minor) {}
+
+    qint64 m_minor;
+};
+
+#endif // MONEY_H
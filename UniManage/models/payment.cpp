@@ -3,10 +3,10 @@
 /**
  * Default Constructor
  * Initializes a new payment record with default values
- * Defaults: m_id=0, m_studentId=0, m_amount=0.0f
+ * Defaults: m_id=0, m_studentId=0, m_amount=0.00
  */
 Payment::Payment()
-    : m_id(0), m_studentId(0), m_amount(0.0f)
+    : m_id(0), m_studentId(0), m_amount()
 {
 }
 
@@ -23,7 +23,7 @@ Payment::Payment()
  * @param createdAt - When the record was created
  * @param studentNumber - The student's unique number (for reference/joining)
  */
-Payment::Payment(int id, int studentId, float amount, const QDateTime &date, const QDateTime &year,
+Payment::Payment(int id, int studentId, Money amount, const QDateTime &date, const QDateTime &year,
                  const QString &method, const QString &status, const QString &notes,
                  const QDateTime &createdAt, const QString &studentNumber)
 {
@@ -76,7 +76,7 @@ void Payment::setStudentId(int studentId)
 /**
  * @return The amount paid
  */
-float Payment::amount() const
+Money Payment::amount() const
 {
     return m_amount;
 }
@@ -85,7 +85,7 @@ float Payment::amount() const
  * Sets the payment amount
  * @param amount - The new amount
  */
-void Payment::setAmount(float amount)
+void Payment::setAmount(Money amount)
 {
     m_amount = amount;
 }
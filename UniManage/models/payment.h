@@ -3,12 +3,13 @@
 
 #include <QString>
 #include <QDateTime>
+#include "money.h"
 
 class Payment
 {
 public:
     Payment();
-    Payment(int id, int studentId, float amount, const QDateTime &date, const QDateTime &year,
+    Payment(int id, int studentId, Money amount, const QDateTime &date, const QDateTime &year,
             const QString &method, const QString &status, const QString &notes,
             const QDateTime &createdAt, const QString &studentNumber);
 
@@ -18,8 +19,8 @@ public:
     int studentId() const;
     void setStudentId(int studentId);
 
-    float amount() const;
-    void setAmount(float amount);
+    Money amount() const;
+    void setAmount(Money amount);
 
     QDateTime date() const;
     void setDate(const QDateTime& date);
@@ -46,7 +47,7 @@ public:
 private:
     int m_id;
     int m_studentId;
-    float m_amount;
+    Money m_amount;
     QDateTime m_date;
     QDateTime m_year;
     QString m_method;
@@ -5,6 +5,7 @@
  * Initializes a new semester instance with default values.
  */
 Semester::Semester()
+    : m_id(0), m_semester(0)
 {
 }
 
@@ -105,3 +106,66 @@ void Semester::setUpdatedAt(const QDateTime& updatedAt)
 {
     m_updatedAt = updatedAt;
 }
+
+/**
+ * @return The first teaching day as entered, invalid if not set
+ */
+QDate Semester::startDate() const
+{
+    return m_startDate;
+}
+
+/**
+ * Sets the first teaching day
+ * @param startDate - The new start date, or an invalid date to use the default
+ */
+void Semester::setStartDate(const QDate& startDate)
+{
+    m_startDate = startDate;
+}
+
+/**
+ * @return The last teaching day as entered, invalid if not set
+ */
+QDate Semester::endDate() const
+{
+    return m_endDate;
+}
+
+/**
+ * Sets the last teaching day
+ * @param endDate - The new end date, or an invalid date to use the default
+ */
+void Semester::setEndDate(const QDate& endDate)
+{
+    m_endDate = endDate;
+}
+
+/**
+ * The first teaching day, defaulting to the usual term dates when none was
+ * entered: 15 September for semester 1 and 15 February for semester 2 of
+ * the academic year that contains year()
+ * @return The start date, invalid if the semester has no year
+ */
+QDate Semester::termStart() const
+{
+    if (m_startDate.isValid()) return m_startDate;
+    const QDate year = m_year.date();
+    if (!year.isValid()) return QDate();
+    // The academic year starts in September
+    const int first = year.month() >= 8 ? year.year() : year.year() - 1;
+    return m_semester == 2 ? QDate(first + 1, 2, 15) : QDate(first, 9, 15);
+}
+
+/**
+ * The last teaching day, defaulting to 15 January (semester 1) or 15 June
+ * (semester 2) when none was entered
+ * @return The end date, invalid if the semester has no year
+ */
+QDate Semester::termEnd() const
+{
+    if (m_endDate.isValid()) return m_endDate;
+    const QDate start = termStart();
+    if (!start.isValid()) return QDate();
+    return m_semester == 2 ? QDate(start.year(), 6, 15) : QDate(start.year() + 1, 1, 15);
+}
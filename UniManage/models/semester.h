@@ -1,6 +1,7 @@
 #ifndef SEMESTER_H
 #define SEMESTER_H
 
+#include <QDate>
 #include <QDateTime>
 
 class Semester
@@ -18,6 +19,15 @@ public:
     int semester() const;
     void setSemester(int semester);
 
+    QDate startDate() const;
+    void setStartDate(const QDate& startDate);
+
+    QDate endDate() const;
+    void setEndDate(const QDate& endDate);
+
+    QDate termStart() const;
+    QDate termEnd() const;
+
     QDateTime createdAt() const;
     void setCreatedAt(const QDateTime& createdAt);
 
@@ -28,6 +38,8 @@ private:
     int m_id;
     QDateTime m_year;
     int m_semester;
+    QDate m_startDate;
+    QDate m_endDate;
     QDateTime m_createdAt;
     QDateTime m_updatedAt;
 };
@@ -0,0 +1,48 @@
+#include "stringpool.h"
+
+/**
+ * @return The process-wide pool
+ */
+StringPool& StringPool::instance()
+{
+    static StringPool pool;
+    return pool;
+}
+
+/**
+ * Constructor for the StringPool class
+ */
+StringPool::StringPool() {}
+
+/**
+ * Returns the pooled copy of a string, adding it on first use
+ * Safe to call from any thread; lookups of known values only take the
+ * read lock
+ * @param value - The string to intern
+ * @return A QString sharing the pooled data (value itself once the pool is full)
+ */
+QString StringPool::intern(const QString& value)
+{
+    if (value.isEmpty()) return QString();
+
+    {
+        QReadLocker locker(&m_lock);
+        auto it = m_strings.constFind(value);
+        if (it != m_strings.constEnd()) return *it;
+    }
+
+    QWriteLocker locker(&m_lock);
+    auto it = m_strings.constFind(value);
+    if (it != m_strings.constEnd()) return *it;
+    if (m_strings.size() >= MaxEntries) return value;
+    return *m_strings.insert(value);
+}
+
+/**
+ * @return The number of pooled strings
+ */
+int StringPool::size() const
+{
+    QReadLocker locker(&m_lock);
+    return m_strings.size();
+}
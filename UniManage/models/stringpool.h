@@ -0,0 +1,37 @@
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include <QReadWriteLock>
+#include <QSet>
+#include <QString>
+
+/**
+ * Process-wide pool of interned strings
+ * Model fields that take a few dozen distinct values (status, role, level,
+ * section and college names, ...) are stored once and shared by every row
+ * through QString's implicit sharing: a 100k-row list holds one buffer per
+ * distinct value instead of one per row, and equal interned values share
+ * their data, so comparing them stops at the data pointer
+ * The pool never shrinks; past MaxEntries new values are returned as they
+ * are, so a field with unbounded values cannot grow it without limit
+ */
+class StringPool
+{
+public:
+    static const int MaxEntries = 4096;
+
+    static StringPool& instance();
+
+    QString intern(const QString& value);
+    int size() const;
+
+private:
+    StringPool();
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    mutable QReadWriteLock m_lock;
+    QSet<QString> m_strings;
+};
+
+#endif // STRINGPOOL_H
@@ -0,0 +1,134 @@
+#include "student_balance.h"
+
+/**
+ * Default Constructor
+ * Initializes an empty ledger row
+ * Defaults: m_studentId=0, m_totalCharged=0.00, m_totalPaid=0.00
+ */
+StudentBalance::StudentBalance()
+    : m_studentId(0), m_totalCharged(), m_totalPaid()
+{
+}
+
+/**
+ * Parameterized Constructor
+ * @param studentId - The ID of the student (students_data.id)
+ * @param totalCharged - Total amount billed to the student
+ * @param totalPaid - Total amount of settled payments
+ */
+StudentBalance::StudentBalance(int studentId, Money totalCharged, Money totalPaid)
+{
+    m_studentId = studentId;
+    m_totalCharged = totalCharged;
+    m_totalPaid = totalPaid;
+}
+
+/**
+ * @return The ID of the student
+ */
+int StudentBalance::studentId() const
+{
+    return m_studentId;
+}
+
+/**
+ * Sets the ID of the student
+ * @param studentId - The new student ID
+ */
+void StudentBalance::setStudentId(int studentId)
+{
+    m_studentId = studentId;
+}
+
+/**
+ * @return Total amount billed to the student
+ */
+Money StudentBalance::totalCharged() const
+{
+    return m_totalCharged;
+}
+
+/**
+ * Sets the total amount billed to the student
+ * @param totalCharged - The new total
+ */
+void StudentBalance::setTotalCharged(Money totalCharged)
+{
+    m_totalCharged = totalCharged;
+}
+
+/**
+ * @return Total amount of settled payments
+ */
+Money StudentBalance::totalPaid() const
+{
+    return m_totalPaid;
+}
+
+/**
+ * Sets the total amount of settled payments
+ * @param totalPaid - The new total
+ */
+void StudentBalance::setTotalPaid(Money totalPaid)
+{
+    m_totalPaid = totalPaid;
+}
+
+/**
+ * @return The outstanding amount (charged minus paid)
+ */
+Money StudentBalance::balance() const
+{
+    return m_totalCharged - m_totalPaid;
+}
+
+/**
+ * @return The timestamp of the last ledger update
+ */
+QDateTime StudentBalance::updatedAt() const
+{
+    return m_updatedAt;
+}
+
+/**
+ * Sets the timestamp of the last ledger update
+ * @param updatedAt - The new timestamp
+ */
+void StudentBalance::setUpdatedAt(const QDateTime& updatedAt)
+{
+    m_updatedAt = updatedAt;
+}
+
+/**
+ * @return The student's unique number (for display)
+ */
+QString StudentBalance::studentNumber() const
+{
+    return m_studentNumber;
+}
+
+/**
+ * Sets the student's unique number
+ * @param studentNumber - The student number
+ */
+void StudentBalance::setStudentNumber(const QString& studentNumber)
+{
+    m_studentNumber = studentNumber;
+}
+
+/**
+ * @return The student's full name (for display)
+ */
+QString StudentBalance::fullName() const
+{
+    return m_fullName;
+}
+
+/**
+ * Sets the student's full name
+ * @param fullName - The full name
+ */
+void StudentBalance::setFullName(const QString& fullName)
+{
+    m_fullName = fullName;
+}
@@ -0,0 +1,44 @@
+#ifndef STUDENT_BALANCE_H
+#define STUDENT_BALANCE_H
+
+#include <QString>
+#include <QDateTime>
+#include "money.h"
+
+class StudentBalance
+{
+public:
+    StudentBalance();
+    StudentBalance(int studentId, Money totalCharged, Money totalPaid);
+
+    int studentId() const;
+    void setStudentId(int studentId);
+
+    Money totalCharged() const;
+    void setTotalCharged(Money totalCharged);
+
+    Money totalPaid() const;
+    void setTotalPaid(Money totalPaid);
+
+    Money balance() const;
+
+    QDateTime updatedAt() const;
+    void setUpdatedAt(const QDateTime& updatedAt);
+
+    // Helper
+    QString studentNumber() const;
+    void setStudentNumber(const QString& studentNumber);
+
+    QString fullName() const;
+    void setFullName(const QString& fullName);
+
+private:
+    int m_studentId;
+    Money m_totalCharged;
+    Money m_totalPaid;
+    QDateTime m_updatedAt;
+    QString m_studentNumber;
+    QString m_fullName;
+};
+
+#endif // STUDENT_BALANCE_H
@@ -1,12 +1,13 @@
 #include "student_data.h"
+#include "stringpool.h"
 
 /**
  * Default Constructor
  * Initializes a new student data instance with default values.
  */
 StudentData::StudentData()
-    : m_id(0), m_userId(0), m_departmentId(0), m_collegeId(0), m_academicLevelId(0), m_sectionId(0), m_tuitionFees(0.0),
-      m_levelName(""), m_sectionName("")
+    : m_id(0), m_userId(0), m_departmentId(0), m_collegeId(0), m_academicLevelId(0), m_sectionId(0),
+      m_status(StudentStatus::Active), m_statusKept(false), m_role(UserRole::Unknown), m_levelName(""), m_sectionName(""), m_tuitionFees()
 {
 }
 
@@ -31,14 +32,15 @@ StudentData::StudentData(int id, int userId, const QString &studentNumber, const
     m_idNumber = idNumber;
     m_phone = phone;
     m_dob = dob;
-    m_department = department;
+    m_department = StringPool::instance().intern(department);
     m_departmentId = 0;
     m_collegeId = 0;
     m_sectionId = sectionId;
     m_seatNumber = seatNumber;
-    m_status = status;
+    setStatus(status);
+    m_role = UserRole::Unknown;
     m_academicLevelId = 0;
-    m_tuitionFees = 0.0;
+    m_tuitionFees = Money();
     m_levelName = "";
     m_sectionName = "";
     m_createdAt = QDateTime::currentDateTime();
@@ -120,7 +122,7 @@ QString StudentData::department() const { return m_department; }
  * Sets the student's department name
  * @param department - The new department name
  */
-void StudentData::setDepartment(const QString &department) { m_department = department; }
+void StudentData::setDepartment(const QString &department) { m_department = StringPool::instance().intern(department); }
 
 /**
  * @return The ID of the department the student belongs to
@@ -169,13 +171,37 @@ void StudentData::setSeatNumber(const QString &seatNumber) { m_seatNumber = seat
 /**
  * @return The student's academic status
  */
-QString StudentData::status() const { return m_status; }
+StudentStatus StudentData::status() const { return m_status; }
+
+/**
+ * @return The student's academic status as stored (e.g., "active", "deleted");
+ *         text read from storage is returned unchanged, even if empty
+ */
+QString StudentData::statusName() const { return m_statusKept ? m_statusText : studentStatusName(m_status); }
 
 /**
  * Sets the student's academic status
  * @param status - The new status
  */
-void StudentData::setStatus(const QString &status) { m_status = status; }
+void StudentData::setStatus(StudentStatus status)
+{
+    m_status = status;
+    m_statusKept = false;
+    m_statusText = QString();
+}
+
+/**
+ * Sets the student's academic status from its stored text
+ * Only text that differs from the canonical name is kept; the common case
+ * holds no string
+ * @param status - The status text (matched case-insensitively; unknown values read as active)
+ */
+void StudentData::setStatus(const QString &status)
+{
+    m_status = studentStatusFromName(status);
+    m_statusKept = status != studentStatusName(m_status);
+    m_statusText = m_statusKept ? status : QString();
+}
 
 /**
  * @return The timestamp when the student data was created
@@ -224,13 +250,24 @@ void StudentData::setUsername(const QString &username) { m_username = username;
 /**
  * @return The user's role (derived/joined from User)
  */
-QString StudentData::role() const { return m_role; }
+UserRole StudentData::role() const { return m_role; }
+
+/**
+ * @return The user's role as stored (e.g., "student")
+ */
+QString StudentData::roleName() const { return ::roleName(m_role); }
 
 /**
  * Sets the user's role
  * @param role - The new role
  */
-void StudentData::setRole(const QString &role) { m_role = role; }
+void StudentData::setRole(UserRole role) { m_role = role; }
+
+/**
+ * Sets the user's role from its stored text
+ * @param role - The role text
+ */
+void StudentData::setRole(const QString &role) { m_role = roleFromName(role); }
 
 /**
  * @return The ID of the college the student belongs to
@@ -252,18 +289,18 @@ QString StudentData::collegeName() const { return m_collegeName; }
  * Sets the college name
  * @param collegeName - The new college name
  */
-void StudentData::setCollegeName(const QString &collegeName) { m_collegeName = collegeName; }
+void StudentData::setCollegeName(const QString &collegeName) { m_collegeName = StringPool::instance().intern(collegeName); }
 
 /**
  * @return The tuition fees applicable to the student
  */
-double StudentData::tuitionFees() const { return m_tuitionFees; }
+Money StudentData::tuitionFees() const { return m_tuitionFees; }
 
 /**
  * Sets the tuition fees
  * @param fees - The new fees amount
  */
-void StudentData::setTuitionFees(double fees) { m_tuitionFees = fees; }
+void StudentData::setTuitionFees(Money fees) { m_tuitionFees = fees; }
 
 /**
  * @return The name of the academic level (derived/joined)
@@ -274,7 +311,7 @@ QString StudentData::levelName() const { return m_levelName; }
  * Sets the academic level name
  * @param levelName - The new level name
  */
-void StudentData::setLevelName(const QString &levelName) { m_levelName = levelName; }
+void StudentData::setLevelName(const QString &levelName) { m_levelName = StringPool::instance().intern(levelName); }
 
 /**
  * @return The name of the section (derived/joined)
@@ -285,4 +322,4 @@ QString StudentData::sectionName() const { return m_sectionName; }
  * Sets the section name
  * @param sectionName - The new section name
  */
-void StudentData::setSectionName(const QString &sectionName) { m_sectionName = sectionName; }
+void StudentData::setSectionName(const QString &sectionName) { m_sectionName = StringPool::instance().intern(sectionName); }
@@ -3,6 +3,8 @@
 
 #include <QString>
 #include <QDateTime>
+#include "money.h"
+#include "domain_types.h"
 
 class StudentData
 {
@@ -43,7 +45,9 @@ public:
     QString seatNumber() const;
     void setSeatNumber(const QString &seatNumber);
 
-    QString status() const;
+    StudentStatus status() const;
+    QString statusName() const;
+    void setStatus(StudentStatus status);
     void setStatus(const QString &status);
 
     QDateTime createdAt() const;
@@ -68,7 +72,9 @@ public:
     void setUsername(const QString &username);
 
     // Helper to store joined role
-    QString role() const;
+    UserRole role() const;
+    QString roleName() const;
+    void setRole(UserRole role);
     void setRole(const QString &role);
 
     int collegeId() const;
@@ -77,8 +83,8 @@ public:
     QString collegeName() const;
     void setCollegeName(const QString &collegeName);
 
-    double tuitionFees() const;
-    void setTuitionFees(double fees);
+    Money tuitionFees() const;
+    void setTuitionFees(Money fees);
 
 private:
     int m_id;
@@ -93,16 +99,18 @@ private:
     int m_academicLevelId;
     int m_sectionId;
     QString m_seatNumber;
-    QString m_status;
+    StudentStatus m_status;
+    bool m_statusKept;    // The stored text was not the canonical name; m_statusText holds it
+    QString m_statusText; // Written back unchanged, so odd casing or an empty status survives a save
     QDateTime m_createdAt;
     QDateTime m_updatedAt;
     QString m_fullName; // Joined from User
     QString m_username; // Joined from User
-    QString m_role;     // Joined from User
+    UserRole m_role;    // Joined from User
     QString m_levelName; // Joined from Academic Levels
     QString m_sectionName; // Joined/Computed from Section
     QString m_collegeName; 
-    double m_tuitionFees;
+    Money m_tuitionFees;
 };
 
 #endif // STUDENT_DATA_H
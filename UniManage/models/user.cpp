@@ -4,7 +4,7 @@
  * Default Constructor
  * Initializes a new user instance with default values.
  */
-User::User() : m_id(0)
+User::User() : m_id(0), m_role(UserRole::Unknown)
 {
 }
 
@@ -22,7 +22,7 @@ User::User(int id, const QString& fullName, const QString& username, const QStri
     m_fullName = fullName;
     m_username = username;
     m_password = password;
-    m_role = role;
+    setRole(role);
     m_createdAt = QDateTime::currentDateTime();
     m_updatedAt = QDateTime::currentDateTime();
 }
@@ -90,16 +90,35 @@ void User::setPassword(const QString& password) {
 /**
  * @return The role of the user
  */
-QString User::role() const {
+UserRole User::role() const {
     return m_role;
 }
 
+/**
+ * @return The role of the user as stored (e.g., "admin"); text read from
+ *         storage keeps its casing, so saving a user does not rewrite it
+ */
+QString User::roleName() const {
+    return m_roleText.isNull() ? ::roleName(m_role) : m_roleText;
+}
+
 /**
  * Sets the role of the user
  * @param role - The new role
  */
-void User::setRole(const QString& role) {
+void User::setRole(UserRole role) {
     m_role = role;
+    m_roleText = QString();
+}
+
+/**
+ * Sets the role of the user from its stored text
+ * The role is matched case-insensitively; the text itself is kept as given
+ * @param role - The role text (unknown values read as UserRole::Unknown)
+ */
+void User::setRole(const QString& role) {
+    m_role = roleFromName(role);
+    m_roleText = role;
 }
 
 /**
@@ -3,6 +3,7 @@
 
 #include <QString>
 #include <QDateTime>
+#include "domain_types.h"
 
 class User
 {
@@ -22,7 +23,9 @@ public:
     QString password() const;
     void setPassword(const QString& password);
 
-    QString role() const;
+    UserRole role() const;
+    QString roleName() const;
+    void setRole(UserRole role);
     void setRole(const QString& role);
 
     QDateTime createdAt() const;
@@ -36,7 +39,8 @@ private:
     QString m_fullName;
     QString m_username;
     QString m_password;
-    QString m_role;
+    UserRole m_role;
+    QString m_roleText; // The role as read, written back unchanged; null when set from the enum
     QDateTime m_createdAt;
     QDateTime m_updatedAt;
 };
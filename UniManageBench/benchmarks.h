@@ -0,0 +1,27 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "benchrunner.h"
+#include <QString>
+
+/**
+ * Data set size and scratch location shared by all suites
+ */
+struct BenchConfig
+{
+    int students = 5000;
+    int coursesPerStudent = 5;
+    QString scratchDir;
+};
+
+// CSV DAOs used by the CLI: load, point lookup, insert + save
+void runCsvBenchmarks(BenchRunner& runner, const BenchConfig& config);
+
+// Grade calculation over large batches of enrollments
+void runGradeBenchmarks(BenchRunner& runner, const BenchConfig& config);
+
+// Seeds the open database (unless seed is false) and times the controller
+// row-mapping paths and the admin panel table refreshes
+bool runDatabaseBenchmarks(BenchRunner& runner, const BenchConfig& config, bool seed);
+
+#endif // BENCHMARKS_H
@@ -0,0 +1,151 @@
+#include "benchrunner.h"
+#include "database/querytracker.h"
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QTextStream>
+#include <QtGlobal>
+#include <algorithm>
+#include <vector>
+
+/**
+ * Constructor for the BenchRunner class
+ * Runs every benchmark at its default iteration count
+ */
+BenchRunner::BenchRunner()
+    : m_iterationScale(1.0)
+{
+}
+
+/**
+ * Restricts the run to benchmarks whose name matches a pattern
+ * @param pattern - A regular expression; empty selects everything
+ */
+void BenchRunner::setFilter(const QString& pattern)
+{
+    m_filter = QRegularExpression(pattern);
+}
+
+/**
+ * Scales every benchmark's iteration count, e.g. 0.1 for a quick smoke run
+ * @param scale - The factor; each benchmark still runs at least once
+ */
+void BenchRunner::setIterationScale(double scale)
+{
+    m_iterationScale = scale > 0.0 ? scale : 1.0;
+}
+
+/**
+ * @param name - A benchmark name
+ * @return True if the filter selects it
+ */
+bool BenchRunner::selected(const QString& name) const
+{
+    return m_filter.pattern().isEmpty() || m_filter.match(name).hasMatch();
+}
+
+/**
+ * Runs and times one benchmark
+ * @param name - Dotted name, e.g. "csv.students.load"
+ * @param iterations - Timed iterations at scale 1
+ * @param body - The code to time; must do the same work every call
+ * @param itemsPerIteration - Operations performed by one call of body
+ */
+void BenchRunner::run(const QString& name, int iterations, const std::function<void()>& body,
+                      qint64 itemsPerIteration)
+{
+    if (!selected(name)) return;
+
+    const int count = qMax(1, int(iterations * m_iterationScale));
+    body();
+
+    std::vector<qint64> samples;
+    samples.reserve(count);
+    QElapsedTimer timer;
+    for (int i = 0; i < count; ++i) {
+        timer.start();
+        body();
+        samples.push_back(timer.nsecsElapsed());
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Result result;
+    result.name = name;
+    result.iterations = count;
+    result.itemsPerIteration = qMax(Q_INT64_C(1), itemsPerIteration);
+    result.minNs = samples.front();
+    result.medianNs = samples[samples.size() / 2];
+    result.p95Ns = samples[qMin(samples.size() - 1, size_t(samples.size() * 0.95))];
+    double total = 0.0;
+    for (qint64 sample : samples) total += sample;
+    result.meanNs = total / samples.size();
+    m_results.append(result);
+
+    QTextStream(stderr) << QString("%1  median %2 ms  (%3 iterations)\n")
+                               .arg(name, -45)
+                               .arg(result.medianNs / 1e6, 0, 'f', 3)
+                               .arg(count);
+}
+
+/**
+ * Runs and times one benchmark with N+1 detection
+ * Every call of body is a QueryTracker scope; a statement template that runs
+ * more than QueryTracker::threshold() times in one call is recorded as a
+ * violation (once per benchmark)
+ * @param name - Dotted name, e.g. "admin.refresh.students"
+ * @param iterations - Timed iterations at scale 1
+ * @param body - The code to time; must do the same work every call
+ */
+void BenchRunner::runTracked(const QString& name, int iterations, const std::function<void()>& body)
+{
+    run(name, iterations, [this, &name, &body]() {
+        QueryTracker::Scope scope(name);
+        body();
+        for (const QString& statement : scope.violations()) {
+            const QString violation = name + ": " + statement;
+            if (!m_queryViolations.contains(violation)) m_queryViolations.append(violation);
+        }
+    });
+}
+
+/**
+ * @return Everything measured so far, in run order
+ */
+const QList<BenchRunner::Result>& BenchRunner::results() const
+{
+    return m_results;
+}
+
+/**
+ * @return N+1 patterns found by tracked benchmarks, "name: template"
+ */
+const QStringList& BenchRunner::queryViolations() const
+{
+    return m_queryViolations;
+}
+
+/**
+ * @return The results as {"benchmarks": [...], "query_violations": [...]},
+ *         times in nanoseconds
+ */
+QJsonObject BenchRunner::toJson() const
+{
+    QJsonArray benchmarks;
+    for (const Result& r : m_results) {
+        QJsonObject entry;
+        entry["name"] = r.name;
+        entry["iterations"] = r.iterations;
+        entry["items_per_iteration"] = double(r.itemsPerIteration);
+        entry["min_ns"] = double(r.minNs);
+        entry["median_ns"] = double(r.medianNs);
+        entry["p95_ns"] = double(r.p95Ns);
+        entry["mean_ns"] = r.meanNs;
+        entry["median_ns_per_item"] = double(r.medianNs) / r.itemsPerIteration;
+        entry["items_per_second"] = r.medianNs > 0 ? r.itemsPerIteration * 1e9 / r.medianNs : 0.0;
+        benchmarks.append(entry);
+    }
+
+    QJsonObject root;
+    root["benchmarks"] = benchmarks;
+    root["query_violations"] = QJsonArray::fromStringList(m_queryViolations);
+    return root;
+}
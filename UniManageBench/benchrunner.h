@@ -0,0 +1,54 @@
+#ifndef BENCHRUNNER_H
+#define BENCHRUNNER_H
+
+#include <QList>
+#include <QString>
+#include <QJsonObject>
+#include <QRegularExpression>
+#include <QStringList>
+#include <functional>
+
+/**
+ * Times benchmark bodies and collects the results as JSON
+ * Each benchmark runs once untimed as a warm-up, then the requested number
+ * of timed iterations. An iteration may process several items (e.g. 1000
+ * lookups); per-item figures are reported alongside per-iteration ones.
+ * Tracked benchmarks also run every call inside a QueryTracker scope and
+ * record the statements it flags as N+1 patterns.
+ */
+class BenchRunner
+{
+public:
+    struct Result
+    {
+        QString name;
+        int iterations = 0;
+        qint64 itemsPerIteration = 1;
+        qint64 minNs = 0;
+        qint64 medianNs = 0;
+        qint64 p95Ns = 0;
+        double meanNs = 0.0;
+    };
+
+    BenchRunner();
+
+    void setFilter(const QString& pattern);
+    void setIterationScale(double scale);
+
+    bool selected(const QString& name) const;
+    void run(const QString& name, int iterations, const std::function<void()>& body,
+             qint64 itemsPerIteration = 1);
+    void runTracked(const QString& name, int iterations, const std::function<void()>& body);
+
+    const QList<Result>& results() const;
+    const QStringList& queryViolations() const;
+    QJsonObject toJson() const;
+
+private:
+    QRegularExpression m_filter;
+    double m_iterationScale;
+    QList<Result> m_results;
+    QStringList m_queryViolations; // "benchmark: statement template"
+};
+
+#endif // BENCHRUNNER_H
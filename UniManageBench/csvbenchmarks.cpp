@@ -0,0 +1,117 @@
+#include "benchmarks.h"
+#include "persistence/csv_student_dao.h"
+#include "persistence/csv_user_dao.h"
+#include <QFile>
+#include <QStringConverter>
+#include <QTextStream>
+#include <QRandomGenerator>
+
+namespace {
+
+const int LookupsPerIteration = 1000;
+
+/**
+ * Writes a students_data.csv with the given number of rows
+ * Rows are written directly; inserting through the DAO rewrites the whole
+ * file per row and would take longer than the benchmarks themselves
+ */
+bool writeStudentsCsv(const QString& path, int rows)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) return false;
+
+    QTextStream out(&file);
+    out.setEncoding(QStringConverter::Utf8);
+    out << "id,user_id,student_number,id_number,dob,department,department_id,academic_level_id,"
+           "section_id,college_id,tuition_fees,seat_number,status,created_at,updated_at\n";
+    for (int i = 1; i <= rows; ++i) {
+        out << i << ',' << i << ',' << QString("S%1").arg(i, 7, 10, QChar('0')) << ','
+            << QString("3%1").arg(i, 13, 10, QChar('0')) << ",2004-05-17,Computer Science,"
+            << (i % 20 + 1) << ',' << (i % 4 + 1) << ',' << (i % 40 + 1) << ',' << (i % 5 + 1)
+            << ",12000.00," << i << ",active,2025-09-01,2025-09-01\n";
+    }
+    return true;
+}
+
+/**
+ * Writes a users.csv with the given number of student accounts
+ */
+bool writeUsersCsv(const QString& path, int rows)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Text | QIODevice::Truncate)) return false;
+
+    QTextStream out(&file);
+    out.setEncoding(QStringConverter::Utf8);
+    out << "id,full_name,username,password,role,created_at,updated_at\n";
+    for (int i = 1; i <= rows; ++i) {
+        out << i << ",Student " << i << ',' << QString("S%1").arg(i, 7, 10, QChar('0'))
+            << ",0000000000000000000000000000000000000000000000000000000000000000,student,"
+               "2025-09-01,2025-09-01\n";
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * Times the CSV DAOs the CLI uses on files of config.students rows
+ * @param runner - Collects the results
+ * @param config - Row count and scratch directory
+ */
+void runCsvBenchmarks(BenchRunner& runner, const BenchConfig& config)
+{
+    const int rows = config.students;
+    const QString studentsPath = config.scratchDir + "/students_data.csv";
+    const QString usersPath = config.scratchDir + "/users.csv";
+    if (!writeStudentsCsv(studentsPath, rows) || !writeUsersCsv(usersPath, rows)) {
+        qWarning("Could not write the CSV fixtures to %s", qPrintable(config.scratchDir));
+        return;
+    }
+
+    runner.run("csv.students.load", 20, [&]() {
+        CsvStudentDAO dao(studentsPath);
+        Q_UNUSED(dao);
+    }, rows);
+
+    runner.run("csv.users.load", 20, [&]() {
+        CsvUserDAO dao(usersPath);
+        Q_UNUSED(dao);
+    }, rows);
+
+    CsvStudentDAO students(studentsPath);
+    CsvUserDAO users(usersPath);
+
+    runner.run("csv.students.get_by_id", 20, [&]() {
+        QRandomGenerator rng(1);
+        for (int i = 0; i < LookupsPerIteration; ++i) {
+            students.getById(rng.bounded(rows) + 1);
+        }
+    }, LookupsPerIteration);
+
+    runner.run("csv.students.get_by_student_number", 20, [&]() {
+        QRandomGenerator rng(2);
+        for (int i = 0; i < LookupsPerIteration; ++i) {
+            students.getByStudentNumber(QString("S%1").arg(rng.bounded(rows) + 1, 7, 10, QChar('0')));
+        }
+    }, LookupsPerIteration);
+
+    runner.run("csv.users.get_by_username", 20, [&]() {
+        QRandomGenerator rng(3);
+        for (int i = 0; i < LookupsPerIteration; ++i) {
+            users.getByUsername(QString("S%1").arg(rng.bounded(rows) + 1, 7, 10, QChar('0')));
+        }
+    }, LookupsPerIteration);
+
+    // Each insert rewrites the whole file, so this grows with the row count
+    int nextNumber = rows + 1;
+    runner.run("csv.students.insert_save", 20, [&]() {
+        StudentData student;
+        student.setUserId(nextNumber);
+        student.setStudentNumber(QString("S%1").arg(nextNumber, 7, 10, QChar('0')));
+        student.setIdNumber(QString("3%1").arg(nextNumber, 13, 10, QChar('0')));
+        student.setStatus("active");
+        ++nextNumber;
+        students.insert(student);
+    });
+}
@@ -0,0 +1,148 @@
+#include "benchmarks.h"
+#include "controllers/studentcontroller.h"
+#include "controllers/enrollmentcontroller.h"
+#include "controllers/coursecontroller.h"
+#include "controllers/professorcontroller.h"
+#include "controllers/sectioncontroller.h"
+#include "controllers/collegecontroller.h"
+#include "controllers/departmentcontroller.h"
+#include "controllers/academic_level_controller.h"
+#include "controllers/roomcontroller.h"
+#include "controllers/schedulecontroller.h"
+#include "controllers/calendarcontroller.h"
+#include "controllers/datagenerator.h"
+#include <QRandomGenerator>
+#include <QDebug>
+
+namespace {
+
+const int LookupsPerIteration = 200;
+
+/**
+ * Fills the database with a university of config.students students
+ * Attendance and payments are left out; no benchmark reads them
+ * @param config - Data set size
+ * @return True if every row was inserted
+ */
+bool seed(const BenchConfig& config)
+{
+    DataGenerator::Scale scale;
+    scale.students = config.students;
+    scale.coursesPerStudent = config.coursesPerStudent;
+    scale.attendanceDays = 0;
+    scale.paymentsPerStudent = 0;
+    scale.seed = 7;
+    return DataGenerator(scale).generateToDatabase();
+}
+
+} // namespace
+
+/**
+ * Times the controller row-mapping paths and the admin table refreshes
+ * @param runner - Collects the results
+ * @param config - Data set size
+ * @param seedData - False to run against the data already in the database
+ * @return False if seeding failed
+ */
+bool runDatabaseBenchmarks(BenchRunner& runner, const BenchConfig& config, bool seedData)
+{
+    if (seedData && !seed(config)) {
+        qWarning() << "Could not seed the benchmark database";
+        return false;
+    }
+
+    QList<int> studentIds;
+    StudentController().forEachStudent(nullptr, [&](const StudentData& s) {
+        studentIds.append(s.id());
+        return true;
+    });
+    QList<int> courseIds;
+    CourseController().forEachCourse(nullptr, [&](const Course& c) {
+        courseIds.append(c.id());
+        return true;
+    });
+    if (studentIds.isEmpty() || courseIds.isEmpty()) {
+        qWarning() << "No students or courses to benchmark against";
+        return false;
+    }
+
+    // Row mapping
+    runner.run("db.students.get_all", 20, []() {
+        StudentController().getAllStudents();
+    }, studentIds.size());
+
+    runner.run("db.students.for_each", 20, []() {
+        qint64 total = 0;
+        StudentController().forEachStudent(nullptr, [&total](const StudentData& s) {
+            total += s.id();
+            return true;
+        });
+    }, studentIds.size());
+
+    runner.run("db.students.get_by_id", 20, [&]() {
+        QRandomGenerator rng(11);
+        StudentController controller;
+        for (int i = 0; i < LookupsPerIteration; ++i) {
+            controller.getStudentById(studentIds.at(rng.bounded(studentIds.size())));
+        }
+    }, LookupsPerIteration);
+
+    runner.run("db.enrollments.by_course", 10, [&]() {
+        EnrollmentController controller;
+        for (int id : courseIds) controller.getEnrollmentsByCourse(id);
+    }, courseIds.size());
+
+    runner.run("db.enrollments.by_student", 20, [&]() {
+        QRandomGenerator rng(12);
+        EnrollmentController controller;
+        for (int i = 0; i < LookupsPerIteration; ++i) {
+            controller.getEnrollmentsByStudent(studentIds.at(rng.bounded(studentIds.size())));
+        }
+    }, LookupsPerIteration);
+
+    // Admin panel refreshes: the fetch half of each table's loader, checked for N+1 queries
+    runner.runTracked("admin.refresh.students", 20, []() {
+        StudentController().getAllStudents();
+        AcademicLevelController().getAllAcademicLevels();
+    });
+    runner.runTracked("admin.refresh.draft", 20, []() {
+        StudentController().getDeletedStudents();
+        AcademicLevelController().getAllAcademicLevels();
+    });
+    runner.runTracked("admin.refresh.courses", 20, []() {
+        CourseController().getAllCourses();
+        AcademicLevelController().getAllAcademicLevels();
+    });
+    runner.runTracked("admin.refresh.professors", 20, []() { ProfessorController().getAllProfessors(); });
+    runner.runTracked("admin.refresh.sections", 20, []() {
+        SectionController().getAllSections();
+        AcademicLevelController().getAllAcademicLevels();
+    });
+    runner.runTracked("admin.refresh.colleges", 20, []() { CollegeController().getAllColleges(); });
+    runner.runTracked("admin.refresh.departments", 20, []() { DepartmentController().getAllDepartments(); });
+    runner.runTracked("admin.refresh.levels", 20, []() { AcademicLevelController().getAllAcademicLevels(); });
+    runner.runTracked("admin.refresh.rooms", 20, []() { RoomController().getAllRooms(); });
+    runner.runTracked("admin.refresh.schedules", 20, []() { ScheduleController().getScheduleTableRows(); });
+    runner.runTracked("admin.refresh.calendar", 20, []() { CalendarController().getAllEvents(); });
+
+    runner.runTracked("admin.refresh.all", 10, []() {
+        StudentController().getAllStudents();
+        StudentController().getDeletedStudents();
+        CourseController().getAllCourses();
+        ProfessorController().getAllProfessors();
+        SectionController().getAllSections();
+        CollegeController().getAllColleges();
+        DepartmentController().getAllDepartments();
+        AcademicLevelController().getAllAcademicLevels();
+        RoomController().getAllRooms();
+        ScheduleController().getScheduleTableRows();
+        CalendarController().getAllEvents();
+    });
+
+    // Patching the rows of students changed elsewhere (AdminPanel::applyStudentChanges)
+    const QList<int> changedIds = studentIds.mid(0, LookupsPerIteration);
+    runner.runTracked("admin.patch.students", 20, [&]() {
+        StudentController().getStudentsByIds(changedIds);
+    });
+    return true;
+}
@@ -0,0 +1,63 @@
+#include "benchmarks.h"
+#include "controllers/enrollmentcontroller.h"
+#include "controllers/gradestatistics.h"
+#include <QRandomGenerator>
+#include <QVector>
+
+namespace {
+
+/**
+ * Builds a batch of enrollments with plausible component marks
+ * @param count - Batch size
+ */
+QVector<Enrollment> makeEnrollments(int count)
+{
+    QRandomGenerator rng(42);
+    QVector<Enrollment> batch;
+    batch.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        Enrollment e;
+        e.setId(i + 1);
+        e.setAssignment1Grade(rng.bounded(11));
+        e.setAssignment2Grade(rng.bounded(11));
+        e.setCourseworkGrade(rng.bounded(21));
+        e.setFinalExamGrade(rng.bounded(61));
+        e.setExperienceGrade(i % 3 == 0 ? rng.bounded(51) : 0);
+        batch.append(e);
+    }
+    return batch;
+}
+
+} // namespace
+
+/**
+ * Times grade calculation over batches the size of a whole university's
+ * enrollments (students x courses per student)
+ * @param runner - Collects the results
+ * @param config - Data set size
+ */
+void runGradeBenchmarks(BenchRunner& runner, const BenchConfig& config)
+{
+    const int count = config.students * config.coursesPerStudent;
+    QVector<Enrollment> batch = makeEnrollments(count);
+    EnrollmentController controller;
+
+    runner.run("grades.calculate_total_and_grade", 20, [&]() {
+        for (int i = 0; i < batch.size(); ++i) {
+            controller.calculateTotalAndGrade(batch[i], CourseType::Theoretical, i % 3 == 0 ? 150 : 100);
+        }
+    }, count);
+
+    runner.run("grades.statistics.compute", 20, [&]() {
+        GradeStatistics stats;
+        for (int i = 0; i < batch.size(); ++i) {
+            const Enrollment& e = batch[i];
+            const double grades[GradeStatistics::ColumnCount] = {
+                e.assignment1Grade(), e.assignment2Grade(), e.courseworkGrade(),
+                e.finalExamGrade(), e.experienceGrade(), e.totalGrade()
+            };
+            stats.addRow(grades, i % 3 == 0 ? 150 : 100);
+        }
+        stats.compute();
+    }, count);
+}
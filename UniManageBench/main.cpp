@@ -0,0 +1,113 @@
+#include "benchmarks.h"
+#include "database/dbconnection.h"
+#include "database/sqldialect.h"
+#include "database/querytracker.h"
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QDateTime>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+/**
+ * unimanage_bench: micro and macro benchmarks for the core library
+ *
+ * By default the database suites run against a scratch SQLite file that is
+ * created, seeded and deleted by the run. --env-db uses the database from
+ * .env instead and only reads from it.
+ *
+ * Results go to stdout (or --out) as JSON; progress goes to stderr.
+ * Exits with 2 when a tracked benchmark ran a statement once per row (see
+ * QueryTracker), 1 when it could not run at all.
+ */
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    app.setApplicationName("unimanage_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("UniManage benchmark suite");
+    parser.addHelpOption();
+    QCommandLineOption outOption("out", "Write the JSON results to <file>.", "file");
+    QCommandLineOption filterOption("filter", "Only run benchmarks matching <regex>.", "regex");
+    QCommandLineOption studentsOption("students", "Data set size in students (default 5000).", "count", "5000");
+    QCommandLineOption scaleOption("scale", "Multiply every iteration count by <factor>.", "factor", "1");
+    QCommandLineOption envDbOption("env-db", "Read from the database configured in .env instead of a scratch SQLite file.");
+    parser.addOption(outOption);
+    parser.addOption(filterOption);
+    parser.addOption(studentsOption);
+    parser.addOption(scaleOption);
+    parser.addOption(envDbOption);
+    parser.process(app);
+
+    QTemporaryDir scratch;
+    if (!scratch.isValid()) {
+        qCritical("Could not create a scratch directory");
+        return 1;
+    }
+
+    BenchConfig config;
+    config.students = qMax(1, parser.value(studentsOption).toInt());
+    config.scratchDir = scratch.path();
+
+    BenchRunner runner;
+    runner.setFilter(parser.value(filterOption));
+    runner.setIterationScale(parser.value(scaleOption).toDouble());
+
+    const bool useEnvDb = parser.isSet(envDbOption);
+    if (!useEnvDb) {
+        // DBConnection lets the process environment override .env
+        qputenv("DB_DRIVER", "sqlite");
+        qputenv("DB_PATH", (scratch.path() + "/bench.db").toUtf8());
+    }
+
+    if (!QueryTracker::isEnabled()) {
+        qWarning("Release build: the admin.* benchmarks are not checked for N+1 queries");
+    }
+
+    runCsvBenchmarks(runner, config);
+    runGradeBenchmarks(runner, config);
+
+    bool databaseOk = false;
+    if (runner.selected("db.") || runner.selected("admin.")) {
+        if (DBConnection::instance().initialize()) {
+            databaseOk = runDatabaseBenchmarks(runner, config, !useEnvDb);
+        } else {
+            qWarning("Database unavailable; skipping the db.* and admin.* benchmarks");
+        }
+    }
+
+    QJsonObject report = runner.toJson();
+    report["suite"] = "unimanage_bench";
+    report["timestamp"] = QDateTime::currentDateTimeUtc().toString(Qt::ISODate);
+    report["qt_version"] = QString(qVersion());
+    report["cpu"] = QSysInfo::currentCpuArchitecture();
+    report["os"] = QSysInfo::prettyProductName();
+    report["backend"] = SqlDialect::instance().isSqlite() ? "sqlite" : "mysql";
+    report["database"] = databaseOk;
+    report["students"] = config.students;
+    report["courses_per_student"] = config.coursesPerStudent;
+
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet(outOption)) {
+        QFile out(parser.value(outOption));
+        if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            qCritical("Could not write %s", qPrintable(out.fileName()));
+            return 1;
+        }
+        out.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+
+    // Fails the run so CI catches a refresh that went back to a query per row
+    if (!runner.queryViolations().isEmpty()) {
+        for (const QString& violation : runner.queryViolations()) {
+            qCritical("N+1 query in %s", qPrintable(violation));
+        }
+        return 2;
+    }
+    return 0;
+}
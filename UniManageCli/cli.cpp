@@ -29,7 +29,7 @@ bool Cli::login() {
 
     if (m_currentUser.id() != 0) {
         std::cout << "\n[SUCCESS] Login successful! Welcome, " << m_currentUser.fullName().toStdString() << "." << std::endl;
-        std::cout << "Role: " << m_currentUser.role().toUpper().toStdString() << std::endl;
+        std::cout << "Role: " << m_currentUser.roleName().toUpper().toStdString() << std::endl;
         return true;
     }
 
@@ -54,15 +54,19 @@ void Cli::run()
         }
 
         // Logic branching based on user role
-        QString role = m_currentUser.role().toLower();
-        if (role == "admin") {
+        switch (m_currentUser.role()) {
+        case UserRole::Admin:
             displayAdminMenu();
-        } else if (role == "student") {
+            break;
+        case UserRole::Student:
             displayStudentDashboard();
-        } else if (role == "professor") {
+            break;
+        case UserRole::Professor:
             displayProfessorDashboard();
-        } else {
+            break;
+        default:
             std::cout << "[ERROR] Unknown user role. Logging out for safety." << std::endl;
+            break;
         }
     }
 }
@@ -151,7 +155,7 @@ void Cli::displayStudentDashboard()
                 std::cout << "National ID:  " << student.idNumber().toStdString() << std::endl;
                 std::cout << "Department:   " << student.department().toStdString() << std::endl;
                 std::cout << "Join Date:    " << m_currentUser.createdAt().toString("yyyy-MM-dd").toStdString() << std::endl;
-                std::cout << "Status:       " << student.status().toStdString() << std::endl;
+                std::cout << "Status:       " << student.statusName().toStdString() << std::endl;
                 std::cout << "-----------------------" << std::endl;
             }
         } else if (choice == 2) {
@@ -406,22 +410,23 @@ void Cli::displayUserMenu()
 
 void Cli::listAllStudents()
 {
-    QList<StudentData> students = m_controller.getAllStudents();
-
-    if (students.isEmpty()) {
-        std::cout << "No students found." << std::endl;
-        return;
-    }
-
-    std::cout << "\n--- All Students ---" << std::endl;
-    printf("%-25s | %-5s | %-15s | %-20s\n", "Name", "ID", "Code", "National ID");
-    printf("--------------------------|-------|-----------------|----------------------\n");
-    for (const auto &student : students) {
+    int printed = 0;
+    m_controller.forEachStudent([&printed](const StudentData& student) {
+        if (printed++ == 0) {
+            std::cout << "\n--- All Students ---" << std::endl;
+            printf("%-25s | %-5s | %-15s | %-20s\n", "Name", "ID", "Code", "National ID");
+            printf("--------------------------|-------|-----------------|----------------------\n");
+        }
         printf("%-25s | %-5d | %-15s | %-20s\n",
                 student.fullName().toStdString().c_str(),
                 student.id(),
                 student.studentNumber().toStdString().c_str(),
                 student.idNumber().toStdString().c_str());
+        return true;
+    });
+
+    if (printed == 0) {
+        std::cout << "No students found." << std::endl;
     }
 }
 
@@ -442,7 +447,7 @@ void Cli::findStudentById()
         std::cout << "Student Code: " << student.studentNumber().toStdString() << std::endl;
         std::cout << "ID Number: " << student.idNumber().toStdString() << std::endl;
         std::cout << "Department: " << student.department().toStdString() << std::endl;
-        std::cout << "Status: " << student.status().toStdString() << std::endl;
+        std::cout << "Status: " << student.statusName().toStdString() << std::endl;
     }
 }
 
@@ -469,7 +474,7 @@ void Cli::addStudent()
     user.setFullName(fullName);
     user.setUsername(code);
     user.setPassword(nationalId);
-    user.setRole("student");
+    user.setRole(UserRole::Student);
 
     if (m_controller.addUser(user)) {
          student.setUserId(user.id());
@@ -494,7 +499,7 @@ void Cli::addStudent()
     std::cout << "College ID: ";
     student.setCollegeId(qtin.readLine().trimmed().toInt());
 
-    student.setStatus("active");
+    student.setStatus(StudentStatus::Active);
 
     if (m_controller.addStudent(student)) {
         std::cout << "Student added successfully with ID: " << student.id() << "!" << std::endl;
@@ -535,7 +540,7 @@ void Cli::updateStudent()
     QString newDept = qtin.readLine().trimmed();
     if (!newDept.isEmpty()) student.setDepartment(newDept);
 
-    std::cout << "Status [" << student.status().toStdString() << "] (active/inactive): ";
+    std::cout << "Status [" << student.statusName().toStdString() << "] (active/inactive): ";
     QString newStatus = qtin.readLine().trimmed();
     if (!newStatus.isEmpty()) student.setStatus(newStatus);
 
@@ -586,22 +591,23 @@ void Cli::deleteStudent()
 
 void Cli::listAllCourses()
 {
-    QList<Course> courses = m_controller.getAllCourses();
-
-    if (courses.isEmpty()) {
-        std::cout << "No courses found." << std::endl;
-        return;
-    }
-
-    std::cout << "\n--- All Courses ---" << std::endl;
-    printf("%-5s | %-20s | %-30s | %-5s\n", "ID", "Name", "Description", "Credit Hours");
-    printf("------|----------------------|--------------------------------|-------------\n");
-    for (const auto &course : courses) {
+    int printed = 0;
+    m_controller.forEachCourse([&printed](const Course& course) {
+        if (printed++ == 0) {
+            std::cout << "\n--- All Courses ---" << std::endl;
+            printf("%-5s | %-20s | %-30s | %-5s\n", "ID", "Name", "Description", "Credit Hours");
+            printf("------|----------------------|--------------------------------|-------------\n");
+        }
         printf("%-5d | %-20s | %-30s | %-5d\n",
                 course.id(),
                 course.name().toStdString().c_str(),
                 course.description().toStdString().c_str(),
                 course.creditHours());
+        return true;
+    });
+
+    if (printed == 0) {
+        std::cout << "No courses found." << std::endl;
     }
 }
 
@@ -629,7 +635,7 @@ void Cli::findCourseById()
         std::cout << "Year Level: " << course.yearLevel() << std::endl;
         std::cout << "Credit Hours: " << course.creditHours() << std::endl;
         std::cout << "Semester ID: " << course.semesterId() << std::endl;
-        std::cout << "Course Type: " << course.courseType().toStdString() << std::endl;
+        std::cout << "Course Type: " << course.courseTypeName().toStdString() << std::endl;
     }
 }
 
@@ -707,7 +713,7 @@ void Cli::updateCourse()
     QString newCreditHours = qtin.readLine().trimmed();
     if (!newCreditHours.isEmpty()) course.setCreditHours(newCreditHours.toInt());
 
-    std::cout << "Course Type [" << course.courseType().toStdString() << "]: ";
+    std::cout << "Course Type [" << course.courseTypeName().toStdString() << "]: ";
     QString newCourseType = qtin.readLine().trimmed();
     if (!newCourseType.isEmpty()) course.setCourseType(newCourseType);
 
@@ -816,7 +822,7 @@ void Cli::addProfessor()
     user.setFullName(fullName);
     user.setUsername(code);
     user.setPassword(nationalId);
-    user.setRole("professor");
+    user.setRole(UserRole::Professor);
 
     if (m_controller.addUser(user)) {
          professor.setUserId(user.id());
@@ -927,7 +933,7 @@ void Cli::listAllUsers()
                 user.id(),
                 user.fullName().toStdString().c_str(),
                 user.username().toStdString().c_str(),
-                user.role().toStdString().c_str());
+                user.roleName().toStdString().c_str());
     }
 }
 
@@ -948,6 +954,10 @@ void Cli::addUser()
 
     std::cout << "Role (admin/student/professor): ";
     user.setRole(qtin.readLine().trimmed());
+    if (user.role() == UserRole::Unknown) {
+        std::cout << "Error: Unknown role." << std::endl;
+        return;
+    }
 
     if (m_controller.addUser(user)) {
         std::cout << "User added successfully with ID: " << user.id() << "!" << std::endl;
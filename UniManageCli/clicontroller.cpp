@@ -1,13 +1,26 @@
 #include "clicontroller.h"
+#include "persistence/csv_user_dao.h"
+#include "persistence/csv_student_dao.h"
+#include "persistence/csv_course_dao.h"
+#include "persistence/csv_professor_dao.h"
+#include "dao/sql_user_dao.h"
+#include "dao/sql_student_dao.h"
+#include "dao/sql_course_dao.h"
+#include "dao/sql_professor_dao.h"
+#include "database/dbconnection.h"
 #include <QCoreApplication>
+#include <QDebug>
 
 CliController::CliController()
+    : m_usesDatabase(false)
 {
-    QString basePath = QCoreApplication::applicationDirPath() + "/FileDB";
-    m_userDAO = std::make_unique<CsvUserDAO>(basePath + "/users.csv");
-    m_studentDAO = std::make_unique<CsvStudentDAO>(basePath + "/students_data.csv");
-    m_courseDAO = std::make_unique<CsvCourseDAO>(basePath + "/courses.csv");
-    m_professorDAO = std::make_unique<CsvProfessorDAO>(basePath + "/professors.csv");
+    // --db runs against the GUI's database (configured in .env) instead of FileDB
+    if (QCoreApplication::arguments().contains("--db")) {
+        m_usesDatabase = openDatabase();
+    }
+    if (!m_usesDatabase) {
+        openCsvFiles();
+    }
 
     // Initialize default admin user if no users exist
     if (m_userDAO->getAll().isEmpty()) {
@@ -15,13 +28,39 @@ CliController::CliController()
         admin.setFullName("Administrator");
         admin.setUsername("admin");
         admin.setPassword("12345678901234"); // Example 14-digit National ID
-        admin.setRole("admin");
-        m_userDAO->insert(admin);
+        admin.setRole(UserRole::Admin);
+        addUser(admin);
     }
 }
 
 CliController::~CliController() = default;
 
+bool CliController::openDatabase()
+{
+    if (!DBConnection::instance().initialize()) {
+        qWarning() << "Database unavailable, falling back to the CSV files";
+        return false;
+    }
+    m_userDAO = std::make_shared<SqlUserDAO>();
+    m_studentDAO = std::make_shared<SqlStudentDAO>();
+    m_courseDAO = std::make_shared<SqlCourseDAO>();
+    m_professorDAO = std::make_shared<SqlProfessorDAO>();
+    m_users = std::make_unique<UserController>(m_userDAO);
+    m_students = std::make_unique<StudentController>(m_studentDAO);
+    m_courses = std::make_unique<CourseController>(m_courseDAO);
+    m_professors = std::make_unique<ProfessorController>(m_professorDAO);
+    return true;
+}
+
+void CliController::openCsvFiles()
+{
+    QString basePath = QCoreApplication::applicationDirPath() + "/FileDB";
+    m_userDAO = std::make_shared<CsvUserDAO>(basePath + "/users.csv");
+    m_studentDAO = std::make_shared<CsvStudentDAO>(basePath + "/students_data.csv");
+    m_courseDAO = std::make_shared<CsvCourseDAO>(basePath + "/courses.csv");
+    m_professorDAO = std::make_shared<CsvProfessorDAO>(basePath + "/professors.csv");
+}
+
 // --- User Functions ---
 
 User CliController::authenticate(const QString& username, const QString& password)
@@ -31,17 +70,17 @@ User CliController::authenticate(const QString& username, const QString& passwor
 
 bool CliController::addUser(User& user)
 {
-    return m_userDAO->insert(user);
+    return m_users ? m_users->addUser(user) : m_userDAO->insert(user);
 }
 
 bool CliController::updateUser(const User& user)
 {
-    return m_userDAO->update(user);
+    return m_users ? m_users->updateUser(user) : m_userDAO->update(user);
 }
 
 bool CliController::deleteUser(int id)
 {
-    return m_userDAO->remove(id);
+    return m_users ? m_users->deleteUser(id) : m_userDAO->remove(id);
 }
 
 QList<User> CliController::getAllUsers()
@@ -63,14 +102,27 @@ User CliController::getUserByUsername(const QString& username)
 
 QList<StudentData> CliController::getAllStudents()
 {
-    QList<StudentData> students = m_studentDAO->getAll();
-    for (auto& student : students) {
-        User user = getUserById(student.userId());
-        student.setFullName(user.fullName());
-    }
+    QList<StudentData> students;
+    forEachStudent([&students](const StudentData& s) {
+        students.append(s);
+        return true;
+    });
     return students;
 }
 
+// Streams the active students with their names filled in, without a list copy
+bool CliController::forEachStudent(const StudentDAO::Visitor& visit)
+{
+    return m_studentDAO->forEach([&](const StudentData& s) {
+        // SQL rows already carry the name from their join; CSV rows are
+        // completed with one indexed lookup in the user store
+        if (!s.fullName().isEmpty()) return visit(s);
+        StudentData named = s;
+        named.setFullName(m_userDAO->getById(s.userId()).fullName());
+        return visit(named);
+    });
+}
+
 StudentData CliController::getStudentById(int id)
 {
     StudentData student = m_studentDAO->getById(id);
@@ -83,17 +135,18 @@ StudentData CliController::getStudentById(int id)
 
 bool CliController::addStudent(StudentData& student)
 {
-    return m_studentDAO->insert(student);
+    return m_students ? m_students->addStudent(student) : m_studentDAO->insert(student);
 }
 
 bool CliController::updateStudent(const StudentData& student)
 {
-    return m_studentDAO->update(student);
+    return m_students ? m_students->updateStudent(student) : m_studentDAO->update(student);
 }
 
 bool CliController::deleteStudent(int id)
 {
-    return m_studentDAO->softDelete(id); // or remove, but soft delete to match GUI
+    // Soft delete to match the GUI
+    return m_students ? m_students->deleteStudent(id) : m_studentDAO->softDelete(id);
 }
 
 StudentData CliController::getStudentByUserId(int userId)
@@ -123,6 +176,11 @@ QList<Course> CliController::getAllCourses()
     return m_courseDAO->getAll();
 }
 
+bool CliController::forEachCourse(const CourseDAO::Visitor& visit)
+{
+    return m_courseDAO->forEach(visit);
+}
+
 Course CliController::getCourseById(int id)
 {
     return m_courseDAO->getById(id);
@@ -130,17 +188,17 @@ Course CliController::getCourseById(int id)
 
 bool CliController::addCourse(Course& course)
 {
-    return m_courseDAO->insert(course);
+    return m_courses ? m_courses->addCourse(course) : m_courseDAO->insert(course);
 }
 
 bool CliController::updateCourse(const Course& course)
 {
-    return m_courseDAO->update(course);
+    return m_courses ? m_courses->updateCourse(course) : m_courseDAO->update(course);
 }
 
 bool CliController::deleteCourse(int id)
 {
-    return m_courseDAO->remove(id);
+    return m_courses ? m_courses->deleteCourse(id) : m_courseDAO->remove(id);
 }
 
 // --- Professor Functions ---
@@ -149,7 +207,8 @@ QList<Professor> CliController::getAllProfessors()
 {
     QList<Professor> professors = m_professorDAO->getAll();
     for (auto& prof : professors) {
-        User user = getUserById(prof.userId());
+        if (!prof.username().isEmpty()) continue; // joined in by the SQL store
+        const User user = m_userDAO->getById(prof.userId());
         prof.setFullName(user.fullName());
         prof.setUsername(user.username());
     }
@@ -163,17 +222,17 @@ Professor CliController::getProfessorById(int id)
 
 bool CliController::addProfessor(Professor& professor)
 {
-    return m_professorDAO->insert(professor);
+    return m_professors ? m_professors->addProfessor(professor) : m_professorDAO->insert(professor);
 }
 
 bool CliController::updateProfessor(const Professor& professor)
 {
-    return m_professorDAO->update(professor);
+    return m_professors ? m_professors->updateProfessor(professor) : m_professorDAO->update(professor);
 }
 
 bool CliController::deleteProfessor(int id)
 {
-    return m_professorDAO->remove(id);
+    return m_professors ? m_professors->deleteProfessor(id) : m_professorDAO->remove(id);
 }
 
 Professor CliController::getProfessorByUserId(int userId)
@@ -5,20 +5,19 @@
 #include "../UniManage/models/student_data.h"
 #include "../UniManage/models/course.h"
 #include "../UniManage/models/professor.h"
-#include "persistence/csv_user_dao.h"
-#include "persistence/csv_student_dao.h"
-#include "persistence/csv_course_dao.h"
-#include "persistence/csv_professor_dao.h"
+#include "dao/user_dao.h"
+#include "dao/student_dao.h"
+#include "dao/course_dao.h"
+#include "dao/professor_dao.h"
+#include "controllers/usercontroller.h"
+#include "controllers/studentcontroller.h"
+#include "controllers/coursecontroller.h"
+#include "controllers/professorcontroller.h"
 #include <QString>
 #include <QList>
 #include <QDateTime>
 #include <memory>
 
-class CsvUserDAO;
-class CsvStudentDAO;
-class CsvCourseDAO;
-class CsvProfessorDAO;
-
 class CliController
 {
 public:
@@ -36,6 +35,7 @@ public:
 
     // Student functions
     QList<StudentData> getAllStudents();
+    bool forEachStudent(const StudentDAO::Visitor& visit);
     StudentData getStudentById(int id);
     bool addStudent(StudentData& student);
     bool updateStudent(const StudentData& student);
@@ -45,6 +45,7 @@ public:
 
     // Course functions
     QList<Course> getAllCourses();
+    bool forEachCourse(const CourseDAO::Visitor& visit);
     Course getCourseById(int id);
     bool addCourse(Course& course);
     bool updateCourse(const Course& course);
@@ -60,10 +61,21 @@ public:
     Professor getProfessorByUsername(const QString& username);
 
 private:
-    std::unique_ptr<CsvUserDAO> m_userDAO;
-    std::unique_ptr<CsvStudentDAO> m_studentDAO;
-    std::unique_ptr<CsvCourseDAO> m_courseDAO;
-    std::unique_ptr<CsvProfessorDAO> m_professorDAO;
+    bool openDatabase();
+    void openCsvFiles();
+
+    bool m_usesDatabase;
+    std::shared_ptr<UserDAO> m_userDAO;
+    std::shared_ptr<StudentDAO> m_studentDAO;
+    std::shared_ptr<CourseDAO> m_courseDAO;
+    std::shared_ptr<ProfessorDAO> m_professorDAO;
+
+    // Set with --db only: writes to the shared database go through the
+    // controllers so the GUI sees them (change tracking, ledger, enrollment)
+    std::unique_ptr<UserController> m_users;
+    std::unique_ptr<StudentController> m_students;
+    std::unique_ptr<CourseController> m_courses;
+    std::unique_ptr<ProfessorController> m_professors;
 };
 
 #endif // CLICONTROLLER_H
@@ -0,0 +1,115 @@
+#include "generatecommand.h"
+#include "controllers/datagenerator.h"
+#include "database/dbconnection.h"
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QTextStream>
+
+namespace {
+
+/**
+ * @param parser - The processed parser
+ * @param option - An option with a numeric value
+ * @param fallback - Used when the value is missing or not a number
+ * @return The option's value
+ */
+int intValue(const QCommandLineParser& parser, const QCommandLineOption& option, int fallback)
+{
+    bool ok = false;
+    const int value = parser.value(option).toInt(&ok);
+    return ok ? value : fallback;
+}
+
+} // namespace
+
+/**
+ * unimanage_cli generate [options]
+ * Fills the .env database, or a FileDB directory with --csv, with a seeded
+ * synthetic data set (see DataGenerator)
+ * @param arguments - The process arguments, "generate" included
+ * @return The process exit code
+ */
+int runGenerateCommand(const QStringList& arguments)
+{
+    DataGenerator::Scale scale;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generates a synthetic university data set. "
+                                     "The same options and seed always produce the same data.");
+    parser.addHelpOption();
+    QCommandLineOption studentsOption("students", "Number of students.", "count", QString::number(scale.students));
+    QCommandLineOption professorsOption("professors", "Number of professors (default: one per 40 students).", "count", "0");
+    QCommandLineOption collegesOption("colleges", "Number of colleges.", "count", QString::number(scale.colleges));
+    QCommandLineOption departmentsOption("departments-per-college", "Departments in each college.", "count",
+                                         QString::number(scale.departmentsPerCollege));
+    QCommandLineOption coursesOption("courses", "Number of courses.", "count", QString::number(scale.courses));
+    QCommandLineOption sectionsOption("sections-per-course", "Sections of each course.", "count",
+                                      QString::number(scale.sectionsPerCourse));
+    QCommandLineOption roomsOption("rooms", "Number of rooms.", "count", QString::number(scale.rooms));
+    QCommandLineOption enrollmentsOption("courses-per-student", "Enrollments per student.", "count",
+                                         QString::number(scale.coursesPerStudent));
+    QCommandLineOption attendanceOption("attendance-days", "Attendance logs per enrollment.", "count",
+                                        QString::number(scale.attendanceDays));
+    QCommandLineOption paymentsOption("payments-per-student", "Payments per student.", "count",
+                                      QString::number(scale.paymentsPerStudent));
+    QCommandLineOption seedOption("seed", "Random seed.", "number", QString::number(scale.seed));
+    QCommandLineOption threadsOption("threads", "Worker threads (default: one per core).", "count", "0");
+    QCommandLineOption batchOption("batch", "Rows per INSERT statement.", "rows", QString::number(scale.batchSize));
+    QCommandLineOption csvOption("csv", "Write FileDB CSV files to <dir> instead of the database.", "dir");
+    parser.addOptions({ studentsOption, professorsOption, collegesOption, departmentsOption, coursesOption,
+                        sectionsOption, roomsOption, enrollmentsOption, attendanceOption, paymentsOption,
+                        seedOption, threadsOption, batchOption, csvOption });
+
+    QStringList parserArguments = arguments;
+    parserArguments.removeAt(1);
+    parser.process(parserArguments);
+
+    scale.students = intValue(parser, studentsOption, scale.students);
+    scale.professors = intValue(parser, professorsOption, scale.professors);
+    scale.colleges = intValue(parser, collegesOption, scale.colleges);
+    scale.departmentsPerCollege = intValue(parser, departmentsOption, scale.departmentsPerCollege);
+    scale.courses = intValue(parser, coursesOption, scale.courses);
+    scale.sectionsPerCourse = intValue(parser, sectionsOption, scale.sectionsPerCourse);
+    scale.rooms = intValue(parser, roomsOption, scale.rooms);
+    scale.coursesPerStudent = intValue(parser, enrollmentsOption, scale.coursesPerStudent);
+    scale.attendanceDays = intValue(parser, attendanceOption, scale.attendanceDays);
+    scale.paymentsPerStudent = intValue(parser, paymentsOption, scale.paymentsPerStudent);
+    scale.seed = parser.value(seedOption).toUInt();
+    scale.threads = intValue(parser, threadsOption, scale.threads);
+    scale.batchSize = intValue(parser, batchOption, scale.batchSize);
+
+    QTextStream err(stderr);
+    DataGenerator generator(scale);
+    generator.setProgressCallback([&err](const QString& table, qint64 written, qint64 planned) {
+        err << "\r" << table << ": " << written << "/" << planned;
+        if (written == planned) err << "\n";
+        err.flush();
+    });
+
+    QElapsedTimer timer;
+    timer.start();
+    bool ok = false;
+    if (parser.isSet(csvOption)) {
+        ok = generator.generateToCsv(parser.value(csvOption));
+    } else if (DBConnection::instance().initialize()) {
+        ok = generator.generateToDatabase();
+    } else {
+        err << "Database unavailable: " << DBConnection::instance().getLastError() << "\n";
+        return 1;
+    }
+
+    if (!ok) {
+        err << "Generation failed: " << generator.lastError() << "\n";
+        return 1;
+    }
+
+    QTextStream out(stdout);
+    const QMap<QString, qint64> counts = generator.rowCounts();
+    qint64 total = 0;
+    for (auto it = counts.constBegin(); it != counts.constEnd(); ++it) {
+        out << it.key() << ": " << it.value() << "\n";
+        total += it.value();
+    }
+    out << total << " rows in " << timer.elapsed() << " ms\n";
+    return 0;
+}
@@ -0,0 +1,8 @@
+#ifndef GENERATECOMMAND_H
+#define GENERATECOMMAND_H
+
+#include <QStringList>
+
+int runGenerateCommand(const QStringList& arguments);
+
+#endif // GENERATECOMMAND_H
@@ -1,6 +1,7 @@
 #include <QCoreApplication>
 #include <QDebug>
 #include "cli.h"
+#include "generatecommand.h"
 
 int main(int argc, char *argv[])
 {
@@ -8,6 +9,11 @@ int main(int argc, char *argv[])
     a.setApplicationName("UniManageCLI");
     a.setOrganizationName("UniManage");
 
+    // unimanage_cli generate [options] runs once and exits
+    if (a.arguments().value(1) == "generate") {
+        return runGenerateCommand(a.arguments());
+    }
+
     Cli cli;
     cli.run();
 
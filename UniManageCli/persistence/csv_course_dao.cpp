@@ -49,6 +49,14 @@ QList<Course> CsvCourseDAO::getAll()
     return m_courses;
 }
 
+bool CsvCourseDAO::forEach(const Visitor& visit)
+{
+    for (const auto& c : m_courses) {
+        if (!visit(c)) break;
+    }
+    return true;
+}
+
 Course CsvCourseDAO::getById(int id)
 {
     for (const auto& c : m_courses) {
@@ -70,6 +78,13 @@ QList<Course> CsvCourseDAO::getBySemester(int semesterId)
     return result;
 }
 
+QList<Course> CsvCourseDAO::getByProfessor(int professorId)
+{
+    // courses.csv has no professor assignments
+    Q_UNUSED(professorId);
+    return QList<Course>();
+}
+
 void CsvCourseDAO::loadData()
 {
     m_courses.clear();
@@ -185,7 +200,7 @@ QString CsvCourseDAO::courseToCsvLine(const Course& course) const
         .arg(course.semesterId())
         .arg(course.departmentId())
         .arg(course.maxGrade())
-        .arg(course.courseType())
+        .arg(course.courseTypeName())
         .arg(dateTimeToString(course.createdAt()))
         .arg(dateTimeToString(course.updatedAt()));
 }
@@ -20,8 +20,10 @@ public:
     bool update(const Course& course) override;
     bool remove(int id) override;
     QList<Course> getAll() override;
+    bool forEach(const Visitor& visit) override;
     Course getById(int id) override;
     QList<Course> getBySemester(int semesterId) override;
+    QList<Course> getByProfessor(int professorId) override;
 
 private:
     QString m_filePath;
@@ -46,7 +46,7 @@ bool CsvStudentDAO::softDelete(int id)
 {
     for (auto& s : m_students) {
         if (s.id() == id) {
-            s.setStatus("deleted");
+            s.setStatus(StudentStatus::Deleted);
             s.setUpdatedAt(QDateTime::currentDateTime());
             return saveData();
         }
@@ -58,7 +58,7 @@ bool CsvStudentDAO::restore(int id)
 {
     for (auto& s : m_students) {
         if (s.id() == id) {
-            s.setStatus("active");
+            s.setStatus(StudentStatus::Active);
             s.setUpdatedAt(QDateTime::currentDateTime());
             return saveData();
         }
@@ -69,19 +69,29 @@ bool CsvStudentDAO::restore(int id)
 QList<StudentData> CsvStudentDAO::getAll()
 {
     QList<StudentData> active;
+    forEach([&active](const StudentData& s) {
+        active.append(s);
+        return true;
+    });
+    return active;
+}
+
+// Walks the in-memory rows in place, skipping deleted ones
+bool CsvStudentDAO::forEach(const Visitor& visit)
+{
     for (const auto& s : m_students) {
-        if (s.status() != "deleted") {
-            active.append(s);
+        if (s.status() != StudentStatus::Deleted && !visit(s)) {
+            break;
         }
     }
-    return active;
+    return true;
 }
 
 QList<StudentData> CsvStudentDAO::getDeleted()
 {
     QList<StudentData> deleted;
     for (const auto& s : m_students) {
-        if (s.status() == "deleted") {
+        if (s.status() == StudentStatus::Deleted) {
             deleted.append(s);
         }
     }
@@ -233,7 +243,7 @@ StudentData CsvStudentDAO::parseLine(const QString& line) const
     student.setAcademicLevelId(parts.at(7).toInt());
     student.setSectionId(parts.at(8).toInt());
     student.setCollegeId(parts.at(9).toInt());
-    student.setTuitionFees(parts.at(10).toDouble());
+    student.setTuitionFees(Money::fromString(parts.at(10)));
     student.setSeatNumber(parts.at(11));
     student.setStatus(parts.at(12));
     student.setCreatedAt(parseDateTime(parts.at(13)));
@@ -254,9 +264,9 @@ QString CsvStudentDAO::studentToCsvLine(const StudentData& student) const
         .arg(student.academicLevelId())
         .arg(student.sectionId())
         .arg(student.collegeId())
-        .arg(student.tuitionFees())
+        .arg(student.tuitionFees().toString())
         .arg(student.seatNumber())
-        .arg(student.status())
+        .arg(student.statusName())
         .arg(dateTimeToString(student.createdAt()))
         .arg(dateTimeToString(student.updatedAt()));
 }
@@ -23,6 +23,7 @@ public:
     bool restore(int id) override;
     QList<StudentData> getAll() override;
     QList<StudentData> getDeleted() override;
+    bool forEach(const Visitor& visit) override;
     StudentData getById(int id) override;
     StudentData getByUserId(int userId) override;
     StudentData getByIdNumber(const QString& idNumber) override;
@@ -19,20 +19,19 @@ bool CsvUserDAO::insert(User& user)
     user.setCreatedAt(QDateTime::currentDateTime());
     user.setUpdatedAt(QDateTime::currentDateTime());
     user.setPassword(hashPassword(user.password()));
+    m_rowById.insert(user.id(), m_users.size());
     m_users.append(user);
     return saveData();
 }
 
 bool CsvUserDAO::update(const User& user)
 {
-    for (auto& u : m_users) {
-        if (u.id() == user.id()) {
-            u = user;
-            u.setUpdatedAt(QDateTime::currentDateTime());
-            return saveData();
-        }
-    }
-    return false;
+    const int row = m_rowById.value(user.id(), -1);
+    if (row < 0) return false;
+    User& u = m_users[row];
+    u = user;
+    u.setUpdatedAt(QDateTime::currentDateTime());
+    return saveData();
 }
 
 bool CsvUserDAO::remove(int id)
@@ -41,6 +40,7 @@ bool CsvUserDAO::remove(int id)
                              [id](const User& u) { return u.id() == id; });
     if (it != m_users.end()) {
         m_users.erase(it, m_users.end());
+        reindex();
         return saveData();
     }
     return false;
@@ -53,12 +53,8 @@ QList<User> CsvUserDAO::getAll()
 
 User CsvUserDAO::getById(int id)
 {
-    for (const auto& u : m_users) {
-        if (u.id() == id) {
-            return u;
-        }
-    }
-    return User();
+    const int row = m_rowById.value(id, -1);
+    return row < 0 ? User() : m_users.at(row);
 }
 
 User CsvUserDAO::getByUsername(const QString& username)
@@ -85,6 +81,7 @@ User CsvUserDAO::authenticate(const QString& username, const QString& password)
 void CsvUserDAO::loadData()
 {
     m_users.clear();
+    m_rowById.clear();
     QFile file(m_filePath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         qWarning() << "Failed to open file:" << m_filePath;
@@ -111,6 +108,7 @@ void CsvUserDAO::loadData()
         if (!line.isEmpty()) {
             User user = parseLine(line);
             if (user.id() > 0) {
+                m_rowById.insert(user.id(), m_users.size());
                 m_users.append(user);
                 m_nextId = std::max(m_nextId, user.id() + 1);
             }
@@ -119,6 +117,15 @@ void CsvUserDAO::loadData()
     file.close();
 }
 
+// Rebuilds the id index after rows were removed
+void CsvUserDAO::reindex()
+{
+    m_rowById.clear();
+    for (int i = 0; i < m_users.size(); ++i) {
+        m_rowById.insert(m_users.at(i).id(), i);
+    }
+}
+
 bool CsvUserDAO::saveData()
 {
     QString tempPath = m_filePath + ".tmp";
@@ -194,7 +201,7 @@ QString CsvUserDAO::userToCsvLine(const User& user) const
         .arg(user.fullName())
         .arg(user.username())
         .arg(user.password())
-        .arg(user.role())
+        .arg(user.roleName())
         .arg(dateTimeToString(user.createdAt()))
         .arg(dateTimeToString(user.updatedAt()));
 }
@@ -4,6 +4,7 @@
 #include "../../UniManage/models/user.h"
 #include "dao/user_dao.h"
 #include <QList>
+#include <QHash>
 #include <QString>
 #include <QDateTime>
 #include <QFile>
@@ -28,9 +29,11 @@ public:
 private:
     QString m_filePath;
     QList<User> m_users;
+    QHash<int, int> m_rowById; // index into m_users by user id
     int m_nextId;
 
     void loadData();
+    void reindex();
     bool saveData();
     bool ensureFileExists();
     QStringList getExpectedHeaders() const;
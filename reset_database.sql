@@ -225,6 +225,69 @@ CREATE TABLE payments (
     FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE
 ) ENGINE=InnoDB;
 
+-- Student balances ledger (running totals, updated with every payment write)
+CREATE TABLE student_balances (
+    student_id INT PRIMARY KEY,
+    total_charged DECIMAL(12,2) NOT NULL DEFAULT 0,
+    total_paid DECIMAL(12,2) NOT NULL DEFAULT 0,
+    updated_at DATETIME NULL,
+    FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE
+) ENGINE=InnoDB;
+
+-- Fee rules (per-term tuition by college and/or academic level, NULL = any)
+CREATE TABLE fee_rules (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    college_id INT NULL,
+    academic_level_id INT NULL,
+    amount DECIMAL(12,2) NOT NULL,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    INDEX idx_fee_rules_scope (college_id, academic_level_id),
+    FOREIGN KEY (college_id) REFERENCES colleges(id) ON DELETE CASCADE,
+    FOREIGN KEY (academic_level_id) REFERENCES academic_levels(id) ON DELETE CASCADE
+) ENGINE=InnoDB;
+
+-- Tuition charges (one per student and semester, written by term billing)
+CREATE TABLE tuition_charges (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    student_id INT NOT NULL,
+    semester_id INT NOT NULL,
+    amount DECIMAL(12,2) NOT NULL,
+    billing_run_id INT NULL,
+    created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,
+    UNIQUE KEY uq_tuition_charge (student_id, semester_id),
+    FOREIGN KEY (student_id) REFERENCES students_data(id) ON DELETE CASCADE,
+    FOREIGN KEY (semester_id) REFERENCES semester(id) ON DELETE CASCADE
+) ENGINE=InnoDB;
+
+-- ============================================
+-- BATCH JOBS
+-- ============================================
+
+-- Checkpointed progress of restartable bulk operations
+CREATE TABLE batch_jobs (
+    id INT AUTO_INCREMENT PRIMARY KEY,
+    job_type VARCHAR(50) NOT NULL,
+    scope VARCHAR(100) NOT NULL,
+    status VARCHAR(20) NOT NULL DEFAULT 'Running',
+    checkpoint INT NOT NULL DEFAULT 0,
+    processed INT NOT NULL DEFAULT 0,
+    total INT NOT NULL DEFAULT 0,
+    started_at DATETIME NULL,
+    updated_at DATETIME NULL,
+    UNIQUE KEY uq_batch_job (job_type, scope)
+) ENGINE=InnoDB;
+
+-- ============================================
+-- TABLE VERSIONS
+-- ============================================
+
+-- Per-table change counters, bumped by every controller write so session
+-- caches can tell which of their tables changed since the last load
+CREATE TABLE table_versions (
+    table_name VARCHAR(64) PRIMARY KEY,
+    version BIGINT NOT NULL DEFAULT 0
+) ENGINE=InnoDB;
+
 -- ============================================
 -- INSERT DEFAULT DATA
 -- ============================================